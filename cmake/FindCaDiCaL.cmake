@@ -11,7 +11,7 @@
 # CaDiCaL_INCLUDE_DIR - the CaDiCaL include directory
 # CaDiCaL_LIBRARIES - Libraries needed to use CaDiCaL
 
-find_path(CaDiCaL_INCLUDE_DIR NAMES ccadical.h)
+find_path(CaDiCaL_INCLUDE_DIR NAMES cadical.hpp)
 find_library(CaDiCaL_LIBRARIES NAMES cadical)
 
 include(FindPackageHandleStandardArgs)
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+
+# Boolector: Satisfiablity Modulo Theories (SMT) solver.
+#
+# Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+#
+# This file is part of Boolector.
+# See COPYING for more information on using this software.
+#
+
+# Retrain the model of the automatic engine selection (-E auto, see
+# src/btorautoengine.c) on a local benchmark corpus.
+#
+# For every benchmark, the formula features are extracted via '-E auto -v'
+# and every configuration in CONFIGS is run with a time limit. Per
+# configuration, a ridge regression of -log10(run time) on the features is
+# computed (timeouts are penalized with twice the time limit). The resulting
+# weights are printed as C initializer, or written to src/btorautoengine.c
+# with --update.
+#
+# Run times are cached in a CSV file (--cache), so a corpus only has to be
+# solved once and the model can be refit without rerunning the solver.
+#
+# Example:
+#   ./btortrainengine.py -b build/bin/boolector -t 60 -j 8 \
+#     --cache runs.csv --update ../src/btorautoengine.c benchmarks/
+
+import argparse
+import csv
+import math
+import multiprocessing
+import os
+import re
+import subprocess
+import sys
+import time
+
+# Note: names and order must be kept in sync with g_btor_auto_configs in
+#       src/btorautoengine.c.
+CONFIGS = [
+  ('fun', []),
+  ('fun-preprop', ['--fun-preprop', '--prop-nprops=10000']),
+  ('fun-cadical', ['-SE', 'cadical']),
+  ('fun-lingeling', ['-SE', 'lingeling']),
+  ('fun-cms', ['-SE', 'cms']),
+  ('prop', ['-E', 'prop']),
+  ('sls', ['-E', 'sls']),
+  ('aigprop', ['-E', 'aigprop']),
+]
+
+FEATURES = ['bias', 'nodes', 'vars', 'avgwidth', 'maxwidth', 'arith',
+            'nonlinear', 'bitwise', 'cond', 'ufs', 'lambdas', 'quantifiers']
+
+RE_FEATURES = re.compile(r'^\[btor>autoengine\] features:((?: \S+)+)$')
+
+def die(msg):
+    print('error: {}'.format(msg))
+    sys.exit(1)
+
+def log(msg):
+    if args.verbose:
+        print('[btortrainengine] {}'.format(msg))
+
+def run(cmd, timeout):
+    start = time.time()
+    try:
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE,
+                              stderr=subprocess.STDOUT,
+                              timeout=timeout + 5)
+        out = proc.stdout.decode(errors='replace')
+    except subprocess.TimeoutExpired:
+        out = ''
+    return out, time.time() - start
+
+def get_features(benchmark):
+    cmd = [args.boolector, '-E', 'auto', '-v', '-t', str(args.timeout),
+           benchmark]
+    out, _ = run(cmd, args.timeout)
+    for line in out.splitlines():
+        m = RE_FEATURES.match(line)
+        if m:
+            return [float(v) for v in m.group(1).split()]
+    return None
+
+# Returns the run time of given configuration, or None on timeout/error.
+def get_time(benchmark, config):
+    _, options = config
+    cmd = [args.boolector, '-t', str(args.timeout)] + options + [benchmark]
+    out, t = run(cmd, args.timeout)
+    result = out.strip().splitlines()[-1] if out.strip() else ''
+    if result not in ('sat', 'unsat') or t > args.timeout:
+        return None
+    return t
+
+def solve(benchmark):
+    features = get_features(benchmark)
+    if features is None:
+        return benchmark, None, None
+    times = [get_time(benchmark, config) for config in CONFIGS]
+    return benchmark, features, times
+
+def collect_benchmarks(paths):
+    res = []
+    for path in paths:
+        if os.path.isdir(path):
+            for root, _, files in os.walk(path):
+                for f in sorted(files):
+                    if f.endswith(('.smt2', '.btor', '.btor2', '.smt')):
+                        res.append(os.path.join(root, f))
+        else:
+            res.append(path)
+    return res
+
+def read_cache(path):
+    cache = {}
+    if not path or not os.path.exists(path):
+        return cache
+    with open(path) as f:
+        for row in csv.reader(f):
+            if row[0] == 'benchmark':
+                continue
+            nfeatures = len(FEATURES)
+            features = [float(v) for v in row[1:1 + nfeatures]]
+            times = [float(v) if v else None for v in row[1 + nfeatures:]]
+            cache[row[0]] = (features, times)
+    return cache
+
+def write_cache(path, cache):
+    with open(path, 'w') as f:
+        writer = csv.writer(f)
+        writer.writerow(['benchmark'] + FEATURES + [c[0] for c in CONFIGS])
+        for benchmark, (features, times) in sorted(cache.items()):
+            writer.writerow([benchmark] + features
+                            + ['' if t is None else t for t in times])
+
+# Solve (X^T X + lambda I) w = X^T y via Gaussian elimination.
+def ridge(xs, ys, lam):
+    n = len(FEATURES)
+    a = [[0.0] * (n + 1) for _ in range(n)]
+    for x, y in zip(xs, ys):
+        for i in range(n):
+            for j in range(n):
+                a[i][j] += x[i] * x[j]
+            a[i][n] += x[i] * y
+    for i in range(1, n):
+        a[i][i] += lam
+    for i in range(n):
+        p = max(range(i, n), key=lambda r: abs(a[r][i]))
+        a[i], a[p] = a[p], a[i]
+        if abs(a[i][i]) < 1e-12:
+            continue
+        for r in range(n):
+            if r != i:
+                f = a[r][i] / a[i][i]
+                for c in range(i, n + 1):
+                    a[r][c] -= f * a[i][c]
+    return [a[i][n] / a[i][i] if abs(a[i][i]) >= 1e-12 else 0.0
+            for i in range(n)]
+
+def train(cache):
+    weights = []
+    penalty = 2 * args.timeout
+    for k, (name, _) in enumerate(CONFIGS):
+        xs, ys = [], []
+        for features, times in cache.values():
+            t = times[k] if k < len(times) else None
+            xs.append(features)
+            ys.append(-math.log10(max(penalty if t is None else t, 1e-3)))
+        w = ridge(xs, ys, args.ridge) if xs else [0.0] * len(FEATURES)
+        log('{}: {}'.format(name, ' '.join('{:.4f}'.format(v) for v in w)))
+        weights.append(w)
+    return weights
+
+def format_model(weights):
+    lines = ['static const double '
+             'g_btor_auto_weights[][BTOR_AUTO_ENGINE_NUM_FEATURES] = {']
+    for w in weights:
+        lines.append('    {{{}}},'.format(', '.join('{:.4f}'.format(v)
+                                                   for v in w)))
+    lines.append('};')
+    return '\n'.join(lines)
+
+def update_source(path, model):
+    with open(path) as f:
+        src = f.read()
+    begin, end = '/* BEGIN MODEL */\n', '/* END MODEL */'
+    if begin not in src or end not in src:
+        die('no model markers found in {}'.format(path))
+    head, rest = src.split(begin, 1)
+    _, tail = rest.split(end, 1)
+    with open(path, 'w') as f:
+        f.write(head + begin + model + '\n' + end + tail)
+
+if __name__ == '__main__':
+    ap = argparse.ArgumentParser(
+            description='Retrain the engine selection model of Boolector.')
+    ap.add_argument('benchmarks', nargs='+',
+                    help='benchmark files or directories')
+    ap.add_argument('-b', dest='boolector', default='boolector',
+                    help='Boolector binary')
+    ap.add_argument('-t', dest='timeout', type=int, default=60,
+                    help='time limit per run in seconds')
+    ap.add_argument('-j', dest='jobs', type=int,
+                    default=multiprocessing.cpu_count(),
+                    help='number of parallel runs')
+    ap.add_argument('--ridge', type=float, default=1.0,
+                    help='regularization parameter')
+    ap.add_argument('--cache', help='CSV file with cached run times')
+    ap.add_argument('--update', metavar='FILE',
+                    help='write model to given btorautoengine.c')
+    ap.add_argument('-v', dest='verbose', action='store_true')
+    args = ap.parse_args()
+
+    cache = read_cache(args.cache)
+    todo = [b for b in collect_benchmarks(args.benchmarks) if b not in cache]
+    log('{} cached, {} to solve'.format(len(cache), len(todo)))
+
+    with multiprocessing.Pool(args.jobs) as pool:
+        for benchmark, features, times in pool.imap_unordered(solve, todo):
+            if features is None:
+                log('{}: could not extract features'.format(benchmark))
+                continue
+            log('{}: {}'.format(benchmark, times))
+            cache[benchmark] = (features, times)
+            if args.cache:
+                write_cache(args.cache, cache)
+
+    if not cache:
+        die('no benchmarks')
+
+    model = format_model(train(cache))
+    if args.update:
+        update_source(args.update, model)
+        log('updated {}'.format(args.update))
+    else:
+        print(model)
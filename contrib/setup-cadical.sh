@@ -69,4 +69,4 @@ else
 fi
 
 install_lib build/libcadical.a
-install_include src/ccadical.h
+install_include src/cadical.hpp
@@ -7,14 +7,15 @@
  */
 
 #include "aigprop.h"
-#include "btorclone.h"
 #include "btorcore.h"
 #include "utils/btorhashint.h"
-#include "utils/btorhashptr.h"
 #include "utils/btorstack.h"
 #include "utils/btorutil.h"
 
+#include <inttypes.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 /*------------------------------------------------------------------------*/
 
@@ -46,6 +47,9 @@ msg (char *fmt, ...)
 
 #define BTOR_AIGPROP_SELECT_CFACT 20
 
+/* index of the score of (signed) AIG id 'id' in 'aprop->score' */
+#define BTOR_AIGPROP_SCORE_IDX(id) ((id) < 0 ? 2 * -(id) + 1 : 2 * (id))
+
 /*------------------------------------------------------------------------*/
 
 int32_t
@@ -54,16 +58,26 @@ btor_aigprop_get_assignment_aig (BtorAIGProp *aprop, BtorAIG *aig)
   assert (aprop);
 
   int32_t res;
-  int32_t id;
+  uint32_t id;
 
   if (btor_aig_is_true (aig)) return 1;
   if (btor_aig_is_false (aig)) return -1;
 
-  id = btor_aig_get_id (BTOR_REAL_ADDR_AIG (aig));
-  assert (btor_hashint_map_get (aprop->model, id));
-  res = btor_hashint_map_get (aprop->model, id)->as_int;
-  res = BTOR_IS_INVERTED_AIG (aig) ? -res : res;
-  return res;
+  assert (aprop->model);
+  id = BTOR_REAL_ADDR_AIG (aig)->id;
+  if (id >= aprop->size) return 0;
+  res = aprop->model[id];
+  return BTOR_IS_INVERTED_AIG (aig) ? -res : res;
+}
+
+/* Get the assignment of the (non-constant) AIG with signed id 'id'. */
+static inline int32_t
+get_assignment (BtorAIGProp *aprop, int32_t id)
+{
+  assert (aprop);
+  assert (id < -1 || id > 1);
+  assert ((uint32_t) abs (id) < aprop->size);
+  return id < 0 ? -aprop->model[-id] : aprop->model[id];
 }
 
 /*------------------------------------------------------------------------*/
@@ -75,197 +89,63 @@ btor_aigprop_get_assignment_aig (BtorAIGProp *aprop, BtorAIG *aig)
  * score (BTOR_CONST_AIG_FALSE, A) = 0.0
  * score (aig0 /\ aig1, A) = 1/2 * (score (aig0) + score (aig1), A)
  * score (-(-aig0 /\ -aig1), A) = max (score (-aig0), score (-aig1), A)
+ *
+ * Note: the children of an AND are never constant.
  */
 
-#define BTOR_AIGPROP_LOG_COMPUTE_SCORE_AIG(cur, left, right, s0, s1, res) \
-  do                                                                      \
-  {                                                                       \
-    a = btor_aigprop_get_assignment_aig (aprop, left);                    \
-    assert (a);                                                           \
-    BTOR_AIGPROPLOG (3,                                                   \
-                     "        assignment aig0 (%s%d): %d",                \
-                     BTOR_IS_INVERTED_AIG (left) ? "-" : "",              \
-                     BTOR_REAL_ADDR_AIG (left)->id,                       \
-                     a < 0 ? 0 : 1);                                      \
-    a = btor_aigprop_get_assignment_aig (aprop, right);                   \
-    assert (a);                                                           \
-    BTOR_AIGPROPLOG (3,                                                   \
-                     "        assignment aig1 (%s%d): %d",                \
-                     BTOR_IS_INVERTED_AIG (right) ? "-" : "",             \
-                     BTOR_REAL_ADDR_AIG (right)->id,                      \
-                     a < 0 ? 0 : 1);                                      \
-    BTOR_AIGPROPLOG (3,                                                   \
-                     "        score      aig0 (%s%d): %f%s",              \
-                     BTOR_IS_INVERTED_AIG (left) ? "-" : "",              \
-                     BTOR_REAL_ADDR_AIG (left)->id,                       \
-                     s0,                                                  \
-                     s0 < 1.0 ? " (< 1.0)" : "");                         \
-    BTOR_AIGPROPLOG (3,                                                   \
-                     "        score      aig1 (%s%d): %f%s",              \
-                     BTOR_IS_INVERTED_AIG (right) ? "-" : "",             \
-                     BTOR_REAL_ADDR_AIG (right)->id,                      \
-                     s1,                                                  \
-                     s1 < 1.0 ? " (< 1.0)" : "");                         \
-    BTOR_AIGPROPLOG (3,                                                   \
-                     "      * score cur (%s%d): %f%s",                    \
-                     BTOR_IS_INVERTED_AIG (cur) ? "-" : "",               \
-                     real_cur->id,                                        \
-                     res,                                                 \
-                     res < 1.0 ? " (< 1.0)" : "");                        \
-  } while (0)
-
-static double
-compute_score_aig (BtorAIGProp *aprop, BtorAIG *aig)
+static inline double
+get_score (BtorAIGProp *aprop, int32_t id)
 {
   assert (aprop);
-  assert (!btor_aig_is_const (aig));
-
-  int32_t curid, leftid, rightid;
-  double res, sleft, sright;
-  BtorAIGPtrStack stack;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorIntHashTable *mark;
-  BtorHashTableData *d;
-  BtorMemMgr *mm;
-#ifndef NDEBUG
-  int32_t a;
-#endif
+  assert (aprop->score);
+  return aprop->score[BTOR_AIGPROP_SCORE_IDX (id)];
+}
 
-  curid = btor_aig_get_id (aig);
-  if (btor_hashint_map_contains (aprop->score, curid))
-    return btor_hashint_map_get (aprop->score, curid)->as_dbl;
+/* Compute the scores of 'id' and '-id' from the assignment (inputs) or from
+ * the scores of the children (ANDs). Returns true if a score changed. */
+static bool
+compute_score_aig (BtorAIGProp *aprop, int32_t id)
+{
+  assert (aprop);
+  assert (aprop->score);
+  assert (id > 1);
 
-  mm  = aprop->amgr->btor->mm;
-  res = 0.0;
+  bool res;
+  int32_t left, right;
+  double s, sneg, sleft, sright;
+  BtorAIG *aig;
 
-  BTOR_INIT_STACK (mm, stack);
-  mark = btor_hashint_map_new (mm);
+  aig = btor_aig_get_by_id (aprop->amgr, id);
+  assert (aprop->model[id]);
 
-  BTOR_PUSH_STACK (stack, aig);
-  while (!BTOR_EMPTY_STACK (stack))
+  if (btor_aig_is_var (aig))
   {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-
-    if (btor_aig_is_const (real_cur)) continue;
-
-    curid = btor_aig_get_id (cur);
-    if (btor_hashint_map_contains (aprop->score, curid)) continue;
-
-    d = btor_hashint_map_get (mark, real_cur->id);
-    if (d && d->as_int == 1) continue;
-
-    if (!d)
-    {
-      btor_hashint_map_add (mark, real_cur->id);
-      assert (btor_aig_is_var (real_cur) || btor_aig_is_and (real_cur));
-      BTOR_PUSH_STACK (stack, cur);
-      if (btor_aig_is_and (real_cur))
-      {
-        left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-        right = btor_aig_get_right_child (aprop->amgr, real_cur);
-        if (!btor_aig_is_const (left)) BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)) BTOR_PUSH_STACK (stack, right);
-      }
-    }
-    else
-    {
-      assert (d->as_int == 0);
-      d->as_int = 1;
-      assert (btor_aigprop_get_assignment_aig (aprop, cur) != 0);
-#ifndef NDEBUG
-      a = btor_aigprop_get_assignment_aig (aprop, cur);
-      assert (a);
-      BTOR_AIGPROPLOG (3, "");
-      BTOR_AIGPROPLOG (3,
-                       "  ** assignment cur (%s%d): %d",
-                       BTOR_IS_INVERTED_AIG (cur) ? "-" : "",
-                       real_cur->id,
-                       a < 0 ? 0 : 1);
-#endif
-      assert (!btor_hashint_map_contains (aprop->score, curid));
-      assert (!btor_hashint_map_contains (aprop->score, -curid));
-
-      if (btor_aig_is_var (real_cur))
-      {
-        res = btor_aigprop_get_assignment_aig (aprop, cur) < 0 ? 0.0 : 1.0;
-        BTOR_AIGPROPLOG (3,
-                         "        * score cur (%s%d): %f",
-                         BTOR_IS_INVERTED_AIG (cur) ? "-" : "",
-                         real_cur->id,
-                         res);
-        BTOR_AIGPROPLOG (3,
-                         "        * score cur (%s%d): %f",
-                         BTOR_IS_INVERTED_AIG (cur) ? "" : "-",
-                         real_cur->id,
-                         res == 0.0 ? 1.0 : 0.0);
-        btor_hashint_map_add (aprop->score, curid)->as_dbl = res;
-        btor_hashint_map_add (aprop->score, -curid)->as_dbl =
-            res == 0.0 ? 1.0 : 0.0;
-      }
-      else
-      {
-        assert (btor_aig_is_and (real_cur));
-
-        left    = btor_aig_get_left_child (aprop->amgr, real_cur);
-        right   = btor_aig_get_right_child (aprop->amgr, real_cur);
-        leftid  = btor_aig_get_id (left);
-        rightid = btor_aig_get_id (right);
-
-        assert (btor_aig_is_const (left)
-                || btor_hashint_map_contains (aprop->score, leftid));
-        assert (btor_aig_is_const (right)
-                || btor_hashint_map_contains (aprop->score, rightid));
-        assert (btor_aig_is_const (left)
-                || btor_hashint_map_contains (aprop->score, -leftid));
-        assert (btor_aig_is_const (right)
-                || btor_hashint_map_contains (aprop->score, -rightid));
-
-        sleft = btor_aig_is_const (left)
-                    ? (btor_aig_is_true (left) ? 1.0 : 0.0)
-                    : btor_hashint_map_get (aprop->score, leftid)->as_dbl;
-        sright = btor_aig_is_const (right)
-                     ? (btor_aig_is_true (right) ? 1.0 : 0.0)
-                     : btor_hashint_map_get (aprop->score, rightid)->as_dbl;
-        res = (sleft + sright) / 2.0;
-        /* fix rounding errors (eg. (0.999+1.0)/2 = 1.0) ->
-           choose minimum (else it might again result in 1.0) */
-        if (res == 1.0 && (sleft < 1.0 || sright < 1.0))
-          res = sleft < sright ? sleft : sright;
-        assert (res >= 0.0 && res <= 1.0);
-        btor_hashint_map_add (aprop->score, real_cur->id)->as_dbl = res;
-#ifndef NDEBUG
-        BTOR_AIGPROP_LOG_COMPUTE_SCORE_AIG (
-            real_cur, left, right, sleft, sright, res);
-#endif
-        sleft = btor_aig_is_const (left)
-                    ? (btor_aig_is_true (left) ? 0.0 : 1.0)
-                    : btor_hashint_map_get (aprop->score, -leftid)->as_dbl;
-        sright = btor_aig_is_const (right)
-                     ? (btor_aig_is_true (right) ? 0.0 : 1.0)
-                     : btor_hashint_map_get (aprop->score, -rightid)->as_dbl;
-        res = sleft > sright ? sleft : sright;
-        assert (res >= 0.0 && res <= 1.0);
-        btor_hashint_map_add (aprop->score, -real_cur->id)->as_dbl = res;
-#ifndef NDEBUG
-        BTOR_AIGPROP_LOG_COMPUTE_SCORE_AIG (BTOR_INVERT_AIG (real_cur),
-                                            BTOR_INVERT_AIG (left),
-                                            BTOR_INVERT_AIG (right),
-                                            sleft,
-                                            sright,
-                                            res);
-#endif
-      }
-      assert (btor_hashint_map_contains (aprop->score, curid));
-      assert (btor_hashint_map_contains (aprop->score, -curid));
-    }
+    s    = aprop->model[id] < 0 ? 0.0 : 1.0;
+    sneg = s == 0.0 ? 1.0 : 0.0;
   }
+  else
+  {
+    assert (btor_aig_is_and (aig));
+    left   = btor_aig_get_left_child_id (aprop->amgr, aig);
+    right  = btor_aig_get_right_child_id (aprop->amgr, aig);
+    sleft  = get_score (aprop, left);
+    sright = get_score (aprop, right);
+    s      = (sleft + sright) / 2.0;
+    /* fix rounding errors (eg. (0.999+1.0)/2 = 1.0) ->
+       choose minimum (else it might again result in 1.0) */
+    if (s == 1.0 && (sleft < 1.0 || sright < 1.0))
+      s = sleft < sright ? sleft : sright;
+    sleft  = get_score (aprop, -left);
+    sright = get_score (aprop, -right);
+    sneg   = sleft > sright ? sleft : sright;
+  }
+  assert (s >= 0.0 && s <= 1.0);
+  assert (sneg >= 0.0 && sneg <= 1.0);
 
-  btor_hashint_map_delete (mark);
-  BTOR_RELEASE_STACK (stack);
-
-  assert (btor_hashint_map_contains (aprop->score, btor_aig_get_id (aig)));
-  assert (btor_hashint_map_contains (aprop->score, -btor_aig_get_id (aig)));
+  res = aprop->score[2 * id] != s || aprop->score[2 * id + 1] != sneg;
+  aprop->score[2 * id]     = s;
+  aprop->score[2 * id + 1] = sneg;
+  BTOR_AIGPROPLOG (3, "  * score (%d): %f, score (-%d): %f", id, s, id, sneg);
   return res;
 }
 
@@ -273,159 +153,129 @@ static void
 compute_scores (BtorAIGProp *aprop)
 {
   assert (aprop);
-  assert (aprop->roots);
+  assert (aprop->score);
   assert (aprop->model);
 
-  BtorAIGPtrStack stack;
-  BtorIntHashTable *cache;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorIntHashTableIterator it;
-  BtorMemMgr *mm;
+  uint32_t i;
 
   BTOR_AIGPROPLOG (3, "*** compute scores");
 
-  mm = aprop->amgr->btor->mm;
-
-  BTOR_INIT_STACK (mm, stack);
-  cache = btor_hashint_table_new (mm);
-
-  if (!aprop->score) aprop->score = btor_hashint_map_new (mm);
-
-  /* collect roots */
-  btor_iter_hashint_init (&it, aprop->roots);
-  while (btor_iter_hashint_has_next (&it))
-    BTOR_PUSH_STACK (
-        stack, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
-
-  /* compute scores */
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-
-    if (btor_aig_is_const (real_cur)) continue;
-    if (btor_hashint_map_contains (aprop->score, btor_aig_get_id (cur)))
-      continue;
-
-    if (!btor_hashint_table_contains (cache, real_cur->id))
-    {
-      btor_hashint_table_add (cache, real_cur->id);
-      assert (btor_aig_is_var (real_cur) || btor_aig_is_and (real_cur));
-      BTOR_PUSH_STACK (stack, cur);
-      if (btor_aig_is_and (real_cur))
-      {
-        left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-        right = btor_aig_get_right_child (aprop->amgr, real_cur);
-        if (!btor_aig_is_const (left)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (left)->id))
-          BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (right)->id))
-          BTOR_PUSH_STACK (stack, right);
-      }
-    }
-    else
-    {
-      compute_score_aig (aprop, cur);
-    }
-  }
-
-  /* cleanup */
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
+  /* ids are in topological order */
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
+    compute_score_aig (aprop, BTOR_PEEK_STACK (aprop->cone, i));
 }
 
 /*------------------------------------------------------------------------*/
 
+static int32_t
+compare_int_asc (const void *a, const void *b)
+{
+  int32_t x = *(const int32_t *) a, y = *(const int32_t *) b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* Collect the ids of all AIGs in the cones of the roots and build their
+ * fanout lists (restricted to the cones). */
 static void
-recursively_compute_assignment (BtorAIGProp *aprop, BtorAIG *aig)
+init_cone (BtorAIGProp *aprop)
 {
   assert (aprop);
-  assert (aprop->model);
-  assert (aig);
+  assert (aprop->roots);
+  assert (!aprop->fanout_pos);
+  assert (!aprop->fanouts);
 
-  int32_t aleft, aright;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorAIGPtrStack stack;
-  BtorIntHashTable *cache;
+  int32_t id, child;
+  uint32_t i, j, size, *pos;
+  uint8_t *mark;
+  BtorIntHashTableIterator it;
+  BtorIntStack stack;
+  BtorAIG *aig;
   BtorMemMgr *mm;
 
-  if (btor_aig_is_const (aig)) return;
-
-  mm = aprop->amgr->btor->mm;
+  mm   = aprop->amgr->btor->mm;
+  size = aprop->size;
 
-  cache = btor_hashint_table_new (mm);
+  BTOR_CNEWN (mm, mark, size);
   BTOR_INIT_STACK (mm, stack);
-  BTOR_PUSH_STACK (stack, aig);
-
+  btor_iter_hashint_init (&it, aprop->roots);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id = btor_iter_hashint_next (&it);
+    if (id < -1 || id > 1) BTOR_PUSH_STACK (stack, abs (id));
+  }
   while (!BTOR_EMPTY_STACK (stack))
   {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-    assert (!btor_aig_is_const (real_cur));
-    if (btor_hashint_map_contains (aprop->model, real_cur->id)) continue;
+    id = BTOR_POP_STACK (stack);
+    if (mark[id]) continue;
+    mark[id] = 1;
+    BTOR_PUSH_STACK (aprop->cone, id);
+    aig = btor_aig_get_by_id (aprop->amgr, id);
+    assert (btor_aig_is_var (aig) || btor_aig_is_and (aig));
+    if (btor_aig_is_var (aig)) continue;
+    BTOR_PUSH_STACK (stack, abs (btor_aig_get_left_child_id (aprop->amgr, aig)));
+    BTOR_PUSH_STACK (stack,
+                     abs (btor_aig_get_right_child_id (aprop->amgr, aig)));
+  }
+  BTOR_RELEASE_STACK (stack);
+  BTOR_DELETEN (mm, mark, size);
 
-    if (btor_aig_is_var (real_cur))
-    {
-      /* initialize with false */
-      btor_hashint_map_add (aprop->model, real_cur->id)->as_int = -1;
-    }
-    else
-    {
-      assert (btor_aig_is_and (real_cur));
-      left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-      right = btor_aig_get_right_child (aprop->amgr, real_cur);
+  qsort (aprop->cone.start,
+         BTOR_COUNT_STACK (aprop->cone),
+         sizeof (int32_t),
+         compare_int_asc);
 
-      if (!btor_hashint_table_contains (cache, real_cur->id))
-      {
-        btor_hashint_table_add (cache, real_cur->id);
-        BTOR_PUSH_STACK (stack, cur);
-        if (!btor_aig_is_const (left)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (left)->id))
-          BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (right)->id))
-          BTOR_PUSH_STACK (stack, right);
-      }
-      else
-      {
-        aleft = btor_aigprop_get_assignment_aig (aprop, left);
-        assert (aleft);
-        aright = btor_aigprop_get_assignment_aig (aprop, right);
-        assert (aright);
-        if (aleft < 0 || aright < 0)
-          btor_hashint_map_add (aprop->model, real_cur->id)->as_int = -1;
-        else
-          btor_hashint_map_add (aprop->model, real_cur->id)->as_int = 1;
-      }
+  /* count parents, fanout_pos[id + 1] is the number of parents of id */
+  BTOR_CNEWN (mm, aprop->fanout_pos, size + 1);
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
+  {
+    aig = btor_aig_get_by_id (aprop->amgr, BTOR_PEEK_STACK (aprop->cone, i));
+    if (btor_aig_is_var (aig)) continue;
+    aprop->fanout_pos[abs (btor_aig_get_left_child_id (aprop->amgr, aig)) + 1]++;
+    aprop->fanout_pos[abs (btor_aig_get_right_child_id (aprop->amgr, aig)) + 1]++;
+  }
+  for (i = 1; i <= size; i++)
+    aprop->fanout_pos[i] += aprop->fanout_pos[i - 1];
+  BTOR_NEWN (mm, aprop->fanouts, aprop->fanout_pos[size] + 1);
+
+  /* fill fanout lists */
+  BTOR_NEWN (mm, pos, size);
+  memcpy (pos, aprop->fanout_pos, size * sizeof (uint32_t));
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
+  {
+    id  = BTOR_PEEK_STACK (aprop->cone, i);
+    aig = btor_aig_get_by_id (aprop->amgr, id);
+    if (btor_aig_is_var (aig)) continue;
+    for (j = 0; j < 2; j++)
+    {
+      child = abs (j ? btor_aig_get_right_child_id (aprop->amgr, aig)
+                     : btor_aig_get_left_child_id (aprop->amgr, aig));
+      aprop->fanouts[pos[child]++] = id;
     }
   }
-
-  btor_hashint_table_delete (cache);
-  BTOR_RELEASE_STACK (stack);
+  BTOR_DELETEN (mm, pos, size);
 }
 
+/*------------------------------------------------------------------------*/
+
 void
 btor_aigprop_delete_model (BtorAIGProp *aprop)
 {
   assert (aprop);
 
   if (!aprop->model) return;
-  btor_hashint_map_delete (aprop->model);
+  BTOR_DELETEN (aprop->amgr->btor->mm, aprop->model, aprop->size);
   aprop->model = 0;
 }
 
-void
-btor_aigprop_init_model (BtorAIGProp *aprop)
+static void
+init_model (BtorAIGProp *aprop)
 {
   assert (aprop);
 
-  if (aprop->model) btor_aigprop_delete_model (aprop);
-  aprop->model = btor_hashint_map_new (aprop->amgr->btor->mm);
+  if (aprop->model)
+    memset (aprop->model, 0, aprop->size * sizeof (*aprop->model));
+  else
+    BTOR_CNEWN (aprop->amgr->btor->mm, aprop->model, aprop->size);
 }
 
 void
@@ -434,274 +284,213 @@ btor_aigprop_generate_model (BtorAIGProp *aprop, bool reset)
   assert (aprop);
   assert (aprop->roots);
 
-  BtorIntHashTableIterator it;
+  uint32_t i;
+  int32_t id;
+  BtorAIG *aig;
 
-  if (reset) btor_aigprop_init_model (aprop);
+  if (reset || !aprop->model) init_model (aprop);
 
-  btor_iter_hashint_init (&it, aprop->roots);
-  while (btor_iter_hashint_has_next (&it))
-    recursively_compute_assignment (
-        aprop, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
+  /* ids are in topological order */
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
+  {
+    id = BTOR_PEEK_STACK (aprop->cone, i);
+    if (aprop->model[id]) continue;
+    aig = btor_aig_get_by_id (aprop->amgr, id);
+    if (btor_aig_is_var (aig))
+    {
+      /* initialize with false */
+      aprop->model[id] = -1;
+    }
+    else
+    {
+      assert (btor_aig_is_and (aig));
+      aprop->model[id] =
+          get_assignment (aprop, btor_aig_get_left_child_id (aprop->amgr, aig))
+                      < 0
+                  || get_assignment (
+                         aprop, btor_aig_get_right_child_id (aprop->amgr, aig))
+                         < 0
+              ? -1
+              : 1;
+    }
+  }
 }
 
 /*------------------------------------------------------------------------*/
 
+/* Add root 'id' to the unsatisfied roots if it is falsified by the current
+ * assignment, and remove it if it is satisfied. */
 static inline void
-update_unsatroots_table (BtorAIGProp *aprop, BtorAIG *aig, int32_t assignment)
+update_unsatroots (BtorAIGProp *aprop, int32_t id)
 {
   assert (aprop);
-  assert (aig);
-  assert (!btor_aig_is_const (aig));
-  assert (
-      btor_hashint_table_contains (aprop->roots, btor_aig_get_id (aig))
-      || btor_hashint_table_contains (aprop->roots, -btor_aig_get_id (aig)));
-  assert (btor_aigprop_get_assignment_aig (aprop, aig) != assignment);
-  assert (assignment == 1 || assignment == -1);
-
-  uint32_t id;
+  assert (id > 1);
 
-  id = btor_aig_get_id (aig);
+  int32_t rootid, last;
+  uint32_t pos;
 
-  if (btor_hashint_map_contains (aprop->unsatroots, id))
+  if (!aprop->rootpol[id]) return;
+  rootid = aprop->rootpol[id] * id;
+  if (get_assignment (aprop, rootid) == 1)
   {
-    btor_hashint_map_remove (aprop->unsatroots, id, 0);
-    assert (btor_aigprop_get_assignment_aig (aprop, aig) == -1);
-    assert (assignment == 1);
-  }
-  else if (btor_hashint_map_contains (aprop->unsatroots, -id))
-  {
-    btor_hashint_map_remove (aprop->unsatroots, -id, 0);
-    assert (btor_aigprop_get_assignment_aig (aprop, BTOR_INVERT_AIG (aig))
-            == -1);
-    assert (assignment == -1);
+    if (!(pos = aprop->unsatpos[id])) return;
+    /* move last unsatisfied root to the position of 'rootid' */
+    last = BTOR_POP_STACK (aprop->unsatroots);
+    if (pos - 1 < BTOR_COUNT_STACK (aprop->unsatroots))
+    {
+      BTOR_POKE_STACK (aprop->unsatroots, pos - 1, last);
+      aprop->unsatpos[abs (last)] = pos;
+    }
+    aprop->unsatpos[id] = 0;
   }
-  else if (assignment == -1)
+  else if (!aprop->unsatpos[id])
   {
-    btor_hashint_map_add (aprop->unsatroots, id);
-    assert (btor_aigprop_get_assignment_aig (aprop, aig) == 1);
+    BTOR_PUSH_STACK (aprop->unsatroots, rootid);
+    aprop->unsatpos[id] = BTOR_COUNT_STACK (aprop->unsatroots);
+    aprop->selected[id] = 0;
   }
-  else
+}
+
+/* Add 'id' to the update queue, a min-heap on AIG ids. */
+static void
+queue_push (BtorAIGProp *aprop, int32_t id)
+{
+  assert (aprop);
+  assert (id > 1);
+
+  uint32_t i, p;
+  int32_t *heap;
+
+  if (aprop->queued[id]) return;
+  aprop->queued[id] = 1;
+  BTOR_PUSH_STACK (aprop->queue, id);
+  heap = aprop->queue.start;
+  for (i = BTOR_COUNT_STACK (aprop->queue) - 1; i > 0; i = p)
   {
-    btor_hashint_map_add (aprop->unsatroots, -id);
-    assert (btor_aigprop_get_assignment_aig (aprop, BTOR_INVERT_AIG (aig))
-            == 1);
+    p = (i - 1) / 2;
+    if (heap[p] <= id) break;
+    heap[i] = heap[p];
   }
+  heap[i] = id;
 }
 
-static void
-update_cone (BtorAIGProp *aprop, BtorAIG *aig, int32_t assignment)
+static int32_t
+queue_pop (BtorAIGProp *aprop)
 {
   assert (aprop);
-  assert (aig);
-  assert (BTOR_IS_REGULAR_AIG (aig));
-  assert (btor_aig_is_var (aig));
-  assert (assignment == 1 || assignment == -1);
+  assert (!BTOR_EMPTY_STACK (aprop->queue));
 
-  int32_t aleft, aright, ass, leftid, rightid;
-  uint32_t i;
-  double start, delta, sleft, sright, s;
-  BtorIntHashTable *cache;
-  BtorHashTableData *d;
-  BtorAIGPtrStack stack, cone;
-  BtorIntStack *parents;
-  BtorAIG *cur, *left, *right;
-  BtorMemMgr *mm;
+  uint32_t i, c, n;
+  int32_t res, last, *heap;
 
-  start = btor_util_time_stamp ();
+  heap = aprop->queue.start;
+  res  = heap[0];
+  last = BTOR_POP_STACK (aprop->queue);
+  n    = BTOR_COUNT_STACK (aprop->queue);
+  if (n)
+  {
+    for (i = 0; (c = 2 * i + 1) < n; i = c)
+    {
+      if (c + 1 < n && heap[c + 1] < heap[c]) c += 1;
+      if (last <= heap[c]) break;
+      heap[i] = heap[c];
+    }
+    heap[i] = last;
+  }
+  aprop->queued[res] = 0;
+  return res;
+}
 
-  mm = aprop->amgr->btor->mm;
+static inline void
+queue_fanouts (BtorAIGProp *aprop, int32_t id)
+{
+  uint32_t i;
+  for (i = aprop->fanout_pos[id]; i < aprop->fanout_pos[id + 1]; i++)
+    queue_push (aprop, aprop->fanouts[i]);
+}
 
 #ifndef NDEBUG
+static void
+check_unsatroots_dbg (BtorAIGProp *aprop)
+{
+  int32_t rootid;
   BtorIntHashTableIterator it;
-  BtorAIG *root;
+
   btor_iter_hashint_init (&it, aprop->roots);
   while (btor_iter_hashint_has_next (&it))
   {
-    root = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-    assert (!btor_aig_is_false (root));
-    if ((!BTOR_IS_INVERTED_AIG (root)
-         && btor_aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root))
-                == -1)
-        || (BTOR_IS_INVERTED_AIG (root)
-            && btor_aigprop_get_assignment_aig (aprop,
-                                                BTOR_REAL_ADDR_AIG (root))
-                   == 1))
-    {
-      assert (btor_hashint_map_contains (aprop->unsatroots,
-                                         btor_aig_get_id (root)));
-    }
-    else if ((!BTOR_IS_INVERTED_AIG (root)
-              && btor_aigprop_get_assignment_aig (aprop,
-                                                  BTOR_REAL_ADDR_AIG (root))
-                     == 1)
-             || (BTOR_IS_INVERTED_AIG (root)
-                 && btor_aigprop_get_assignment_aig (aprop,
-                                                     BTOR_REAL_ADDR_AIG (root))
-                        == -1))
-    {
-      assert (!btor_hashint_map_contains (aprop->unsatroots,
-                                          btor_aig_get_id (root)));
-    }
+    rootid = btor_iter_hashint_next (&it);
+    if (rootid >= -1 && rootid <= 1) continue;
+    assert ((get_assignment (aprop, rootid) == -1)
+            == (aprop->unsatpos[abs (rootid)] != 0));
+    assert (!aprop->unsatpos[abs (rootid)]
+            || BTOR_PEEK_STACK (aprop->unsatroots,
+                                aprop->unsatpos[abs (rootid)] - 1)
+                   == rootid);
   }
+}
 #endif
 
-  /* reset cone ----------------------------------------------------------- */
-
-  BTOR_INIT_STACK (mm, cone);
-  BTOR_INIT_STACK (mm, stack);
-  cache = btor_hashint_table_new (mm);
-  BTOR_PUSH_STACK (stack, aig);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_POP_STACK (stack);
-    assert (BTOR_IS_REGULAR_AIG (cur));
-    if (btor_hashint_table_contains (cache, cur->id)) continue;
-    btor_hashint_table_add (cache, cur->id);
-    if (cur != aig) BTOR_PUSH_STACK (cone, cur);
-    assert (btor_hashint_map_contains (aprop->parents, cur->id));
-    parents = btor_hashint_map_get (aprop->parents, cur->id)->as_ptr;
-    for (i = 0; i < BTOR_COUNT_STACK (*parents); i++)
-      BTOR_PUSH_STACK (
-          stack,
-          btor_aig_get_by_id (aprop->amgr, BTOR_PEEK_STACK (*parents, i)));
-  }
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
-
-  aprop->time.update_cone_reset += btor_util_time_stamp () - start;
-
-  /* update assignment and score of 'aig' --------------------------------- */
-  /* update model */
-  d = btor_hashint_map_get (aprop->model, aig->id);
-  assert (d);
-  /* update unsatroots table */
-  if (d->as_int != assignment
-      && (btor_hashint_table_contains (aprop->roots, aig->id)
-          || btor_hashint_table_contains (aprop->roots, -aig->id)))
-    update_unsatroots_table (aprop, aig, assignment);
-  d->as_int = assignment;
-
-  /* update score */
-  if (aprop->score)
-  {
-    d         = btor_hashint_map_get (aprop->score, aig->id);
-    d->as_dbl = assignment < 0 ? 0.0 : 1.0;
-    d         = btor_hashint_map_get (aprop->score, -aig->id);
-    d->as_dbl = assignment < 0 ? 1.0 : 0.0;
-  }
+/* Flip input 'aig' to 'assignment' and propagate the change along the
+ * fanouts. Nodes are updated in ascending id (= topological) order, and the
+ * fanouts of a node are only visited if its assignment or score changed. */
+static void
+update_cone (BtorAIGProp *aprop, BtorAIG *aig, int32_t assignment)
+{
+  assert (aprop);
+  assert (aig);
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (btor_aig_is_var (aig));
+  assert (assignment == 1 || assignment == -1);
 
-  qsort (cone.start,
-         BTOR_COUNT_STACK (cone),
-         sizeof (BtorAIG *),
-         btor_compare_aig_by_id_qsort_asc);
+  int32_t id, ass;
+  bool changed;
+  double start;
 
-  /* update model of cone ------------------------------------------------- */
+  start = btor_util_time_stamp ();
 
-  delta = btor_util_time_stamp ();
+#ifndef NDEBUG
+  check_unsatroots_dbg (aprop);
+#endif
 
-  for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+  id = aig->id;
+  if (aprop->model[id] != assignment)
   {
-    cur = BTOR_PEEK_STACK (cone, i);
-    assert (BTOR_IS_REGULAR_AIG (cur));
-    assert (btor_aig_is_and (cur));
-    assert (btor_hashint_map_contains (aprop->model, cur->id));
-
-    left  = btor_aig_get_left_child (aprop->amgr, cur);
-    right = btor_aig_get_right_child (aprop->amgr, cur);
-    aleft = btor_aigprop_get_assignment_aig (aprop, left);
-    assert (aleft);
-    aright = btor_aigprop_get_assignment_aig (aprop, right);
-    assert (aright);
-    ass = aleft < 0 || aright < 0 ? -1 : 1;
-    d   = btor_hashint_map_get (aprop->model, cur->id);
-    assert (d);
-    /* update unsatroots table */
-    if (d->as_int != ass
-        && (btor_hashint_table_contains (aprop->roots, cur->id)
-            || btor_hashint_table_contains (aprop->roots, -cur->id)))
-      update_unsatroots_table (aprop, cur, ass);
-    d->as_int = ass;
-  }
-
-  aprop->time.update_cone_model_gen += btor_util_time_stamp () - delta;
-  delta = btor_util_time_stamp ();
+    aprop->model[id] = assignment;
+    aprop->stats.flips += 1;
+    update_unsatroots (aprop, id);
+    if (aprop->score) compute_score_aig (aprop, id);
+    queue_fanouts (aprop, id);
 
-  /* update score of cone ------------------------------------------------- */
-
-  if (aprop->score)
-  {
-    delta = btor_util_time_stamp ();
-    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+    while (!BTOR_EMPTY_STACK (aprop->queue))
     {
-      cur = BTOR_PEEK_STACK (cone, i);
-      assert (BTOR_IS_REGULAR_AIG (cur));
-      assert (btor_aig_is_and (cur));
-      assert (btor_hashint_map_contains (aprop->score, cur->id));
-      assert (btor_hashint_map_contains (aprop->score, -cur->id));
-
-      left    = btor_aig_get_left_child (aprop->amgr, cur);
-      right   = btor_aig_get_right_child (aprop->amgr, cur);
-      leftid  = btor_aig_get_id (left);
-      rightid = btor_aig_get_id (right);
-
-      sleft = btor_aig_is_const (left)
-                  ? (btor_aig_is_true (left) ? 1.0 : 0.0)
-                  : btor_hashint_map_get (aprop->score, leftid)->as_dbl;
-      sright = btor_aig_is_const (right)
-                   ? (btor_aig_is_true (right) ? 1.0 : 0.0)
-                   : btor_hashint_map_get (aprop->score, rightid)->as_dbl;
-      s = (sleft + sright) / 2.0;
-      /* fix rounding errors (eg. (0.999+1.0)/2 = 1.0) ->
-         choose minimum (else it might again result in 1.0) */
-      if (s == 1.0 && (sleft < 1.0 || sright < 1.0))
-        s = sleft < sright ? sleft : sright;
-      assert (s >= 0.0 && s <= 1.0);
-      btor_hashint_map_get (aprop->score, cur->id)->as_dbl = s;
-
-      sleft = btor_aig_is_const (left)
-                  ? (btor_aig_is_true (left) ? 0.0 : 1.0)
-                  : btor_hashint_map_get (aprop->score, -leftid)->as_dbl;
-      sright = btor_aig_is_const (right)
-                   ? (btor_aig_is_true (right) ? 1.0 : 0.0)
-                   : btor_hashint_map_get (aprop->score, -rightid)->as_dbl;
-      s = sleft > sright ? sleft : sright;
-      assert (s >= 0.0 && s <= 1.0);
-      btor_hashint_map_get (aprop->score, -cur->id)->as_dbl = s;
+      id  = queue_pop (aprop);
+      aig = btor_aig_get_by_id (aprop->amgr, id);
+      assert (btor_aig_is_and (aig));
+      aprop->stats.updates += 1;
+
+      ass = get_assignment (aprop,
+                            btor_aig_get_left_child_id (aprop->amgr, aig))
+                        < 0
+                    || get_assignment (
+                           aprop, btor_aig_get_right_child_id (aprop->amgr, aig))
+                           < 0
+                ? -1
+                : 1;
+      changed = false;
+      if (aprop->model[id] != ass)
+      {
+        aprop->model[id] = ass;
+        update_unsatroots (aprop, id);
+        changed = true;
+      }
+      if (aprop->score && compute_score_aig (aprop, id)) changed = true;
+      if (changed) queue_fanouts (aprop, id);
     }
-    aprop->time.update_cone_compute_score += btor_util_time_stamp () - delta;
   }
 
-  BTOR_RELEASE_STACK (cone);
-
 #ifndef NDEBUG
-  btor_iter_hashint_init (&it, aprop->roots);
-  while (btor_iter_hashint_has_next (&it))
-  {
-    root = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-    if ((!BTOR_IS_INVERTED_AIG (root)
-         && btor_aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root))
-                == -1)
-        || (BTOR_IS_INVERTED_AIG (root)
-            && btor_aigprop_get_assignment_aig (aprop,
-                                                BTOR_REAL_ADDR_AIG (root))
-                   == 1))
-    {
-      assert (btor_hashint_map_contains (aprop->unsatroots,
-                                         btor_aig_get_id (root)));
-    }
-    else if ((!BTOR_IS_INVERTED_AIG (root)
-              && btor_aigprop_get_assignment_aig (aprop,
-                                                  BTOR_REAL_ADDR_AIG (root))
-                     == 1)
-             || (BTOR_IS_INVERTED_AIG (root)
-                 && btor_aigprop_get_assignment_aig (aprop,
-                                                     BTOR_REAL_ADDR_AIG (root))
-                        == -1))
-    {
-      assert (!btor_hashint_map_contains (aprop->unsatroots,
-                                          btor_aig_get_id (root)));
-    }
-  }
+  check_unsatroots_dbg (aprop);
 #endif
 
   aprop->time.update_cone += btor_util_time_stamp () - start;
@@ -713,33 +502,30 @@ static BtorAIG *
 select_root (BtorAIGProp *aprop, uint32_t nmoves)
 {
   assert (aprop);
-  assert (aprop->unsatroots);
-  assert (aprop->score);
+  assert (!BTOR_EMPTY_STACK (aprop->unsatroots));
 
   BtorAIG *res, *cur;
-  BtorIntHashTableIterator it;
-  BtorMemMgr *mm;
+  int32_t rootid;
+  uint32_t i;
 
-  mm  = aprop->amgr->btor->mm;
   res = 0;
 
   if (aprop->use_bandit)
   {
-    int32_t *selected;
+    uint32_t *selected;
     double value, max_value, score;
-    BtorHashTableData *d;
+
+    assert (aprop->score);
 
     max_value = 0.0;
-    btor_iter_hashint_init (&it, aprop->unsatroots);
-    while (btor_iter_hashint_has_next (&it))
+    for (i = 0; i < BTOR_COUNT_STACK (aprop->unsatroots); i++)
     {
-      selected = &aprop->unsatroots->data[it.cur_pos].as_int;
-      cur      = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-      assert (btor_aigprop_get_assignment_aig (aprop, cur) != 1);
+      rootid   = BTOR_PEEK_STACK (aprop->unsatroots, i);
+      selected = &aprop->selected[abs (rootid)];
+      cur      = btor_aig_get_by_id (aprop->amgr, rootid);
+      assert (get_assignment (aprop, rootid) != 1);
       assert (!btor_aig_is_const (cur));
-      d = btor_hashint_map_get (aprop->score, btor_aig_get_id (cur));
-      assert (d);
-      score = d->as_dbl;
+      score = get_score (aprop, rootid);
       assert (score < 1.0);
       if (!res)
       {
@@ -759,21 +545,11 @@ select_root (BtorAIGProp *aprop, uint32_t nmoves)
   }
   else
   {
-    uint32_t r;
-    BtorAIGPtrStack stack;
-    BTOR_INIT_STACK (mm, stack);
-    btor_iter_hashint_init (&it, aprop->unsatroots);
-    while (btor_iter_hashint_has_next (&it))
-    {
-      cur = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-      assert (btor_aigprop_get_assignment_aig (aprop, cur) != 1);
-      assert (!btor_aig_is_const (cur));
-      BTOR_PUSH_STACK (stack, cur);
-    }
-    assert (BTOR_COUNT_STACK (stack));
-    r   = btor_rng_pick_rand (&aprop->rng, 0, BTOR_COUNT_STACK (stack) - 1);
-    res = stack.start[r];
-    BTOR_RELEASE_STACK (stack);
+    i = btor_rng_pick_rand (
+        &aprop->rng, 0, BTOR_COUNT_STACK (aprop->unsatroots) - 1);
+    rootid = BTOR_PEEK_STACK (aprop->unsatroots, i);
+    assert (get_assignment (aprop, rootid) != 1);
+    res = btor_aig_get_by_id (aprop->amgr, rootid);
   }
 
   assert (res);
@@ -801,7 +577,6 @@ select_move (BtorAIGProp *aprop,
   int32_t i, asscur, ass[2], assnew;
   uint32_t eidx;
   BtorAIG *cur, *real_cur, *c[2];
-  BtorHashTableData *d;
 
   *input      = 0;
   *assignment = 0;
@@ -821,39 +596,25 @@ select_move (BtorAIGProp *aprop,
       real_cur = BTOR_REAL_ADDR_AIG (cur);
       assert (btor_aig_is_and (real_cur));
       asscur = BTOR_IS_INVERTED_AIG (cur) ? -asscur : asscur;
-      c[0]   = btor_aig_get_by_id (aprop->amgr, real_cur->children[0]);
-      c[1]   = btor_aig_get_by_id (aprop->amgr, real_cur->children[1]);
+      c[0]   = btor_aig_get_left_child (aprop->amgr, real_cur);
+      c[1]   = btor_aig_get_right_child (aprop->amgr, real_cur);
+      assert (!btor_aig_is_const (c[0]));
+      assert (!btor_aig_is_const (c[1]));
 
-      /* conflict */
-      if (btor_aig_is_and (real_cur) && btor_aig_is_const (c[0])
-          && btor_aig_is_const (c[1]))
-        break;
-
-      /* select path and determine path assignment */
-      if (btor_aig_is_const (c[0]))
-        eidx = 1;
-      else if (btor_aig_is_const (c[1]))
-        eidx = 0;
-      else
+      /* choose 0-branch if exactly one branch is 0,
+       * else choose randomly */
+      for (i = 0; i < 2; i++)
       {
-        /* choose 0-branch if exactly one branch is 0,
-         * else choose randomly */
-        for (i = 0; i < 2; i++)
-        {
-          assert (btor_hashint_map_get (aprop->model,
-                                        BTOR_REAL_ADDR_AIG (c[i])->id));
-          d = btor_hashint_map_get (aprop->model,
-                                    BTOR_REAL_ADDR_AIG (c[i])->id);
-          assert (d);
-          ass[i] = BTOR_IS_INVERTED_AIG (c[i]) ? -d->as_int : d->as_int;
-        }
-        if (ass[0] == -1 && ass[1] == 1)
-          eidx = 0;
-        else if (ass[0] == 1 && ass[1] == -1)
-          eidx = 1;
-        else
-          eidx = btor_rng_pick_rand (&aprop->rng, 0, 1);
+        ass[i] = get_assignment (aprop, btor_aig_get_id (c[i]));
+        assert (ass[i]);
       }
+      if (ass[0] == -1 && ass[1] == 1)
+        eidx = 0;
+      else if (ass[0] == 1 && ass[1] == -1)
+        eidx = 1;
+      else
+        eidx = btor_rng_pick_rand (&aprop->rng, 0, 1);
+
       if (asscur == 1)
         assnew = 1;
       else if (ass[eidx ? 0 : 1] == 1)
@@ -882,7 +643,6 @@ move (BtorAIGProp *aprop, uint32_t nmoves)
 {
   assert (aprop);
   assert (aprop->roots);
-  assert (aprop->unsatroots);
   assert (aprop->model);
 
   int32_t assignment;
@@ -912,6 +672,15 @@ move (BtorAIGProp *aprop, uint32_t nmoves)
 
 /*------------------------------------------------------------------------*/
 
+static void
+reset_unsatroots (BtorAIGProp *aprop)
+{
+  assert (aprop);
+
+  while (!BTOR_EMPTY_STACK (aprop->unsatroots))
+    aprop->unsatpos[abs (BTOR_POP_STACK (aprop->unsatroots))] = 0;
+}
+
 // TODO termination callback?
 int32_t
 btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
@@ -920,15 +689,11 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
   assert (roots);
 
   double start;
-  int32_t i, j, max_steps, sat_result, rootid, childid;
-  uint32_t nmoves;
+  int32_t j, max_steps, sat_result, rootid;
+  uint32_t nmoves, size;
   BtorMemMgr *mm;
-  BtorIntHashTable *cache;
   BtorIntHashTableIterator it;
-  BtorHashTableData *d;
-  BtorAIGPtrStack stack;
-  BtorIntStack *childparents;
-  BtorAIG *root, *cur, *child;
+  BtorAIG *root;
 
   start      = btor_util_time_stamp ();
   sat_result = BTOR_AIGPROP_UNKNOWN;
@@ -937,90 +702,50 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
   mm           = aprop->amgr->btor->mm;
   aprop->roots = roots;
 
-  /* collect parents (for cone computation) */
-  BTOR_INIT_STACK (mm, stack);
-  cache = btor_hashint_map_new (mm);
-  assert (!aprop->parents);
-  aprop->parents = btor_hashint_map_new (mm);
+  /* AIGs may have been added since the last call */
+  btor_aigprop_delete_model (aprop);
+  aprop->size = size = BTOR_COUNT_STACK (aprop->amgr->id2aig);
+
+  BTOR_CNEWN (mm, aprop->rootpol, size);
+  BTOR_CNEWN (mm, aprop->unsatpos, size);
+  BTOR_CNEWN (mm, aprop->selected, size);
+  BTOR_CNEWN (mm, aprop->queued, size);
 
   btor_iter_hashint_init (&it, roots);
   while (btor_iter_hashint_has_next (&it))
   {
-    cur = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-    if (btor_aig_is_const (cur)) continue;
-    BTOR_PUSH_STACK (stack, cur);
+    rootid = btor_iter_hashint_next (&it);
+    root   = btor_aig_get_by_id (aprop->amgr, rootid);
+    if (btor_aig_is_true (root)) continue;
+    if (btor_aig_is_false (root)) goto UNSAT;
+    if (btor_hashint_table_contains (aprop->roots, -rootid)) goto UNSAT;
+    aprop->rootpol[abs (rootid)] = rootid < 0 ? -1 : 1;
   }
 
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (stack));
-    assert (!btor_aig_is_const (cur));
-
-    if ((d = btor_hashint_map_get (cache, cur->id)) && d->as_int == 1) continue;
-
-    if (!d)
-    {
-      btor_hashint_map_add (cache, cur->id);
-      BTOR_PUSH_STACK (stack, cur);
-      BTOR_NEW (mm, childparents);
-      BTOR_INIT_STACK (mm, *childparents);
-      btor_hashint_map_add (aprop->parents, cur->id)->as_ptr = childparents;
-      if (btor_aig_is_and (cur))
-      {
-        for (i = 0; i < 2; i++)
-        {
-          child = btor_aig_get_by_id (aprop->amgr, cur->children[i]);
-          if (!btor_aig_is_const (child)) BTOR_PUSH_STACK (stack, child);
-        }
-      }
-    }
-    else
-    {
-      assert (d->as_int == 0);
-      d->as_int = 1;
-      if (btor_aig_is_var (cur)) continue;
-      for (i = 0; i < 2; i++)
-      {
-        if (btor_aig_is_const (
-                btor_aig_get_by_id (aprop->amgr, cur->children[i])))
-          continue;
-        childid = cur->children[i] < 0 ? -cur->children[i] : cur->children[i];
-        assert (btor_hashint_map_contains (aprop->parents, childid));
-        childparents = btor_hashint_map_get (aprop->parents, childid)->as_ptr;
-        assert (childparents);
-        BTOR_PUSH_STACK (*childparents, cur->id);
-      }
-    }
-  }
-  btor_hashint_map_delete (cache);
-  BTOR_RELEASE_STACK (stack);
+  /* collect cones and fanouts (for cone updates) */
+  init_cone (aprop);
 
   /* generate initial model, all inputs are initialized with false */
   btor_aigprop_generate_model (aprop, true);
 
+  if (aprop->use_bandit) BTOR_CNEWN (mm, aprop->score, 2 * size);
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
-    assert (!aprop->unsatroots);
-    aprop->unsatroots = btor_hashint_map_new (mm);
+    assert (BTOR_EMPTY_STACK (aprop->unsatroots));
     btor_iter_hashint_init (&it, roots);
     while (btor_iter_hashint_has_next (&it))
     {
       rootid = btor_iter_hashint_next (&it);
-      root   = btor_aig_get_by_id (aprop->amgr, rootid);
-      if (btor_aig_is_true (root)) continue;
-      if (btor_aig_is_false (root)) goto UNSAT;
-      if (btor_hashint_table_contains (aprop->roots, -rootid)) goto UNSAT;
-      assert (btor_aigprop_get_assignment_aig (aprop, root));
-      if (!btor_hashint_map_contains (aprop->unsatroots, rootid)
-          && btor_aigprop_get_assignment_aig (aprop, root) == -1)
-        btor_hashint_map_add (aprop->unsatroots, rootid);
+      if (rootid >= -1 && rootid <= 1) continue;
+      update_unsatroots (aprop, abs (rootid));
     }
 
     /* compute initial score */
-    compute_scores (aprop);
+    if (aprop->score) compute_scores (aprop);
 
-    if (!aprop->unsatroots->count) goto SAT;
+    if (BTOR_EMPTY_STACK (aprop->unsatroots)) goto SAT;
 
     for (j = 0, max_steps = BTOR_AIGPROP_MAXSTEPS (aprop->stats.restarts + 1);
          !aprop->use_restarts || j < max_steps;
@@ -1028,15 +753,12 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
     {
       if (!(move (aprop, nmoves))) goto UNSAT;
       nmoves += 1;
-      if (!aprop->unsatroots->count) goto SAT;
+      if (BTOR_EMPTY_STACK (aprop->unsatroots)) goto SAT;
     }
 
     /* restart */
     btor_aigprop_generate_model (aprop, true);
-    btor_hashint_map_delete (aprop->score);
-    aprop->score = 0;
-    btor_hashint_map_delete (aprop->unsatroots);
-    aprop->unsatroots = 0;
+    reset_unsatroots (aprop);
     aprop->stats.restarts += 1;
   }
 SAT:
@@ -1045,21 +767,29 @@ SAT:
 UNSAT:
   sat_result = BTOR_AIGPROP_UNSAT;
 DONE:
-  btor_iter_hashint_init (&it, aprop->parents);
-  while (btor_iter_hashint_has_next (&it))
+  /* keep the model only */
+  if (!aprop->model) init_model (aprop);
+  BTOR_DELETEN (mm, aprop->rootpol, size);
+  BTOR_DELETEN (mm, aprop->unsatpos, size);
+  BTOR_DELETEN (mm, aprop->selected, size);
+  BTOR_DELETEN (mm, aprop->queued, size);
+  if (aprop->score) BTOR_DELETEN (mm, aprop->score, 2 * size);
+  if (aprop->fanout_pos)
   {
-    childparents = btor_iter_hashint_next_data (&it)->as_ptr;
-    assert (childparents);
-    BTOR_RELEASE_STACK (*childparents);
-    BTOR_DELETE (mm, childparents);
+    BTOR_DELETEN (mm, aprop->fanouts, aprop->fanout_pos[size] + 1);
+    BTOR_DELETEN (mm, aprop->fanout_pos, size + 1);
   }
-  btor_hashint_map_delete (aprop->parents);
-  aprop->parents = 0;
-  if (aprop->unsatroots) btor_hashint_map_delete (aprop->unsatroots);
-  aprop->unsatroots = 0;
-  aprop->roots      = 0;
-  if (aprop->score) btor_hashint_map_delete (aprop->score);
-  aprop->score = 0;
+  aprop->rootpol    = 0;
+  aprop->unsatpos   = 0;
+  aprop->selected   = 0;
+  aprop->queued     = 0;
+  aprop->score      = 0;
+  aprop->fanouts    = 0;
+  aprop->fanout_pos = 0;
+  BTOR_RESET_STACK (aprop->unsatroots);
+  BTOR_RELEASE_STACK (aprop->cone);
+  BTOR_RELEASE_STACK (aprop->queue);
+  aprop->roots = 0;
 
   aprop->time.sat += btor_util_time_stamp () - start;
   return sat_result;
@@ -1075,18 +805,25 @@ btor_aigprop_clone_aigprop (BtorAIGMgr *clone, BtorAIGProp *aprop)
 
   if (!aprop) return 0;
 
+  /* the search state only exists during btor_aigprop_sat */
+  assert (!aprop->roots);
+  assert (!aprop->score);
+  assert (!aprop->fanouts);
+
   mm = clone->btor->mm;
 
   BTOR_CNEW (mm, res);
   memcpy (res, aprop, sizeof (BtorAIGProp));
   btor_rng_clone (&res->rng, &aprop->rng);
   res->amgr = clone;
-  res->unsatroots =
-      btor_hashint_map_clone (mm, aprop->unsatroots, btor_clone_data_as_int, 0);
-  res->score =
-      btor_hashint_map_clone (mm, aprop->score, btor_clone_data_as_dbl, 0);
-  res->model =
-      btor_hashint_map_clone (mm, aprop->model, btor_clone_data_as_int, 0);
+  if (aprop->model)
+  {
+    BTOR_NEWN (mm, res->model, aprop->size);
+    memcpy (res->model, aprop->model, aprop->size * sizeof (*aprop->model));
+  }
+  BTOR_INIT_STACK (mm, res->cone);
+  BTOR_INIT_STACK (mm, res->unsatroots);
+  BTOR_INIT_STACK (mm, res->queue);
   return res;
 }
 
@@ -1100,14 +837,20 @@ btor_aigprop_new_aigprop (BtorAIGMgr *amgr,
   assert (amgr);
 
   BtorAIGProp *res;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
 
-  BTOR_CNEW (amgr->btor->mm, res);
+  BTOR_CNEW (mm, res);
   res->amgr = amgr;
   btor_rng_init (&res->rng, seed);
   res->loglevel     = loglevel;
   res->seed         = seed;
   res->use_restarts = use_restarts;
   res->use_bandit   = use_bandit;
+  BTOR_INIT_STACK (mm, res->cone);
+  BTOR_INIT_STACK (mm, res->unsatroots);
+  BTOR_INIT_STACK (mm, res->queue);
 
   return res;
 }
@@ -1116,29 +859,36 @@ void
 btor_aigprop_delete_aigprop (BtorAIGProp *aprop)
 {
   assert (aprop);
+  assert (!aprop->roots);
 
   btor_rng_delete (&aprop->rng);
-  if (aprop->unsatroots) btor_hashint_map_delete (aprop->unsatroots);
-  if (aprop->score) btor_hashint_map_delete (aprop->score);
-  if (aprop->model) btor_hashint_map_delete (aprop->model);
+  btor_aigprop_delete_model (aprop);
+  BTOR_RELEASE_STACK (aprop->cone);
+  BTOR_RELEASE_STACK (aprop->unsatroots);
+  BTOR_RELEASE_STACK (aprop->queue);
   BTOR_DELETE (aprop->amgr->btor->mm, aprop);
 }
 
-#if 0
 void
-btor_aigprop_print_stats (BtorAIGProp * aprop)
+btor_aigprop_print_stats (BtorAIGProp *aprop)
 {
   assert (aprop);
   msg ("");
-  msg ("restarts: %d", aprop->stats.restarts);
-  msg ("moves: %d", aprop->stats.moves);
+  msg ("restarts: %u", aprop->stats.restarts);
+  msg ("moves: %u", aprop->stats.moves);
+  msg ("moves per second: %.2f",
+       aprop->time.sat ? aprop->stats.moves / aprop->time.sat : 0.0);
+  msg ("flips: %" PRIu64, aprop->stats.flips);
+  msg ("flips per second: %.2f",
+       aprop->time.sat ? aprop->stats.flips / aprop->time.sat : 0.0);
+  msg ("updates (cone): %" PRIu64, aprop->stats.updates);
 }
 
 void
-btor_aigprop_print_time_stats (BtorAIGProp * aprop)
+btor_aigprop_print_time_stats (BtorAIGProp *aprop)
 {
   assert (aprop);
   msg ("");
   msg ("%.2f seconds for sat call (AIG propagation)", aprop->time.sat);
+  msg ("%.2f seconds for updating cone", aprop->time.update_cone);
 }
-#endif
@@ -12,6 +12,7 @@
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorrng.h"
+#include "utils/btorstack.h"
 
 #define BTOR_AIGPROP_UNKNOWN 0
 #define BTOR_AIGPROP_SAT 10
@@ -21,10 +22,21 @@ struct BtorAIGProp
 {
   BtorAIGMgr *amgr;
   BtorIntHashTable *roots;
-  BtorIntHashTable *unsatroots;
-  BtorIntHashTable *score;
-  BtorIntHashTable *model;
-  BtorIntHashTable *parents;
+
+  /* The following arrays are indexed by AIG id and cover all AIGs that exist
+   * when btor_aigprop_sat is called. */
+  uint32_t size;
+  int8_t *model;  /* assignment (1 or -1), 0 if not in the cone of a root */
+  double *score;  /* score of id at 2 * id, score of -id at 2 * id + 1 */
+  int8_t *rootpol;       /* 1 if id is a root, -1 if -id is a root, else 0 */
+  uint32_t *unsatpos;    /* position of root in 'unsatroots' + 1, or 0 */
+  uint32_t *selected;    /* number of selections of unsat root (bandit) */
+  uint32_t *fanout_pos;  /* parents of id at fanouts[fanout_pos[id]...] */
+  int32_t *fanouts;      /* parent ids */
+  uint8_t *queued;       /* AIG id is in 'queue' */
+  BtorIntStack cone;     /* ids in the cones of the roots, ascending */
+  BtorIntStack unsatroots; /* unsatisfied roots (signed ids) */
+  BtorIntStack queue;      /* min-heap of ids to update (update_cone) */
 
   BtorRNG rng;
 
@@ -37,15 +49,14 @@ struct BtorAIGProp
   {
     uint32_t moves;
     uint32_t restarts;
+    uint64_t flips;
+    uint64_t updates;
   } stats;
 
   struct
   {
     double sat;
     double update_cone;
-    double update_cone_reset;
-    double update_cone_model_gen;
-    double update_cone_compute_score;
   } time;
 };
 
@@ -60,14 +71,15 @@ BtorAIGProp *btor_aigprop_new_aigprop (BtorAIGMgr *amgr,
 BtorAIGProp *btor_aigprop_clone_aigprop (BtorAIGMgr *clone, BtorAIGProp *aprop);
 void btor_aigprop_delete_aigprop (BtorAIGProp *aprop);
 
+/* Get the assignment (1 or -1) of 'aig', or 0 if 'aig' is not in the cone
+ * of a root. */
 int32_t btor_aigprop_get_assignment_aig (BtorAIGProp *aprop, BtorAIG *aig);
 void btor_aigprop_generate_model (BtorAIGProp *aprop, bool reset);
+void btor_aigprop_delete_model (BtorAIGProp *aprop);
 
 int32_t btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots);
 
-#if 0
-void btor_aigprop_print_stats (BtorAIGProp * aprop);
-void btor_aigprop_print_time_stats (BtorAIGProp * aprop);
-#endif
+void btor_aigprop_print_stats (BtorAIGProp *aprop);
+void btor_aigprop_print_time_stats (BtorAIGProp *aprop);
 
 #endif
@@ -419,11 +419,12 @@ boolector_push (Btor *btor, uint32_t level)
   if (level == 0) return;
 
   uint32_t i;
+  BtorSortId sort;
+
+  sort = btor_sort_bool (btor);
   for (i = 0; i < level; i++)
-  {
-    BTOR_PUSH_STACK (btor->assertions_trail,
-                     BTOR_COUNT_STACK (btor->assertions));
-  }
+    BTOR_PUSH_STACK (btor->scope_lits, btor_exp_var (btor, sort, 0));
+  btor_sort_release (btor, sort);
   btor->num_push_pop++;
 }
 
@@ -434,24 +435,28 @@ boolector_pop (Btor *btor, uint32_t level)
   BTOR_TRAPI ("%u", level);
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
               "incremental usage has not been enabled");
-  BTOR_ABORT (level > BTOR_COUNT_STACK (btor->assertions_trail),
+  BTOR_ABORT (level > BTOR_COUNT_STACK (btor->scope_lits),
               "can not pop more levels (%u) than created via push (%u).",
               level,
-              BTOR_COUNT_STACK (btor->assertions_trail));
+              BTOR_COUNT_STACK (btor->scope_lits));
 
   if (level == 0) return;
 
-  uint32_t i, pos;
-  BtorNode *cur;
-
-  for (i = 0, pos = 0; i < level; i++)
-    pos = BTOR_POP_STACK (btor->assertions_trail);
-
-  while (BTOR_COUNT_STACK (btor->assertions) > pos)
+  uint32_t i;
+  BtorNode *lit;
+
+  /* retract the assertions of the popped levels by permanently disabling
+   * their activation literals. The literal is then substituted by false,
+   * hence all guarded assertions 'lit -> c' of the level rewrite to true and
+   * are removed from the constraints, and the literal and the nodes only
+   * reachable from 'c' are released. The SAT solver keeps the (then
+   * satisfied) clauses that were already added for 'lit -> c', variables
+   * of the SAT solver are not recycled. */
+  for (i = 0; i < level; i++)
   {
-    cur = BTOR_POP_STACK (btor->assertions);
-    btor_hashint_table_remove (btor->assertions_cache, btor_node_get_id (cur));
-    btor_node_release (btor, cur);
+    lit = BTOR_POP_STACK (btor->scope_lits);
+    btor_assert_exp (btor, btor_node_invert (lit));
+    btor_node_release (btor, lit);
   }
   btor->num_push_pop++;
 }
@@ -477,16 +482,14 @@ boolector_assert (Btor *btor, BoolectorNode *node)
   BTOR_ABORT (btor_node_real_addr (exp)->parameterized,
               "assertion must not be parameterized");
 
-  /* all assertions at a context level > 0 are internally handled as
-   * assumptions. */
-  if (BTOR_COUNT_STACK (btor->assertions_trail) > 0)
+  /* all assertions at a context level > 0 are guarded by the activation
+   * literal of the current level. */
+  if (BTOR_COUNT_STACK (btor->scope_lits) > 0)
   {
-    int32_t id = btor_node_get_id (exp);
-    if (!btor_hashint_table_contains (btor->assertions_cache, id))
-    {
-      BTOR_PUSH_STACK (btor->assertions, btor_node_copy (btor, exp));
-      btor_hashint_table_add (btor->assertions_cache, id);
-    }
+    BtorNode *imp =
+        btor_exp_implies (btor, BTOR_TOP_STACK (btor->scope_lits), exp);
+    btor_assert_exp (btor, imp);
+    btor_node_release (btor, imp);
   }
   else
     btor_assert_exp (btor, exp);
@@ -756,18 +759,6 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
       BTOR_ABORT (btor->btor_sat_btor_called > 0,
                   "enabling/disabling incremental usage must be done "
                   "before calling 'boolector_sat'");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_UCOPT),
-                  "incremental solving cannot be enabled "
-                  "if unconstrained optimization is enabled");
-    }
-    else if (opt == BTOR_OPT_UCOPT)
-    {
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_MODEL_GEN),
-                  "Unconstrained optimization cannot be enabled "
-                  "if model generation is enabled");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
-                  "Unconstrained optimization cannot be enabled "
-                  "in incremental mode");
     }
     else if (opt == BTOR_OPT_FUN_DUAL_PROP)
     {
@@ -13,6 +13,7 @@
 #include "btorsat.h"
 #include "utils/btoraigmap.h"
 #include "utils/btorhashptr.h"
+#include "utils/btorrng.h"
 #include "utils/btorutil.h"
 
 #include <assert.h>
@@ -62,18 +63,52 @@
 /*------------------------------------------------------------------------*/
 
 static void
-setup_aig_and_add_to_id_table (BtorAIGMgr *amgr, BtorAIG *aig)
+release_aig_chunk (BtorAIGMgr *amgr, uint32_t idx)
+{
+  BtorAIGChunk *chunk;
+
+  chunk = BTOR_PEEK_STACK (amgr->chunks, idx);
+  assert (chunk);
+  assert (!chunk->live);
+  btor_mem_free (amgr->btor->mm, chunk, BTOR_AIG_CHUNK_BYTES);
+  BTOR_POKE_STACK (amgr->chunks, idx, 0);
+}
+
+static BtorAIG *
+new_aig_node (BtorAIGMgr *amgr)
 {
   int32_t id;
+  uint32_t idx;
+  BtorAIG *aig;
+  BtorAIGChunk *chunk;
 
   id = BTOR_COUNT_STACK (amgr->id2aig);
   BTOR_ABORT (id == INT32_MAX, "AIG id overflow");
+  idx = (uint32_t) id >> BTOR_AIG_CHUNK_LOG;
+  if (idx == BTOR_COUNT_STACK (amgr->chunks))
+  {
+    /* previous chunk is full, release it if all its nodes are deleted */
+    if (idx > 0 && !BTOR_TOP_STACK (amgr->chunks)->live)
+      release_aig_chunk (amgr, idx - 1);
+    chunk       = btor_mem_malloc (amgr->btor->mm, BTOR_AIG_CHUNK_BYTES);
+    chunk->live = 0;
+    BTOR_PUSH_STACK (amgr->chunks, chunk);
+  }
+  chunk = BTOR_PEEK_STACK (amgr->chunks, idx);
+  assert (chunk);
+  chunk->live++;
+  aig = chunk->nodes + (id & (BTOR_AIG_CHUNK_SIZE - 1));
+  memset (aig, 0, sizeof *aig);
   aig->refs = 1;
   aig->id   = id;
   BTOR_PUSH_STACK (amgr->id2aig, aig);
+  BTOR_PUSH_STACK (amgr->children, 0);
+  BTOR_PUSH_STACK (amgr->children, 0);
   assert (aig->id >= 0);
   assert (BTOR_COUNT_STACK (amgr->id2aig) == (size_t) aig->id + 1);
+  assert (BTOR_COUNT_STACK (amgr->children) == 2 * (size_t) aig->id + 2);
   assert (BTOR_PEEK_STACK (amgr->id2aig, aig->id) == aig);
+  return aig;
 }
 
 static BtorAIG *
@@ -84,14 +119,10 @@ new_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   assert (!btor_aig_is_const (right));
 
   BtorAIG *aig;
-  size_t size;
 
-  size = sizeof (BtorAIG) + 2 * sizeof (int32_t);
-  aig  = btor_mem_malloc (amgr->btor->mm, size);
-  memset (aig, 0, size);
-  setup_aig_and_add_to_id_table (amgr, aig);
-  aig->children[0] = btor_aig_get_id (left);
-  aig->children[1] = btor_aig_get_id (right);
+  aig = new_aig_node (amgr);
+  BTOR_POKE_STACK (amgr->children, 2 * aig->id, btor_aig_get_id (left));
+  BTOR_POKE_STACK (amgr->children, 2 * aig->id + 1, btor_aig_get_id (right));
   amgr->cur_num_aigs++;
   if (amgr->max_num_aigs < amgr->cur_num_aigs)
     amgr->max_num_aigs = amgr->cur_num_aigs;
@@ -109,6 +140,7 @@ release_cnf_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *aig)
   amgr->cnfid2aig.start[aig->cnf_id] = 0;
   btor_sat_mgr_release_cnf_id (amgr->smgr, aig->cnf_id);
   aig->cnf_id = 0;
+  aig->pol    = 0;
 }
 
 static void
@@ -116,20 +148,24 @@ delete_aig_node (BtorAIGMgr *amgr, BtorAIG *aig)
 {
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (amgr);
+
+  uint32_t idx;
+  BtorAIGChunk *chunk;
+
   if (btor_aig_is_const (aig)) return;
   if (aig->cnf_id) release_cnf_id_aig_mgr (amgr, aig);
   amgr->id2aig.start[aig->id] = 0;
   if (aig->is_var)
-  {
     amgr->cur_num_aig_vars--;
-    BTOR_DELETE (amgr->btor->mm, aig);
-  }
   else
-  {
     amgr->cur_num_aigs--;
-    btor_mem_free (
-        amgr->btor->mm, aig, sizeof (BtorAIG) + 2 * sizeof (int32_t));
-  }
+  idx   = (uint32_t) aig->id >> BTOR_AIG_CHUNK_LOG;
+  chunk = BTOR_PEEK_STACK (amgr->chunks, idx);
+  assert (chunk->live > 0);
+  chunk->live--;
+  /* the last chunk is still filled with new nodes */
+  if (!chunk->live && idx + 1 < BTOR_COUNT_STACK (amgr->chunks))
+    release_aig_chunk (amgr, idx);
 }
 
 static uint32_t
@@ -146,12 +182,14 @@ hash_aig (int32_t id0, int32_t id1, uint32_t table_size)
 }
 
 static uint32_t
-compute_aig_hash (BtorAIG *aig, uint32_t table_size)
+compute_aig_hash (BtorAIGMgr *amgr, BtorAIG *aig, uint32_t table_size)
 {
   uint32_t hash;
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (btor_aig_is_and (aig));
-  hash = hash_aig (aig->children[0], aig->children[1], table_size);
+  hash = hash_aig (btor_aig_get_left_child_id (amgr, aig),
+                   btor_aig_get_right_child_id (amgr, aig),
+                   table_size);
   return hash;
 }
 
@@ -164,7 +202,7 @@ delete_aig_nodes_unique_table_entry (BtorAIGMgr *amgr, BtorAIG *aig)
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (btor_aig_is_and (aig));
   prev = 0;
-  hash = compute_aig_hash (aig, amgr->table.size);
+  hash = compute_aig_hash (amgr, aig, amgr->table.size);
   cur  = btor_aig_get_by_id (amgr, amgr->table.chains[hash]);
   while (cur != aig)
   {
@@ -272,7 +310,7 @@ enlarge_aig_nodes_unique_table (BtorAIGMgr *amgr)
       assert (!BTOR_IS_INVERTED_AIG (cur));
       assert (btor_aig_is_and (cur));
       temp             = btor_aig_get_by_id (amgr, cur->next);
-      hash             = compute_aig_hash (cur, new_size);
+      hash             = compute_aig_hash (amgr, cur, new_size);
       cur->next        = new_chains[hash];
       new_chains[hash] = cur->id;
       cur              = temp;
@@ -352,8 +390,7 @@ btor_aig_var (BtorAIGMgr *amgr)
 {
   BtorAIG *aig;
   assert (amgr);
-  BTOR_CNEW (amgr->btor->mm, aig);
-  setup_aig_and_add_to_id_table (amgr, aig);
+  aig         = new_aig_node (amgr);
   aig->is_var = 1;
   amgr->cur_num_aig_vars++;
   if (amgr->max_num_aig_vars < amgr->cur_num_aig_vars)
@@ -410,7 +447,7 @@ simp_aig_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   if (btor_aig_is_const (aig)) return aig;
 
   lit = btor_aig_get_cnf_id (aig);
-  if (!lit) return aig;
+  if (!lit || !btor_aig_is_encoded (aig)) return aig;
   val = btor_sat_fixed (amgr->smgr, lit);
   if (val) return (val < 0) ? BTOR_AIG_FALSE : BTOR_AIG_TRUE;
   repr = btor_sat_repr (amgr->smgr, lit);
@@ -784,6 +821,7 @@ btor_aig_mgr_new (Btor *btor)
 {
   assert (btor);
 
+  uint32_t i;
   BtorAIGMgr *amgr;
 
   BTOR_CNEW (btor->mm, amgr);
@@ -796,29 +834,15 @@ btor_aig_mgr_new (Btor *btor)
   assert ((size_t) BTOR_AIG_FALSE == 0);
   assert ((size_t) BTOR_AIG_TRUE == 1);
   BTOR_INIT_STACK (btor->mm, amgr->cnfid2aig);
+  BTOR_INIT_STACK (btor->mm, amgr->chunks);
+  BTOR_INIT_STACK (btor->mm, amgr->children);
+  /* constants have no children */
+  for (i = 0; i < 4; i++) BTOR_PUSH_STACK (amgr->children, 0);
+  BTOR_INIT_STACK (btor->mm, amgr->fraig_roots);
+  BTOR_INIT_STACK (btor->mm, amgr->fraig_toplevel);
   return amgr;
 }
 
-static BtorAIG *
-clone_aig (BtorMemMgr *mm, BtorAIG *aig)
-{
-  assert (mm);
-
-  size_t size;
-  BtorAIG *res, *real_aig;
-
-  if (btor_aig_is_const (aig)) return aig;
-
-  real_aig = BTOR_REAL_ADDR_AIG (aig);
-  size     = sizeof (BtorAIG);
-  if (!real_aig->is_var) size += 2 * sizeof (int32_t);
-  res = btor_mem_malloc (mm, size);
-  memcpy (res, real_aig, size);
-
-  res = BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
-  return res;
-}
-
 static void
 clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
 {
@@ -829,9 +853,40 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
   size_t size;
   BtorMemMgr *mm;
   BtorAIG *aig;
+  BtorAIGChunk *chunk, *cchunk;
 
   mm = clone->btor->mm;
 
+  /* clone node store */
+  BTOR_INIT_STACK (mm, clone->chunks);
+  size = BTOR_SIZE_STACK (amgr->chunks);
+  if (size)
+  {
+    BTOR_CNEWN (mm, clone->chunks.start, size);
+    clone->chunks.end = clone->chunks.start + size;
+    clone->chunks.top = clone->chunks.start + BTOR_COUNT_STACK (amgr->chunks);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->chunks); i++)
+  {
+    chunk = BTOR_PEEK_STACK (amgr->chunks, i);
+    if (!chunk) continue;
+    cchunk = btor_mem_malloc (mm, BTOR_AIG_CHUNK_BYTES);
+    memcpy (cchunk, chunk, BTOR_AIG_CHUNK_BYTES);
+    BTOR_POKE_STACK (clone->chunks, i, cchunk);
+  }
+
+  /* clone children of AND nodes */
+  BTOR_INIT_STACK (mm, clone->children);
+  size = BTOR_SIZE_STACK (amgr->children);
+  assert (size);
+  BTOR_NEWN (mm, clone->children.start, size);
+  clone->children.end = clone->children.start + size;
+  clone->children.top =
+      clone->children.start + BTOR_COUNT_STACK (amgr->children);
+  memcpy (clone->children.start,
+          amgr->children.start,
+          BTOR_COUNT_STACK (amgr->children) * sizeof (int32_t));
+
   /* clone id2aig table */
   BTOR_INIT_STACK (mm, clone->id2aig);
   size = BTOR_SIZE_STACK (amgr->id2aig);
@@ -843,7 +898,13 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
   }
   for (i = 0; i < BTOR_COUNT_STACK (amgr->id2aig); i++)
   {
-    aig = clone_aig (mm, BTOR_PEEK_STACK (amgr->id2aig, i));
+    aig = BTOR_PEEK_STACK (amgr->id2aig, i);
+    if (!btor_aig_is_const (aig))
+    {
+      assert (BTOR_IS_REGULAR_AIG (aig));
+      cchunk = BTOR_PEEK_STACK (clone->chunks, i >> BTOR_AIG_CHUNK_LOG);
+      aig    = cchunk->nodes + (i & (BTOR_AIG_CHUNK_SIZE - 1));
+    }
     BTOR_POKE_STACK (clone->id2aig, i, aig);
   }
 
@@ -870,6 +931,10 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
           == BTOR_SIZE_STACK (amgr->cnfid2aig));
   assert (BTOR_COUNT_STACK (clone->cnfid2aig)
           == BTOR_COUNT_STACK (amgr->cnfid2aig));
+
+  /* clone representatives of SAT sweeping (references to representatives
+   * are already accounted for in the cloned reference counters) */
+  clone->fraig_repr = btor_hashint_map_clone (mm, amgr->fraig_repr, 0, 0);
 }
 
 BtorAIGMgr *
@@ -893,6 +958,22 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->num_cnf_vars     = amgr->num_cnf_vars;
   res->num_cnf_clauses  = amgr->num_cnf_clauses;
   res->num_cnf_literals = amgr->num_cnf_literals;
+
+  res->num_fraig_merged    = amgr->num_fraig_merged;
+  res->num_fraig_sat_calls = amgr->num_fraig_sat_calls;
+  res->num_fraig_refuted   = amgr->num_fraig_refuted;
+  res->num_rw_balanced     = amgr->num_rw_balanced;
+  res->num_rw_rewritten    = amgr->num_rw_rewritten;
+  res->num_rw_refactored   = amgr->num_rw_refactored;
+  res->num_cnf_pg_clauses  = amgr->num_cnf_pg_clauses;
+  res->num_cnf_pg_literals = amgr->num_cnf_pg_literals;
+  res->num_cnf_cut_clauses  = amgr->num_cnf_cut_clauses;
+  res->num_cnf_cut_literals = amgr->num_cnf_cut_literals;
+  assert (!amgr->fraig_defer);
+  assert (BTOR_EMPTY_STACK (amgr->fraig_roots));
+  assert (BTOR_EMPTY_STACK (amgr->fraig_toplevel));
+  BTOR_INIT_STACK (btor->mm, res->fraig_roots);
+  BTOR_INIT_STACK (btor->mm, res->fraig_toplevel);
   clone_aigs (amgr, res);
   return res;
 }
@@ -900,8 +981,25 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
 void
 btor_aig_mgr_delete (BtorAIGMgr *amgr)
 {
+  uint32_t i;
   BtorMemMgr *mm;
+  BtorIntHashTableIterator it;
+  BtorHashTableData *d;
+  BtorAIGChunk *chunk;
   assert (amgr);
+  assert (BTOR_EMPTY_STACK (amgr->fraig_roots));
+  assert (BTOR_EMPTY_STACK (amgr->fraig_toplevel));
+  if (amgr->fraig_repr)
+  {
+    btor_iter_hashint_init (&it, amgr->fraig_repr);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      d = btor_iter_hashint_next_data (&it);
+      btor_aig_release (amgr, btor_aig_get_by_id (amgr, d->as_int));
+    }
+    btor_hashint_map_delete (amgr->fraig_repr);
+  }
+  if (amgr->eval_cache) btor_hashint_map_delete (amgr->eval_cache);
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKAIG")
           || amgr->table.num_elements == 0);
   mm = amgr->btor->mm;
@@ -909,6 +1007,16 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   btor_sat_mgr_delete (amgr->smgr);
   BTOR_RELEASE_STACK (amgr->id2aig);
   BTOR_RELEASE_STACK (amgr->cnfid2aig);
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->chunks); i++)
+  {
+    chunk = BTOR_PEEK_STACK (amgr->chunks, i);
+    if (!chunk) continue;
+    btor_mem_free (mm, chunk, BTOR_AIG_CHUNK_BYTES);
+  }
+  BTOR_RELEASE_STACK (amgr->chunks);
+  BTOR_RELEASE_STACK (amgr->children);
+  BTOR_RELEASE_STACK (amgr->fraig_roots);
+  BTOR_RELEASE_STACK (amgr->fraig_toplevel);
   BTOR_DELETE (mm, amgr);
 }
 
@@ -1046,6 +1154,21 @@ set_next_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *root)
   amgr->num_cnf_vars++;
 }
 
+static bool
+get_fraig_repr (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIG **repr)
+{
+  assert (amgr);
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (repr);
+
+  BtorHashTableData *d;
+
+  if (!amgr->fraig_repr) return false;
+  if (!(d = btor_hashint_map_get (amgr->fraig_repr, aig->id))) return false;
+  *repr = btor_aig_get_by_id (amgr, d->as_int);
+  return true;
+}
+
 #ifdef BTOR_EXTRACT_TOP_LEVEL_MULTI_OR
 static bool
 is_or_aig (BtorAIGMgr *amgr, BtorAIG *root, BtorAIGPtrStack *leafs)
@@ -1112,17 +1235,25 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 {
   BtorAIGPtrStack stack, tree, leafs, marked;
   int32_t x, y, a, b, c;
-  bool isxor, isite;
-  BtorAIG *root, *cur;
+  bool isxor, isite, isrepr;
+  BtorAIG *root, *cur, *repr;
   BtorSATMgr *smgr;
   BtorMemMgr *mm;
   uint32_t local;
+  uint8_t missing;
   BtorAIG **p;
 
   if (btor_aig_is_const (start)) return;
 
   assert (amgr);
 
+  if (amgr->fraig_defer)
+  {
+    if (!btor_aig_is_encoded (start))
+      BTOR_PUSH_STACK (amgr->fraig_roots, btor_aig_copy (amgr, start));
+    return;
+  }
+
   smgr = amgr->smgr;
   mm   = amgr->btor->mm;
 
@@ -1146,11 +1277,12 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
       continue;
     }
 
-    if (root->cnf_id) continue;
+    if (root->cnf_id && root->pol == BTOR_AIG_POL_BOTH) continue;
 
     if (btor_aig_is_var (root))
     {
       set_next_id_aig_mgr (amgr, root);
+      root->pol = BTOR_AIG_POL_BOTH;
       continue;
     }
 
@@ -1159,12 +1291,19 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
     assert (BTOR_EMPTY_STACK (tree));
     assert (BTOR_EMPTY_STACK (leafs));
 
-    if ((isxor = is_xor_aig (amgr, root, &leafs)))
+    /* nodes merged by SAT sweeping are encoded as equivalence to their
+     * representative */
+    isxor = isite = false;
+    if ((isrepr = get_fraig_repr (amgr, root, &repr)))
+    {
+      if (!btor_aig_is_const (repr)) BTOR_PUSH_STACK (leafs, repr);
+    }
+    else if ((isxor = is_xor_aig (amgr, root, &leafs)))
       isite = 0;
     else
       isite = is_ite_aig (amgr, root, &leafs);
 
-    if (!isxor && !isite)
+    if (!isrepr && !isxor && !isite)
     {
 #ifdef BTOR_AIG_TO_CNF_NARY_AND
       BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, root));
@@ -1206,37 +1345,85 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
       assert (root->mark == 1);
       root->mark = 2;
 
-      set_next_id_aig_mgr (amgr, root);
-      x = root->cnf_id;
+      /* AIGs encoded in one polarity only are completed */
+      missing = BTOR_AIG_POL_BOTH & ~root->pol;
+      if (!root->cnf_id) set_next_id_aig_mgr (amgr, root);
+      root->pol = BTOR_AIG_POL_BOTH;
+      x         = root->cnf_id;
       assert (x);
 
-      if (isxor)
+      if (isrepr)
+      {
+        /* unit clause covers both polarities */
+        if (btor_aig_is_const (repr))
+        {
+          if (missing == BTOR_AIG_POL_BOTH)
+          {
+            btor_sat_add (smgr, repr == BTOR_AIG_TRUE ? x : -x);
+            btor_sat_add (smgr, 0);
+            amgr->num_cnf_clauses++;
+            amgr->num_cnf_literals++;
+          }
+        }
+        else
+        {
+          a = btor_aig_get_cnf_id (repr);
+          assert (a);
+
+          if (missing & BTOR_AIG_POL_POS)
+          {
+            btor_sat_add (smgr, -x);
+            btor_sat_add (smgr, a);
+            btor_sat_add (smgr, 0);
+            amgr->num_cnf_clauses++;
+            amgr->num_cnf_literals += 2;
+          }
+
+          if (missing & BTOR_AIG_POL_NEG)
+          {
+            btor_sat_add (smgr, x);
+            btor_sat_add (smgr, -a);
+            btor_sat_add (smgr, 0);
+            amgr->num_cnf_clauses++;
+            amgr->num_cnf_literals += 2;
+          }
+        }
+      }
+      else if (isxor)
       {
         assert (BTOR_COUNT_STACK (leafs) == 2);
         a = btor_aig_get_cnf_id (leafs.start[0]);
         b = btor_aig_get_cnf_id (leafs.start[1]);
 
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
+        if (missing & BTOR_AIG_POL_POS)
+        {
+          btor_sat_add (smgr, -x);
+          btor_sat_add (smgr, a);
+          btor_sat_add (smgr, -b);
+          btor_sat_add (smgr, 0);
 
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
+          btor_sat_add (smgr, -x);
+          btor_sat_add (smgr, -a);
+          btor_sat_add (smgr, b);
+          btor_sat_add (smgr, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
 
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
+        if (missing & BTOR_AIG_POL_NEG)
+        {
+          btor_sat_add (smgr, x);
+          btor_sat_add (smgr, -a);
+          btor_sat_add (smgr, -b);
+          btor_sat_add (smgr, 0);
 
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
+          btor_sat_add (smgr, x);
+          btor_sat_add (smgr, a);
+          btor_sat_add (smgr, b);
+          btor_sat_add (smgr, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
       }
       else if (isite)
       {
@@ -1245,52 +1432,66 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
         b = btor_aig_get_cnf_id (leafs.start[1]);  // then
         c = btor_aig_get_cnf_id (leafs.start[2]);  // cond
 
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
+        if (missing & BTOR_AIG_POL_POS)
+        {
+          btor_sat_add (smgr, -x);
+          btor_sat_add (smgr, -c);
+          btor_sat_add (smgr, b);
+          btor_sat_add (smgr, 0);
 
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, 0);
+          btor_sat_add (smgr, -x);
+          btor_sat_add (smgr, c);
+          btor_sat_add (smgr, a);
+          btor_sat_add (smgr, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
 
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
+        if (missing & BTOR_AIG_POL_NEG)
+        {
+          btor_sat_add (smgr, x);
+          btor_sat_add (smgr, -c);
+          btor_sat_add (smgr, -b);
+          btor_sat_add (smgr, 0);
 
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
+          btor_sat_add (smgr, x);
+          btor_sat_add (smgr, c);
+          btor_sat_add (smgr, -a);
+          btor_sat_add (smgr, 0);
+          amgr->num_cnf_clauses += 2;
+          amgr->num_cnf_literals += 6;
+        }
       }
       else
       {
-        for (p = leafs.start; p < leafs.top; p++)
+        if (missing & BTOR_AIG_POL_NEG)
         {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          assert (y);
-          btor_sat_add (smgr, -y);
+          for (p = leafs.start; p < leafs.top; p++)
+          {
+            cur = *p;
+            y   = btor_aig_get_cnf_id (cur);
+            assert (y);
+            btor_sat_add (smgr, -y);
+            amgr->num_cnf_literals++;
+          }
+          btor_sat_add (smgr, x);
+          btor_sat_add (smgr, 0);
+          amgr->num_cnf_clauses++;
           amgr->num_cnf_literals++;
         }
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses++;
-        amgr->num_cnf_literals++;
 
-        for (p = leafs.start; p < leafs.top; p++)
+        if (missing & BTOR_AIG_POL_POS)
         {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          btor_sat_add (smgr, -x);
-          btor_sat_add (smgr, y);
-          btor_sat_add (smgr, 0);
-          amgr->num_cnf_clauses++;
-          amgr->num_cnf_literals += 2;
+          for (p = leafs.start; p < leafs.top; p++)
+          {
+            cur = *p;
+            y   = btor_aig_get_cnf_id (cur);
+            btor_sat_add (smgr, -x);
+            btor_sat_add (smgr, y);
+            btor_sat_add (smgr, 0);
+            amgr->num_cnf_clauses++;
+            amgr->num_cnf_literals += 2;
+          }
         }
       }
     }
@@ -1346,6 +1547,12 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
 
   if (!btor_sat_is_initialized (amgr->smgr)) return;
 
+  if (amgr->fraig_defer)
+  {
+    BTOR_PUSH_STACK (amgr->fraig_toplevel, btor_aig_copy (amgr, root));
+    return;
+  }
+
 #ifdef BTOR_AIG_TO_CNF_TOP_ELIM
   BtorMemMgr *mm;
   BtorSATMgr *smgr;
@@ -1458,29 +1665,2014 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
 #endif
 }
 
-BtorSATMgr *
-btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
+/*------------------------------------------------------------------------*/
+/* deferred translation into CNF                                          */
+/*------------------------------------------------------------------------*/
+
+/* Inputs of the deferred cone are AIG variables, AIGs that are already
+ * translated into CNF and AIGs that were merged into a representative. */
+static bool
+is_fraig_input (BtorAIGMgr *amgr, BtorAIG *aig)
 {
-  return amgr ? amgr->smgr : 0;
+  BtorAIG *repr;
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  return btor_aig_is_var (aig) || aig->cnf_id
+         || get_fraig_repr (amgr, aig, &repr);
 }
 
-int32_t
-btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+static int32_t
+get_fraig_pos (BtorIntHashTable *idx, BtorAIG *aig)
 {
-  assert (amgr);
-  if (aig == BTOR_AIG_TRUE) return 1;
-  if (aig == BTOR_AIG_FALSE) return -1;
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (idx, BTOR_REAL_ADDR_AIG (aig)->id);
+  assert (d);
+  return d->as_int;
+}
 
-  /* Note: If an AIG is not yet encoded to SAT or if the SAT solver returns
-   * undefined for a variable, we implicitly initialize it with false (-1). */
-  int32_t val = -1;
-  if (BTOR_REAL_ADDR_AIG (aig)->cnf_id > 0)
+/* Collect the cone of the deferred roots in topological order (including
+ * the cones of representatives of merged AIGs). The representative of a
+ * merged AIG is its only child, i.e., it is collected before the merged
+ * AIG such that its definition is encoded first. */
+static void
+collect_fraig_cone (BtorAIGMgr *amgr,
+                    BtorIntHashTable *idx,
+                    BtorAIGPtrStack *nodes)
+{
+  size_t i;
+  BtorAIG *cur, *repr;
+  BtorAIGPtrStack stack;
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_roots); i++)
+    BTOR_PUSH_STACK (stack, BTOR_PEEK_STACK (amgr->fraig_roots, i));
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_toplevel); i++)
+    BTOR_PUSH_STACK (stack, BTOR_PEEK_STACK (amgr->fraig_toplevel, i));
+
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    if (btor_aig_is_const (cur)) continue;
+    cur = BTOR_REAL_ADDR_AIG (cur);
+    if (btor_hashint_map_contains (idx, cur->id)) continue;
+    if (cur->mark == 0)
+    {
+      if (!is_fraig_input (amgr, cur))
+      {
+        cur->mark = 1;
+        BTOR_PUSH_STACK (stack, cur);
+        BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, cur));
+        BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, cur));
+        continue;
+      }
+      if (!cur->cnf_id && get_fraig_repr (amgr, cur, &repr))
+      {
+        cur->mark = 1;
+        BTOR_PUSH_STACK (stack, cur);
+        BTOR_PUSH_STACK (stack, repr);
+        continue;
+      }
+    }
+    cur->mark = 0;
+    btor_hashint_map_add (idx, cur->id)->as_int = BTOR_COUNT_STACK (*nodes);
+    BTOR_PUSH_STACK (*nodes, cur);
+  }
+  BTOR_RELEASE_STACK (stack);
+}
+
+/* Merge 'aig' into 'repr', i.e., 'aig' will be translated into CNF as an
+ * equivalence to 'repr'. Representatives of previous merges are resolved,
+ * returns false if 'aig' would be its own representative. */
+static bool
+set_fraig_repr (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIG *repr)
+{
+  int32_t id;
+  bool inv;
+  BtorAIG *real_repr;
+
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (!btor_aig_is_const (aig));
+  assert (!get_fraig_repr (amgr, aig, &real_repr));
+
+  inv  = BTOR_IS_INVERTED_AIG (repr);
+  repr = BTOR_REAL_ADDR_AIG (repr);
+  while (!btor_aig_is_const (repr)
+         && get_fraig_repr (amgr, repr, &real_repr))
+  {
+    if (BTOR_IS_INVERTED_AIG (real_repr)) inv = !inv;
+    repr = BTOR_REAL_ADDR_AIG (real_repr);
+  }
+  if (repr == aig) return false;
+  if (inv) repr = BTOR_INVERT_AIG (repr);
+
+  if (btor_aig_is_const (repr))
+    id = repr == BTOR_AIG_TRUE ? 1 : 0;
+  else
+    id = btor_aig_get_id (repr);
+
+  if (!amgr->fraig_repr)
+    amgr->fraig_repr = btor_hashint_map_new (amgr->btor->mm);
+  btor_hashint_map_add (amgr->fraig_repr, aig->id)->as_int = id;
+  (void) btor_aig_copy (amgr, repr);
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+/* SAT sweeping                                                           */
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of refuted equivalence checks per AIG node. */
+#define BTOR_AIG_FRAIG_MAX_REFUTED 4
+
+/* Number of counter-examples collected before re-simulating. */
+#define BTOR_AIG_FRAIG_MAX_CEX 64
+
+#define BTOR_AIG_FRAIG_UNPROCESSED 0
+#define BTOR_AIG_FRAIG_LEADER 1
+#define BTOR_AIG_FRAIG_MERGED 2
+#define BTOR_AIG_FRAIG_PENDING 3
+
+struct BtorAIGFraig
+{
+  BtorAIGMgr *amgr;
+  BtorSATMgr *smgr; /* SAT solver for equivalence checks */
+  BtorRNG rng;
+  int32_t limit;         /* conflict limit per check */
+  BtorAIGPtrStack nodes; /* cone in topological order, FALSE first */
+  BtorIntHashTable *idx; /* AIG id -> position in 'nodes' */
+  BtorIntStack inputs;   /* positions of inputs encoded in 'smgr' */
+  BtorIntStack pending;  /* positions of refuted nodes to recheck */
+  bool *input;           /* variable, encoded or merged AIG */
+  bool *phase;           /* phase of first simulation vector */
+  uint8_t *state;
+  uint8_t *refuted;
+  uint64_t *sim; /* simulation vector of current round */
+  uint64_t *sig; /* phase normalized signature over all rounds */
+  uint64_t *cex; /* counter-example bits of inputs */
+  uint32_t ncex;
+  uint32_t rounds;
+  int32_t *lit;  /* literal in 'smgr' */
+  int32_t *repr; /* position of representative */
+  int32_t *head; /* signature hash table */
+  int32_t *next;
+  uint32_t hsize;
+};
+
+typedef struct BtorAIGFraig BtorAIGFraig;
+
+static uint64_t
+get_fraig_child_sim (BtorAIGFraig *fraig, BtorAIG *aig)
+{
+  uint64_t res;
+  res = fraig->sim[get_fraig_pos (fraig->idx, aig)];
+  return BTOR_IS_INVERTED_AIG (aig) ? ~res : res;
+}
+
+static void
+simulate_fraig (BtorAIGFraig *fraig)
+{
+  uint32_t i, n;
+  uint64_t mask, rand, v;
+  BtorAIG *aig;
+  BtorAIGMgr *amgr;
+
+  amgr = fraig->amgr;
+  n    = BTOR_COUNT_STACK (fraig->nodes);
+  mask = fraig->ncex == BTOR_AIG_FRAIG_MAX_CEX
+             ? ~UINT64_C (0)
+             : (UINT64_C (1) << fraig->ncex) - 1;
+
+  fraig->sim[0] = 0;
+  for (i = 1; i < n; i++)
+  {
+    aig = BTOR_PEEK_STACK (fraig->nodes, i);
+    if (fraig->input[i])
+    {
+      rand = ((uint64_t) btor_rng_rand (&fraig->rng) << 32)
+             | btor_rng_rand (&fraig->rng);
+      fraig->sim[i] = (rand & ~mask) | fraig->cex[i];
+    }
+    else
+    {
+      fraig->sim[i] =
+          get_fraig_child_sim (fraig, btor_aig_get_left_child (amgr, aig))
+          & get_fraig_child_sim (fraig, btor_aig_get_right_child (amgr, aig));
+    }
+  }
+
+  for (i = 0; i < n; i++)
+  {
+    if (!fraig->rounds) fraig->phase[i] = fraig->sim[i] & 1;
+    v             = fraig->phase[i] ? ~fraig->sim[i] : fraig->sim[i];
+    fraig->sig[i] = (fraig->sig[i] ^ v) * UINT64_C (0x9e3779b97f4a7c15);
+    fraig->cex[i] = 0;
+  }
+  fraig->ncex = 0;
+  fraig->rounds++;
+}
+
+static uint32_t
+hash_fraig_sig (BtorAIGFraig *fraig, uint64_t sig)
+{
+  return (uint32_t) (sig ^ (sig >> 32)) & (fraig->hsize - 1);
+}
+
+static void
+insert_fraig_leader (BtorAIGFraig *fraig, int32_t pos)
+{
+  uint32_t h;
+  h                 = hash_fraig_sig (fraig, fraig->sig[pos]);
+  fraig->next[pos]  = fraig->head[h];
+  fraig->head[h]    = pos;
+  fraig->state[pos] = BTOR_AIG_FRAIG_LEADER;
+}
+
+/* Returns the first leader in topological order with the same signature
+ * as node at position 'pos', or -1 if there is none. Refuted nodes are
+ * rechecked after later nodes became leaders, hence leaders that follow
+ * 'pos' are ignored, they may contain 'pos' in their cone. */
+static int32_t
+find_fraig_leader (BtorAIGFraig *fraig, int32_t pos)
+{
+  int32_t cur, res;
+
+  res = -1;
+  for (cur = fraig->head[hash_fraig_sig (fraig, fraig->sig[pos])]; cur >= 0;
+       cur = fraig->next[cur])
+  {
+    if (cur > pos || fraig->sig[cur] != fraig->sig[pos]) continue;
+    if (res < 0 || cur < res) res = cur;
+  }
+  return res;
+}
+
+static void
+rebuild_fraig_leaders (BtorAIGFraig *fraig, int32_t to)
+{
+  int32_t i;
+
+  for (i = 0; i < (int32_t) fraig->hsize; i++) fraig->head[i] = -1;
+  for (i = 0; i < to; i++)
+  {
+    if (fraig->state[i] != BTOR_AIG_FRAIG_LEADER) continue;
+    insert_fraig_leader (fraig, i);
+  }
+}
+
+static int32_t
+get_fraig_child_lit (BtorAIGFraig *fraig, BtorAIG *aig)
+{
+  int32_t res;
+  res = fraig->lit[get_fraig_pos (fraig->idx, aig)];
+  return BTOR_IS_INVERTED_AIG (aig) ? -res : res;
+}
+
+/* Encode cone of node at position 'pos' into the SAT solver of the
+ * sweeper (Tseitin, AND gates only). */
+static int32_t
+get_fraig_lit (BtorAIGFraig *fraig, int32_t pos)
+{
+  int32_t cur, l, r, x, a, b;
+  BtorAIG *aig;
+  BtorAIGMgr *amgr;
+  BtorSATMgr *smgr;
+  BtorIntStack stack;
+
+  if (fraig->lit[pos]) return fraig->lit[pos];
+
+  amgr = fraig->amgr;
+  smgr = fraig->smgr;
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, pos);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (fraig->lit[cur])
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+    if (fraig->input[cur])
+    {
+      (void) BTOR_POP_STACK (stack);
+      fraig->lit[cur] = btor_sat_mgr_next_cnf_id (smgr);
+      BTOR_PUSH_STACK (fraig->inputs, cur);
+      continue;
+    }
+    aig = BTOR_PEEK_STACK (fraig->nodes, cur);
+    l   = get_fraig_pos (fraig->idx, btor_aig_get_left_child (amgr, aig));
+    r   = get_fraig_pos (fraig->idx, btor_aig_get_right_child (amgr, aig));
+    if (!fraig->lit[l])
+    {
+      BTOR_PUSH_STACK (stack, l);
+      continue;
+    }
+    if (!fraig->lit[r])
+    {
+      BTOR_PUSH_STACK (stack, r);
+      continue;
+    }
+    (void) BTOR_POP_STACK (stack);
+    x = btor_sat_mgr_next_cnf_id (smgr);
+    a = get_fraig_child_lit (fraig, btor_aig_get_left_child (amgr, aig));
+    b = get_fraig_child_lit (fraig, btor_aig_get_right_child (amgr, aig));
+
+    btor_sat_add (smgr, -x);
+    btor_sat_add (smgr, a);
+    btor_sat_add (smgr, 0);
+
+    btor_sat_add (smgr, -x);
+    btor_sat_add (smgr, b);
+    btor_sat_add (smgr, 0);
+
+    btor_sat_add (smgr, x);
+    btor_sat_add (smgr, -a);
+    btor_sat_add (smgr, -b);
+    btor_sat_add (smgr, 0);
+
+    fraig->lit[cur] = x;
+  }
+  BTOR_RELEASE_STACK (stack);
+  return fraig->lit[pos];
+}
+
+/* Check if 'a' and 'b' can have different values, i.e., if 'a' and '-b'
+ * are satisfiable. Collects a counter-example in the SAT case. */
+static BtorSolverResult
+check_fraig_miter (BtorAIGFraig *fraig, int32_t a, int32_t b)
+{
+  size_t i;
+  int32_t pos;
+  BtorSolverResult res;
+
+  btor_sat_assume (fraig->smgr, a);
+  btor_sat_assume (fraig->smgr, -b);
+  res = btor_sat_check_sat (fraig->smgr, fraig->limit);
+  fraig->amgr->num_fraig_sat_calls++;
+  if (res == BTOR_RESULT_SAT)
   {
-    val = btor_sat_deref (amgr->smgr, BTOR_REAL_ADDR_AIG (aig)->cnf_id);
-    if (val == 0)
+    assert (fraig->ncex < BTOR_AIG_FRAIG_MAX_CEX);
+    for (i = 0; i < BTOR_COUNT_STACK (fraig->inputs); i++)
     {
-      val = -1;
+      pos = BTOR_PEEK_STACK (fraig->inputs, i);
+      if (btor_sat_deref (fraig->smgr, fraig->lit[pos]) > 0)
+        fraig->cex[pos] |= UINT64_C (1) << fraig->ncex;
     }
+    fraig->ncex++;
+  }
+  return res;
+}
+
+static void
+check_fraig_node (BtorAIGFraig *fraig, int32_t pos)
+{
+  int32_t leader, a, b;
+  BtorSolverResult res;
+
+  if (pos == 0 || fraig->input[pos])
+  {
+    insert_fraig_leader (fraig, pos);
+    return;
+  }
+
+  if ((leader = find_fraig_leader (fraig, pos)) < 0)
+  {
+    insert_fraig_leader (fraig, pos);
+    return;
+  }
+
+  a = get_fraig_lit (fraig, pos);
+  b = get_fraig_lit (fraig, leader);
+  if (fraig->phase[pos] != fraig->phase[leader]) b = -b;
+
+  res = check_fraig_miter (fraig, a, b);
+  if (res == BTOR_RESULT_UNSAT) res = check_fraig_miter (fraig, -a, -b);
+
+  if (res == BTOR_RESULT_UNSAT)
+  {
+    /* add proven equivalence to speed up subsequent checks */
+    btor_sat_add (fraig->smgr, -a);
+    btor_sat_add (fraig->smgr, b);
+    btor_sat_add (fraig->smgr, 0);
+    btor_sat_add (fraig->smgr, a);
+    btor_sat_add (fraig->smgr, -b);
+    btor_sat_add (fraig->smgr, 0);
+    fraig->state[pos] = BTOR_AIG_FRAIG_MERGED;
+    fraig->repr[pos]  = leader;
+  }
+  else if (res == BTOR_RESULT_SAT
+           && ++fraig->refuted[pos] < BTOR_AIG_FRAIG_MAX_REFUTED)
+  {
+    fraig->amgr->num_fraig_refuted++;
+    fraig->state[pos] = BTOR_AIG_FRAIG_PENDING;
+    BTOR_PUSH_STACK (fraig->pending, pos);
+  }
+  else
+  {
+    /* give up */
+    insert_fraig_leader (fraig, pos);
+  }
+}
+
+/* Refine candidate classes with the collected counter-examples and recheck
+ * refuted nodes. */
+static void
+refine_fraig (BtorAIGFraig *fraig, int32_t to)
+{
+  size_t i;
+  BtorIntStack pending;
+
+  BTOR_INIT_STACK (fraig->amgr->btor->mm, pending);
+  while (!BTOR_EMPTY_STACK (fraig->pending))
+  {
+    simulate_fraig (fraig);
+    rebuild_fraig_leaders (fraig, to);
+    BTOR_RESET_STACK (pending);
+    for (i = 0; i < BTOR_COUNT_STACK (fraig->pending); i++)
+      BTOR_PUSH_STACK (pending, BTOR_PEEK_STACK (fraig->pending, i));
+    BTOR_RESET_STACK (fraig->pending);
+    for (i = 0; i < BTOR_COUNT_STACK (pending); i++)
+    {
+      /* recheck after next refinement if counter-example buffer is full */
+      if (fraig->ncex == BTOR_AIG_FRAIG_MAX_CEX)
+        BTOR_PUSH_STACK (fraig->pending, BTOR_PEEK_STACK (pending, i));
+      else
+        check_fraig_node (fraig, BTOR_PEEK_STACK (pending, i));
+    }
+  }
+  BTOR_RELEASE_STACK (pending);
+}
+
+/* Store proven equivalences as representatives in the AIG manager. */
+static void
+merge_fraig (BtorAIGFraig *fraig)
+{
+  int32_t i;
+  BtorAIG *aig, *repr;
+
+  for (i = 1; i < (int32_t) BTOR_COUNT_STACK (fraig->nodes); i++)
+  {
+    if (fraig->state[i] != BTOR_AIG_FRAIG_MERGED) continue;
+    aig  = BTOR_PEEK_STACK (fraig->nodes, i);
+    repr = BTOR_PEEK_STACK (fraig->nodes, fraig->repr[i]);
+    if (fraig->phase[i] != fraig->phase[fraig->repr[i]])
+      repr = BTOR_INVERT_AIG (repr);
+    if (set_fraig_repr (fraig->amgr, aig, repr))
+      fraig->amgr->num_fraig_merged++;
+  }
+}
+
+static void
+sweep_fraig (BtorAIGMgr *amgr, uint32_t limit)
+{
+  int32_t i, n;
+  uint32_t merged;
+  BtorMemMgr *mm;
+  BtorAIGFraig fraig;
+
+  mm = amgr->btor->mm;
+
+  BTOR_CLR (&fraig);
+  fraig.amgr  = amgr;
+  fraig.limit = limit > INT32_MAX ? INT32_MAX : (int32_t) limit;
+  fraig.idx   = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, fraig.nodes);
+  BTOR_INIT_STACK (mm, fraig.inputs);
+  BTOR_INIT_STACK (mm, fraig.pending);
+
+  BTOR_PUSH_STACK (fraig.nodes, BTOR_AIG_FALSE);
+  collect_fraig_cone (amgr, fraig.idx, &fraig.nodes);
+  n = BTOR_COUNT_STACK (fraig.nodes);
+
+  fraig.smgr = btor_sat_mgr_new (amgr->btor);
+  btor_sat_enable_solver (fraig.smgr);
+  if (n > 2 && btor_sat_mgr_has_incremental_support (fraig.smgr))
+  {
+    btor_sat_init (fraig.smgr);
+    btor_rng_init (&fraig.rng, btor_opt_get (amgr->btor, BTOR_OPT_SEED));
+
+    for (fraig.hsize = 1; fraig.hsize < 2 * (uint32_t) n; fraig.hsize <<= 1)
+      ;
+    BTOR_CNEWN (mm, fraig.input, n);
+    BTOR_CNEWN (mm, fraig.phase, n);
+    BTOR_CNEWN (mm, fraig.state, n);
+    BTOR_CNEWN (mm, fraig.refuted, n);
+    BTOR_CNEWN (mm, fraig.sim, n);
+    BTOR_CNEWN (mm, fraig.sig, n);
+    BTOR_CNEWN (mm, fraig.cex, n);
+    BTOR_CNEWN (mm, fraig.lit, n);
+    BTOR_CNEWN (mm, fraig.repr, n);
+    BTOR_CNEWN (mm, fraig.next, n);
+    BTOR_CNEWN (mm, fraig.head, fraig.hsize);
+
+    for (i = 1; i < n; i++)
+      fraig.input[i] =
+          is_fraig_input (amgr, BTOR_PEEK_STACK (fraig.nodes, i));
+    fraig.lit[0] = -fraig.smgr->true_lit;
+
+    simulate_fraig (&fraig);
+    rebuild_fraig_leaders (&fraig, 0);
+    for (i = 0; i < n; i++)
+    {
+      check_fraig_node (&fraig, i);
+      if (fraig.ncex == BTOR_AIG_FRAIG_MAX_CEX) refine_fraig (&fraig, i + 1);
+    }
+    refine_fraig (&fraig, n);
+
+    merged = amgr->num_fraig_merged;
+    merge_fraig (&fraig);
+    BTOR_MSG (amgr->btor->msg,
+              1,
+              "SAT sweeping merged %u of %d AIGs in %u rounds",
+              (uint32_t) (amgr->num_fraig_merged - merged),
+              n - 1,
+              fraig.rounds);
+
+    BTOR_DELETEN (mm, fraig.input, n);
+    BTOR_DELETEN (mm, fraig.phase, n);
+    BTOR_DELETEN (mm, fraig.state, n);
+    BTOR_DELETEN (mm, fraig.refuted, n);
+    BTOR_DELETEN (mm, fraig.sim, n);
+    BTOR_DELETEN (mm, fraig.sig, n);
+    BTOR_DELETEN (mm, fraig.cex, n);
+    BTOR_DELETEN (mm, fraig.lit, n);
+    BTOR_DELETEN (mm, fraig.repr, n);
+    BTOR_DELETEN (mm, fraig.next, n);
+    BTOR_DELETEN (mm, fraig.head, fraig.hsize);
+    btor_rng_delete (&fraig.rng);
+  }
+  btor_sat_mgr_delete (fraig.smgr);
+
+  BTOR_RELEASE_STACK (fraig.nodes);
+  BTOR_RELEASE_STACK (fraig.inputs);
+  BTOR_RELEASE_STACK (fraig.pending);
+  btor_hashint_map_delete (fraig.idx);
+}
+
+/*------------------------------------------------------------------------*/
+/* AIG rewriting                                                          */
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of leaves of cuts for rewriting. */
+#define BTOR_AIG_RW_CUT_SIZE 4
+
+/* Maximum number of cuts per AIG node for rewriting. */
+#define BTOR_AIG_RW_MAX_CUTS 8
+
+/* Maximum number of leaves of cuts for refactoring. */
+#define BTOR_AIG_RF_CUT_SIZE 6
+
+/* Maximum number of leaves of AND supergates for balancing. */
+#define BTOR_AIG_BAL_MAX_LEAVES 64
+
+#define BTOR_AIG_RW_CUT_SLOT (BTOR_AIG_RW_CUT_SIZE + 1)
+
+static const uint64_t btor_aig_rw_var_masks[BTOR_AIG_RF_CUT_SIZE] = {
+    UINT64_C (0xAAAAAAAAAAAAAAAA),
+    UINT64_C (0xCCCCCCCCCCCCCCCC),
+    UINT64_C (0xF0F0F0F0F0F0F0F0),
+    UINT64_C (0xFF00FF00FF00FF00),
+    UINT64_C (0xFFFF0000FFFF0000),
+    UINT64_C (0xFFFFFFFF00000000)};
+
+struct BtorAIGRewrite
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack nodes; /* deferred cone in topological order */
+  BtorIntHashTable *idx; /* AIG id -> position in 'nodes' */
+  bool *input;           /* variable, encoded or merged AIG */
+  uint32_t *level;
+  uint64_t *tt;       /* truth table w.r.t. current cut */
+  uint32_t *deref;    /* dereferenced count for MFFC computation */
+  uint32_t *stamp;    /* validity stamp for 'tt' and 'deref' */
+  uint32_t cur_stamp;
+  int32_t *cuts;      /* cut slots per node: size, leaf positions */
+  BtorIntStack cubes; /* cubes of irredundant sum-of-products */
+};
+
+typedef struct BtorAIGRewrite BtorAIGRewrite;
+
+static void
+init_aig_rw (BtorAIGRewrite *rw, BtorAIGMgr *amgr)
+{
+  uint32_t i, n, l, r;
+  BtorAIG *aig;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
+  BTOR_CLR (rw);
+  rw->amgr = amgr;
+  rw->idx  = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, rw->nodes);
+  BTOR_INIT_STACK (mm, rw->cubes);
+  collect_fraig_cone (amgr, rw->idx, &rw->nodes);
+
+  n = BTOR_COUNT_STACK (rw->nodes);
+  /* the cone is empty if all roots are constant */
+  if (!n) return;
+  BTOR_CNEWN (mm, rw->input, n);
+  BTOR_CNEWN (mm, rw->level, n);
+  BTOR_CNEWN (mm, rw->tt, n);
+  BTOR_CNEWN (mm, rw->deref, n);
+  BTOR_CNEWN (mm, rw->stamp, n);
+  for (i = 0; i < n; i++)
+  {
+    aig          = BTOR_PEEK_STACK (rw->nodes, i);
+    rw->input[i] = is_fraig_input (amgr, aig);
+    if (rw->input[i]) continue;
+    l = rw->level[get_fraig_pos (rw->idx, btor_aig_get_left_child (amgr, aig))];
+    r = rw->level[get_fraig_pos (rw->idx,
+                                 btor_aig_get_right_child (amgr, aig))];
+    rw->level[i] = 1 + (l > r ? l : r);
+  }
+}
+
+static void
+delete_aig_rw (BtorAIGRewrite *rw)
+{
+  uint32_t n;
+  BtorMemMgr *mm;
+
+  mm = rw->amgr->btor->mm;
+  n  = BTOR_COUNT_STACK (rw->nodes);
+  BTOR_DELETEN (mm, rw->input, n);
+  BTOR_DELETEN (mm, rw->level, n);
+  BTOR_DELETEN (mm, rw->tt, n);
+  BTOR_DELETEN (mm, rw->deref, n);
+  BTOR_DELETEN (mm, rw->stamp, n);
+  if (rw->cuts)
+    BTOR_DELETEN (
+        mm, rw->cuts, n * BTOR_AIG_RW_MAX_CUTS * BTOR_AIG_RW_CUT_SLOT);
+  BTOR_RELEASE_STACK (rw->nodes);
+  BTOR_RELEASE_STACK (rw->cubes);
+  btor_hashint_map_delete (rw->idx);
+}
+
+/* Number of AND nodes to be translated into CNF. */
+static uint32_t
+count_aig_rw (BtorAIGRewrite *rw)
+{
+  uint32_t i, res;
+  for (i = 0, res = 0; i < BTOR_COUNT_STACK (rw->nodes); i++)
+    if (!rw->input[i]) res++;
+  return res;
+}
+
+static uint64_t
+get_aig_rw_child_tt (BtorAIGRewrite *rw, BtorAIG *aig)
+{
+  uint64_t res;
+  res = rw->tt[get_fraig_pos (rw->idx, aig)];
+  return BTOR_IS_INVERTED_AIG (aig) ? ~res : res;
+}
+
+static int32_t
+get_aig_rw_child_pos (BtorAIGRewrite *rw, int32_t pos, uint32_t i)
+{
+  BtorAIG *aig;
+  aig = BTOR_PEEK_STACK (rw->nodes, pos);
+  return get_fraig_pos (rw->idx,
+                        i ? btor_aig_get_right_child (rw->amgr, aig)
+                          : btor_aig_get_left_child (rw->amgr, aig));
+}
+
+/* Compute truth table of node at position 'pos' w.r.t. the given cut. */
+static uint64_t
+compute_aig_rw_tt (BtorAIGRewrite *rw,
+                   int32_t pos,
+                   int32_t *leaves,
+                   uint32_t nleaves)
+{
+  assert (nleaves <= BTOR_AIG_RF_CUT_SIZE);
+
+  uint32_t i;
+  int32_t cur, l, r;
+  BtorAIG *aig, *left, *right;
+  BtorAIGMgr *amgr;
+  BtorIntStack stack;
+
+  amgr = rw->amgr;
+  rw->cur_stamp++;
+  for (i = 0; i < nleaves; i++)
+  {
+    rw->tt[leaves[i]]    = btor_aig_rw_var_masks[i];
+    rw->stamp[leaves[i]] = rw->cur_stamp;
+  }
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, pos);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (rw->stamp[cur] == rw->cur_stamp)
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+    assert (!rw->input[cur]);
+    aig   = BTOR_PEEK_STACK (rw->nodes, cur);
+    left  = btor_aig_get_left_child (amgr, aig);
+    right = btor_aig_get_right_child (amgr, aig);
+    l     = get_fraig_pos (rw->idx, left);
+    r     = get_fraig_pos (rw->idx, right);
+    if (rw->stamp[l] != rw->cur_stamp)
+    {
+      BTOR_PUSH_STACK (stack, l);
+      continue;
+    }
+    if (rw->stamp[r] != rw->cur_stamp)
+    {
+      BTOR_PUSH_STACK (stack, r);
+      continue;
+    }
+    (void) BTOR_POP_STACK (stack);
+    rw->tt[cur] =
+        get_aig_rw_child_tt (rw, left) & get_aig_rw_child_tt (rw, right);
+    rw->stamp[cur] = rw->cur_stamp;
+  }
+  BTOR_RELEASE_STACK (stack);
+  return rw->tt[pos];
+}
+
+static bool
+is_aig_rw_leaf (int32_t pos, int32_t *leaves, uint32_t nleaves)
+{
+  uint32_t i;
+  for (i = 0; i < nleaves; i++)
+    if (leaves[i] == pos) return true;
+  return false;
+}
+
+/* Size of the maximum fanout-free cone of node at position 'pos' bounded
+ * by the given cut, i.e., the number of nodes that are not translated
+ * into CNF if 'pos' is replaced. */
+static uint32_t
+mffc_aig_rw (BtorAIGRewrite *rw, int32_t pos, int32_t *leaves, uint32_t nleaves)
+{
+  uint32_t res, i;
+  int32_t cur, c;
+  BtorAIG *aig, *child;
+  BtorAIGMgr *amgr;
+  BtorIntStack stack;
+
+  amgr = rw->amgr;
+  rw->cur_stamp++;
+  res = 1;
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, pos);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    aig = BTOR_PEEK_STACK (rw->nodes, cur);
+    for (i = 0; i < 2; i++)
+    {
+      child = i ? btor_aig_get_right_child (amgr, aig)
+                : btor_aig_get_left_child (amgr, aig);
+      c     = get_fraig_pos (rw->idx, child);
+      if (rw->input[c] || is_aig_rw_leaf (c, leaves, nleaves)) continue;
+      if (rw->stamp[c] != rw->cur_stamp)
+      {
+        rw->stamp[c] = rw->cur_stamp;
+        rw->deref[c] = 0;
+      }
+      rw->deref[c]++;
+      if (rw->deref[c] < BTOR_REAL_ADDR_AIG (child)->refs) continue;
+      res++;
+      BTOR_PUSH_STACK (stack, c);
+    }
+  }
+  BTOR_RELEASE_STACK (stack);
+  return res;
+}
+
+static uint64_t
+cofactor0_aig_rw (uint64_t tt, int32_t var)
+{
+  uint64_t m = tt & ~btor_aig_rw_var_masks[var];
+  return m | (m << (1 << var));
+}
+
+static uint64_t
+cofactor1_aig_rw (uint64_t tt, int32_t var)
+{
+  uint64_t m = tt & btor_aig_rw_var_masks[var];
+  return m | (m >> (1 << var));
+}
+
+/* Minato-Morreale irredundant sum-of-products of an incompletely
+ * specified function with on-set 'lo' and on-set + don't care set 'up'.
+ * A cube is represented as 2 bits per variable (negative, positive). */
+static uint64_t
+isop_aig_rw (uint64_t lo, uint64_t up, int32_t nvars, BtorIntStack *cubes)
+{
+  assert ((lo & ~up) == 0);
+
+  int32_t var;
+  size_t beg, mid, end, i;
+  uint64_t lo0, lo1, up0, up1, r0, r1, rs;
+
+  if (lo == 0) return 0;
+  if (up == ~UINT64_C (0))
+  {
+    BTOR_PUSH_STACK (*cubes, 0);
+    return up;
+  }
+
+  for (var = nvars - 1; var >= 0; var--)
+  {
+    if (cofactor0_aig_rw (lo, var) != cofactor1_aig_rw (lo, var)
+        || cofactor0_aig_rw (up, var) != cofactor1_aig_rw (up, var))
+      break;
+  }
+  assert (var >= 0);
+
+  lo0 = cofactor0_aig_rw (lo, var);
+  lo1 = cofactor1_aig_rw (lo, var);
+  up0 = cofactor0_aig_rw (up, var);
+  up1 = cofactor1_aig_rw (up, var);
+
+  beg = BTOR_COUNT_STACK (*cubes);
+  r0  = isop_aig_rw (lo0 & ~up1, up0, var, cubes);
+  mid = BTOR_COUNT_STACK (*cubes);
+  r1  = isop_aig_rw (lo1 & ~up0, up1, var, cubes);
+  end = BTOR_COUNT_STACK (*cubes);
+  rs  = isop_aig_rw ((lo0 & ~r0) | (lo1 & ~r1), up0 & up1, var, cubes);
+
+  for (i = beg; i < mid; i++) cubes->start[i] |= 1 << (2 * var);
+  for (i = mid; i < end; i++) cubes->start[i] |= 1 << (2 * var + 1);
+
+  return (r0 & ~btor_aig_rw_var_masks[var]) | (r1 & btor_aig_rw_var_masks[var])
+         | rs;
+}
+
+static uint32_t
+count_aig_rw_literals (BtorIntStack *cubes, size_t from, size_t to)
+{
+  size_t i;
+  uint32_t res, c;
+  for (i = from, res = 0; i < to; i++)
+    for (c = (uint32_t) cubes->start[i]; c; c &= c - 1) res++;
+  return res;
+}
+
+static BtorAIG *
+build_aig_rw_cubes (BtorAIGRewrite *rw,
+                    size_t from,
+                    size_t to,
+                    BtorAIG **leaves,
+                    uint32_t nleaves)
+{
+  size_t i;
+  uint32_t j;
+  int32_t cube;
+  BtorAIG *res, *conj, *lit, *tmp;
+  BtorAIGMgr *amgr;
+
+  amgr = rw->amgr;
+  res  = BTOR_AIG_FALSE;
+  for (i = from; i < to; i++)
+  {
+    cube = BTOR_PEEK_STACK (rw->cubes, i);
+    conj = BTOR_AIG_TRUE;
+    for (j = 0; j < nleaves; j++)
+    {
+      if (cube & (1 << (2 * j)))
+        lit = BTOR_INVERT_AIG (leaves[j]);
+      else if (cube & (1 << (2 * j + 1)))
+        lit = leaves[j];
+      else
+        continue;
+      tmp = btor_aig_and (amgr, conj, lit);
+      btor_aig_release (amgr, conj);
+      conj = tmp;
+    }
+    tmp = btor_aig_or (amgr, res, conj);
+    btor_aig_release (amgr, res);
+    btor_aig_release (amgr, conj);
+    res = tmp;
+  }
+  return res;
+}
+
+/* Resynthesize given truth table over 'leaves' as factored form of the
+ * smaller irredundant sum-of-products of the function or its negation. */
+static BtorAIG *
+build_aig_rw_tt (BtorAIGRewrite *rw,
+                 uint64_t tt,
+                 BtorAIG **leaves,
+                 uint32_t nleaves)
+{
+  size_t beg, mid, end;
+  uint32_t pos, neg;
+  BtorAIG *res;
+
+  if (tt == 0) return BTOR_AIG_FALSE;
+  if (tt == ~UINT64_C (0)) return BTOR_AIG_TRUE;
+
+  beg = BTOR_COUNT_STACK (rw->cubes);
+  (void) isop_aig_rw (tt, tt, nleaves, &rw->cubes);
+  mid = BTOR_COUNT_STACK (rw->cubes);
+  (void) isop_aig_rw (~tt, ~tt, nleaves, &rw->cubes);
+  end = BTOR_COUNT_STACK (rw->cubes);
+
+  pos = count_aig_rw_literals (&rw->cubes, beg, mid) + (mid - beg);
+  neg = count_aig_rw_literals (&rw->cubes, mid, end) + (end - mid);
+  if (pos <= neg)
+    res = build_aig_rw_cubes (rw, beg, mid, leaves, nleaves);
+  else
+    res = BTOR_INVERT_AIG (build_aig_rw_cubes (rw, mid, end, leaves, nleaves));
+  BTOR_RESET_STACK (rw->cubes);
+  return res;
+}
+
+/* Check if 'root' is reachable from 'aig' (w.r.t. translation into CNF,
+ * i.e., including representatives of merged AIGs) without passing
+ * 'leaves'. */
+static bool
+contains_aig_rw (BtorAIGRewrite *rw,
+                 BtorAIG *aig,
+                 BtorAIG *root,
+                 BtorAIG **leaves,
+                 uint32_t nleaves)
+{
+  bool res;
+  uint32_t i;
+  BtorAIG *cur, *repr;
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack stack;
+  BtorIntHashTable *cache;
+
+  amgr  = rw->amgr;
+  res   = false;
+  cache = btor_hashint_table_new (amgr->btor->mm);
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, aig);
+  while (!res && !BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    if (btor_aig_is_const (cur)) continue;
+    cur = BTOR_REAL_ADDR_AIG (cur);
+    if (cur == root)
+    {
+      res = true;
+      continue;
+    }
+    if (btor_aig_is_var (cur) || cur->cnf_id) continue;
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    for (i = 0; i < nleaves; i++)
+      if (BTOR_REAL_ADDR_AIG (leaves[i]) == cur) break;
+    if (i < nleaves) continue;
+    if (get_fraig_repr (amgr, cur, &repr))
+      BTOR_PUSH_STACK (stack, repr);
+    else
+    {
+      BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, cur));
+    }
+  }
+  BTOR_RELEASE_STACK (stack);
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
+static void
+get_aig_rw_leaves (BtorAIGRewrite *rw,
+                   int32_t *leaves,
+                   uint32_t nleaves,
+                   BtorAIG **res)
+{
+  uint32_t i;
+  for (i = 0; i < nleaves; i++) res[i] = BTOR_PEEK_STACK (rw->nodes, leaves[i]);
+}
+
+/* Replace node at position 'pos' by 'aig' (takes ownership of 'aig'). */
+static bool
+replace_aig_rw (BtorAIGRewrite *rw,
+                int32_t pos,
+                BtorAIG *aig,
+                BtorAIG **leaves,
+                uint32_t nleaves)
+{
+  bool res;
+  BtorAIG *root;
+
+  root = BTOR_PEEK_STACK (rw->nodes, pos);
+  res  = BTOR_REAL_ADDR_AIG (aig) != root
+        && !contains_aig_rw (rw, aig, root, leaves, nleaves)
+        && set_fraig_repr (rw->amgr, root, aig);
+  btor_aig_release (rw->amgr, aig);
+  return res;
+}
+
+/* Resynthesize node at position 'pos' w.r.t. the given cut. Returns the
+ * gain in number of AND nodes, and the new AIG in 'res' if positive. */
+static int32_t
+resynth_aig_rw (BtorAIGRewrite *rw,
+                int32_t pos,
+                int32_t *leaves,
+                uint32_t nleaves,
+                BtorAIG **res)
+{
+  uint32_t mffc;
+  uint64_t tt, num_aigs;
+  int32_t gain;
+  BtorAIG *aigs[BTOR_AIG_RF_CUT_SIZE], *aig;
+
+  tt   = compute_aig_rw_tt (rw, pos, leaves, nleaves);
+  mffc = mffc_aig_rw (rw, pos, leaves, nleaves);
+  get_aig_rw_leaves (rw, leaves, nleaves, aigs);
+
+  num_aigs = rw->amgr->cur_num_aigs;
+  aig      = build_aig_rw_tt (rw, tt, aigs, nleaves);
+  gain     = (int32_t) mffc - (int32_t) (rw->amgr->cur_num_aigs - num_aigs);
+  if (BTOR_REAL_ADDR_AIG (aig) == BTOR_PEEK_STACK (rw->nodes, pos)) gain = 0;
+  if (gain <= 0)
+    btor_aig_release (rw->amgr, aig);
+  else
+    *res = aig;
+  return gain;
+}
+
+static int32_t *
+get_aig_rw_cut (BtorAIGRewrite *rw, int32_t pos, uint32_t i)
+{
+  return rw->cuts + (pos * BTOR_AIG_RW_MAX_CUTS + i) * BTOR_AIG_RW_CUT_SLOT;
+}
+
+/* Merge the sorted leaves of cuts 'a' and 'b' into 'res', returns the
+ * number of leaves or 0 if the merged cut is too large. */
+static uint32_t
+merge_aig_rw_cuts (int32_t *a, int32_t *b, int32_t *res)
+{
+  int32_t i, j;
+  uint32_t size;
+
+  for (i = 1, j = 1, size = 0; i <= a[0] || j <= b[0];)
+  {
+    if (size == BTOR_AIG_RW_CUT_SIZE) return 0;
+    if (j > b[0] || (i <= a[0] && a[i] < b[j]))
+      res[size++] = a[i++];
+    else if (i > a[0] || b[j] < a[i])
+      res[size++] = b[j++];
+    else
+    {
+      res[size++] = a[i++];
+      j++;
+    }
+  }
+  return size;
+}
+
+/* Enumerate the cuts of the node at position 'pos' by merging the cuts of
+ * its children, returns the number of cuts (including the trivial cut). */
+static uint32_t
+enumerate_aig_rw_cuts (BtorAIGRewrite *rw, int32_t pos)
+{
+  uint32_t i, j, k, size, ncuts;
+  int32_t l, r, *cut, *a, *b;
+  int32_t merged[BTOR_AIG_RW_CUT_SIZE];
+
+  cut    = get_aig_rw_cut (rw, pos, 0);
+  cut[0] = 1;
+  cut[1] = pos;
+  ncuts  = 1;
+  if (rw->input[pos]) return ncuts;
+
+  l = get_aig_rw_child_pos (rw, pos, 0);
+  r = get_aig_rw_child_pos (rw, pos, 1);
+  for (i = 0; i < BTOR_AIG_RW_MAX_CUTS; i++)
+  {
+    a = get_aig_rw_cut (rw, l, i);
+    if (!a[0]) break;
+    for (j = 0; j < BTOR_AIG_RW_MAX_CUTS && ncuts < BTOR_AIG_RW_MAX_CUTS; j++)
+    {
+      b = get_aig_rw_cut (rw, r, j);
+      if (!b[0]) break;
+      if (!(size = merge_aig_rw_cuts (a, b, merged))) continue;
+      for (k = 1; k < ncuts; k++)
+      {
+        cut = get_aig_rw_cut (rw, pos, k);
+        if ((uint32_t) cut[0] == size
+            && !memcmp (cut + 1, merged, size * sizeof (int32_t)))
+          break;
+      }
+      if (k < ncuts) continue;
+      cut    = get_aig_rw_cut (rw, pos, ncuts++);
+      cut[0] = size;
+      memcpy (cut + 1, merged, size * sizeof (int32_t));
+    }
+  }
+  return ncuts;
+}
+
+/* DAG-aware rewriting of AND nodes w.r.t. their 4-feasible cuts. */
+static uint32_t
+rewrite_aig_rw (BtorAIGRewrite *rw)
+{
+  uint32_t i, j, n, ncuts, res;
+  int32_t *cut, gain, best_gain, best_cut;
+  BtorAIG *best, *cand, *aigs[BTOR_AIG_RW_CUT_SIZE];
+  BtorMemMgr *mm;
+
+  mm  = rw->amgr->btor->mm;
+  n   = BTOR_COUNT_STACK (rw->nodes);
+  res = 0;
+  if (!n) return res;
+  BTOR_CNEWN (mm, rw->cuts, n * BTOR_AIG_RW_MAX_CUTS * BTOR_AIG_RW_CUT_SLOT);
+
+  for (i = 0; i < n; i++)
+  {
+    ncuts = enumerate_aig_rw_cuts (rw, i);
+
+    best      = 0;
+    best_gain = 0;
+    best_cut  = -1;
+    for (j = 1; j < ncuts; j++)
+    {
+      cut  = get_aig_rw_cut (rw, i, j);
+      gain = resynth_aig_rw (rw, i, cut + 1, cut[0], &cand);
+      if (gain <= 0) continue;
+      if (gain <= best_gain)
+      {
+        btor_aig_release (rw->amgr, cand);
+        continue;
+      }
+      if (best_cut >= 0) btor_aig_release (rw->amgr, best);
+      best      = cand;
+      best_gain = gain;
+      best_cut  = j;
+    }
+    if (best_cut < 0) continue;
+
+    cut = get_aig_rw_cut (rw, i, best_cut);
+    get_aig_rw_leaves (rw, cut + 1, cut[0], aigs);
+    if (replace_aig_rw (rw, i, best, aigs, cut[0])) res++;
+  }
+  return res;
+}
+
+/* Compute a reconvergence-driven cut of the node at position 'pos' with
+ * at most 6 leaves, returns the number of leaves. */
+static uint32_t
+compute_aig_rf_cut (BtorAIGRewrite *rw, int32_t pos, int32_t *leaves)
+{
+  uint32_t i, nleaves, cost, best_cost;
+  int32_t best, c0, c1;
+
+  leaves[0] = get_aig_rw_child_pos (rw, pos, 0);
+  leaves[1] = get_aig_rw_child_pos (rw, pos, 1);
+  nleaves   = leaves[0] == leaves[1] ? 1 : 2;
+
+  for (;;)
+  {
+    /* expand the leaf that adds the least number of new leaves */
+    best      = -1;
+    best_cost = UINT32_MAX;
+    for (i = 0; i < nleaves; i++)
+    {
+      if (rw->input[leaves[i]]) continue;
+      c0   = get_aig_rw_child_pos (rw, leaves[i], 0);
+      c1   = get_aig_rw_child_pos (rw, leaves[i], 1);
+      cost = !is_aig_rw_leaf (c0, leaves, nleaves)
+             + (c1 != c0 && !is_aig_rw_leaf (c1, leaves, nleaves));
+      if (nleaves - 1 + cost > BTOR_AIG_RF_CUT_SIZE || cost >= best_cost)
+        continue;
+      best      = i;
+      best_cost = cost;
+    }
+    if (best < 0) break;
+
+    c0           = get_aig_rw_child_pos (rw, leaves[best], 0);
+    c1           = get_aig_rw_child_pos (rw, leaves[best], 1);
+    leaves[best] = leaves[--nleaves];
+    if (!is_aig_rw_leaf (c0, leaves, nleaves)) leaves[nleaves++] = c0;
+    if (!is_aig_rw_leaf (c1, leaves, nleaves)) leaves[nleaves++] = c1;
+  }
+  return nleaves;
+}
+
+/* Refactoring of AND nodes w.r.t. larger reconvergence-driven cuts. */
+static uint32_t
+refactor_aig_rw (BtorAIGRewrite *rw)
+{
+  uint32_t i, nleaves, res;
+  int32_t leaves[BTOR_AIG_RF_CUT_SIZE];
+  BtorAIG *aig, *aigs[BTOR_AIG_RF_CUT_SIZE];
+
+  res = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (rw->nodes); i++)
+  {
+    if (rw->input[i]) continue;
+    nleaves = compute_aig_rf_cut (rw, i, leaves);
+    if (resynth_aig_rw (rw, i, leaves, nleaves, &aig) <= 0) continue;
+    get_aig_rw_leaves (rw, leaves, nleaves, aigs);
+    if (replace_aig_rw (rw, i, aig, aigs, nleaves)) res++;
+  }
+  return res;
+}
+
+/* Balancing of AND supergates, i.e., trees of non-shared AND nodes, by
+ * pairing leaves with minimum level first. */
+static uint32_t
+balance_aig_rw (BtorAIGRewrite *rw)
+{
+  uint32_t i, j, k, nleaves, norig, size, res;
+  uint32_t levels[BTOR_AIG_BAL_MAX_LEAVES], level;
+  uint64_t num_aigs;
+  int32_t pos;
+  BtorAIG *aig, *cur, *tmp;
+  BtorAIG *leaves[BTOR_AIG_BAL_MAX_LEAVES], *orig[BTOR_AIG_BAL_MAX_LEAVES];
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack stack;
+
+  amgr = rw->amgr;
+  res  = 0;
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  for (i = 0; i < BTOR_COUNT_STACK (rw->nodes); i++)
+  {
+    if (rw->input[i]) continue;
+
+    /* collect supergate leaves */
+    aig     = BTOR_PEEK_STACK (rw->nodes, i);
+    nleaves = 0;
+    size    = 1;
+    BTOR_RESET_STACK (stack);
+    BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, aig));
+    BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, aig));
+    while (!BTOR_EMPTY_STACK (stack) && nleaves < BTOR_AIG_BAL_MAX_LEAVES)
+    {
+      cur = BTOR_POP_STACK (stack);
+      pos = get_fraig_pos (rw->idx, cur);
+      if (!BTOR_IS_INVERTED_AIG (cur) && !rw->input[pos] && cur->refs == 1
+          && nleaves + BTOR_COUNT_STACK (stack) + 2 <= BTOR_AIG_BAL_MAX_LEAVES)
+      {
+        BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, cur));
+        BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, cur));
+        size++;
+        continue;
+      }
+      levels[nleaves]   = rw->level[pos];
+      orig[nleaves]     = cur;
+      leaves[nleaves++] = btor_aig_copy (amgr, cur);
+    }
+    assert (BTOR_EMPTY_STACK (stack));
+    if (nleaves < 3)
+    {
+      for (j = 0; j < nleaves; j++) btor_aig_release (amgr, leaves[j]);
+      continue;
+    }
+    norig = nleaves;
+
+    /* combine the two leaves with minimum level until one is left */
+    num_aigs = amgr->cur_num_aigs;
+    while (nleaves > 1)
+    {
+      for (j = 0, k = 1; k < nleaves; k++)
+        if (levels[k] < levels[j]) j = k;
+      tmp       = leaves[j];
+      level     = levels[j];
+      leaves[j] = leaves[--nleaves];
+      levels[j] = levels[nleaves];
+      for (j = 0, k = 1; k < nleaves; k++)
+        if (levels[k] < levels[j]) j = k;
+      cur = btor_aig_and (amgr, tmp, leaves[j]);
+      btor_aig_release (amgr, tmp);
+      btor_aig_release (amgr, leaves[j]);
+      leaves[j] = cur;
+      levels[j] = 1 + (level > levels[j] ? level : levels[j]);
+    }
+
+    if (levels[0] >= rw->level[i] || amgr->cur_num_aigs - num_aigs > size)
+    {
+      btor_aig_release (amgr, leaves[0]);
+      continue;
+    }
+    if (replace_aig_rw (rw, i, leaves[0], orig, norig)) res++;
+  }
+  BTOR_RELEASE_STACK (stack);
+  return res;
+}
+
+void
+btor_aig_rewrite (BtorAIGMgr *amgr, uint32_t rounds)
+{
+  assert (amgr);
+  assert (amgr->fraig_defer);
+
+  uint32_t i, j, before, after, replaced, total;
+  BtorAIGRewrite rw;
+  static const char *passes[] = {"balancing", "rewriting", "refactoring"};
+
+  if (BTOR_EMPTY_STACK (amgr->fraig_roots)
+      && BTOR_EMPTY_STACK (amgr->fraig_toplevel))
+    return;
+
+  for (i = 0; i < rounds; i++)
+  {
+    total = 0;
+    for (j = 0; j < 3; j++)
+    {
+      init_aig_rw (&rw, amgr);
+      before = count_aig_rw (&rw);
+      switch (j)
+      {
+        case 0:
+          replaced = balance_aig_rw (&rw);
+          amgr->num_rw_balanced += replaced;
+          break;
+        case 1:
+          replaced = rewrite_aig_rw (&rw);
+          amgr->num_rw_rewritten += replaced;
+          break;
+        default:
+          replaced = refactor_aig_rw (&rw);
+          amgr->num_rw_refactored += replaced;
+      }
+      delete_aig_rw (&rw);
+
+      init_aig_rw (&rw, amgr);
+      after = count_aig_rw (&rw);
+      delete_aig_rw (&rw);
+
+      BTOR_MSG (amgr->btor->msg,
+                2,
+                "AIG %s round %u: %u replaced, %u -> %u ANDs",
+                passes[j],
+                i + 1,
+                replaced,
+                before,
+                after);
+      total += replaced;
+    }
+    if (!total) break;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/* Plaisted-Greenbaum and cut-based translation into CNF                  */
+/*------------------------------------------------------------------------*/
+
+struct BtorAIGCNF
+{
+  BtorAIGRewrite rw;  /* cone, cuts and truth tables */
+  uint32_t enc;       /* BTOR_AIG_CNF_PG or BTOR_AIG_CNF_CUT */
+  int32_t *def;       /* definition per node: size, leaf positions */
+  uint64_t *fun;      /* function of node w.r.t. the leaves of 'def' */
+  uint8_t *req;       /* required polarities */
+  uint32_t *fanout;   /* number of parents in the cone */
+  bool *ext;          /* referenced from outside of the cone */
+  double *flow;       /* area flow of selected cut */
+  BtorAIGPtrStack units; /* top level literals */
+  bool empty;            /* top level false constraint */
+};
+
+typedef struct BtorAIGCNF BtorAIGCNF;
+
+static int32_t *
+get_aig_cnf_def (BtorAIGCNF *cnf, int32_t pos)
+{
+  return cnf->def + pos * BTOR_AIG_RW_CUT_SLOT;
+}
+
+/* AIGs at the boundary of the cone that are encoded in one polarity only
+ * are completed first, returns true if any AIG was completed. */
+static bool
+complete_aig_cnf_inputs (BtorAIGRewrite *rw)
+{
+  uint32_t i;
+  bool res;
+  BtorAIG *aig;
+
+  for (i = 0, res = false; i < BTOR_COUNT_STACK (rw->nodes); i++)
+  {
+    aig = BTOR_PEEK_STACK (rw->nodes, i);
+    if (!aig->cnf_id || aig->pol == BTOR_AIG_POL_BOTH) continue;
+    btor_aig_to_sat_tseitin (rw->amgr, aig);
+    res = true;
+  }
+  return res;
+}
+
+static void
+init_aig_cnf (BtorAIGCNF *cnf, BtorAIGMgr *amgr, uint32_t enc)
+{
+  uint32_t i, n;
+  BtorAIG *aig, *repr;
+  BtorAIGRewrite *rw;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
+  BTOR_CLR (cnf);
+  cnf->enc = enc;
+  rw       = &cnf->rw;
+  init_aig_rw (rw, amgr);
+  while (complete_aig_cnf_inputs (rw))
+  {
+    delete_aig_rw (rw);
+    init_aig_rw (rw, amgr);
+  }
+  BTOR_INIT_STACK (mm, cnf->units);
+
+  n = BTOR_COUNT_STACK (rw->nodes);
+  if (!n) return;
+  BTOR_CNEWN (mm, cnf->def, n * BTOR_AIG_RW_CUT_SLOT);
+  BTOR_CNEWN (mm, cnf->fun, n);
+  BTOR_CNEWN (mm, cnf->req, n);
+  BTOR_CNEWN (mm, cnf->fanout, n);
+  BTOR_CNEWN (mm, cnf->ext, n);
+  BTOR_CNEWN (mm, cnf->flow, n);
+
+  for (i = 0; i < n; i++)
+  {
+    aig = BTOR_PEEK_STACK (rw->nodes, i);
+    if (!rw->input[i])
+    {
+      cnf->fanout[get_aig_rw_child_pos (rw, i, 0)]++;
+      cnf->fanout[get_aig_rw_child_pos (rw, i, 1)]++;
+    }
+    else if (!aig->cnf_id && get_fraig_repr (amgr, aig, &repr)
+             && !btor_aig_is_const (repr))
+    {
+      cnf->fanout[get_fraig_pos (rw->idx, repr)]++;
+    }
+  }
+  for (i = 0; i < n; i++)
+  {
+    aig         = BTOR_PEEK_STACK (rw->nodes, i);
+    cnf->ext[i] = !rw->input[i] && aig->refs > cnf->fanout[i];
+  }
+}
+
+static void
+delete_aig_cnf (BtorAIGCNF *cnf)
+{
+  uint32_t n;
+  BtorMemMgr *mm;
+
+  mm = cnf->rw.amgr->btor->mm;
+  n  = BTOR_COUNT_STACK (cnf->rw.nodes);
+  BTOR_DELETEN (mm, cnf->def, n * BTOR_AIG_RW_CUT_SLOT);
+  BTOR_DELETEN (mm, cnf->fun, n);
+  BTOR_DELETEN (mm, cnf->req, n);
+  BTOR_DELETEN (mm, cnf->fanout, n);
+  BTOR_DELETEN (mm, cnf->ext, n);
+  BTOR_DELETEN (mm, cnf->flow, n);
+  BTOR_RELEASE_STACK (cnf->units);
+  delete_aig_rw (&cnf->rw);
+}
+
+/* Number of clauses required to encode 'fun' over 'nvars' leaves in both
+ * polarities. */
+static uint32_t
+count_aig_cnf_clauses (BtorAIGRewrite *rw, uint64_t fun, uint32_t nvars)
+{
+  uint32_t res;
+  (void) isop_aig_rw (fun, fun, nvars, &rw->cubes);
+  (void) isop_aig_rw (~fun, ~fun, nvars, &rw->cubes);
+  res = BTOR_COUNT_STACK (rw->cubes);
+  BTOR_RESET_STACK (rw->cubes);
+  return res;
+}
+
+/* Select a 4-feasible cut for every AND node of the cone that minimizes
+ * the area flow w.r.t. the number of clauses (technology mapping). Nodes
+ * referenced from outside of the cone are always mapped, i.e., only
+ * their trivial cut is visible to their parents. */
+static void
+map_aig_cnf_cuts (BtorAIGCNF *cnf)
+{
+  uint32_t i, j, k, n, ncuts, fanout;
+  int32_t *cut, *def;
+  uint64_t fun;
+  double flow, best;
+  BtorAIGRewrite *rw;
+
+  rw = &cnf->rw;
+  n  = BTOR_COUNT_STACK (rw->nodes);
+  if (!n) return;
+  BTOR_CNEWN (rw->amgr->btor->mm,
+              rw->cuts,
+              n * BTOR_AIG_RW_MAX_CUTS * BTOR_AIG_RW_CUT_SLOT);
+
+  for (i = 0; i < n; i++)
+  {
+    ncuts = enumerate_aig_rw_cuts (rw, i);
+    if (rw->input[i]) continue;
+
+    def  = get_aig_cnf_def (cnf, i);
+    best = -1;
+    for (j = 1; j < ncuts; j++)
+    {
+      cut  = get_aig_rw_cut (rw, i, j);
+      fun  = compute_aig_rw_tt (rw, i, cut + 1, cut[0]);
+      flow = count_aig_cnf_clauses (rw, fun, cut[0]);
+      for (k = 1; k <= (uint32_t) cut[0]; k++)
+      {
+        fanout = cnf->fanout[cut[k]];
+        flow += cnf->flow[cut[k]] / (fanout ? fanout : 1);
+      }
+      if (best >= 0 && flow >= best) continue;
+      best         = flow;
+      cnf->fun[i]  = fun;
+      memcpy (def, cut, BTOR_AIG_RW_CUT_SLOT * sizeof (int32_t));
+    }
+    assert (best >= 0);
+
+    if (cnf->ext[i])
+      get_aig_rw_cut (rw, i, 1)[0] = 0;
+    else
+      cnf->flow[i] = best;
+  }
+}
+
+/* Definition of AND node at position 'pos' for Plaisted-Greenbaum
+ * encoding, i.e., over its children or the leaves of an XOR or ITE. */
+static void
+get_aig_cnf_pg_def (BtorAIGCNF *cnf, int32_t pos)
+{
+  uint32_t i, j;
+  int32_t l, r, leaf, *def;
+  BtorAIG *aig;
+  BtorAIGRewrite *rw;
+  BtorAIGPtrStack leafs;
+
+  rw  = &cnf->rw;
+  aig = BTOR_PEEK_STACK (rw->nodes, pos);
+  def = get_aig_cnf_def (cnf, pos);
+  l   = get_aig_rw_child_pos (rw, pos, 0);
+  r   = get_aig_rw_child_pos (rw, pos, 1);
+
+  BTOR_INIT_STACK (rw->amgr->btor->mm, leafs);
+  if (rw->input[l] || rw->input[r]
+      || (!is_xor_aig (rw->amgr, aig, &leafs)
+          && !is_ite_aig (rw->amgr, aig, &leafs)))
+  {
+    def[0] = 2;
+    def[1] = l;
+    def[2] = r;
+  }
+  else
+  {
+    def[0] = 0;
+    for (i = 0; i < BTOR_COUNT_STACK (leafs); i++)
+    {
+      leaf = get_fraig_pos (rw->idx, BTOR_PEEK_STACK (leafs, i));
+      for (j = 1; j <= (uint32_t) def[0]; j++)
+        if (def[j] == leaf) break;
+      if (j > (uint32_t) def[0]) def[++def[0]] = leaf;
+    }
+  }
+  BTOR_RELEASE_STACK (leafs);
+  cnf->fun[pos] = compute_aig_rw_tt (rw, pos, def + 1, def[0]);
+}
+
+/* Definition of AIG at position 'pos' that was merged into 'repr'. */
+static void
+get_aig_cnf_repr_def (BtorAIGCNF *cnf, int32_t pos, BtorAIG *repr)
+{
+  int32_t *def;
+
+  def = get_aig_cnf_def (cnf, pos);
+  if (btor_aig_is_const (repr))
+  {
+    def[0]        = 0;
+    cnf->fun[pos] = repr == BTOR_AIG_TRUE ? ~UINT64_C (0) : 0;
+  }
+  else
+  {
+    def[0]        = 1;
+    def[1]        = get_fraig_pos (cnf->rw.idx, repr);
+    cnf->fun[pos] = BTOR_IS_INVERTED_AIG (repr) ? ~btor_aig_rw_var_masks[0]
+                                                : btor_aig_rw_var_masks[0];
+  }
+}
+
+static void
+add_aig_cnf_req (BtorAIGCNF *cnf, BtorAIG *aig, uint8_t pol)
+{
+  if (btor_aig_is_const (aig)) return;
+  if (BTOR_IS_INVERTED_AIG (aig) && pol != BTOR_AIG_POL_BOTH)
+    pol = BTOR_AIG_POL_BOTH & ~pol;
+  cnf->req[get_fraig_pos (cnf->rw.idx, aig)] |= pol;
+}
+
+/* Required polarities of the deferred roots. Top level ANDs are split into
+ * separate unit clauses. */
+static void
+init_aig_cnf_req (BtorAIGCNF *cnf)
+{
+  size_t i;
+  int32_t pos;
+  BtorAIG *aig;
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack stack;
+
+  amgr = cnf->rw.amgr;
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_roots); i++)
+    add_aig_cnf_req (
+        cnf, BTOR_PEEK_STACK (amgr->fraig_roots, i), BTOR_AIG_POL_BOTH);
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_toplevel); i++)
+    BTOR_PUSH_STACK (stack, BTOR_PEEK_STACK (amgr->fraig_toplevel, i));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    aig = BTOR_POP_STACK (stack);
+    if (aig == BTOR_AIG_TRUE) continue;
+    if (aig == BTOR_AIG_FALSE)
+    {
+      cnf->empty = true;
+      continue;
+    }
+    pos = get_fraig_pos (cnf->rw.idx, aig);
+    if (!BTOR_IS_INVERTED_AIG (aig) && !cnf->rw.input[pos])
+    {
+      BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, aig));
+      BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, aig));
+      continue;
+    }
+    BTOR_PUSH_STACK (cnf->units, aig);
+    add_aig_cnf_req (cnf, aig, BTOR_AIG_POL_POS);
+  }
+  BTOR_RELEASE_STACK (stack);
+}
+
+/* Propagate required polarities from the roots to the leaves of the
+ * definitions in reverse topological order. A leaf occurring positively
+ * in the clauses of a definition requires its positive polarity and vice
+ * versa. */
+static void
+propagate_aig_cnf_req (BtorAIGCNF *cnf)
+{
+  int32_t i, *def;
+  uint32_t j, k;
+  size_t c;
+  uint64_t fun;
+  BtorAIG *aig, *repr;
+  BtorAIGRewrite *rw;
+
+  rw = &cnf->rw;
+  for (i = BTOR_COUNT_STACK (rw->nodes) - 1; i >= 0; i--)
+  {
+    if (!cnf->req[i]) continue;
+    aig = BTOR_PEEK_STACK (rw->nodes, i);
+    if (btor_aig_is_var (aig) || aig->cnf_id) continue;
+
+    if (rw->input[i])
+    {
+      (void) get_fraig_repr (rw->amgr, aig, &repr);
+      get_aig_cnf_repr_def (cnf, i, repr);
+    }
+    else if (cnf->enc == BTOR_AIG_CNF_PG)
+      get_aig_cnf_pg_def (cnf, i);
+
+    def = get_aig_cnf_def (cnf, i);
+    fun = cnf->fun[i];
+    if (cnf->req[i] & BTOR_AIG_POL_POS)
+      (void) isop_aig_rw (~fun, ~fun, def[0], &rw->cubes);
+    if (cnf->req[i] & BTOR_AIG_POL_NEG)
+      (void) isop_aig_rw (fun, fun, def[0], &rw->cubes);
+    for (c = 0; c < BTOR_COUNT_STACK (rw->cubes); c++)
+    {
+      for (j = 0, k = 1; k <= (uint32_t) def[0]; j += 2, k++)
+      {
+        if (rw->cubes.start[c] & (1 << j))
+          cnf->req[def[k]] |= BTOR_AIG_POL_POS;
+        if (rw->cubes.start[c] & (1 << (j + 1)))
+          cnf->req[def[k]] |= BTOR_AIG_POL_NEG;
+      }
+    }
+    BTOR_RESET_STACK (rw->cubes);
+  }
+}
+
+/* Add clauses (sign * x | !cube) for all cubes from 'from' to 'to'. */
+static void
+add_aig_cnf_clauses (BtorAIGCNF *cnf,
+                     int32_t x,
+                     int32_t *def,
+                     size_t from,
+                     size_t to)
+{
+  size_t c;
+  uint32_t j, k;
+  int32_t cube, lit;
+  BtorAIGMgr *amgr;
+  BtorAIG *leaf;
+
+  amgr = cnf->rw.amgr;
+  for (c = from; c < to; c++)
+  {
+    cube = BTOR_PEEK_STACK (cnf->rw.cubes, c);
+    for (j = 0, k = 1; k <= (uint32_t) def[0]; j += 2, k++)
+    {
+      if (!(cube & (3 << j))) continue;
+      leaf = BTOR_PEEK_STACK (cnf->rw.nodes, def[k]);
+      lit  = btor_aig_get_cnf_id (leaf);
+      assert (lit);
+      btor_sat_add (amgr->smgr, cube & (1 << j) ? lit : -lit);
+      amgr->num_cnf_literals++;
+      if (cnf->enc == BTOR_AIG_CNF_PG)
+        amgr->num_cnf_pg_literals++;
+      else
+        amgr->num_cnf_cut_literals++;
+    }
+    btor_sat_add (amgr->smgr, x);
+    btor_sat_add (amgr->smgr, 0);
+    amgr->num_cnf_clauses++;
+    amgr->num_cnf_literals++;
+    if (cnf->enc == BTOR_AIG_CNF_PG)
+    {
+      amgr->num_cnf_pg_clauses++;
+      amgr->num_cnf_pg_literals++;
+    }
+    else
+    {
+      amgr->num_cnf_cut_clauses++;
+      amgr->num_cnf_cut_literals++;
+    }
+  }
+}
+
+/* Translate the definitions of all AIGs with required polarities into CNF
+ * in topological order, followed by the top level unit clauses. */
+static void
+encode_aig_cnf (BtorAIGCNF *cnf)
+{
+  size_t i, beg, mid, end;
+  int32_t x, *def;
+  uint64_t fun;
+  BtorAIG *aig;
+  BtorAIGMgr *amgr;
+  BtorAIGRewrite *rw;
+
+  rw   = &cnf->rw;
+  amgr = rw->amgr;
+  for (i = 0; i < BTOR_COUNT_STACK (rw->nodes); i++)
+  {
+    if (!cnf->req[i]) continue;
+    aig = BTOR_PEEK_STACK (rw->nodes, i);
+    if (btor_aig_is_var (aig))
+    {
+      if (!aig->cnf_id)
+      {
+        set_next_id_aig_mgr (amgr, aig);
+        aig->pol = BTOR_AIG_POL_BOTH;
+      }
+      continue;
+    }
+    if (aig->cnf_id)
+    {
+      assert (aig->pol == BTOR_AIG_POL_BOTH);
+      continue;
+    }
+
+    set_next_id_aig_mgr (amgr, aig);
+    x   = aig->cnf_id;
+    def = get_aig_cnf_def (cnf, i);
+    fun = cnf->fun[i];
+
+    /* merged into constant, unit clause covers both polarities */
+    if (!def[0])
+    {
+      cnf->req[i] = BTOR_AIG_POL_BOTH;
+      BTOR_PUSH_STACK (rw->cubes, 0);
+      add_aig_cnf_clauses (cnf, fun ? x : -x, def, 0, 1);
+      BTOR_RESET_STACK (rw->cubes);
+    }
+    else
+    {
+      beg = mid = end = 0;
+      if (cnf->req[i] & BTOR_AIG_POL_POS)
+        (void) isop_aig_rw (~fun, ~fun, def[0], &rw->cubes);
+      mid = BTOR_COUNT_STACK (rw->cubes);
+      if (cnf->req[i] & BTOR_AIG_POL_NEG)
+        (void) isop_aig_rw (fun, fun, def[0], &rw->cubes);
+      end = BTOR_COUNT_STACK (rw->cubes);
+      add_aig_cnf_clauses (cnf, -x, def, beg, mid);
+      add_aig_cnf_clauses (cnf, x, def, mid, end);
+      BTOR_RESET_STACK (rw->cubes);
+    }
+    aig->pol = cnf->req[i];
+  }
+
+  if (cnf->empty)
+  {
+    btor_sat_add (amgr->smgr, 0);
+    amgr->num_cnf_clauses++;
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (cnf->units); i++)
+  {
+    x = btor_aig_get_cnf_id (BTOR_PEEK_STACK (cnf->units, i));
+    assert (x);
+    btor_sat_add (amgr->smgr, x);
+    btor_sat_add (amgr->smgr, 0);
+    amgr->num_cnf_clauses++;
+    amgr->num_cnf_literals++;
+  }
+}
+
+/* Translate the deferred AIGs into CNF with Plaisted-Greenbaum or cut-based
+ * encoding. */
+static void
+aig_to_sat_pg (BtorAIGMgr *amgr, uint32_t enc)
+{
+  BtorAIGCNF cnf;
+
+  BTOR_MSG (amgr->btor->msg,
+            3,
+            "transforming AIG into CNF using %s encoding",
+            enc == BTOR_AIG_CNF_PG ? "Plaisted-Greenbaum" : "cut-based");
+  init_aig_cnf (&cnf, amgr, enc);
+  if (enc == BTOR_AIG_CNF_CUT) map_aig_cnf_cuts (&cnf);
+  init_aig_cnf_req (&cnf);
+  propagate_aig_cnf_req (&cnf);
+  encode_aig_cnf (&cnf);
+  delete_aig_cnf (&cnf);
+}
+
+void
+btor_aig_fraig_defer (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+  if (!btor_sat_is_initialized (amgr->smgr)) return;
+  amgr->fraig_defer = true;
+}
+
+void
+btor_aig_fraig (BtorAIGMgr *amgr, uint32_t limit)
+{
+  assert (amgr);
+
+  size_t i;
+  uint32_t enc;
+  BtorAIG *aig;
+
+  if (!amgr->fraig_defer) return;
+  amgr->fraig_defer = false;
+
+  if (BTOR_EMPTY_STACK (amgr->fraig_roots)
+      && BTOR_EMPTY_STACK (amgr->fraig_toplevel))
+    return;
+
+  if (limit) sweep_fraig (amgr, limit);
+
+  enc = btor_opt_get (amgr->btor, BTOR_OPT_AIG_CNF);
+  if (enc != BTOR_AIG_CNF_TSEITIN)
+  {
+    aig_to_sat_pg (amgr, enc);
+    for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_roots); i++)
+      btor_aig_release (amgr, BTOR_PEEK_STACK (amgr->fraig_roots, i));
+    for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_toplevel); i++)
+      btor_aig_release (amgr, BTOR_PEEK_STACK (amgr->fraig_toplevel, i));
+    BTOR_RESET_STACK (amgr->fraig_roots);
+    BTOR_RESET_STACK (amgr->fraig_toplevel);
+    return;
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_roots); i++)
+  {
+    aig = BTOR_PEEK_STACK (amgr->fraig_roots, i);
+    btor_aig_to_sat_tseitin (amgr, aig);
+    btor_aig_release (amgr, aig);
+  }
+  BTOR_RESET_STACK (amgr->fraig_roots);
+
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->fraig_toplevel); i++)
+  {
+    aig = BTOR_PEEK_STACK (amgr->fraig_toplevel, i);
+    btor_aig_add_toplevel_to_sat (amgr, aig);
+    btor_aig_release (amgr, aig);
+  }
+  BTOR_RESET_STACK (amgr->fraig_toplevel);
+}
+
+BtorSATMgr *
+btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
+{
+  return amgr ? amgr->smgr : 0;
+}
+
+static int32_t
+deref_aig (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  int32_t val;
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (aig->cnf_id > 0);
+  val = btor_sat_deref (amgr->smgr, aig->cnf_id);
+  return val ? val : -1;
+}
+
+static int32_t
+get_eval_aig_value (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  int32_t val;
+  if (aig == BTOR_AIG_TRUE) return 1;
+  if (aig == BTOR_AIG_FALSE) return -1;
+  val = btor_hashint_map_get (amgr->eval_cache, BTOR_REAL_ADDR_AIG (aig)->id)
+            ->as_int;
+  return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
+}
+
+/* The CNF id of an AIG that is encoded in one polarity only (see
+ * BTOR_OPT_AIG_CNF) does not necessarily agree with its function in the
+ * current model. Hence, its value is computed from its children (or its
+ * representative) down to AIGs that are encoded in both polarities. */
+static int32_t
+eval_aig_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (BTOR_IS_REGULAR_AIG (aig));
+
+  int32_t val;
+  BtorAIG *cur, *repr, *left, *right;
+  BtorAIGPtrStack stack;
+  BtorHashTableData *d;
+
+  if (amgr->eval_cache && amgr->eval_satcalls != amgr->smgr->satcalls)
+  {
+    btor_hashint_map_delete (amgr->eval_cache);
+    amgr->eval_cache = 0;
+  }
+  if (!amgr->eval_cache)
+  {
+    amgr->eval_cache    = btor_hashint_map_new (amgr->btor->mm);
+    amgr->eval_satcalls = amgr->smgr->satcalls;
+  }
+  if ((d = btor_hashint_map_get (amgr->eval_cache, aig->id))) return d->as_int;
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, aig);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (btor_hashint_map_contains (amgr->eval_cache, cur->id))
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+    if (btor_aig_is_var (cur) || btor_aig_is_encoded (cur))
+    {
+      (void) BTOR_POP_STACK (stack);
+      val = cur->cnf_id ? deref_aig (amgr, cur) : -1;
+    }
+    else if (get_fraig_repr (amgr, cur, &repr))
+    {
+      if (!btor_aig_is_const (repr)
+          && !btor_hashint_map_contains (amgr->eval_cache,
+                                         BTOR_REAL_ADDR_AIG (repr)->id))
+      {
+        BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (repr));
+        continue;
+      }
+      (void) BTOR_POP_STACK (stack);
+      val = get_eval_aig_value (amgr, repr);
+    }
+    else
+    {
+      left  = btor_aig_get_left_child (amgr, cur);
+      right = btor_aig_get_right_child (amgr, cur);
+      if (!btor_hashint_map_contains (amgr->eval_cache,
+                                      BTOR_REAL_ADDR_AIG (left)->id))
+      {
+        BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (left));
+        continue;
+      }
+      if (!btor_hashint_map_contains (amgr->eval_cache,
+                                      BTOR_REAL_ADDR_AIG (right)->id))
+      {
+        BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (right));
+        continue;
+      }
+      (void) BTOR_POP_STACK (stack);
+      val = get_eval_aig_value (amgr, left) > 0
+                    && get_eval_aig_value (amgr, right) > 0
+                ? 1
+                : -1;
+    }
+    btor_hashint_map_add (amgr->eval_cache, cur->id)->as_int = val;
+  }
+  BTOR_RELEASE_STACK (stack);
+  return btor_hashint_map_get (amgr->eval_cache, aig->id)->as_int;
+}
+
+int32_t
+btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+  if (aig == BTOR_AIG_TRUE) return 1;
+  if (aig == BTOR_AIG_FALSE) return -1;
+
+  /* Note: If an AIG is not yet encoded to SAT, if the last SAT call was not
+   * satisfiable (e.g., limit reached) or if the SAT solver returns undefined
+   * for a variable, we implicitly initialize it with false (-1). */
+  int32_t val = -1;
+  if (BTOR_REAL_ADDR_AIG (aig)->cnf_id > 0 && amgr->smgr->has_model)
+  {
+    if (BTOR_REAL_ADDR_AIG (aig)->pol != BTOR_AIG_POL_BOTH)
+      val = eval_aig_assignment (amgr, BTOR_REAL_ADDR_AIG (aig));
+    else
+      val = deref_aig (amgr, BTOR_REAL_ADDR_AIG (aig));
   }
   return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
 }
@@ -12,6 +12,7 @@
 #include "btoropt.h"
 #include "btorsat.h"
 #include "btortypes.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -31,14 +32,43 @@ struct BtorAIG
   int32_t next; /* next AIG id for unique table */
   uint8_t mark : 2;
   uint8_t is_var : 1; /* is it an AIG variable or an AND? */
+  uint8_t pol : 2;    /* polarities translated into CNF */
   uint32_t local;
-  int32_t children[]; /* only allocated for AIG AND */
 };
 
 typedef struct BtorAIG BtorAIG;
 
 BTOR_DECLARE_STACK (BtorAIGPtr, BtorAIG *);
 
+/* Polarities of an AIG node that are translated into CNF. The CNF id of a
+ * node implies its function in positive polarity, and is implied by its
+ * function in negative polarity (Plaisted-Greenbaum). Nodes translated
+ * via 'btor_aig_to_sat_tseitin' are always encoded in both polarities. */
+#define BTOR_AIG_POL_POS 1
+#define BTOR_AIG_POL_NEG 2
+#define BTOR_AIG_POL_BOTH 3
+
+/* AIG nodes are stored in chunks of BTOR_AIG_CHUNK_SIZE consecutive ids.
+ * Since children are always created before their parents and ids are
+ * never reused, ids (and thus the node store) are in topological order.
+ * A chunk is released as soon as all of its nodes have been deleted.
+ */
+#define BTOR_AIG_CHUNK_LOG 12
+#define BTOR_AIG_CHUNK_SIZE (1u << BTOR_AIG_CHUNK_LOG)
+
+struct BtorAIGChunk
+{
+  uint32_t live; /* number of nodes in the chunk that are not deleted */
+  BtorAIG nodes[];
+};
+
+typedef struct BtorAIGChunk BtorAIGChunk;
+
+#define BTOR_AIG_CHUNK_BYTES \
+  (sizeof (BtorAIGChunk) + BTOR_AIG_CHUNK_SIZE * sizeof (BtorAIG))
+
+BTOR_DECLARE_STACK (BtorAIGChunkPtr, BtorAIGChunk *);
+
 struct BtorAIGUniqueTable
 {
   uint32_t size;
@@ -53,18 +83,40 @@ struct BtorAIGMgr
   Btor *btor;
   BtorAIGUniqueTable table;
   BtorSATMgr *smgr;
-  BtorAIGPtrStack id2aig; /* id to AIG node */
-  BtorIntStack cnfid2aig; /* cnf id to AIG id */
+  BtorAIGPtrStack id2aig;      /* id to AIG node */
+  BtorIntStack cnfid2aig;      /* cnf id to AIG id */
+  BtorAIGChunkPtrStack chunks; /* node store, id >> BTOR_AIG_CHUNK_LOG */
+  BtorIntStack children;       /* children ids of AND id at 2 * id */
 
   uint_least64_t cur_num_aigs;     /* current number of ANDs */
   uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
 
+  /* SAT sweeping (see btor_aig_fraig) */
+  bool fraig_defer;               /* defer translation into CNF */
+  BtorAIGPtrStack fraig_roots;    /* deferred roots */
+  BtorAIGPtrStack fraig_toplevel; /* deferred top level roots */
+  BtorIntHashTable *fraig_repr;   /* AIG id -> representative AIG id */
+
+  /* values of AIGs that are not encoded in both polarities */
+  BtorIntHashTable *eval_cache; /* AIG id -> value */
+  int32_t eval_satcalls;        /* SAT call 'eval_cache' is valid for */
+
   /* statistics */
   uint_least64_t max_num_aigs;
   uint_least64_t max_num_aig_vars;
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_cnf_pg_clauses;
+  uint_least64_t num_cnf_pg_literals;
+  uint_least64_t num_cnf_cut_clauses;
+  uint_least64_t num_cnf_cut_literals;
+  uint_least64_t num_fraig_merged;
+  uint_least64_t num_fraig_sat_calls;
+  uint_least64_t num_fraig_refuted;
+  uint_least64_t num_rw_balanced;
+  uint_least64_t num_rw_rewritten;
+  uint_least64_t num_rw_refactored;
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -126,6 +178,15 @@ btor_aig_get_id (const BtorAIG *aig)
   return BTOR_IS_INVERTED_AIG (aig) ? -BTOR_REAL_ADDR_AIG (aig)->id : aig->id;
 }
 
+/* Check if AIG is translated into CNF in both polarities. */
+static inline bool
+btor_aig_is_encoded (const BtorAIG *aig)
+{
+  if (btor_aig_is_const (aig)) return true;
+  aig = BTOR_REAL_ADDR_AIG (aig);
+  return aig->cnf_id && aig->pol == BTOR_AIG_POL_BOTH;
+}
+
 static inline BtorAIG *
 btor_aig_get_by_id (BtorAIGMgr *amgr, int32_t id)
 {
@@ -144,22 +205,35 @@ btor_aig_get_cnf_id (const BtorAIG *aig)
                                     : aig->cnf_id;
 }
 
-static inline BtorAIG *
-btor_aig_get_left_child (BtorAIGMgr *amgr, const BtorAIG *aig)
+static inline int32_t
+btor_aig_get_left_child_id (const BtorAIGMgr *amgr, const BtorAIG *aig)
 {
   assert (amgr);
   assert (aig);
   assert (!btor_aig_is_const (aig));
-  return btor_aig_get_by_id (amgr, BTOR_REAL_ADDR_AIG (aig)->children[0]);
+  return BTOR_PEEK_STACK (amgr->children, 2 * BTOR_REAL_ADDR_AIG (aig)->id);
 }
 
-static inline BtorAIG *
-btor_aig_get_right_child (BtorAIGMgr *amgr, const BtorAIG *aig)
+static inline int32_t
+btor_aig_get_right_child_id (const BtorAIGMgr *amgr, const BtorAIG *aig)
 {
   assert (amgr);
   assert (aig);
   assert (!btor_aig_is_const (aig));
-  return btor_aig_get_by_id (amgr, BTOR_REAL_ADDR_AIG (aig)->children[1]);
+  return BTOR_PEEK_STACK (amgr->children,
+                          2 * BTOR_REAL_ADDR_AIG (aig)->id + 1);
+}
+
+static inline BtorAIG *
+btor_aig_get_left_child (BtorAIGMgr *amgr, const BtorAIG *aig)
+{
+  return btor_aig_get_by_id (amgr, btor_aig_get_left_child_id (amgr, aig));
+}
+
+static inline BtorAIG *
+btor_aig_get_right_child (BtorAIGMgr *amgr, const BtorAIG *aig)
+{
+  return btor_aig_get_by_id (amgr, btor_aig_get_right_child_id (amgr, aig));
 }
 
 /*------------------------------------------------------------------------*/
@@ -210,10 +284,33 @@ void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 
 /* Translates AIG into SAT instance in both phases.
  * The function guarantees that after finishing every reachable AIG
- * has a CNF id.
+ * has a CNF id. AIGs that are only encoded in one polarity are completed.
  */
 void btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *aig);
 
+/* Defers the translation of AIGs into CNF via 'btor_aig_to_sat_tseitin'
+ * and 'btor_aig_add_toplevel_to_sat' until 'btor_aig_fraig' is called.
+ */
+void btor_aig_fraig_defer (BtorAIGMgr *amgr);
+
+/* Optimization of the deferred AIGs for at most 'rounds' rounds of
+ * AND balancing, DAG-aware 4-feasible cut rewriting and refactoring.
+ * AIG nodes are not modified but merged into their optimized version,
+ * which is translated into CNF instead (see 'btor_aig_fraig').
+ */
+void btor_aig_rewrite (BtorAIGMgr *amgr, uint32_t rounds);
+
+/* SAT sweeping (fraiging) of the deferred AIGs.
+ * AIG nodes with equal simulation signatures are checked for equivalence
+ * with a separate SAT solver (at most 'limit' conflicts per check).
+ * Proven equivalent nodes are merged, i.e., are translated into CNF as
+ * an equivalence to their representative instead of their cone.
+ * Afterwards, all deferred AIGs are translated into CNF with the encoding
+ * selected via BTOR_OPT_AIG_CNF.
+ * If 'limit' is 0, the deferred AIGs are only translated.
+ */
+void btor_aig_fraig (BtorAIGMgr *amgr, uint32_t limit);
+
 /* Gets current assignment of AIG aig (in the SAT case).
  */
 int32_t btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig);
@@ -0,0 +1,210 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorautoengine.h"
+
+#include "btorcore.h"
+#include "btormsg.h"
+#include "btoropt.h"
+#include "utils/btorhashptr.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/*------------------------------------------------------------------------*/
+
+/* An engine configuration that can be selected in auto mode. */
+struct BtorAutoEngineConfig
+{
+  const char *name;
+  BtorOptEngine engine;
+  int32_t sat_engine;  /* SAT engine, -1 for the default SAT engine */
+  uint32_t nprops;     /* move budget of the prop pre-pass (FUN), 0: none */
+};
+typedef struct BtorAutoEngineConfig BtorAutoEngineConfig;
+
+/* Note: names and order must be kept in sync with CONFIGS in
+ *       contrib/btortrainengine.py. */
+static const BtorAutoEngineConfig g_btor_auto_configs[] = {
+    {"fun", BTOR_ENGINE_FUN, -1, 0},
+    {"fun-preprop", BTOR_ENGINE_FUN, -1, 10000},
+    {"fun-cadical", BTOR_ENGINE_FUN, BTOR_SAT_ENGINE_CADICAL, 0},
+    {"fun-lingeling", BTOR_ENGINE_FUN, BTOR_SAT_ENGINE_LINGELING, 0},
+    {"fun-cms", BTOR_ENGINE_FUN, BTOR_SAT_ENGINE_CMS, 0},
+    {"prop", BTOR_ENGINE_PROP, -1, 0},
+    {"sls", BTOR_ENGINE_SLS, -1, 0},
+    {"aigprop", BTOR_ENGINE_AIGPROP, -1, 0},
+};
+
+#define BTOR_AUTO_ENGINE_NUM_CONFIGS \
+  (sizeof (g_btor_auto_configs) / sizeof (*g_btor_auto_configs))
+
+/* Features (see btor_auto_engine_features):
+ *   bias, nodes, vars, avgwidth, maxwidth, arith, nonlinear, bitwise, cond,
+ *   ufs, lambdas, quantifiers
+ *
+ * The score of a configuration is the dot product of its weights with the
+ * feature vector (a predicted -log10 of the run time), the configuration
+ * with the highest score is selected. The weights between the BEGIN/END
+ * markers are generated by contrib/btortrainengine.py. */
+
+/* BEGIN MODEL */
+static const double g_btor_auto_weights[][BTOR_AUTO_ENGINE_NUM_FEATURES] = {
+    {1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 4.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+};
+/* END MODEL */
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_sat_engine_available (int32_t sat_engine)
+{
+  switch (sat_engine)
+  {
+#ifdef BTOR_USE_LINGELING
+    case BTOR_SAT_ENGINE_LINGELING: return true;
+#endif
+#ifdef BTOR_USE_CADICAL
+    case BTOR_SAT_ENGINE_CADICAL: return true;
+#endif
+#ifdef BTOR_USE_MINISAT
+    case BTOR_SAT_ENGINE_MINISAT: return true;
+#endif
+#ifdef BTOR_USE_PICOSAT
+    case BTOR_SAT_ENGINE_PICOSAT: return true;
+#endif
+#ifdef BTOR_USE_CMS
+    case BTOR_SAT_ENGINE_CMS: return true;
+#endif
+    default: return sat_engine < 0;
+  }
+}
+
+void
+btor_auto_engine_features (Btor *btor, double *features)
+{
+  assert (btor);
+  assert (features);
+
+  uint32_t i, w, nvars, maxw;
+  double nops, sumw;
+  BtorPtrHashTableIterator it;
+
+  nops = 0;
+  for (i = 1; i < BTOR_NUM_OPS_NODE - 1; i++) nops += btor->ops[i].cur;
+
+  nvars = 0;
+  sumw  = 0;
+  maxw  = 0;
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    w = btor_node_bv_get_width (btor, btor_iter_hashptr_next (&it));
+    sumw += w;
+    if (w > maxw) maxw = w;
+    nvars += 1;
+  }
+
+  i             = 0;
+  features[i++] = 1.0;
+  features[i++] = log2 (1 + nops);
+  features[i++] = log2 (1 + nvars);
+  features[i++] = log2 (1 + (nvars ? sumw / nvars : 0));
+  features[i++] = log2 (1 + maxw);
+  /* fractions of operator kinds */
+  if (nops == 0) nops = 1;
+  features[i++] =
+      (btor->ops[BTOR_BV_ADD_NODE].cur + btor->ops[BTOR_BV_ULT_NODE].cur)
+      / nops;
+  features[i++] = (btor->ops[BTOR_BV_MUL_NODE].cur
+                   + btor->ops[BTOR_BV_UDIV_NODE].cur
+                   + btor->ops[BTOR_BV_UREM_NODE].cur)
+                  / nops;
+  features[i++] =
+      (btor->ops[BTOR_BV_AND_NODE].cur + btor->ops[BTOR_BV_SLICE_NODE].cur
+       + btor->ops[BTOR_BV_CONCAT_NODE].cur + btor->ops[BTOR_BV_SLL_NODE].cur
+       + btor->ops[BTOR_BV_SRL_NODE].cur)
+      / nops;
+  features[i++] = btor->ops[BTOR_COND_NODE].cur / nops;
+  features[i++] = log2 (1 + btor->ufs->count + btor->feqs->count);
+  features[i++] = log2 (1 + btor->lambdas->count);
+  features[i++] = btor->quantifiers->count > 0 ? 1.0 : 0.0;
+  assert (i == BTOR_AUTO_ENGINE_NUM_FEATURES);
+}
+
+void
+btor_auto_engine_select (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_AUTO);
+  assert (!btor->slv);
+
+  bool qf_bv;
+  uint32_t i, j;
+  int32_t best;
+  double features[BTOR_AUTO_ENGINE_NUM_FEATURES], score, best_score;
+  char buf[BTOR_AUTO_ENGINE_NUM_FEATURES * 16];
+  const BtorAutoEngineConfig *config;
+
+  btor_auto_engine_features (btor, features);
+
+  /* Note: the output format of the features is parsed by
+   *       contrib/btortrainengine.py */
+  for (i = 0, j = 0; i < BTOR_AUTO_ENGINE_NUM_FEATURES; i++)
+    j += snprintf (buf + j, sizeof (buf) - j, " %.4f", features[i]);
+  BTOR_MSG (btor->msg, 1, "features:%s", buf);
+
+  /* only the quantifier engine supports quantifiers */
+  if (btor->quantifiers->count > 0)
+  {
+    BTOR_MSG (btor->msg, 1, "selected configuration 'quant'");
+    btor_opt_set (btor, BTOR_OPT_ENGINE, BTOR_ENGINE_QUANT);
+    return;
+  }
+
+  qf_bv      = btor->ufs->count == 0 && btor->feqs->count == 0;
+  best       = -1;
+  best_score = 0;
+  for (i = 0; i < BTOR_AUTO_ENGINE_NUM_CONFIGS; i++)
+  {
+    config = &g_btor_auto_configs[i];
+    /* local search engines work on QF_BV only */
+    if (config->engine != BTOR_ENGINE_FUN && !qf_bv) continue;
+    if (!is_sat_engine_available (config->sat_engine)) continue;
+
+    for (j = 0, score = 0; j < BTOR_AUTO_ENGINE_NUM_FEATURES; j++)
+      score += g_btor_auto_weights[i][j] * features[j];
+    BTOR_MSG (btor->msg, 2, "score of '%s': %.4f", config->name, score);
+
+    if (best < 0 || score > best_score)
+    {
+      best       = i;
+      best_score = score;
+    }
+  }
+  assert (best >= 0);
+
+  config = &g_btor_auto_configs[best];
+  BTOR_MSG (btor->msg, 1, "selected configuration '%s'", config->name);
+
+  btor_opt_set (btor, BTOR_OPT_ENGINE, config->engine);
+  if (config->sat_engine >= 0)
+    btor_opt_set (btor, BTOR_OPT_SAT_ENGINE, config->sat_engine);
+  if (config->nprops)
+  {
+    btor_opt_set (btor, BTOR_OPT_FUN_PREPROP, 1);
+    btor_opt_set (btor, BTOR_OPT_PROP_NPROPS, config->nprops);
+  }
+}
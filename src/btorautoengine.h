@@ -0,0 +1,34 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAUTOENGINE_H_INCLUDED
+#define BTORAUTOENGINE_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Number of formula features (including the constant bias feature). */
+#define BTOR_AUTO_ENGINE_NUM_FEATURES 12
+
+/**
+ * Compute cheap features of the current (simplified) formula, e.g., operator
+ * counts, bit-widths of inputs, number of UFs/lambdas, quantifier presence.
+ * 'features' must hold BTOR_AUTO_ENGINE_NUM_FEATURES values.
+ */
+void btor_auto_engine_features (Btor *btor, double *features);
+
+/**
+ * Select an engine configuration (engine, SAT engine and move budget of the
+ * prop pre-pass) for the current formula and set the corresponding options.
+ * The selected engine replaces BTOR_ENGINE_AUTO as value of BTOR_OPT_ENGINE.
+ *
+ * Configurations are ranked by a linear model over the formula features,
+ * see contrib/btortrainengine.py for retraining the model.
+ */
+void btor_auto_engine_select (Btor *btor);
+
+#endif
@@ -7,6 +7,7 @@
  */
 
 #include "btorbeta.h"
+#include "btorclone.h"
 #include "btorexp.h"
 #include "btorlog.h"
 #include "btorrewrite.h"
@@ -822,11 +823,11 @@ beta_reduce_partial_aux (Btor *btor,
             tmp  = btor_node_invert (e[0]);
           }
 
-          if (conds_cache
-              && !btor_hashint_table_contains (conds_cache,
-                                               btor_node_get_id (tmp)))
+          if (conds_stack
+              && (!conds_cache
+                  || !btor_hashint_table_contains (conds_cache,
+                                                   btor_node_get_id (tmp))))
           {
-            assert (conds_stack);
             BTOR_PUSH_STACK (*conds_stack, btor_node_copy (btor, tmp));
           }
 
@@ -953,3 +954,234 @@ btor_beta_reduce_partial_collect_new (Btor *btor,
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
   return beta_reduce_partial_aux (btor, exp, 0, 0, 0, exps, cache);
 }
+
+/*------------------------------------------------------------------------*/
+
+BtorBetaCache *
+btor_beta_cache_new (Btor *btor)
+{
+  assert (btor);
+
+  BtorBetaCache *res;
+
+  BTOR_CNEW (btor->mm, res);
+  res->btor  = btor;
+  res->table = btor_hashptr_table_new (btor->mm,
+                                       (BtorHashPtr) btor_node_pair_hash,
+                                       (BtorCmpPtr) btor_node_pair_compare);
+  return res;
+}
+
+static void *
+clone_key_as_node_pair (BtorMemMgr *mm, const void *map, const void *key)
+{
+  assert (mm);
+  assert (map);
+  assert (key);
+
+  BtorNodePair *pair, *res;
+  BtorNodeMap *exp_map;
+
+  pair    = (BtorNodePair *) key;
+  exp_map = (BtorNodeMap *) map;
+
+  /* node references are already accounted for in the cloned nodes */
+  BTOR_NEW (mm, res);
+  res->node1 = btor_nodemap_mapped (exp_map, pair->node1);
+  res->node2 = btor_nodemap_mapped (exp_map, pair->node2);
+  assert (res->node1);
+  assert (res->node2);
+  return res;
+}
+
+static void
+clone_data_as_beta_cache_entry (BtorMemMgr *mm,
+                                const void *map,
+                                BtorHashTableData *data,
+                                BtorHashTableData *cloned_data)
+{
+  assert (mm);
+  assert (map);
+  assert (data);
+  assert (cloned_data);
+
+  BtorBetaCacheEntry *entry, *res;
+  BtorNodeMap *exp_map;
+
+  entry   = (BtorBetaCacheEntry *) data->as_ptr;
+  exp_map = (BtorNodeMap *) map;
+
+  BTOR_NEW (mm, res);
+  res->result = btor_nodemap_mapped (exp_map, entry->result);
+  res->time   = entry->time;
+  assert (res->result);
+  btor_clone_node_ptr_stack (mm, &entry->conds, &res->conds, exp_map, false);
+  cloned_data->as_ptr = res;
+}
+
+BtorBetaCache *
+btor_beta_cache_clone (Btor *clone, BtorBetaCache *cache, BtorNodeMap *exp_map)
+{
+  assert (clone);
+  assert (cache);
+  assert (exp_map);
+
+  BtorBetaCache *res;
+
+  BTOR_NEW (clone->mm, res);
+  res->btor  = clone;
+  res->stats = cache->stats;
+  res->table = btor_hashptr_table_clone (clone->mm,
+                                         cache->table,
+                                         clone_key_as_node_pair,
+                                         clone_data_as_beta_cache_entry,
+                                         exp_map,
+                                         exp_map);
+  return res;
+}
+
+static void
+delete_beta_cache_entry (Btor *btor, BtorBetaCacheEntry *entry)
+{
+  uint32_t i;
+
+  btor_node_release (btor, entry->result);
+  for (i = 0; i < BTOR_COUNT_STACK (entry->conds); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (entry->conds, i));
+  BTOR_RELEASE_STACK (entry->conds);
+  BTOR_DELETE (btor->mm, entry);
+}
+
+static void
+delete_beta_cache_entries (BtorBetaCache *cache)
+{
+  Btor *btor;
+  BtorPtrHashTableIterator it;
+  BtorBetaCacheEntry *entry;
+
+  btor = cache->btor;
+  btor_iter_hashptr_init (&it, cache->table);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    entry = it.bucket->data.as_ptr;
+    btor_node_pair_delete (btor, btor_iter_hashptr_next (&it));
+    delete_beta_cache_entry (btor, entry);
+  }
+  btor_hashptr_table_delete (cache->table);
+}
+
+void
+btor_beta_cache_reset (BtorBetaCache *cache)
+{
+  assert (cache);
+
+  delete_beta_cache_entries (cache);
+  cache->table = btor_hashptr_table_new (cache->btor->mm,
+                                         (BtorHashPtr) btor_node_pair_hash,
+                                         (BtorCmpPtr) btor_node_pair_compare);
+}
+
+void
+btor_beta_cache_delete (BtorBetaCache *cache)
+{
+  assert (cache);
+
+  delete_beta_cache_entries (cache);
+  BTOR_DELETE (cache->btor->mm, cache);
+}
+
+#ifndef NDEBUG
+/* The cache is reset at the beginning of every refinement iteration, hence
+ * the model and the constraints did not change since an entry was added and
+ * all of its conditions still evaluate to true. */
+static bool
+is_valid_beta_cache_entry (Btor *btor, BtorBetaCacheEntry *entry)
+{
+  bool res;
+  uint32_t i;
+  BtorNode *cond;
+  BtorBitVector *bv;
+
+  if (btor_node_is_simplified (entry->result)) return false;
+
+  for (i = 0, res = true; res && i < BTOR_COUNT_STACK (entry->conds); i++)
+  {
+    cond = BTOR_PEEK_STACK (entry->conds, i);
+    if (btor_node_is_simplified (cond)) return false;
+    bv  = btor_eval_exp (btor, cond);
+    res = btor_bv_is_true (bv);
+    btor_bv_free (btor->mm, bv);
+  }
+  return res;
+}
+#endif
+
+BtorNode *
+btor_beta_reduce_partial_cached (Btor *btor,
+                                 BtorNode *fun,
+                                 BtorNode *args,
+                                 BtorPtrHashTable *conds,
+                                 BtorBetaCache *cache)
+{
+  assert (btor);
+  assert (fun);
+  assert (args);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_regular (args));
+  assert (btor_node_is_lambda (fun));
+  assert (btor_node_is_args (args));
+
+  uint32_t i;
+  double start;
+  BtorNode *result, *cond;
+  BtorNodePair *pair;
+  BtorPtrHashBucket *b;
+  BtorBetaCacheEntry *entry;
+
+  BTORLOG (2,
+           "%s: %s %s",
+           __FUNCTION__,
+           btor_util_node2string (fun),
+           btor_util_node2string (args));
+
+  if (!cache)
+  {
+    btor_beta_assign_args (btor, fun, args);
+    result = beta_reduce_partial_aux (btor, fun, 0, 0, conds, 0, 0);
+    btor_beta_unassign_params (btor, fun);
+    return result;
+  }
+
+  start = btor_util_time_stamp ();
+  pair  = btor_node_pair_new (btor, fun, args);
+  b     = btor_hashptr_table_get (cache->table, pair);
+
+  if (b)
+  {
+    entry = b->data.as_ptr;
+    assert (is_valid_beta_cache_entry (btor, entry));
+    btor_node_pair_delete (btor, pair);
+    /* save conditions for consistency checking */
+    for (i = 0; conds && i < BTOR_COUNT_STACK (entry->conds); i++)
+    {
+      cond = btor_node_real_addr (BTOR_PEEK_STACK (entry->conds, i));
+      if (!btor_hashptr_table_get (conds, cond))
+        btor_hashptr_table_add (conds, btor_node_copy (btor, cond));
+    }
+    cache->stats.hits++;
+    cache->stats.time_saved += entry->time - (btor_util_time_stamp () - start);
+    return btor_node_copy (btor, entry->result);
+  }
+  cache->stats.misses++;
+
+  BTOR_CNEW (btor->mm, entry);
+  BTOR_INIT_STACK (btor->mm, entry->conds);
+  btor_beta_assign_args (btor, fun, args);
+  result = beta_reduce_partial_aux (btor, fun, 0, 0, conds, &entry->conds, 0);
+  btor_beta_unassign_params (btor, fun);
+
+  entry->result = btor_node_copy (btor, result);
+  entry->time   = btor_util_time_stamp () - start;
+  btor_hashptr_table_add (cache->table, pair)->data.as_ptr = entry;
+  return result;
+}
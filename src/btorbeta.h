@@ -13,6 +13,39 @@
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
+
+/* Cache for partial beta reduction results.  Maps a lambda and the
+ * arguments assigned to it to the reduced term, together with the
+ * conditions that were evaluated (and hence, selected the branches) during
+ * reduction.  Entries are only valid within one refinement iteration: the
+ * evaluated conditions depend on the current model, and the reduced term
+ * depends on the constraints (embedded constraints rewriting), which change
+ * whenever lemmas are added.  Hence, the cache is reset at the beginning of
+ * every refinement iteration. */
+struct BtorBetaCache
+{
+  Btor *btor;
+  BtorPtrHashTable *table; /* maps (lambda, args) to BtorBetaCacheEntry */
+
+  struct
+  {
+    uint_least64_t hits;
+    uint_least64_t misses;
+    double time_saved; /* reduction time saved by cache hits */
+  } stats;
+};
+
+typedef struct BtorBetaCache BtorBetaCache;
+
+struct BtorBetaCacheEntry
+{
+  BtorNode *result;
+  BtorNodePtrStack conds; /* evaluated conditions as selected literals */
+  double time;            /* time spent for the reduction */
+};
+
+typedef struct BtorBetaCacheEntry BtorBetaCacheEntry;
 
 BtorNode* btor_beta_reduce_full (Btor* btor,
                                  BtorNode* exp,
@@ -44,4 +77,23 @@ void btor_beta_assign_args (Btor* btor, BtorNode* fun, BtorNode* args);
 
 void btor_beta_unassign_params (Btor* btor, BtorNode* lambda);
 
+BtorBetaCache* btor_beta_cache_new (Btor* btor);
+
+BtorBetaCache* btor_beta_cache_clone (Btor* clone,
+                                      BtorBetaCache* cache,
+                                      BtorNodeMap* exp_map);
+
+/* Remove all entries, but keep statistics. */
+void btor_beta_cache_reset (BtorBetaCache* cache);
+
+void btor_beta_cache_delete (BtorBetaCache* cache);
+
+/* Partially beta reduce lambda 'fun' applied to 'args' (see
+ * btor_beta_reduce_partial) and cache the result in 'cache' (if given). */
+BtorNode* btor_beta_reduce_partial_cached (Btor* btor,
+                                           BtorNode* fun,
+                                           BtorNode* args,
+                                           BtorPtrHashTable* conds,
+                                           BtorBetaCache* cache);
+
 #endif
@@ -1313,6 +1313,54 @@ btor_bv_get_num_leading_ones (const BtorBitVector *bv)
 #endif
 }
 
+#ifndef BTOR_USE_GMP
+static inline uint32_t
+popcount_limb (BTOR_BV_TYPE limb)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount (limb);
+#else
+  limb = limb - ((limb >> 1) & 0x55555555u);
+  limb = (limb & 0x33333333u) + ((limb >> 2) & 0x33333333u);
+  limb = (limb + (limb >> 4)) & 0x0f0f0f0fu;
+  return (limb * 0x01010101u) >> 24;
+#endif
+}
+#endif
+
+uint32_t
+btor_bv_get_num_ones (const BtorBitVector *bv)
+{
+  assert (bv);
+
+#ifdef BTOR_USE_GMP
+  return mpz_popcount (bv->val);
+#else
+  uint32_t i, res;
+  for (i = 0, res = 0; i < bv->len; i++) res += popcount_limb (bv->bits[i]);
+  return res;
+#endif
+}
+
+uint32_t
+btor_bv_hamming_distance (const BtorBitVector *a, const BtorBitVector *b)
+{
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+
+#ifdef BTOR_USE_GMP
+  return mpz_hamdist (a->val, b->val);
+#else
+  assert (a->len == b->len);
+  uint32_t i, res;
+  /* word-wise xor and popcount, no intermediate bit-vectors */
+  for (i = 0, res = 0; i < a->len; i++)
+    res += popcount_limb (a->bits[i] ^ b->bits[i]);
+  return res;
+#endif
+}
+
 /*------------------------------------------------------------------------*/
 
 BtorBitVector *
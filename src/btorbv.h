@@ -162,6 +162,11 @@ uint32_t btor_bv_get_num_trailing_zeros (const BtorBitVector *bv);
 uint32_t btor_bv_get_num_leading_zeros (const BtorBitVector *bv);
 /* count leading ones (starting from MSB) */
 uint32_t btor_bv_get_num_leading_ones (const BtorBitVector *bv);
+/* count bits set to 1 */
+uint32_t btor_bv_get_num_ones (const BtorBitVector *bv);
+/* count bits in which given bit-vectors (of same bit-width) differ */
+uint32_t btor_bv_hamming_distance (const BtorBitVector *a,
+                                   const BtorBitVector *b);
 
 /*------------------------------------------------------------------------*/
 
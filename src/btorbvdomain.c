@@ -0,0 +1,1179 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorbvdomain.h"
+
+#include "btorcore.h"
+#include "btorlog.h"
+#include "utils/btorutil.h"
+
+/* maximum number of forward/backward propagation rounds */
+#define BTOR_BVDOMAIN_MAX_ROUNDS 16
+
+/*------------------------------------------------------------------------*/
+
+static void
+set_bv (BtorMemMgr *mm, BtorBitVector **dst, BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  btor_bv_free (mm, *dst);
+  *dst = bv;
+}
+
+static BtorBitVector *
+bv_umin (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_copy (mm, btor_bv_compare (a, b) <= 0 ? a : b);
+}
+
+static BtorBitVector *
+bv_umax (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_copy (mm, btor_bv_compare (a, b) >= 0 ? a : b);
+}
+
+/* Create bit-vector of given width with the 'n' least significant bits set
+ * to zero and all other bits set to one. */
+static BtorBitVector *
+bv_clear_low_bits (BtorMemMgr *mm, uint32_t width, uint32_t n)
+{
+  BtorBitVector *ones, *res;
+
+  if (n >= width) return btor_bv_new (mm, width);
+  ones = btor_bv_ones (mm, width);
+  res  = btor_bv_sll_uint64 (mm, ones, n);
+  btor_bv_free (mm, ones);
+  return res;
+}
+
+/* Determine the smallest value >= 'bv' (if 'ge') or the greatest value <= 'bv'
+ * (if !'ge') that is consistent with the known bits of 'd'.
+ * Returns 0 if there is no such value. */
+static BtorBitVector *
+next_consistent (BtorMemMgr *mm, BtorBvDomain *d, BtorBitVector *bv, bool ge)
+{
+  int64_t i, j;
+  uint32_t b, width, fixed1, fixed0;
+  BtorBitVector *res;
+
+  width = btor_bv_get_width (bv);
+  res   = btor_bv_copy (mm, bv);
+
+  /* bits above the first conflicting bit (from the MSB) are consistent */
+  for (i = width - 1; i >= 0; i--)
+  {
+    b      = btor_bv_get_bit (bv, i);
+    fixed1 = btor_bv_get_bit (d->lo, i);
+    fixed0 = !btor_bv_get_bit (d->hi, i);
+    if ((fixed1 && !b) || (fixed0 && b)) break;
+  }
+  if (i < 0) return res;
+
+  if ((ge && fixed1) || (!ge && fixed0))
+  {
+    /* flipping the conflicting bit moves into the right direction */
+    btor_bv_set_bit (res, i, !b);
+  }
+  else
+  {
+    /* flip the lowest unfixed bit above that moves into the right direction */
+    for (j = i + 1; j < width; j++)
+    {
+      if (btor_bv_get_bit (bv, j) == (ge ? 0 : 1)
+          && btor_bv_get_bit (d->lo, j) != btor_bv_get_bit (d->hi, j))
+        break;
+    }
+    if (j == width)
+    {
+      btor_bv_free (mm, res);
+      return 0;
+    }
+    btor_bv_set_bit (res, j, ge);
+    i = j;
+  }
+  /* bits below are set to their minimum (maximum) consistent value */
+  for (j = i - 1; j >= 0; j--)
+    btor_bv_set_bit (res, j, btor_bv_get_bit (ge ? d->lo : d->hi, j));
+  return res;
+}
+
+/* Make known bits and interval consistent with each other. */
+static void
+tighten (BtorMemMgr *mm, BtorBvDomain *d)
+{
+  uint32_t i, n, width;
+  BtorBitVector *x, *mask, *nmask, *tmp;
+
+  width = btor_bv_get_width (d->lo);
+  for (i = 0; i < 2; i++)
+  {
+    if (btor_bv_compare (d->min, d->max) > 0) return;
+    x = btor_bv_and (mm, d->lo, d->hi);
+    if (btor_bv_compare (x, d->lo))
+    {
+      /* conflicting known bits */
+      btor_bv_free (mm, x);
+      return;
+    }
+    btor_bv_free (mm, x);
+
+    tmp = next_consistent (mm, d, d->min, true);
+    x   = next_consistent (mm, d, d->max, false);
+    if (!tmp || !x)
+    {
+      /* no value consistent with the known bits in [min, max] */
+      set_bv (mm, &d->min, btor_bv_ones (mm, width));
+      set_bv (mm, &d->max, btor_bv_new (mm, width));
+      if (tmp) btor_bv_free (mm, tmp);
+      if (x) btor_bv_free (mm, x);
+      return;
+    }
+    set_bv (mm, &d->min, tmp);
+    set_bv (mm, &d->max, x);
+    if (btor_bv_compare (d->min, d->max) > 0) return;
+
+    /* the n most significant bits of all values in [min, max] are equal */
+    x = btor_bv_xor (mm, d->min, d->max);
+    n = btor_bv_get_num_leading_zeros (x);
+    btor_bv_free (mm, x);
+    if (n == 0) return;
+
+    mask  = bv_clear_low_bits (mm, width, width - n);
+    nmask = btor_bv_not (mm, mask);
+    tmp   = btor_bv_and (mm, d->min, mask);
+    set_bv (mm, &d->lo, btor_bv_or (mm, d->lo, tmp));
+    btor_bv_free (mm, tmp);
+    tmp = btor_bv_or (mm, d->min, nmask);
+    set_bv (mm, &d->hi, btor_bv_and (mm, d->hi, tmp));
+    btor_bv_free (mm, tmp);
+    btor_bv_free (mm, mask);
+    btor_bv_free (mm, nmask);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+BtorBvDomain *
+btor_bvdomain_new_init (BtorMemMgr *mm, uint32_t width)
+{
+  assert (mm);
+  assert (width);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_new (mm, width);
+  res->hi  = btor_bv_ones (mm, width);
+  res->min = btor_bv_new (mm, width);
+  res->max = btor_bv_ones (mm, width);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_new_fixed (BtorMemMgr *mm, const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (bv);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_copy (mm, bv);
+  res->hi  = btor_bv_copy (mm, bv);
+  res->min = btor_bv_copy (mm, bv);
+  res->max = btor_bv_copy (mm, bv);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_copy (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_copy (mm, d->lo);
+  res->hi  = btor_bv_copy (mm, d->hi);
+  res->min = btor_bv_copy (mm, d->min);
+  res->max = btor_bv_copy (mm, d->max);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_not (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_not (mm, d->hi);
+  res->hi  = btor_bv_not (mm, d->lo);
+  res->min = btor_bv_not (mm, d->max);
+  res->max = btor_bv_not (mm, d->min);
+  return res;
+}
+
+void
+btor_bvdomain_free (BtorMemMgr *mm, BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  btor_bv_free (mm, d->lo);
+  btor_bv_free (mm, d->hi);
+  btor_bv_free (mm, d->min);
+  btor_bv_free (mm, d->max);
+  BTOR_DELETE (mm, d);
+}
+
+uint32_t
+btor_bvdomain_get_width (const BtorBvDomain *d)
+{
+  assert (d);
+  return btor_bv_get_width (d->lo);
+}
+
+bool
+btor_bvdomain_is_valid (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  bool res;
+  BtorBitVector *nhi, *conflict;
+
+  nhi      = btor_bv_not (mm, d->hi);
+  conflict = btor_bv_and (mm, d->lo, nhi);
+  res      = btor_bv_is_zero (conflict) && btor_bv_compare (d->min, d->max) <= 0
+        && btor_bv_compare (d->lo, d->max) <= 0
+        && btor_bv_compare (d->min, d->hi) <= 0;
+  btor_bv_free (mm, conflict);
+  btor_bv_free (mm, nhi);
+  return res;
+}
+
+bool
+btor_bvdomain_is_fixed (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+  (void) mm;
+  /* fixed intervals are reflected in the known bits via tighten */
+  return btor_bv_compare (d->lo, d->hi) == 0;
+}
+
+bool
+btor_bvdomain_check_value (BtorMemMgr *mm,
+                           const BtorBvDomain *d,
+                           const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (d);
+  assert (bv);
+  assert (btor_bv_get_width (bv) == btor_bvdomain_get_width (d));
+
+  bool res;
+  BtorBitVector *and_lo, *or_hi;
+
+  and_lo = btor_bv_and (mm, bv, d->lo);
+  or_hi  = btor_bv_or (mm, bv, d->hi);
+  res    = btor_bv_compare (and_lo, d->lo) == 0
+        && btor_bv_compare (or_hi, d->hi) == 0
+        && btor_bv_compare (d->min, bv) <= 0
+        && btor_bv_compare (bv, d->max) <= 0;
+  btor_bv_free (mm, and_lo);
+  btor_bv_free (mm, or_hi);
+  return res;
+}
+
+bool
+btor_bvdomain_intersect (BtorMemMgr *mm,
+                         BtorBvDomain *d,
+                         const BtorBvDomain *other)
+{
+  assert (mm);
+  assert (d);
+  assert (other);
+  assert (btor_bvdomain_get_width (d) == btor_bvdomain_get_width (other));
+
+  bool res = false;
+  BtorBitVector *tmp;
+
+  tmp = btor_bv_or (mm, d->lo, other->lo);
+  if (btor_bv_compare (tmp, d->lo))
+  {
+    set_bv (mm, &d->lo, tmp);
+    res = true;
+  }
+  else
+    btor_bv_free (mm, tmp);
+
+  tmp = btor_bv_and (mm, d->hi, other->hi);
+  if (btor_bv_compare (tmp, d->hi))
+  {
+    set_bv (mm, &d->hi, tmp);
+    res = true;
+  }
+  else
+    btor_bv_free (mm, tmp);
+
+  if (btor_bv_compare (other->min, d->min) > 0)
+  {
+    set_bv (mm, &d->min, btor_bv_copy (mm, other->min));
+    res = true;
+  }
+  if (btor_bv_compare (other->max, d->max) < 0)
+  {
+    set_bv (mm, &d->max, btor_bv_copy (mm, other->max));
+    res = true;
+  }
+
+  if (res) tighten (mm, d);
+  return res;
+}
+
+bool
+btor_bvdomain_exclude (BtorMemMgr *mm,
+                       BtorBvDomain *d,
+                       const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (d);
+  assert (bv);
+  assert (btor_bv_get_width (bv) == btor_bvdomain_get_width (d));
+
+  if (btor_bv_compare (d->min, d->max) >= 0) return false;
+
+  if (!btor_bv_compare (bv, d->min))
+    set_bv (mm, &d->min, btor_bv_inc (mm, d->min));
+  else if (!btor_bv_compare (bv, d->max))
+    set_bv (mm, &d->max, btor_bv_dec (mm, d->max));
+  else
+    return false;
+  tighten (mm, d);
+  assert (btor_bvdomain_is_valid (mm, d));
+  return true;
+}
+
+BtorBitVector *
+btor_bvdomain_project (BtorMemMgr *mm,
+                       const BtorBvDomain *d,
+                       const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (d);
+  assert (bv);
+  assert (btor_bv_get_width (bv) == btor_bvdomain_get_width (d));
+  assert (btor_bvdomain_is_valid (mm, d));
+
+  BtorBitVector *tmp, *res;
+
+  tmp = btor_bv_or (mm, bv, d->lo);
+  res = btor_bv_and (mm, tmp, d->hi);
+  btor_bv_free (mm, tmp);
+
+  /* the bounds are consistent with the known bits (see tighten) */
+  if (btor_bv_compare (res, d->min) < 0)
+    set_bv (mm, &res, btor_bv_copy (mm, d->min));
+  else if (btor_bv_compare (res, d->max) > 0)
+    set_bv (mm, &res, btor_bv_copy (mm, d->max));
+  assert (btor_bvdomain_check_value (mm, d, res));
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_leaf (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (exp->parameterized) return true;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_CONCAT_NODE: return false;
+    case BTOR_COND_NODE: return !btor_sort_is_bv (btor, exp->sort_id);
+    default: return true;
+  }
+}
+
+static BtorBvDomain *
+get_domain (BtorIntHashTable *domains, BtorNode *exp)
+{
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (domains, btor_node_real_addr (exp)->id);
+  assert (d);
+  return d->as_ptr;
+}
+
+/* Narrow domain of (possibly inverted) 'exp' with 'd' and free 'd'. */
+static bool
+narrow (BtorMemMgr *mm,
+        BtorIntHashTable *domains,
+        BtorNode *exp,
+        BtorBvDomain *d)
+{
+  bool res;
+  BtorBvDomain *tmp;
+
+  if (btor_node_is_inverted (exp))
+  {
+    tmp = btor_bvdomain_not (mm, d);
+    btor_bvdomain_free (mm, d);
+    d = tmp;
+  }
+  res = btor_bvdomain_intersect (mm, get_domain (domains, exp), d);
+  btor_bvdomain_free (mm, d);
+  return res;
+}
+
+static BtorBvDomain *
+new_bool (BtorMemMgr *mm, bool value)
+{
+  BtorBitVector *bv;
+  BtorBvDomain *res;
+
+  bv  = value ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1);
+  res = btor_bvdomain_new_fixed (mm, bv);
+  btor_bv_free (mm, bv);
+  return res;
+}
+
+static BtorBvDomain *
+new_empty (BtorMemMgr *mm, uint32_t width)
+{
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, width);
+  set_bv (mm, &res->min, btor_bv_ones (mm, width));
+  set_bv (mm, &res->max, btor_bv_new (mm, width));
+  return res;
+}
+
+/* Value of a fixed domain of bit-width 1 (or -1 if not fixed). */
+static int32_t
+bool_value (BtorMemMgr *mm, BtorBvDomain *d)
+{
+  assert (btor_bvdomain_get_width (d) == 1);
+  if (!btor_bvdomain_is_fixed (mm, d)) return -1;
+  return btor_bv_is_true (d->lo) ? 1 : 0;
+}
+
+/*------------------------------------------------------------------------*/
+/* forward propagation                                                    */
+/*------------------------------------------------------------------------*/
+
+static BtorBvDomain *
+fwd_and (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  set_bv (mm, &res->lo, btor_bv_and (mm, d0->lo, d1->lo));
+  set_bv (mm, &res->hi, btor_bv_and (mm, d0->hi, d1->hi));
+  set_bv (mm, &res->max, bv_umin (mm, d0->max, d1->max));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_eq (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  bool conflict;
+  BtorBitVector *n0, *n1, *c0, *c1;
+
+  if (btor_bvdomain_is_fixed (mm, d0) && btor_bvdomain_is_fixed (mm, d1))
+    return new_bool (mm, btor_bv_compare (d0->lo, d1->lo) == 0);
+
+  n0       = btor_bv_not (mm, d0->hi);
+  n1       = btor_bv_not (mm, d1->hi);
+  c0       = btor_bv_and (mm, d0->lo, n1);
+  c1       = btor_bv_and (mm, d1->lo, n0);
+  conflict = !btor_bv_is_zero (c0) || !btor_bv_is_zero (c1)
+             || btor_bv_compare (d0->max, d1->min) < 0
+             || btor_bv_compare (d1->max, d0->min) < 0;
+  btor_bv_free (mm, n0);
+  btor_bv_free (mm, n1);
+  btor_bv_free (mm, c0);
+  btor_bv_free (mm, c1);
+
+  if (conflict) return new_bool (mm, false);
+  return btor_bvdomain_new_init (mm, 1);
+}
+
+static BtorBvDomain *
+fwd_ult (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  if (btor_bv_compare (d0->max, d1->min) < 0) return new_bool (mm, true);
+  if (btor_bv_compare (d0->min, d1->max) >= 0) return new_bool (mm, false);
+  return btor_bvdomain_new_init (mm, 1);
+}
+
+static BtorBvDomain *
+fwd_add (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  bool ovf_min, ovf_max;
+  BtorBitVector *sum_zero, *sum_one, *carry_zero, *carry_one, *known;
+  BtorBitVector *known0, *known1, *tmp0, *tmp1, *smin, *smax;
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+
+  /* known bits: a carry into a bit is known if the sums of the minimum and
+   * maximum values of the known bits agree on it */
+  sum_zero = btor_bv_add (mm, d0->hi, d1->hi);
+  sum_one  = btor_bv_add (mm, d0->lo, d1->lo);
+
+  tmp0       = btor_bv_xor (mm, sum_zero, d0->hi);
+  tmp1       = btor_bv_xor (mm, tmp0, d1->hi);
+  carry_zero = btor_bv_not (mm, tmp1);
+  btor_bv_free (mm, tmp0);
+  btor_bv_free (mm, tmp1);
+
+  tmp0      = btor_bv_xor (mm, sum_one, d0->lo);
+  carry_one = btor_bv_xor (mm, tmp0, d1->lo);
+  btor_bv_free (mm, tmp0);
+
+  tmp0   = btor_bv_not (mm, d0->hi);
+  known0 = btor_bv_or (mm, tmp0, d0->lo);
+  btor_bv_free (mm, tmp0);
+  tmp0   = btor_bv_not (mm, d1->hi);
+  known1 = btor_bv_or (mm, tmp0, d1->lo);
+  btor_bv_free (mm, tmp0);
+
+  tmp0  = btor_bv_or (mm, carry_zero, carry_one);
+  tmp1  = btor_bv_and (mm, known0, known1);
+  known = btor_bv_and (mm, tmp0, tmp1);
+  btor_bv_free (mm, tmp0);
+  btor_bv_free (mm, tmp1);
+
+  set_bv (mm, &res->lo, btor_bv_and (mm, sum_one, known));
+  tmp0 = btor_bv_not (mm, known);
+  set_bv (mm, &res->hi, btor_bv_or (mm, sum_zero, tmp0));
+  btor_bv_free (mm, tmp0);
+
+  btor_bv_free (mm, sum_zero);
+  btor_bv_free (mm, sum_one);
+  btor_bv_free (mm, carry_zero);
+  btor_bv_free (mm, carry_one);
+  btor_bv_free (mm, known0);
+  btor_bv_free (mm, known1);
+  btor_bv_free (mm, known);
+
+  /* interval: valid if both or none of the bounds overflow */
+  smin    = btor_bv_add (mm, d0->min, d1->min);
+  smax    = btor_bv_add (mm, d0->max, d1->max);
+  ovf_min = btor_bv_compare (smin, d0->min) < 0;
+  ovf_max = btor_bv_compare (smax, d0->max) < 0;
+  if (ovf_min == ovf_max)
+  {
+    set_bv (mm, &res->min, smin);
+    set_bv (mm, &res->max, smax);
+  }
+  else
+  {
+    btor_bv_free (mm, smin);
+    btor_bv_free (mm, smax);
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_mul (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  uint32_t width, tz;
+  BtorBvDomain *res;
+
+  width = btor_bvdomain_get_width (d0);
+  res   = btor_bvdomain_new_init (mm, width);
+
+  tz = btor_bv_get_num_trailing_zeros (d0->hi);
+  tz += btor_bv_get_num_trailing_zeros (d1->hi);
+  if (tz) set_bv (mm, &res->hi, bv_clear_low_bits (mm, width, tz));
+
+  if (!btor_bv_is_umulo (mm, d0->max, d1->max))
+  {
+    set_bv (mm, &res->min, btor_bv_mul (mm, d0->min, d1->min));
+    set_bv (mm, &res->max, btor_bv_mul (mm, d0->max, d1->max));
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_udiv (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  /* division by zero yields ~0, which is an upper bound anyways */
+  set_bv (mm, &res->min, btor_bv_udiv (mm, d0->min, d1->max));
+  if (!btor_bv_is_zero (d1->min))
+    set_bv (mm, &res->max, btor_bv_udiv (mm, d0->max, d1->min));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_urem (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBitVector *max;
+  BtorBvDomain *res;
+
+  /* a < b implies a % b = a */
+  if (btor_bv_compare (d0->max, d1->min) < 0)
+    return btor_bvdomain_copy (mm, d0);
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+  set_bv (mm, &res->max, btor_bv_copy (mm, d0->max));
+  if (!btor_bv_is_zero (d1->min))
+  {
+    max = btor_bv_dec (mm, d1->max);
+    if (btor_bv_compare (max, res->max) < 0)
+      set_bv (mm, &res->max, max);
+    else
+      btor_bv_free (mm, max);
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_sll (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  uint32_t width;
+  BtorBitVector *max, *tmp;
+  BtorBvDomain *res;
+
+  width = btor_bvdomain_get_width (d0);
+  res   = btor_bvdomain_new_init (mm, width);
+
+  if (btor_bvdomain_is_fixed (mm, d1))
+  {
+    set_bv (mm, &res->lo, btor_bv_sll (mm, d0->lo, d1->lo));
+    set_bv (mm, &res->hi, btor_bv_sll (mm, d0->hi, d1->lo));
+    max = btor_bv_sll (mm, d0->max, d1->lo);
+    tmp = btor_bv_srl (mm, max, d1->lo);
+    if (btor_bv_compare (tmp, d0->max) == 0)
+    {
+      set_bv (mm, &res->min, btor_bv_sll (mm, d0->min, d1->lo));
+      set_bv (mm, &res->max, max);
+    }
+    else
+      btor_bv_free (mm, max);
+    btor_bv_free (mm, tmp);
+  }
+  else
+  {
+    set_bv (mm,
+            &res->hi,
+            bv_clear_low_bits (
+                mm, width, btor_bv_get_num_trailing_zeros (d0->hi)));
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_srl (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  res = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (d0));
+
+  if (btor_bvdomain_is_fixed (mm, d1))
+  {
+    set_bv (mm, &res->lo, btor_bv_srl (mm, d0->lo, d1->lo));
+    set_bv (mm, &res->hi, btor_bv_srl (mm, d0->hi, d1->lo));
+    set_bv (mm, &res->min, btor_bv_srl (mm, d0->min, d1->lo));
+    set_bv (mm, &res->max, btor_bv_srl (mm, d0->max, d1->lo));
+  }
+  else
+    set_bv (mm, &res->max, btor_bv_copy (mm, d0->max));
+  return res;
+}
+
+static BtorBvDomain *
+fwd_concat (BtorMemMgr *mm, BtorBvDomain *d0, BtorBvDomain *d1)
+{
+  BtorBvDomain *res;
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_concat (mm, d0->lo, d1->lo);
+  res->hi  = btor_bv_concat (mm, d0->hi, d1->hi);
+  res->min = btor_bv_concat (mm, d0->min, d1->min);
+  res->max = btor_bv_concat (mm, d0->max, d1->max);
+  return res;
+}
+
+static BtorBvDomain *
+fwd_slice (BtorMemMgr *mm, BtorBvDomain *d0, uint32_t upper, uint32_t lower)
+{
+  uint32_t width;
+  BtorBvDomain *res;
+
+  width = btor_bvdomain_get_width (d0);
+  res   = btor_bvdomain_new_init (mm, upper - lower + 1);
+  set_bv (mm, &res->lo, btor_bv_slice (mm, d0->lo, upper, lower));
+  set_bv (mm, &res->hi, btor_bv_slice (mm, d0->hi, upper, lower));
+
+  /* the interval of the lower bits is preserved if the upper bits are 0 */
+  if (lower == 0
+      && btor_bv_get_num_leading_zeros (d0->max) >= width - 1 - upper)
+  {
+    set_bv (mm, &res->min, btor_bv_slice (mm, d0->min, upper, lower));
+    set_bv (mm, &res->max, btor_bv_slice (mm, d0->max, upper, lower));
+  }
+  return res;
+}
+
+static BtorBvDomain *
+fwd_cond (BtorMemMgr *mm, BtorBvDomain *dc, BtorBvDomain *d1, BtorBvDomain *d2)
+{
+  int32_t c;
+  BtorBvDomain *res;
+
+  if ((c = bool_value (mm, dc)) != -1)
+    return btor_bvdomain_copy (mm, c ? d1 : d2);
+
+  BTOR_CNEW (mm, res);
+  res->lo  = btor_bv_and (mm, d1->lo, d2->lo);
+  res->hi  = btor_bv_or (mm, d1->hi, d2->hi);
+  res->min = bv_umin (mm, d1->min, d2->min);
+  res->max = bv_umax (mm, d1->max, d2->max);
+  return res;
+}
+
+static BtorBvDomain *
+forward (Btor *btor, BtorIntHashTable *domains, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorBvDomain *d[3], *res;
+
+  mm = btor->mm;
+
+  if (btor_node_is_bv_const (exp))
+    return btor_bvdomain_new_fixed (mm, btor_node_bv_const_get_bits (exp));
+  if (is_leaf (btor, exp))
+    return btor_bvdomain_new_init (mm, btor_node_bv_get_width (btor, exp));
+
+  for (i = 0; i < exp->arity; i++)
+    d[i] = btor_bvdomain_get (mm, domains, exp->e[i]);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE: res = fwd_and (mm, d[0], d[1]); break;
+    case BTOR_BV_EQ_NODE: res = fwd_eq (mm, d[0], d[1]); break;
+    case BTOR_BV_ULT_NODE: res = fwd_ult (mm, d[0], d[1]); break;
+    case BTOR_BV_ADD_NODE: res = fwd_add (mm, d[0], d[1]); break;
+    case BTOR_BV_MUL_NODE: res = fwd_mul (mm, d[0], d[1]); break;
+    case BTOR_BV_UDIV_NODE: res = fwd_udiv (mm, d[0], d[1]); break;
+    case BTOR_BV_UREM_NODE: res = fwd_urem (mm, d[0], d[1]); break;
+    case BTOR_BV_SLL_NODE: res = fwd_sll (mm, d[0], d[1]); break;
+    case BTOR_BV_SRL_NODE: res = fwd_srl (mm, d[0], d[1]); break;
+    case BTOR_BV_CONCAT_NODE: res = fwd_concat (mm, d[0], d[1]); break;
+    case BTOR_BV_SLICE_NODE:
+      res = fwd_slice (mm,
+                       d[0],
+                       btor_node_bv_slice_get_upper (exp),
+                       btor_node_bv_slice_get_lower (exp));
+      break;
+    default:
+      assert (exp->kind == BTOR_COND_NODE);
+      res = fwd_cond (mm, d[0], d[1], d[2]);
+  }
+
+  for (i = 0; i < exp->arity; i++) btor_bvdomain_free (mm, d[i]);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* backward propagation                                                   */
+/*------------------------------------------------------------------------*/
+
+static bool
+bwd_and (BtorMemMgr *mm,
+         BtorIntHashTable *domains,
+         BtorNode *exp,
+         BtorBvDomain *r,
+         BtorBvDomain **d)
+{
+  uint32_t i;
+  bool res = false;
+  BtorBitVector *tmp;
+  BtorBvDomain *nd;
+
+  for (i = 0; i < 2; i++)
+  {
+    /* bits that are 1 in the result are 1 in both operands, bits that are 0
+     * in the result are 0 in an operand if they are 1 in the other one */
+    nd = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (r));
+    set_bv (mm, &nd->lo, btor_bv_copy (mm, r->lo));
+    tmp = btor_bv_not (mm, d[1 - i]->lo);
+    set_bv (mm, &nd->hi, btor_bv_or (mm, r->hi, tmp));
+    btor_bv_free (mm, tmp);
+    set_bv (mm, &nd->min, btor_bv_copy (mm, r->min));
+    res |= narrow (mm, domains, exp->e[i], nd);
+  }
+  return res;
+}
+
+static bool
+bwd_ult (BtorMemMgr *mm,
+         BtorIntHashTable *domains,
+         BtorNode *exp,
+         BtorBvDomain *r,
+         BtorBvDomain **d)
+{
+  int32_t val;
+  uint32_t width;
+  bool res = false;
+  BtorBvDomain *nd0, *nd1;
+
+  if ((val = bool_value (mm, r)) == -1) return false;
+
+  width = btor_bvdomain_get_width (d[0]);
+  if (val)
+  {
+    /* a < b: a <= max (b) - 1, b >= min (a) + 1 */
+    if (btor_bv_is_zero (d[1]->max) || btor_bv_is_ones (d[0]->min))
+    {
+      nd0 = new_empty (mm, width);
+      nd1 = new_empty (mm, width);
+    }
+    else
+    {
+      nd0 = btor_bvdomain_new_init (mm, width);
+      nd1 = btor_bvdomain_new_init (mm, width);
+      set_bv (mm, &nd0->max, btor_bv_dec (mm, d[1]->max));
+      set_bv (mm, &nd1->min, btor_bv_inc (mm, d[0]->min));
+    }
+  }
+  else
+  {
+    /* a >= b: a >= min (b), b <= max (a) */
+    nd0 = btor_bvdomain_new_init (mm, width);
+    nd1 = btor_bvdomain_new_init (mm, width);
+    set_bv (mm, &nd0->min, btor_bv_copy (mm, d[1]->min));
+    set_bv (mm, &nd1->max, btor_bv_copy (mm, d[0]->max));
+  }
+  res |= narrow (mm, domains, exp->e[0], nd0);
+  res |= narrow (mm, domains, exp->e[1], nd1);
+  return res;
+}
+
+static bool
+bwd_add (BtorMemMgr *mm,
+         BtorIntHashTable *domains,
+         BtorNode *exp,
+         BtorBvDomain *r,
+         BtorBvDomain **d)
+{
+  uint32_t i;
+  bool res = false;
+  BtorBitVector *c;
+  BtorBvDomain *nd;
+
+  for (i = 0; i < 2; i++)
+  {
+    if (!btor_bvdomain_is_fixed (mm, d[1 - i])) continue;
+    /* a + c in [min, max] with c <= min: a in [min - c, max - c] */
+    c = d[1 - i]->lo;
+    if (btor_bv_compare (r->min, c) < 0) continue;
+    nd = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (r));
+    set_bv (mm, &nd->min, btor_bv_sub (mm, r->min, c));
+    set_bv (mm, &nd->max, btor_bv_sub (mm, r->max, c));
+    res |= narrow (mm, domains, exp->e[i], nd);
+  }
+  return res;
+}
+
+static bool
+bwd_concat (BtorMemMgr *mm,
+            BtorIntHashTable *domains,
+            BtorNode *exp,
+            BtorBvDomain *r,
+            BtorBvDomain **d)
+{
+  uint32_t width, width1;
+  bool res = false;
+  BtorBvDomain *nd;
+
+  width  = btor_bvdomain_get_width (r);
+  width1 = btor_bvdomain_get_width (d[1]);
+
+  BTOR_CNEW (mm, nd);
+  nd->lo  = btor_bv_slice (mm, r->lo, width - 1, width1);
+  nd->hi  = btor_bv_slice (mm, r->hi, width - 1, width1);
+  nd->min = btor_bv_slice (mm, r->min, width - 1, width1);
+  nd->max = btor_bv_slice (mm, r->max, width - 1, width1);
+  res |= narrow (mm, domains, exp->e[0], nd);
+
+  nd = btor_bvdomain_new_init (mm, width1);
+  set_bv (mm, &nd->lo, btor_bv_slice (mm, r->lo, width1 - 1, 0));
+  set_bv (mm, &nd->hi, btor_bv_slice (mm, r->hi, width1 - 1, 0));
+  res |= narrow (mm, domains, exp->e[1], nd);
+  return res;
+}
+
+static bool
+bwd_slice (BtorMemMgr *mm,
+           BtorIntHashTable *domains,
+           BtorNode *exp,
+           BtorBvDomain *r,
+           BtorBvDomain **d)
+{
+  uint32_t width, rwidth, lower;
+  BtorBitVector *tmp0, *tmp1, *tmp2;
+  BtorBvDomain *nd;
+
+  width  = btor_bvdomain_get_width (d[0]);
+  rwidth = btor_bvdomain_get_width (r);
+  lower  = btor_node_bv_slice_get_lower (exp);
+
+  nd   = btor_bvdomain_new_init (mm, width);
+  tmp0 = btor_bv_uext (mm, r->lo, width - rwidth);
+  set_bv (mm, &nd->lo, btor_bv_sll_uint64 (mm, tmp0, lower));
+  btor_bv_free (mm, tmp0);
+
+  tmp0 = btor_bv_not (mm, r->hi);
+  tmp1 = btor_bv_uext (mm, tmp0, width - rwidth);
+  tmp2 = btor_bv_sll_uint64 (mm, tmp1, lower);
+  set_bv (mm, &nd->hi, btor_bv_not (mm, tmp2));
+  btor_bv_free (mm, tmp0);
+  btor_bv_free (mm, tmp1);
+  btor_bv_free (mm, tmp2);
+
+  return narrow (mm, domains, exp->e[0], nd);
+}
+
+static bool
+bwd_cond (BtorMemMgr *mm,
+          BtorIntHashTable *domains,
+          BtorNode *exp,
+          BtorBvDomain *r,
+          BtorBvDomain **d)
+{
+  int32_t c;
+  uint32_t i;
+  bool res = false;
+  BtorBvDomain *tmp;
+
+  if ((c = bool_value (mm, d[0])) != -1)
+    return narrow (mm, domains, exp->e[c ? 1 : 2], btor_bvdomain_copy (mm, r));
+
+  /* a branch that is disjoint with the result can not be selected */
+  for (i = 1; i < 3; i++)
+  {
+    tmp = btor_bvdomain_copy (mm, d[i]);
+    btor_bvdomain_intersect (mm, tmp, r);
+    if (!btor_bvdomain_is_valid (mm, tmp))
+      res |= narrow (mm, domains, exp->e[0], new_bool (mm, i == 2));
+    btor_bvdomain_free (mm, tmp);
+  }
+  return res;
+}
+
+/* Propagate domain of 'exp' to its children, returns true if the domain of
+ * some child changed. */
+static bool
+backward (Btor *btor, BtorIntHashTable *domains, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i;
+  bool res = false;
+  BtorMemMgr *mm;
+  BtorBvDomain *d[3], *r, *nd;
+
+  if (is_leaf (btor, exp)) return false;
+
+  mm = btor->mm;
+  r  = get_domain (domains, exp);
+  for (i = 0; i < exp->arity; i++)
+    d[i] = btor_bvdomain_get (mm, domains, exp->e[i]);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE: res = bwd_and (mm, domains, exp, r, d); break;
+    case BTOR_BV_EQ_NODE:
+      if (bool_value (mm, r) == 1)
+      {
+        res |= narrow (mm, domains, exp->e[0], btor_bvdomain_copy (mm, d[1]));
+        res |= narrow (mm, domains, exp->e[1], btor_bvdomain_copy (mm, d[0]));
+      }
+      else if (bool_value (mm, r) == 0 && btor_bvdomain_get_width (d[0]) == 1)
+      {
+        /* a != b on bit-width 1: a = ~b */
+        res |= narrow (mm, domains, exp->e[0], btor_bvdomain_not (mm, d[1]));
+        res |= narrow (mm, domains, exp->e[1], btor_bvdomain_not (mm, d[0]));
+      }
+      break;
+    case BTOR_BV_ULT_NODE: res = bwd_ult (mm, domains, exp, r, d); break;
+    case BTOR_BV_ADD_NODE: res = bwd_add (mm, domains, exp, r, d); break;
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_SRL_NODE:
+      /* result is less than or equal to the first operand */
+      nd = btor_bvdomain_new_init (mm, btor_bvdomain_get_width (r));
+      set_bv (mm, &nd->min, btor_bv_copy (mm, r->min));
+      res = narrow (mm, domains, exp->e[0], nd);
+      break;
+    case BTOR_BV_CONCAT_NODE: res = bwd_concat (mm, domains, exp, r, d); break;
+    case BTOR_BV_SLICE_NODE: res = bwd_slice (mm, domains, exp, r, d); break;
+    case BTOR_COND_NODE: res = bwd_cond (mm, domains, exp, r, d); break;
+    default: break;
+  }
+
+  for (i = 0; i < exp->arity; i++) btor_bvdomain_free (mm, d[i]);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+all_valid (BtorMemMgr *mm, BtorIntHashTable *domains, BtorNodePtrStack *nodes)
+{
+  uint32_t i;
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    if (!btor_bvdomain_is_valid (
+            mm, get_domain (domains, BTOR_PEEK_STACK (*nodes, i))))
+      return false;
+  }
+  return true;
+}
+
+bool
+btor_bvdomain_compute (Btor *btor,
+                       BtorNodePtrStack *roots,
+                       BtorIntHashTable *domains)
+{
+  assert (btor);
+  assert (roots);
+  assert (domains);
+
+  bool res, changed;
+  uint32_t i, rounds;
+  BtorMemMgr *mm;
+  BtorNode *cur;
+  BtorNodePtrStack visit, nodes;
+  BtorIntHashTable *cache;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, nodes);
+  cache = btor_hashint_table_new (mm);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (*roots, i));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    assert (btor_sort_is_bv (btor, cur->sort_id));
+    /* keep given initial domains */
+    if (!btor_hashint_map_contains (domains, cur->id))
+      btor_hashint_map_add (domains, cur->id)->as_ptr =
+          btor_bvdomain_new_init (mm, btor_node_bv_get_width (btor, cur));
+    BTOR_PUSH_STACK (nodes, cur);
+    if (is_leaf (btor, cur)) continue;
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  /* children have smaller ids than their parents */
+  qsort (nodes.start,
+         BTOR_COUNT_STACK (nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    narrow (mm, domains, BTOR_PEEK_STACK (*roots, i), new_bool (mm, true));
+
+  res    = all_valid (mm, domains, &nodes);
+  rounds = 0;
+  while (res && rounds++ < BTOR_BVDOMAIN_MAX_ROUNDS)
+  {
+    changed = false;
+    for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i);
+      changed |= narrow (mm, domains, cur, forward (btor, domains, cur));
+    }
+    for (i = BTOR_COUNT_STACK (nodes); i > 0; i--)
+      changed |= backward (btor, domains, BTOR_PEEK_STACK (nodes, i - 1));
+    res = all_valid (mm, domains, &nodes);
+    if (!changed) break;
+  }
+  BTORLOG (1, "bit-vector domains: %u rounds", rounds);
+
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (nodes);
+  BTOR_RELEASE_STACK (visit);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvdomain_get (BtorMemMgr *mm, BtorIntHashTable *domains, BtorNode *exp)
+{
+  assert (mm);
+  assert (domains);
+  assert (exp);
+
+  BtorHashTableData *d;
+
+  d = btor_hashint_map_get (domains, btor_node_real_addr (exp)->id);
+  if (!d) return 0;
+  if (btor_node_is_inverted (exp)) return btor_bvdomain_not (mm, d->as_ptr);
+  return btor_bvdomain_copy (mm, d->as_ptr);
+}
+
+static void
+clone_data_as_domain (BtorMemMgr *mm,
+                      const void *map,
+                      BtorHashTableData *data,
+                      BtorHashTableData *cloned_data)
+{
+  (void) map;
+  cloned_data->as_ptr = btor_bvdomain_copy (mm, data->as_ptr);
+}
+
+BtorIntHashTable *
+btor_bvdomain_clone_map (BtorMemMgr *mm, BtorIntHashTable *domains)
+{
+  assert (mm);
+  assert (domains);
+  return btor_hashint_map_clone (mm, domains, clone_data_as_domain, 0);
+}
+
+void
+btor_bvdomain_delete_map (BtorMemMgr *mm, BtorIntHashTable *domains)
+{
+  assert (mm);
+  assert (domains);
+
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, domains);
+  while (btor_iter_hashint_has_next (&it))
+    btor_bvdomain_free (mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (domains);
+}
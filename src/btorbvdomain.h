@@ -0,0 +1,120 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBVDOMAIN_H_INCLUDED
+#define BTORBVDOMAIN_H_INCLUDED
+
+#include "btorbv.h"
+#include "btornode.h"
+#include "btortypes.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * Abstract domain of a bit-vector value: the product of known bits and an
+ * unsigned interval.
+ *
+ * Bits set in 'lo' are fixed to 1, bits not set in 'hi' are fixed to 0.
+ * All values of the domain are in the interval ['min', 'max'].
+ */
+struct BtorBvDomain
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+  BtorBitVector *min;
+  BtorBitVector *max;
+};
+
+typedef struct BtorBvDomain BtorBvDomain;
+
+/* Create domain of given bit-width that contains all values. */
+BtorBvDomain *btor_bvdomain_new_init (BtorMemMgr *mm, uint32_t width);
+/* Create domain that contains the given value only. */
+BtorBvDomain *btor_bvdomain_new_fixed (BtorMemMgr *mm, const BtorBitVector *bv);
+/* Create a copy of given domain. */
+BtorBvDomain *btor_bvdomain_copy (BtorMemMgr *mm, const BtorBvDomain *d);
+/* Create the domain of the bit-wise negation of the values of 'd'. */
+BtorBvDomain *btor_bvdomain_not (BtorMemMgr *mm, const BtorBvDomain *d);
+
+void btor_bvdomain_free (BtorMemMgr *mm, BtorBvDomain *d);
+
+uint32_t btor_bvdomain_get_width (const BtorBvDomain *d);
+
+/* Return true if the domain contains at least one value. */
+bool btor_bvdomain_is_valid (BtorMemMgr *mm, const BtorBvDomain *d);
+/* Return true if the domain contains exactly one value. */
+bool btor_bvdomain_is_fixed (BtorMemMgr *mm, const BtorBvDomain *d);
+/* Return true if given value is contained in the domain. */
+bool btor_bvdomain_check_value (BtorMemMgr *mm,
+                                const BtorBvDomain *d,
+                                const BtorBitVector *bv);
+
+/**
+ * Narrow 'd' to the intersection of 'd' and 'other'.
+ * Returns true if 'd' changed.
+ */
+bool btor_bvdomain_intersect (BtorMemMgr *mm,
+                              BtorBvDomain *d,
+                              const BtorBvDomain *other);
+
+/**
+ * Remove 'bv' from 'd' if it is the lower or upper bound of the interval of
+ * 'd' and 'd' contains other values.
+ * Returns true if 'd' changed.
+ */
+bool btor_bvdomain_exclude (BtorMemMgr *mm,
+                            BtorBvDomain *d,
+                            const BtorBitVector *bv);
+
+/**
+ * Get the value of 'd' closest to 'bv': bits known in 'd' are overwritten,
+ * and the result is clamped to the interval of 'd'.
+ * 'd' must be valid.
+ */
+BtorBitVector *btor_bvdomain_project (BtorMemMgr *mm,
+                                      const BtorBvDomain *d,
+                                      const BtorBitVector *bv);
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * Compute the domains of all bit-vector nodes in the cones of given roots
+ * under the assumption that all roots are true.
+ *
+ * Domains are propagated forwards (from the inputs to the roots) and
+ * backwards (from the roots to the inputs) until fixed point or until a
+ * bounded number of rounds is reached.  Parameterized nodes and function
+ * applications are treated as inputs.
+ *
+ * 'domains' maps the ids of the regular nodes to their domains, and must be
+ * freed via btor_bvdomain_delete_map.  Domains already contained in
+ * 'domains' (e.g., known bits of inputs) are used as initial domains.
+ *
+ * Returns false if some domain becomes empty, i.e., if the roots are
+ * inconsistent.
+ */
+bool btor_bvdomain_compute (Btor *btor,
+                            BtorNodePtrStack *roots,
+                            BtorIntHashTable *domains);
+
+/**
+ * Get a copy of the domain of 'exp' in 'domains' (negated if 'exp' is
+ * inverted), or 0 if 'exp' has no domain.
+ */
+BtorBvDomain *btor_bvdomain_get (BtorMemMgr *mm,
+                                 BtorIntHashTable *domains,
+                                 BtorNode *exp);
+
+BtorIntHashTable *btor_bvdomain_clone_map (BtorMemMgr *mm,
+                                           BtorIntHashTable *domains);
+
+void btor_bvdomain_delete_map (BtorMemMgr *mm, BtorIntHashTable *domains);
+
+#endif
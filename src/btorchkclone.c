@@ -23,6 +23,8 @@
 
 #include "btorchkclone.h"
 
+#include <string.h>
+
 /*------------------------------------------------------------------------*/
 
 #define BTOR_CHKCLONE_EXPID(exp, clone)                                        \
@@ -42,15 +44,6 @@ cmp_data_as_int (const BtorHashTableData *d1, const BtorHashTableData *d2)
   return d1->as_int - d2->as_int;
 }
 
-static int32_t
-cmp_data_as_dbl (const BtorHashTableData *d1, const BtorHashTableData *d2)
-{
-  assert (d1);
-  assert (d2);
-
-  return d1->as_dbl == d2->as_dbl ? 0 : (d1->as_dbl > d2->as_dbl ? 1 : -1);
-}
-
 static int32_t
 cmp_data_as_bv_ptr (const BtorHashTableData *d1, const BtorHashTableData *d2)
 {
@@ -132,6 +125,23 @@ chkclone_int_hash_map (BtorIntHashTable *map,
   assert (i >= cmap->size);
 }
 
+static inline void
+chkclone_sls_score (BtorSLSScore *score, BtorSLSScore *cscore)
+{
+  uint32_t i;
+
+  if (!score)
+  {
+    assert (!cscore);
+    return;
+  }
+
+  assert (score != cscore);
+  assert (score->size == cscore->size);
+  for (i = 0; i < score->size; i++)
+    assert (score->scores[i] == cscore->scores[i]);
+}
+
 static inline void
 chkclone_node_ptr_hash_table (BtorPtrHashTable *table,
                               BtorPtrHashTable *ctable,
@@ -241,6 +251,11 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_STATS (gaussian_eliminations);
   BTOR_CHKCLONE_STATS (eliminated_slices);
   BTOR_CHKCLONE_STATS (skeleton_constraints);
+  BTOR_CHKCLONE_STATS (domain_constraints);
+  BTOR_CHKCLONE_STATS (width_reduced_vars);
+  BTOR_CHKCLONE_STATS (width_reduced_ops);
+  BTOR_CHKCLONE_STATS (xor_equations);
+  BTOR_CHKCLONE_STATS (xor_substitutions);
   BTOR_CHKCLONE_STATS (adds_normalized);
   BTOR_CHKCLONE_STATS (ands_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
@@ -248,6 +263,7 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_STATS (ackermann_constraints);
   BTOR_CHKCLONE_STATS (bv_uc_props);
   BTOR_CHKCLONE_STATS (fun_uc_props);
+  BTOR_CHKCLONE_STATS (uc_reconnects);
   BTOR_CHKCLONE_STATS (lambdas_merged);
   BTOR_CHKCLONE_STATS (expressions);
   BTOR_CHKCLONE_STATS (clone_calls);
@@ -366,7 +382,6 @@ chkclone_opts (Btor *btor, Btor *clone)
 static void
 chkclone_aig (BtorAIG *aig, BtorAIG *clone)
 {
-  int32_t i;
   BtorAIG *real_aig, *real_clone;
 
   real_aig   = BTOR_REAL_ADDR_AIG (aig);
@@ -380,11 +395,10 @@ chkclone_aig (BtorAIG *aig, BtorAIG *clone)
     BTOR_CHKCLONE_AIG (refs);
     BTOR_CHKCLONE_AIG (next);
     BTOR_CHKCLONE_AIG (cnf_id);
+    BTOR_CHKCLONE_AIG (pol);
     BTOR_CHKCLONE_AIG (mark);
     BTOR_CHKCLONE_AIG (is_var);
     BTOR_CHKCLONE_AIG (local);
-    if (!real_aig->is_var)
-      for (i = 0; i < 2; i++) BTOR_CHKCLONE_AIG (children[i]);
   }
 }
 
@@ -419,6 +433,21 @@ chkclone_aig_id_table (Btor *btor, Btor *clone)
     chkclone_aig (btable->start[i], ctable->start[i]);
 }
 
+static inline void
+chkclone_aig_children (Btor *btor, Btor *clone)
+{
+  uint32_t i;
+  BtorIntStack *bchildren, *cchildren;
+
+  bchildren = &btor_get_aig_mgr (btor)->children;
+  cchildren = &btor_get_aig_mgr (clone)->children;
+  assert (bchildren != cchildren);
+
+  assert (BTOR_COUNT_STACK (*bchildren) == BTOR_COUNT_STACK (*cchildren));
+  for (i = 0; i < BTOR_COUNT_STACK (*bchildren); i++)
+    assert (bchildren->start[i] == cchildren->start[i]);
+}
+
 static inline void
 chkclone_aig_cnf_id_table (Btor *btor, Btor *clone)
 {
@@ -858,6 +887,7 @@ chkclone_tables (Btor *btor, Btor *clone)
   chkclone_node_ptr_hash_table (btor->bv_vars, clone->bv_vars, 0);
   chkclone_node_ptr_hash_table (btor->lambdas, clone->lambdas, 0);
   chkclone_node_ptr_hash_table (btor->feqs, clone->feqs, 0);
+  chkclone_node_ptr_hash_table (btor->lazy_bv_ops, clone->lazy_bv_ops, 0);
   chkclone_node_ptr_hash_table (btor->substitutions, clone->substitutions, 0);
   chkclone_node_ptr_hash_table (
       btor->varsubst_constraints, clone->varsubst_constraints, 0);
@@ -1036,7 +1066,9 @@ chkclone_slv (Btor *btor, Btor *clone)
     BtorPtrHashTableIterator it;
     BtorPtrHashTableIterator cit;
 
-    chkclone_node_ptr_hash_table (slv->lemmas, cslv->lemmas, 0);
+    chkclone_node_ptr_hash_table (slv->lemmas, cslv->lemmas, cmp_data_as_int);
+    chkclone_int_hash_map (
+        slv->pending_lemmas, cslv->pending_lemmas, cmp_data_as_int);
 
     if (slv->score)
     {
@@ -1079,12 +1111,31 @@ chkclone_slv (Btor *btor, Btor *clone)
       assert (BTOR_PEEK_STACK (slv->stats.lemmas_size, i)
               == BTOR_PEEK_STACK (cslv->stats.lemmas_size, i));
 
+    if (slv->betap_cache)
+    {
+      assert (cslv->betap_cache);
+      assert (slv->betap_cache->table->count
+              == cslv->betap_cache->table->count);
+      assert (slv->betap_cache->stats.hits == cslv->betap_cache->stats.hits);
+      assert (slv->betap_cache->stats.misses
+              == cslv->betap_cache->stats.misses);
+    }
+    else
+    {
+      assert (!cslv->betap_cache);
+    }
+
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, lod_refinements);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, refinement_iterations);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, function_congruence_conflicts);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_reduction_conflicts);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, extensionality_lemmas);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, static_lemmas);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_size_sum);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_premisses_removed);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_deferred);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_rederived);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, conflict_search_lemmas);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_applies);
@@ -1104,7 +1155,7 @@ chkclone_slv (Btor *btor, Btor *clone)
     chkclone_int_hash_map (slv->roots, cslv->roots, cmp_data_as_int);
     chkclone_int_hash_map (
         slv->weights, cslv->weights, cmp_data_as_sls_constr_data_ptr);
-    chkclone_int_hash_map (slv->score, cslv->score, cmp_data_as_dbl);
+    chkclone_sls_score (slv->score, cslv->score);
 
     assert (BTOR_COUNT_STACK (slv->moves) == BTOR_COUNT_STACK (cslv->moves));
     for (i = 0; i < BTOR_COUNT_STACK (slv->moves); i++)
@@ -1160,7 +1211,7 @@ chkclone_slv (Btor *btor, Btor *clone)
     BtorPropSolver *cslv = BTOR_PROP_SOLVER (clone);
 
     chkclone_int_hash_map (slv->roots, cslv->roots, cmp_data_as_int);
-    chkclone_int_hash_map (slv->score, cslv->score, cmp_data_as_dbl);
+    chkclone_sls_score (slv->score, cslv->score);
 
     BTOR_CHKCLONE_SLV_STATE (slv, cslv, flip_cond_const_prob);
     BTOR_CHKCLONE_SLV_STATE (slv, cslv, flip_cond_const_prob_delta);
@@ -1208,20 +1259,24 @@ chkclone_slv (Btor *btor, Btor *clone)
     assert (slv->aprop != cslv->aprop);
     assert (slv->aprop->roots == cslv->aprop->roots);
 
-    chkclone_int_hash_map (
-        slv->aprop->unsatroots, cslv->aprop->unsatroots, cmp_data_as_int);
-    chkclone_int_hash_map (
-        slv->aprop->model, cslv->aprop->model, cmp_data_as_int);
-    chkclone_int_hash_map (
-        slv->aprop->score, cslv->aprop->score, cmp_data_as_dbl);
+    BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, size);
+    assert ((!slv->aprop->model && !cslv->aprop->model)
+            || (slv->aprop->model && cslv->aprop->model));
+    assert (!slv->aprop->model
+            || !memcmp (slv->aprop->model,
+                        cslv->aprop->model,
+                        slv->aprop->size * sizeof (*slv->aprop->model)));
+    assert (!slv->aprop->score && !cslv->aprop->score);
 
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, loglevel);
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, seed);
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, use_restarts);
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, use_bandit);
 
-    BTOR_CHKCLONE_SLV_STATS (slv, cslv, moves);
-    BTOR_CHKCLONE_SLV_STATS (slv, cslv, restarts);
+    BTOR_CHKCLONE_SLV_STATS (slv->aprop, cslv->aprop, moves);
+    BTOR_CHKCLONE_SLV_STATS (slv->aprop, cslv->aprop, restarts);
+    BTOR_CHKCLONE_SLV_STATS (slv->aprop, cslv->aprop, flips);
+    BTOR_CHKCLONE_SLV_STATS (slv->aprop, cslv->aprop, updates);
   }
 }
 
@@ -1255,6 +1310,7 @@ btor_chkclone (Btor *btor, Btor *clone)
   {
     chkclone_aig_unique_table (btor, clone);
     chkclone_aig_id_table (btor, clone);
+    chkclone_aig_children (btor, clone);
     chkclone_aig_cnf_id_table (btor, clone);
   }
 
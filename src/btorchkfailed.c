@@ -80,10 +80,10 @@ btor_check_failed_assumptions (Btor *btor)
   clone->slv->api.delet (clone->slv);
   clone->slv = 0;
 
-  /* clone->assertions have already been added at this point. */
-  while (!BTOR_EMPTY_STACK (clone->assertions))
+  /* clone->scope_lits have already been added at this point. */
+  while (!BTOR_EMPTY_STACK (clone->scope_lits))
   {
-    ass = BTOR_POP_STACK (clone->assertions);
+    ass = BTOR_POP_STACK (clone->scope_lits);
     btor_node_release (clone, ass);
   }
 
@@ -17,6 +17,7 @@
 #include "btoropt.h"
 #include "btorsubst.h"
 #include "preprocess/btorpreprocess.h"
+#include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorutil.h"
@@ -143,6 +144,7 @@ btor_check_model (BtorCheckModelContext *ctx)
         break;
       default: btor->slv->api.generate_model (btor->slv, false, true);
     }
+    btor_reconstruct_unconstrained_model (btor);
   }
 
   /* Reset terminate callbacks. */
@@ -160,10 +162,10 @@ btor_check_model (BtorCheckModelContext *ctx)
     btor_assert_exp (clone, btor_iter_hashptr_next (&it));
   btor_reset_assumptions (clone);
 
-  /* clone->assertions have been already added at this point. */
-  while (!BTOR_EMPTY_STACK (clone->assertions))
+  /* clone->scope_lits have been already added at this point. */
+  while (!BTOR_EMPTY_STACK (clone->scope_lits))
   {
-    cur = BTOR_POP_STACK (clone->assertions);
+    cur = BTOR_POP_STACK (clone->scope_lits);
     btor_node_release (clone, cur);
   }
 
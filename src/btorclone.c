@@ -10,6 +10,7 @@
 #include "btoraigvec.h"
 #include "btorbeta.h"
 #include "btorbv.h"
+#include "btorbvdomain.h"
 #include "btorcore.h"
 #include "btorexp.h"
 #include "btorlog.h"
@@ -22,6 +23,7 @@
 #include "btorslvprop.h"
 #include "btorslvsls.h"
 #include "btorsort.h"
+#include "preprocess/btorunconstrained.h"
 #include "sat/btorlgl.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
@@ -792,6 +794,45 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
   }
 }
 
+static void
+clone_uc_terms (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
+{
+  assert (btor);
+  assert (clone);
+  assert (exp_map);
+
+  uint32_t i, j;
+  BtorUCTerm *ucterm, *cloned_ucterm;
+  BtorMemMgr *mm;
+
+  mm = clone->mm;
+
+  BTOR_INIT_STACK (mm, clone->uc_terms);
+  if (BTOR_SIZE_STACK (btor->uc_terms))
+  {
+    BTOR_NEWN (mm, clone->uc_terms.start, BTOR_SIZE_STACK (btor->uc_terms));
+    clone->uc_terms.top = clone->uc_terms.start;
+    clone->uc_terms.end =
+        clone->uc_terms.start + BTOR_SIZE_STACK (btor->uc_terms);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (btor->uc_terms); i++)
+  {
+    ucterm = BTOR_PEEK_STACK (btor->uc_terms, i);
+    BTOR_NEW (mm, cloned_ucterm);
+    *cloned_ucterm     = *ucterm;
+    cloned_ucterm->exp = btor_nodemap_mapped (exp_map, ucterm->exp);
+    cloned_ucterm->var = btor_nodemap_mapped (exp_map, ucterm->var);
+    assert (cloned_ucterm->exp);
+    assert (cloned_ucterm->var);
+    for (j = 0; j < ucterm->arity; j++)
+    {
+      cloned_ucterm->e[j] = btor_nodemap_mapped (exp_map, ucterm->e[j]);
+      assert (cloned_ucterm->e[j]);
+    }
+    BTOR_PUSH_STACK (clone->uc_terms, cloned_ucterm);
+  }
+}
+
 #define MEM_INT_HASH_TABLE(table)                                 \
   ((table) ? sizeof (*(table)) + (table)->size * sizeof (int32_t) \
                  + (table)->size * sizeof (uint8_t)               \
@@ -807,6 +848,9 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
                  + (table)->count * sizeof (BtorPtrHashBucket)                \
            : 0)
 
+#define MEM_SLS_SCORE(score) \
+  ((score) ? sizeof (*(score)) + (score)->size * sizeof (double) : 0)
+
 #define CHKCLONE_MEM_INT_HASH_TABLE(table, clone)                      \
   do                                                                   \
   {                                                                    \
@@ -825,6 +869,12 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
     assert (MEM_PTR_HASH_TABLE (table) == MEM_PTR_HASH_TABLE (clone)); \
   } while (0)
 
+#define CHKCLONE_MEM_SLS_SCORE(score, clone)                 \
+  do                                                         \
+  {                                                          \
+    assert (MEM_SLS_SCORE (score) == MEM_SLS_SCORE (clone)); \
+  } while (0)
+
 #define CLONE_PTR_HASH_TABLE(table)                           \
   do                                                          \
   {                                                           \
@@ -1017,6 +1067,8 @@ clone_aux_btor (Btor *btor,
                             + sizeof (BtorSATMgr)
                             /* true and false AIGs */
                             + 2 * sizeof (BtorAIG *)
+                            /* children of true and false AIGs */
+                            + 4 * sizeof (int32_t)
                             + sizeof (int32_t)) /* unique table chains */
               == clone->mm->allocated);
     }
@@ -1029,14 +1081,20 @@ clone_aux_btor (Btor *btor,
       allocated +=
           sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr)
           + sizeof (BtorSATMgr)
-          /* memory of AIG nodes */
-          + (amgr->cur_num_aigs + amgr->cur_num_aig_vars) * sizeof (BtorAIG)
-          /* children for AND AIGs */
-          + amgr->cur_num_aigs * sizeof (int32_t) * 2
+          /* children of AIGs */
+          + BTOR_SIZE_STACK (amgr->children) * sizeof (int32_t)
+          + BTOR_SIZE_STACK (amgr->chunks) * sizeof (BtorAIGChunk *)
           /* unique table chain */
           + amgr->table.size * sizeof (int32_t)
           + BTOR_SIZE_STACK (amgr->id2aig) * sizeof (BtorAIG *)
           + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t);
+      /* memory of AIG nodes */
+      for (i = 0; i < BTOR_COUNT_STACK (amgr->chunks); i++)
+        if (BTOR_PEEK_STACK (amgr->chunks, i))
+          allocated += BTOR_AIG_CHUNK_BYTES;
+      if (amgr->fraig_repr)
+        allocated += btor_hashint_table_size (amgr->fraig_repr)
+                     + amgr->fraig_repr->size * sizeof (BtorHashTableData);
 #ifdef BTOR_USE_LINGELING
       assert (strcmp (amgr->smgr->name, "Lingeling") == 0
               || strcmp (amgr->smgr->name, "DIMACS Printer") == 0);
@@ -1179,6 +1237,9 @@ clone_aux_btor (Btor *btor,
   CLONE_PTR_HASH_TABLE_DATA (feqs, btor_clone_data_as_int);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->feqs))
           == clone->mm->allocated);
+  CLONE_PTR_HASH_TABLE (lazy_bv_ops);
+  assert ((allocated += MEM_PTR_HASH_TABLE (btor->lazy_bv_ops))
+          == clone->mm->allocated);
   CLONE_PTR_HASH_TABLE_DATA (substitutions, btor_clone_data_as_node_ptr);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->substitutions))
           == clone->mm->allocated);
@@ -1206,24 +1267,16 @@ clone_aux_btor (Btor *btor,
            BTOR_SIZE_STACK (btor->failed_assumptions) * sizeof (BtorNode *))
           == clone->mm->allocated);
 
-  clone->assertions_cache =
-      btor_hashint_table_clone (clone->mm, btor->assertions_cache);
-  assert ((allocated += MEM_INT_HASH_TABLE (btor->assertions_cache))
-          == clone->mm->allocated);
-
   btor_clone_node_ptr_stack (
-      mm, &btor->assertions, &clone->assertions, emap, false);
+      mm, &btor->scope_lits, &clone->scope_lits, emap, false);
   assert (
-      (allocated += BTOR_SIZE_STACK (btor->assertions) * sizeof (BtorNode *))
+      (allocated += BTOR_SIZE_STACK (btor->scope_lits) * sizeof (BtorNode *))
       == clone->mm->allocated);
 
-  BTOR_INIT_STACK (clone->mm, clone->assertions_trail);
-  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_trail); i++)
-    BTOR_PUSH_STACK (clone->assertions_trail,
-                     BTOR_PEEK_STACK (btor->assertions_trail, i));
-  BTOR_ADJUST_STACK (btor->assertions_trail, clone->assertions_trail);
+  clone_uc_terms (btor, clone, emap);
   assert ((allocated +=
-           BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
+           BTOR_SIZE_STACK (btor->uc_terms) * sizeof (BtorUCTerm *)
+           + BTOR_COUNT_STACK (btor->uc_terms) * sizeof (BtorUCTerm))
           == clone->mm->allocated);
 
   if (btor->bv_model)
@@ -1420,6 +1473,26 @@ clone_aux_btor (Btor *btor,
       allocated += MEM_PTR_HASH_TABLE (slv->lemmas);
       allocated += BTOR_SIZE_STACK (slv->cur_lemmas) * sizeof (BtorNode *);
 
+      CHKCLONE_MEM_INT_HASH_MAP (slv->pending_lemmas, cslv->pending_lemmas);
+      allocated += MEM_INT_HASH_MAP (slv->pending_lemmas);
+
+      if (slv->betap_cache)
+      {
+        assert (cslv->betap_cache);
+        allocated += sizeof (BtorBetaCache)
+                     + MEM_PTR_HASH_TABLE (slv->betap_cache->table);
+        btor_iter_hashptr_init (&pit, slv->betap_cache->table);
+        while (btor_iter_hashptr_has_next (&pit))
+        {
+          allocated += sizeof (BtorNodePair) + sizeof (BtorBetaCacheEntry)
+                       + BTOR_SIZE_STACK (((BtorBetaCacheEntry *)
+                                               pit.bucket->data.as_ptr)
+                                              ->conds)
+                             * sizeof (BtorNode *);
+          (void) btor_iter_hashptr_next (&pit);
+        }
+      }
+
       if (slv->score)
       {
         h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -1462,11 +1535,11 @@ clone_aux_btor (Btor *btor,
       BtorSLSSolver *cslv = BTOR_SLS_SOLVER (clone);
 
       CHKCLONE_MEM_INT_HASH_MAP (slv->roots, cslv->roots);
-      CHKCLONE_MEM_INT_HASH_MAP (slv->score, cslv->score);
+      CHKCLONE_MEM_SLS_SCORE (slv->score, cslv->score);
       CHKCLONE_MEM_INT_HASH_MAP (slv->weights, cslv->weights);
 
       allocated += sizeof (BtorSLSSolver) + MEM_INT_HASH_MAP (cslv->roots)
-                   + MEM_INT_HASH_MAP (cslv->score)
+                   + MEM_SLS_SCORE (cslv->score)
                    + MEM_INT_HASH_MAP (cslv->weights);
 
       if (slv->weights)
@@ -1508,10 +1581,23 @@ clone_aux_btor (Btor *btor,
       BtorPropSolver *cslv = BTOR_PROP_SOLVER (clone);
 
       CHKCLONE_MEM_INT_HASH_MAP (slv->roots, cslv->roots);
-      CHKCLONE_MEM_INT_HASH_MAP (slv->score, cslv->score);
+      CHKCLONE_MEM_SLS_SCORE (slv->score, cslv->score);
+      CHKCLONE_MEM_INT_HASH_MAP (slv->domains, cslv->domains);
 
       allocated += sizeof (BtorPropSolver) + MEM_PTR_HASH_TABLE (cslv->roots)
-                   + MEM_PTR_HASH_TABLE (cslv->score);
+                   + MEM_SLS_SCORE (cslv->score)
+                   + MEM_INT_HASH_MAP (cslv->domains);
+      if (cslv->domains)
+      {
+        btor_iter_hashint_init (&iit, cslv->domains);
+        while (btor_iter_hashint_has_next (&iit))
+        {
+          BtorBvDomain *d = btor_iter_hashint_next_data (&iit)->as_ptr;
+          allocated += sizeof (BtorBvDomain) + MEM_BITVEC (d->lo)
+                       + MEM_BITVEC (d->hi) + MEM_BITVEC (d->min)
+                       + MEM_BITVEC (d->max);
+        }
+      }
     }
     else if (clone->slv->kind == BTOR_AIGPROP_SOLVER_KIND)
     {
@@ -1521,13 +1607,11 @@ clone_aux_btor (Btor *btor,
       if (slv->aprop)
       {
         assert (cslv->aprop);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->roots, cslv->aprop->roots);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->score, cslv->aprop->score);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->model, cslv->aprop->model);
-        allocated += sizeof (BtorAIGProp)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->roots)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->score)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->model);
+        assert (!slv->aprop->roots && !cslv->aprop->roots);
+        assert (slv->aprop->size == cslv->aprop->size);
+        allocated += sizeof (BtorAIGProp);
+        if (cslv->aprop->model)
+          allocated += cslv->aprop->size * sizeof (*cslv->aprop->model);
       }
 
       allocated += sizeof (BtorAIGPropSolver);
@@ -11,6 +11,7 @@
 #include <limits.h>
 
 #include "btorabort.h"
+#include "btorautoengine.h"
 #ifndef NDEBUG
 #include "btorchkfailed.h"
 #include "btorchkmodel.h"
@@ -30,6 +31,7 @@
 #include "btorslvsls.h"
 #include "btorsubst.h"
 #include "preprocess/btorpreprocess.h"
+#include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
@@ -454,6 +456,10 @@ btor_print_stats (Btor *btor)
               1,
               "%5d unconstrained parameterized props",
               btor->stats.param_uc_props);
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d reconnected unconstrained terms",
+              btor->stats.uc_reconnects);
   }
   BTOR_MSG (btor->msg,
             1,
@@ -488,6 +494,20 @@ btor_print_stats (Btor *btor)
             1,
             "%5d extracted skeleton constraints",
             btor->stats.skeleton_constraints);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d bit-vector domain constraints",
+            btor->stats.domain_constraints);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d variables and %d operators with reduced width",
+            btor->stats.width_reduced_vars,
+            btor->stats.width_reduced_ops);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d variables solved in %d XOR equations",
+            btor->stats.xor_substitutions,
+            btor->stats.xor_equations);
   BTOR_MSG (
       btor->msg, 1, "%5d and normalizations", btor->stats.ands_normalized);
   BTOR_MSG (
@@ -568,6 +588,45 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld CNF literals",
             btor->avmgr ? btor->avmgr->amgr->num_cnf_literals : 0);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_REWRITE))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs balanced",
+              btor->avmgr ? btor->avmgr->amgr->num_rw_balanced : 0);
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs rewritten",
+              btor->avmgr ? btor->avmgr->amgr->num_rw_rewritten : 0);
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs refactored",
+              btor->avmgr ? btor->avmgr->amgr->num_rw_refactored : 0);
+  }
+  if (btor_opt_get (btor, BTOR_OPT_AIG_CNF) == BTOR_AIG_CNF_PG)
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld CNF clauses (%lld literals) by Plaisted-Greenbaum",
+              btor->avmgr ? btor->avmgr->amgr->num_cnf_pg_clauses : 0,
+              btor->avmgr ? btor->avmgr->amgr->num_cnf_pg_literals : 0);
+  else if (btor_opt_get (btor, BTOR_OPT_AIG_CNF) == BTOR_AIG_CNF_CUT)
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld CNF clauses (%lld literals) by cut-based encoding",
+              btor->avmgr ? btor->avmgr->amgr->num_cnf_cut_clauses : 0,
+              btor->avmgr ? btor->avmgr->amgr->num_cnf_cut_literals : 0);
+  if (btor_opt_get (btor, BTOR_OPT_FRAIG))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs merged by SAT sweeping",
+              btor->avmgr ? btor->avmgr->amgr->num_fraig_merged : 0);
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld SAT sweeping checks (%lld refuted)",
+              btor->avmgr ? btor->avmgr->amgr->num_fraig_sat_calls : 0,
+              btor->avmgr ? btor->avmgr->amgr->num_fraig_refuted : 0);
+  }
 
   if (btor->slv) btor->slv->api.print_stats (btor->slv);
 
@@ -578,6 +637,13 @@ btor_print_stats (Btor *btor)
             1,
             "%.2f seconds synthesize expressions",
             btor->time.synth_exp);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_REWRITE))
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds AIG rewriting",
+              btor->time.aig_rewrite);
+  if (btor_opt_get (btor, BTOR_OPT_FRAIG))
+    BTOR_MSG (btor->msg, 1, "%.2f seconds SAT sweeping", btor->time.fraig);
   BTOR_MSG (btor->msg,
             1,
             "%.2f seconds determining failed assumptions",
@@ -625,6 +691,27 @@ btor_print_stats (Btor *btor)
             percent (btor->time.skel, btor->time.simplify));
 #endif
 
+  if (btor_opt_get (btor, BTOR_OPT_BV_DOMAINS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds domain propagation (%.0f%%)",
+              btor->time.domains,
+              percent (btor->time.domains, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_REDUCE_WIDTHS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds bit-width reduction (%.0f%%)",
+              btor->time.width,
+              percent (btor->time.width, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_XORS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds XOR elimination (%.0f%%)",
+              btor->time.gauss,
+              percent (btor->time.gauss, btor->time.simplify));
+
   if (btor_opt_get (btor, BTOR_OPT_UCOPT))
     BTOR_MSG (btor->msg,
               1,
@@ -730,6 +817,10 @@ btor_new (void)
   btor->feqs = btor_hashptr_table_new (mm,
                                        (BtorHashPtr) btor_node_hash_by_id,
                                        (BtorCmpPtr) btor_node_compare_by_id);
+  btor->lazy_bv_ops =
+      btor_hashptr_table_new (mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
 
   btor->valid_assignments = 1;
 
@@ -763,9 +854,8 @@ btor_new (void)
                               (BtorHashPtr) btor_node_hash_by_id,
                               (BtorCmpPtr) btor_node_compare_by_id);
 
-  BTOR_INIT_STACK (mm, btor->assertions);
-  BTOR_INIT_STACK (mm, btor->assertions_trail);
-  btor->assertions_cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, btor->scope_lits);
+  BTOR_INIT_STACK (mm, btor->uc_terms);
 
 #ifndef NDEBUG
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
@@ -921,6 +1011,7 @@ btor_delete (Btor *btor)
   btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
   btor_iter_hashptr_queue (&it, btor->assumptions);
   btor_iter_hashptr_queue (&it, btor->orig_assumptions);
+  btor_iter_hashptr_queue (&it, btor->lazy_bv_ops);
   while (btor_iter_hashptr_has_next (&it))
     btor_node_release (btor, btor_iter_hashptr_next (&it));
 
@@ -930,6 +1021,7 @@ btor_delete (Btor *btor)
   btor_hashptr_table_delete (btor->synthesized_constraints);
   btor_hashptr_table_delete (btor->assumptions);
   btor_hashptr_table_delete (btor->orig_assumptions);
+  btor_hashptr_table_delete (btor->lazy_bv_ops);
   for (i = 0; i < BTOR_COUNT_STACK (btor->failed_assumptions); i++)
   {
     if (BTOR_PEEK_STACK (btor->failed_assumptions, i))
@@ -937,11 +1029,10 @@ btor_delete (Btor *btor)
   }
   BTOR_RELEASE_STACK (btor->failed_assumptions);
 
-  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
-    btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions, i));
-  BTOR_RELEASE_STACK (btor->assertions);
-  BTOR_RELEASE_STACK (btor->assertions_trail);
-  btor_hashint_table_delete (btor->assertions_cache);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->scope_lits); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (btor->scope_lits, i));
+  BTOR_RELEASE_STACK (btor->scope_lits);
+  btor_delete_unconstrained_terms (btor);
 
   btor_model_delete (btor);
   btor_node_release (btor, btor->true_exp);
@@ -1081,11 +1172,24 @@ btor_process_unsynthesized_constraints (Btor *btor)
   BtorNode *cur;
   BtorAIG *aig;
   BtorAIGMgr *amgr;
+  uint32_t fraig, rewrite;
+  bool defer;
+  double start;
 
   uc   = btor->unsynthesized_constraints;
   sc   = btor->synthesized_constraints;
   amgr = btor_get_aig_mgr (btor);
 
+  /* defer translation of the bit-blasted constraints into CNF for AIG
+   * optimization and SAT sweeping */
+  fraig = btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)
+              ? 0
+              : btor_opt_get (btor, BTOR_OPT_FRAIG);
+  rewrite = btor_opt_get (btor, BTOR_OPT_AIG_REWRITE);
+  defer   = fraig || rewrite
+          || btor_opt_get (btor, BTOR_OPT_AIG_CNF) != BTOR_AIG_CNF_TSEITIN;
+  if (defer && uc->count > 0) btor_aig_fraig_defer (amgr);
+
   while (uc->count > 0)
   {
     bucket = uc->first;
@@ -1149,6 +1253,19 @@ btor_process_unsynthesized_constraints (Btor *btor)
       btor_node_release (btor, cur);
     }
   }
+
+  if (amgr->fraig_defer)
+  {
+    if (rewrite)
+    {
+      start = btor_util_time_stamp ();
+      btor_aig_rewrite (amgr, rewrite);
+      btor->time.aig_rewrite += btor_util_time_stamp () - start;
+    }
+    start = btor_util_time_stamp ();
+    btor_aig_fraig (amgr, fraig);
+    btor->time.fraig += btor_util_time_stamp () - start;
+  }
 }
 
 void
@@ -1811,7 +1928,7 @@ exp_to_cnf_lit (Btor *btor, BtorNode *exp)
       sign *= -1;
     }
 
-    if (!aig->cnf_id) btor_aig_to_sat_tseitin (amgr, aig);
+    if (!btor_aig_is_encoded (aig)) btor_aig_to_sat_tseitin (amgr, aig);
 
     res = aig->cnf_id;
     btor_aig_release (amgr, aig);
@@ -2014,13 +2131,26 @@ btor_fixate_assumptions (Btor *btor)
   BtorNode *exp;
   BtorNodePtrStack stack;
   BtorPtrHashTableIterator it;
+  BtorIntHashTable *scope_lits;
   size_t i;
 
+  /* activation literals of open context levels are not fixated */
+  scope_lits = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->scope_lits); i++)
+  {
+    exp = btor_simplify_exp (btor, BTOR_PEEK_STACK (btor->scope_lits, i));
+    if (!btor_hashint_table_contains (scope_lits, btor_node_get_id (exp)))
+      btor_hashint_table_add (scope_lits, btor_node_get_id (exp));
+  }
+
   BTOR_INIT_STACK (btor->mm, stack);
   btor_iter_hashptr_init (&it, btor->assumptions);
   while (btor_iter_hashptr_has_next (&it))
-    BTOR_PUSH_STACK (stack,
-                     btor_node_copy (btor, btor_iter_hashptr_next (&it)));
+  {
+    exp = btor_iter_hashptr_next (&it);
+    if (!btor_hashint_table_contains (scope_lits, btor_node_get_id (exp)))
+      BTOR_PUSH_STACK (stack, btor_node_copy (btor, exp));
+  }
   for (i = 0; i < BTOR_COUNT_STACK (stack); i++)
   {
     exp = BTOR_PEEK_STACK (stack, i);
@@ -2028,6 +2158,7 @@ btor_fixate_assumptions (Btor *btor)
     btor_node_release (btor, exp);
   }
   BTOR_RELEASE_STACK (stack);
+  btor_hashint_table_delete (scope_lits);
   btor_reset_assumptions (btor);
 }
 
@@ -2466,9 +2597,73 @@ btor_substitute_node (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
+/* Returns true if BV operator 'exp' is abstracted by 'btor_synthesize_exp'
+ * rather than bit-blasted. Abstractions are only refined by the function
+ * solver. */
+static bool
+is_lazy_bv_op (Btor *btor, BtorNode *exp)
+{
+  uint32_t width;
+
+  assert (btor_node_is_regular (exp));
+
+  if (!btor->slv || btor->slv->kind != BTOR_FUN_SOLVER_KIND) return false;
+  if (btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)) return false;
+  if (exp->parameterized) return false;
+  if (!btor_node_is_bv_mul (exp) && !btor_node_is_bv_udiv (exp)
+      && !btor_node_is_bv_urem (exp))
+    return false;
+  width = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_BITBLAST);
+  return width && btor_node_bv_get_width (btor, exp) >= width;
+}
+
+void
+btor_synthesize_lazy_bv_op (Btor *btor, BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (exp->av);
+  assert (btor_hashptr_table_get (btor->lazy_bv_ops, exp));
+
+  uint32_t i;
+  BtorAIGVecMgr *avmgr;
+  BtorAIGMgr *amgr;
+  BtorAIGVec *av0, *av1, *av;
+  BtorAIG *eq;
+
+  avmgr = btor->avmgr;
+  amgr  = btor_get_aig_mgr (btor);
+  av0   = BTOR_AIGVEC_NODE (btor, exp->e[0]);
+  av1   = BTOR_AIGVEC_NODE (btor, exp->e[1]);
+  if (btor_node_is_bv_mul (exp))
+    av = btor_aigvec_mul (avmgr, av0, av1);
+  else if (btor_node_is_bv_udiv (exp))
+    av = btor_aigvec_udiv (avmgr, av0, av1);
+  else
+  {
+    assert (btor_node_is_bv_urem (exp));
+    av = btor_aigvec_urem (avmgr, av0, av1);
+  }
+  for (i = 0; i < av->width; i++)
+  {
+    eq = btor_aig_eq (amgr, exp->av->aigs[i], av->aigs[i]);
+    btor_aig_add_toplevel_to_sat (amgr, eq);
+    btor_aig_release (amgr, eq);
+  }
+  btor_aigvec_release_delete (avmgr, av);
+  btor_aigvec_release_delete (avmgr, av1);
+  btor_aigvec_release_delete (avmgr, av0);
+
+  btor_hashptr_table_remove (btor->lazy_bv_ops, exp, 0, 0);
+  btor_node_release (btor, exp);
+}
+
 /* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
  * then it is also encoded. with option lazy_synthesize enabled,
- * 'btor_synthesize_exp' stops at feq and apply nodes */
+ * 'btor_synthesize_exp' stops at feq and apply nodes. expensive BV operators
+ * are encoded as fresh variables if lazy bit-blasting is enabled, but their
+ * operands are synthesized. */
 void
 btor_synthesize_exp (Btor *btor,
                      BtorNode *exp,
@@ -2490,7 +2685,7 @@ btor_synthesize_exp (Btor *btor,
   bool invert_av1 = false;
   bool invert_av2 = false;
   double start;
-  bool restart, opt_lazy_synth;
+  bool restart, opt_lazy_synth, lazy_bv_op;
   BtorIntHashTable *cache;
 
   assert (btor);
@@ -2516,6 +2711,7 @@ btor_synthesize_exp (Btor *btor,
     if (btor_node_is_synth (cur)) continue;
 
     count++;
+    lazy_bv_op = is_lazy_bv_op (btor, cur);
     if (!btor_hashint_table_contains (cache, cur->id))
     {
       if (btor_node_is_bv_const (cur))
@@ -2524,10 +2720,11 @@ btor_synthesize_exp (Btor *btor,
         BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
         /* no need to call btor_aigvec_to_sat_tseitin here */
       }
-      /* encode bv skeleton inputs: var, apply, feq */
+      /* encode bv skeleton inputs: var, apply, feq, abstracted BV ops */
       else if (btor_node_is_bv_var (cur)
                || (btor_node_is_apply (cur) && !cur->parameterized)
-               || btor_node_is_fun_eq (cur))
+               || btor_node_is_fun_eq (cur)
+               || lazy_bv_op)
       {
         assert (!cur->parameterized);
         cur->av = btor_aigvec_var (avmgr, btor_node_bv_get_width (btor, cur));
@@ -2559,6 +2756,15 @@ btor_synthesize_exp (Btor *btor,
         BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
         btor_aigvec_to_sat_tseitin (avmgr, cur->av);
 
+        /* operands of abstracted BV operators are always synthesized */
+        if (lazy_bv_op)
+        {
+          if (!btor_hashptr_table_get (btor->lazy_bv_ops, cur))
+            btor_hashptr_table_add (btor->lazy_bv_ops,
+                                    btor_node_copy (btor, cur));
+          goto PUSH_CHILDREN;
+        }
+
         /* continue synthesizing children for apply and feq nodes if
          * lazy_synthesize is disabled */
         if (!opt_lazy_synth) goto PUSH_CHILDREN;
@@ -2890,17 +3096,16 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (btor->valid_assignments == 1) btor_reset_incremental_usage (btor);
 
-  /* 'btor->assertions' contains all assertions that were asserted in context
-   * levels > 0 (boolector_push). We assume all these assertions on every
-   * btor_check_sat call since these assumptions are valid until the
-   * corresponding context is popped. */
-  if (BTOR_COUNT_STACK (btor->assertions) > 0)
+  /* Assertions in context levels > 0 (boolector_push) are asserted as
+   * implications guarded by the activation literal of their level. We assume
+   * the activation literals of all open levels on every btor_check_sat call,
+   * independent of the number of assertions in these levels. */
+  if (BTOR_COUNT_STACK (btor->scope_lits) > 0)
   {
-    assert (BTOR_COUNT_STACK (btor->assertions_trail) > 0);
     uint32_t i;
-    for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+    for (i = 0; i < BTOR_COUNT_STACK (btor->scope_lits); i++)
     {
-      btor_assume_exp (btor, BTOR_PEEK_STACK (btor->assertions, i));
+      btor_assume_exp (btor, BTOR_PEEK_STACK (btor->scope_lits, i));
     }
   }
 
@@ -2912,8 +3117,6 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   if (check && btor_opt_get (btor, BTOR_OPT_CHK_UNCONSTRAINED)
       && btor_opt_get (btor, BTOR_OPT_UCOPT)
       && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-      && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
-      && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN)
       && !btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS))
   {
     uclone = btor_clone_btor (btor);
@@ -2973,6 +3176,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (res != BTOR_RESULT_UNSAT)
   {
+    if (!btor->slv && btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_AUTO)
+      btor_auto_engine_select (btor);
+
     engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
 
     if (!btor->slv)
@@ -3050,6 +3256,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
         btor->slv->api.generate_model (
             btor->slv, btor_opt_get (btor, BTOR_OPT_MODEL_GEN) == 2, true);
     }
+    btor_reconstruct_unconstrained_model (btor);
   }
 
 #ifndef NDEBUG
@@ -3057,8 +3264,6 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   {
     assert (btor_opt_get (btor, BTOR_OPT_UCOPT));
     assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-    assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
-    assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
     BtorSolverResult ucres = btor_check_sat (uclone, -1, -1);
     assert (res == ucres);
     btor_delete (uclone);
@@ -3066,7 +3271,12 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (chkmodel)
   {
-    if (res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
+    /* without incremental mode or model generation, unconstrained terms
+     * are eliminated without model reconstruction */
+    if (res == BTOR_RESULT_SAT
+        && (!btor_opt_get (btor, BTOR_OPT_UCOPT)
+            || btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+            || btor_opt_get (btor, BTOR_OPT_MODEL_GEN)))
     {
       btor_check_model (chkmodel);
     }
@@ -84,6 +84,11 @@ struct BtorConstraintStats
 
 typedef struct BtorConstraintStats BtorConstraintStats;
 
+/* see preprocess/btorunconstrained.h */
+typedef struct BtorUCTerm BtorUCTerm;
+
+BTOR_DECLARE_STACK (BtorUCTermPtr, BtorUCTerm *);
+
 struct Btor
 {
   BtorMemMgr *mm;
@@ -110,9 +115,13 @@ struct Btor
   BtorPtrHashTable *exists_vars;
   BtorPtrHashTable *forall_vars;
   BtorPtrHashTable *feqs;
+  BtorPtrHashTable *lazy_bv_ops; /* abstracted, not bit-blasted BV operators */
   BtorPtrHashTable *parameterized;
 
   BtorPtrHashTable *substitutions;
+  /* unconstrained terms eliminated in incremental mode or with model
+   * generation enabled */
+  BtorUCTermPtrStack uc_terms;
 
   BtorNode *true_exp;
 
@@ -148,12 +157,9 @@ struct Btor
    * this stack is needed for boolector_get_failed_assumptions only */
   BtorNodePtrStack failed_assumptions;
 
-  /* maintain assertions for different contexts push/pop */
-  BtorNodePtrStack assertions;
-  /* caches the assertions on stack 'assertions' */
-  BtorIntHashTable *assertions_cache;
-  /* saves the number of assertions on each push */
-  BtorUIntStack assertions_trail;
+  /* activation literals of the context levels created via push, assertions
+   * at level i are asserted as implications guarded by the i-th literal */
+  BtorNodePtrStack scope_lits;
   /* Number of push/pop calls (used for unique symbol prefixes) */
   uint32_t num_push_pop;
 
@@ -187,6 +193,11 @@ struct Btor
     uint32_t gaussian_eliminations; /* number of gaussian eliminations */
     uint32_t eliminated_slices;     /* number of eliminated slices */
     uint32_t skeleton_constraints;  /* number of skeleton constraints */
+    uint32_t domain_constraints;    /* number of domain constraints */
+    uint32_t width_reduced_vars;    /* number of narrowed variables */
+    uint32_t width_reduced_ops;     /* number of narrowed operators */
+    uint32_t xor_equations;         /* number of eliminated XOR equations */
+    uint32_t xor_substitutions;     /* number of vars solved by XOR elim. */
     uint32_t adds_normalized;       /* number of add chains normalizations */
     uint32_t ands_normalized;       /* number of and chains normalizations */
     uint32_t muls_normalized;       /* number of mul chains normalizations */
@@ -196,6 +207,7 @@ struct Btor
     uint32_t bv_uc_props;
     uint32_t fun_uc_props;
     uint32_t param_uc_props;
+    uint32_t uc_reconnects; /* number of reconnected unconstrained terms */
     uint_least64_t lambdas_merged;
     BtorConstraintStats constraints;
     BtorConstraintStats oldconstraints;
@@ -220,12 +232,17 @@ struct Btor
     double embedded;
     double slicing;
     double skel;
+    double domains;
+    double width;
+    double gauss;
     double propagate;
     double beta;
     double betap;
     double failed;
     double cloning;
     double synth_exp;
+    double fraig;
+    double aig_rewrite;
     double model_gen;
     double ucopt;
     double merge;
@@ -322,6 +339,11 @@ void btor_synthesize_exp (Btor *btor,
                           BtorNode *exp,
                           BtorPtrHashTable *backannotation);
 
+/* Bit-blasts BV operator 'exp' that was abstracted by 'btor_synthesize_exp'
+ * (see BTOR_OPT_FUN_LAZY_BITBLAST) and constrains its abstraction to be
+ * equal to the result. */
+void btor_synthesize_lazy_bv_op (Btor *btor, BtorNode *exp);
+
 /* Finds most simplified expression and shortens path to it */
 BtorNode *btor_node_get_simplified (Btor *btor, BtorNode *exp);
 
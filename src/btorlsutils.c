@@ -9,13 +9,20 @@
 #include "btorlsutils.h"
 
 #include "btorbv.h"
+#include "btorclone.h"
 #include "btorlog.h"
 #include "btormodel.h"
 #include "btornode.h"
 #include "btorslsutils.h"
+#include "btorslvprop.h"
+#include "btorslvsls.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 static void
 update_roots_table (Btor *btor,
                     BtorIntHashTable *roots,
@@ -65,6 +72,59 @@ update_roots_table (Btor *btor,
   }
 }
 
+uint32_t
+btor_lsutils_collect_cone (Btor *btor,
+                           BtorNodePtrStack *exps,
+                           BtorNodePtrStack *cone)
+{
+  assert (btor);
+  assert (exps);
+  assert (cone);
+
+  uint32_t i, res;
+  BtorNode *cur;
+  BtorNodeIterator nit;
+  BtorNodePtrStack stack;
+  BtorIntHashTable *cache;
+
+  BTOR_INIT_STACK (btor->mm, stack);
+  cache = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*exps); i++)
+  {
+    cur = BTOR_PEEK_STACK (*exps, i);
+    assert (btor_node_is_regular (cur));
+    assert (btor_node_is_bv_var (cur));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  }
+  res = cache->count;
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    assert (btor_node_is_regular (cur));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    BTOR_PUSH_STACK (*cone, cur);
+    res += 1;
+
+    /* push parents */
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  }
+  BTOR_RELEASE_STACK (stack);
+  btor_hashint_table_delete (cache);
+
+  qsort (cone->start,
+         BTOR_COUNT_STACK (*cone),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+  return res;
+}
+
 /**
  * Update cone of influence.
  *
@@ -83,8 +143,9 @@ void
 btor_lsutils_update_cone (Btor *btor,
                           BtorIntHashTable *bv_model,
                           BtorIntHashTable *roots,
-                          BtorIntHashTable *score,
+                          BtorSLSScore *score,
                           BtorIntHashTable *exps,
+                          BtorNodePtrStack *cone,
                           bool update_roots,
                           uint64_t *stats_updates,
                           double *time_update_cone,
@@ -109,11 +170,9 @@ btor_lsutils_update_cone (Btor *btor,
   uint32_t i, j;
   int32_t id;
   BtorNode *exp, *cur;
-  BtorNodeIterator nit;
   BtorIntHashTableIterator iit;
   BtorHashTableData *d;
-  BtorNodePtrStack stack, cone;
-  BtorIntHashTable *cache;
+  BtorNodePtrStack exps_stack, cone_stack;
   BtorBitVector *bv, *e[3], *ass;
   BtorMemMgr *mm;
 
@@ -142,34 +201,25 @@ btor_lsutils_update_cone (Btor *btor,
 
   /* reset cone ----------------------------------------------------------- */
 
-  BTOR_INIT_STACK (mm, cone);
-  BTOR_INIT_STACK (mm, stack);
-  btor_iter_hashint_init (&iit, exps);
-  while (btor_iter_hashint_has_next (&iit))
+  BTOR_INIT_STACK (mm, cone_stack);
+  if (cone)
   {
-    exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
-    assert (btor_node_is_regular (exp));
-    assert (btor_node_is_bv_var (exp));
-    BTOR_PUSH_STACK (stack, exp);
+    *stats_updates += exps->count + BTOR_COUNT_STACK (*cone);
   }
-  cache = btor_hashint_table_new (mm);
-  while (!BTOR_EMPTY_STACK (stack))
+  else
   {
-    cur = BTOR_POP_STACK (stack);
-    assert (btor_node_is_regular (cur));
-    if (btor_hashint_table_contains (cache, cur->id)) continue;
-    btor_hashint_table_add (cache, cur->id);
-    if (!btor_hashint_table_contains (exps, cur->id))
-      BTOR_PUSH_STACK (cone, cur);
-    *stats_updates += 1;
-
-    /* push parents */
-    btor_iter_parent_init (&nit, cur);
-    while (btor_iter_parent_has_next (&nit))
-      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+    BTOR_INIT_STACK (mm, exps_stack);
+    btor_iter_hashint_init (&iit, exps);
+    while (btor_iter_hashint_has_next (&iit))
+    {
+      exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
+      BTOR_PUSH_STACK (exps_stack, exp);
+    }
+    *stats_updates +=
+        btor_lsutils_collect_cone (btor, &exps_stack, &cone_stack);
+    BTOR_RELEASE_STACK (exps_stack);
+    cone = &cone_stack;
   }
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
 
   *time_update_cone_reset += btor_util_time_stamp () - delta;
 
@@ -204,30 +254,29 @@ btor_lsutils_update_cone (Btor *btor,
     /* update score */
     if (score && btor_node_bv_get_width (btor, exp) == 1)
     {
-      assert (btor_hashint_map_contains (score, btor_node_get_id (exp)));
-      btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl =
+      assert (btor_slsutils_has_score (score, exp->id));
+      btor_slsutils_set_score (
+          score,
+          exp->id,
           btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, exp);
+              btor, bv_model, btor->fun_model, score, exp));
 
-      assert (btor_hashint_map_contains (score, -btor_node_get_id (exp)));
-      btor_hashint_map_get (score, -btor_node_get_id (exp))->as_dbl =
+      assert (btor_slsutils_has_score (score, -exp->id));
+      btor_slsutils_set_score (
+          score,
+          -exp->id,
           btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, btor_node_invert (exp));
+              btor, bv_model, btor->fun_model, score, btor_node_invert (exp)));
     }
   }
 
-  qsort (cone.start,
-         BTOR_COUNT_STACK (cone),
-         sizeof (BtorNode *),
-         btor_node_compare_by_id_qsort_asc);
-
   /* update model of cone ------------------------------------------------- */
 
   delta = btor_util_time_stamp ();
 
-  for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+  for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
   {
-    cur = BTOR_PEEK_STACK (cone, i);
+    cur = BTOR_PEEK_STACK (*cone, i);
     assert (btor_node_is_regular (cur));
     for (j = 0; j < cur->arity; j++)
     {
@@ -322,32 +371,36 @@ btor_lsutils_update_cone (Btor *btor,
   if (score)
   {
     delta = btor_util_time_stamp ();
-    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+    for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
     {
-      cur = BTOR_PEEK_STACK (cone, i);
+      cur = BTOR_PEEK_STACK (*cone, i);
       assert (btor_node_is_regular (cur));
 
       if (btor_node_bv_get_width (btor, cur) != 1) continue;
 
       id = btor_node_get_id (cur);
-      if (!btor_hashint_map_contains (score, id))
+      if (!btor_slsutils_has_score (score, id))
       {
         /* not reachable from the roots */
-        assert (!btor_hashint_map_contains (score, -id));
+        assert (!btor_slsutils_has_score (score, -id));
         continue;
       }
-      btor_hashint_map_get (score, id)->as_dbl =
+      btor_slsutils_set_score (
+          score,
+          id,
           btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, cur);
-      assert (btor_hashint_map_contains (score, -id));
-      btor_hashint_map_get (score, -id)->as_dbl =
+              btor, bv_model, btor->fun_model, score, cur));
+      assert (btor_slsutils_has_score (score, -id));
+      btor_slsutils_set_score (
+          score,
+          -id,
           btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, btor_node_invert (cur));
+              btor, bv_model, btor->fun_model, score, btor_node_invert (cur)));
     }
     *time_update_cone_compute_score += btor_util_time_stamp () - delta;
   }
 
-  BTOR_RELEASE_STACK (cone);
+  BTOR_RELEASE_STACK (cone_stack);
 
 #ifndef NDEBUG
   btor_iter_hashptr_init (&pit, btor->unsynthesized_constraints);
@@ -363,3 +416,319 @@ btor_lsutils_update_cone (Btor *btor,
 #endif
   *time_update_cone += btor_util_time_stamp () - start;
 }
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+/* Probability for restarting from the best assignment of the pool (rather
+ * than from the initial model) if it is better than the current assignment.
+ * Always restarting from the best assignment drives all walkers into the
+ * same local minimum. */
+#define BTOR_LSUTILS_PROB_RESTART_FROM_BEST 500
+
+struct BtorLSWorkerPool
+{
+  BtorMemMgr *mm;
+  BtorIntHashTable *best; /* map: input id -> assignment with the least
+                             number of unsatisfied roots seen so far */
+  uint32_t best_nroots;
+  uint32_t nimports; /* number of restarts from the best assignment */
+  bool found_result;
+  struct BtorLSWorker *winner;
+  Btor *main;                  /* instance of the main walker */
+  int32_t (*termfun) (void *); /* termination function of the main walker */
+  pthread_mutex_t mutex;
+};
+
+struct BtorLSWorker
+{
+  Btor *btor;
+  uint32_t id;
+  BtorSolverResult result;
+  BtorLSWorkerPool *pool;
+  bool threaded; /* false if the walker runs in the current thread */
+};
+
+typedef struct BtorLSWorker BtorLSWorker;
+
+static BtorLSWorkerPool **
+get_pool_ref (Btor *btor)
+{
+  assert (btor);
+  assert (btor->slv);
+
+  if (btor->slv->kind == BTOR_SLS_SOLVER_KIND)
+    return &BTOR_SLS_SOLVER (btor)->pool;
+  assert (btor->slv->kind == BTOR_PROP_SOLVER_KIND);
+  return &BTOR_PROP_SOLVER (btor)->pool;
+}
+
+static void
+merge_stats (Btor *btor, Btor *clone)
+{
+  assert (btor);
+  assert (clone);
+  assert (btor->slv->kind == clone->slv->kind);
+
+  BtorSLSSolver *slv, *cslv;
+  BtorPropSolver *pslv, *cpslv;
+
+  if (btor->slv->kind == BTOR_SLS_SOLVER_KIND)
+  {
+    slv  = BTOR_SLS_SOLVER (btor);
+    cslv = BTOR_SLS_SOLVER (clone);
+    slv->stats.restarts += cslv->stats.restarts;
+    slv->stats.moves += cslv->stats.moves;
+    slv->stats.flips += cslv->stats.flips;
+    slv->stats.props += cslv->stats.props;
+    slv->stats.updates += cslv->stats.updates;
+  }
+  else
+  {
+    pslv  = BTOR_PROP_SOLVER (btor);
+    cpslv = BTOR_PROP_SOLVER (clone);
+    pslv->stats.restarts += cpslv->stats.restarts;
+    pslv->stats.moves += cpslv->stats.moves;
+    pslv->stats.props += cpslv->stats.props;
+    pslv->stats.props_cons += cpslv->stats.props_cons;
+    pslv->stats.props_inv += cpslv->stats.props_inv;
+    pslv->stats.ic_checks += cpslv->stats.ic_checks;
+    pslv->stats.ic_invertible += cpslv->stats.ic_invertible;
+    pslv->stats.domain_props += cpslv->stats.domain_props;
+    pslv->stats.domain_refinements += cpslv->stats.domain_refinements;
+    pslv->stats.updates += cpslv->stats.updates;
+  }
+}
+
+static void
+delete_best (BtorLSWorkerPool *pool)
+{
+  assert (pool);
+
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, pool->best);
+  while (btor_iter_hashint_has_next (&it))
+    btor_bv_free (pool->mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (pool->best);
+  pool->best = 0;
+}
+
+void
+btor_lsutils_restart (Btor *btor, BtorLSWorkerPool *pool, uint32_t nroots)
+{
+  assert (btor);
+  assert (pool);
+  assert (btor->bv_model);
+
+  bool import;
+  int32_t id;
+  BtorNode *cur;
+  BtorBitVector *bv;
+  BtorIntHashTableIterator it;
+
+  import = false;
+  pthread_mutex_lock (&pool->mutex);
+  if (nroots < pool->best_nroots)
+  {
+    delete_best (pool);
+    pool->best = btor_hashint_map_new (pool->mm);
+    btor_iter_hashint_init (&it, btor->bv_model);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      bv  = btor->bv_model->data[it.cur_pos].as_ptr;
+      id  = btor_iter_hashint_next (&it);
+      cur = btor_node_get_by_id (btor, id);
+      if (id < 0 || !btor_node_is_bv_var (cur)) continue;
+      btor_hashint_map_add (pool->best, id)->as_ptr =
+          btor_bv_copy (pool->mm, bv);
+    }
+    pool->best_nroots = nroots;
+  }
+  else if (pool->best_nroots < nroots
+           && btor_rng_pick_with_prob (&btor->rng,
+                                       BTOR_LSUTILS_PROB_RESTART_FROM_BEST))
+  {
+    /* restart from the best assignment, all other nodes are computed based
+     * on the assignments of the inputs */
+    btor_model_init_bv (btor, &btor->bv_model);
+    btor_iter_hashint_init (&it, pool->best);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      bv  = pool->best->data[it.cur_pos].as_ptr;
+      cur = btor_node_get_by_id (btor, btor_iter_hashint_next (&it));
+      btor_model_add_to_bv (btor, btor->bv_model, cur, bv);
+    }
+    pool->nimports += 1;
+    import = true;
+  }
+  pthread_mutex_unlock (&pool->mutex);
+
+  if (import)
+  {
+    btor_model_init_fun (btor, &btor->fun_model);
+    btor_model_generate (btor, btor->bv_model, btor->fun_model, false);
+  }
+  else
+  {
+    btor->slv->api.generate_model (btor->slv, false, true);
+  }
+}
+
+static void *
+thread_work (void *state)
+{
+  BtorLSWorker *worker;
+  BtorLSWorkerPool *pool;
+
+  worker         = state;
+  pool           = worker->pool;
+  worker->result = worker->btor->slv->api.sat (worker->btor->slv);
+
+  pthread_mutex_lock (&pool->mutex);
+  if (!pool->winner && worker->result != BTOR_RESULT_UNKNOWN)
+    pool->winner = worker;
+  /* the walker on the original instance is the only one that is subject to
+   * user-defined termination, all other walkers stop with it */
+  if (pool->winner || worker->id == 0) pool->found_result = true;
+  pthread_mutex_unlock (&pool->mutex);
+  return NULL;
+}
+
+static bool
+has_result (BtorLSWorkerPool *pool)
+{
+  bool res;
+
+  pthread_mutex_lock (&pool->mutex);
+  res = pool->found_result;
+  pthread_mutex_unlock (&pool->mutex);
+  return res;
+}
+
+static int32_t
+thread_terminate (void *state)
+{
+  return has_result ((BtorLSWorkerPool *) state);
+}
+
+/* Termination function of a walker that runs in the current thread since
+ * its thread could not be created. As for the main walker, user-defined
+ * termination applies. */
+static int32_t
+terminate_inline (void *state)
+{
+  BtorLSWorkerPool *pool;
+
+  pool = state;
+  if (has_result (pool)) return 1;
+  return pool->termfun ? pool->termfun (pool->main) : 0;
+}
+
+static int32_t
+terminate_main (void *state)
+{
+  Btor *btor;
+  BtorLSWorkerPool *pool;
+
+  btor = state;
+  pool = *get_pool_ref (btor);
+  assert (pool);
+  if (has_result (pool)) return 1;
+  return pool->termfun ? pool->termfun (btor) : 0;
+}
+
+BtorSolverResult
+btor_lsutils_sat_parallel (Btor *btor, uint32_t nworkers)
+{
+  assert (btor);
+  assert (nworkers > 1);
+  assert (!*get_pool_ref (btor));
+
+  uint32_t i, seed;
+  BtorLSWorkerPool pool;
+  BtorLSWorker *workers, *winner;
+  BtorSolverResult res;
+  BtorMemMgr *mm;
+  Btor *clone;
+  pthread_t *threads;
+
+  mm = btor->mm;
+
+  pool.mm           = btor_mem_mgr_new ();
+  pool.best         = btor_hashint_map_new (pool.mm);
+  pool.best_nroots  = UINT32_MAX;
+  pool.nimports     = 0;
+  pool.found_result = false;
+  pool.winner       = 0;
+  pool.main         = btor;
+  pool.termfun      = btor->cbs.term.termfun;
+  pthread_mutex_init (&pool.mutex, 0);
+
+  seed = btor_opt_get (btor, BTOR_OPT_SEED);
+  BTOR_CNEWN (mm, workers, nworkers);
+  for (i = 0; i < nworkers; i++)
+  {
+    if (i == 0)
+      clone = btor;
+    else
+    {
+      clone = btor_clone_btor (btor);
+      btor_opt_set (clone, BTOR_OPT_SEED, seed + i);
+      btor_set_term (clone, thread_terminate, &pool);
+    }
+    workers[i].btor = clone;
+    workers[i].id   = i;
+    workers[i].pool = &pool;
+  }
+  for (i = 0; i < nworkers; i++) *get_pool_ref (workers[i].btor) = &pool;
+  btor->cbs.term.termfun = terminate_main;
+
+  /* the walker on 'btor' runs in the current thread */
+  BTOR_NEWN (mm, threads, nworkers);
+  for (i = 1; i < nworkers; i++)
+    workers[i].threaded =
+        !pthread_create (&threads[i], 0, thread_work, &workers[i]);
+  /* walkers whose thread could not be created run in the current thread */
+  for (i = 1; i < nworkers; i++)
+  {
+    if (workers[i].threaded) continue;
+    btor_set_term (workers[i].btor, terminate_inline, &pool);
+    thread_work (&workers[i]);
+  }
+  thread_work (&workers[0]);
+  for (i = 1; i < nworkers; i++)
+    if (workers[i].threaded) pthread_join (threads[i], 0);
+  BTOR_DELETEN (mm, threads, nworkers);
+
+  btor->cbs.term.termfun = pool.termfun;
+  *get_pool_ref (btor)   = 0;
+
+  winner = pool.winner;
+  res    = winner ? winner->result : BTOR_RESULT_UNKNOWN;
+  if (res == BTOR_RESULT_SAT && winner->btor != btor)
+  {
+    btor_model_delete_bv (btor, &btor->bv_model);
+    btor->bv_model = btor_model_clone_bv (btor, winner->btor->bv_model, true);
+    btor_model_init_fun (btor, &btor->fun_model);
+  }
+  BTOR_MSG (btor->msg,
+            1,
+            "%u walkers, %u restarts from best assignment",
+            nworkers,
+            pool.nimports);
+  if (winner) BTOR_MSG (btor->msg, 1, "result found by walker %u", winner->id);
+
+  for (i = 1; i < nworkers; i++)
+  {
+    merge_stats (btor, workers[i].btor);
+    btor_delete (workers[i].btor);
+  }
+  BTOR_DELETEN (mm, workers, nworkers);
+
+  delete_best (&pool);
+  btor_mem_mgr_delete (pool.mm);
+  pthread_mutex_destroy (&pool.mutex);
+  return res;
+}
+#endif
@@ -9,9 +9,24 @@
 #ifndef BTORLSUTILS_H_INCLUDED
 #define BTORLSUTILS_H_INCLUDED
 
+#include "btornode.h"
+#include "btorslsutils.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 
+/* State shared between parallel local search walkers (see
+ * btor_lsutils_sat_parallel). */
+typedef struct BtorLSWorkerPool BtorLSWorkerPool;
+
+/**
+ * Collect the cone of influence of given inputs 'exps' (excluding 'exps'),
+ * sorted by id in ascending order.
+ * Returns the number of visited nodes (including 'exps').
+ */
+uint32_t btor_lsutils_collect_cone (Btor* btor,
+                                    BtorNodePtrStack* exps,
+                                    BtorNodePtrStack* cone);
+
 /**
  * Update cone of incluence as a consequence of a local search move.
  *
@@ -19,12 +34,17 @@
  *         + PROP engine: always
  *         + SLS  engine: only if an actual move is performed
  *                        (not during neighborhood exploration, 'try_move')
+ *
+ * If given, 'cone' is the cone of influence of 'exps' as collected via
+ * btor_lsutils_collect_cone (shared when trying several moves on the same
+ * set of inputs), else it is collected on the fly.
  */
 void btor_lsutils_update_cone (Btor* btor,
                                BtorIntHashTable* bv_model,
                                BtorIntHashTable* roots,
-                               BtorIntHashTable* score,
+                               BtorSLSScore* score,
                                BtorIntHashTable* exps,
+                               BtorNodePtrStack* cone,
                                bool update_roots,
                                uint64_t* stats_updates,
                                double* time_update_cone,
@@ -32,4 +52,27 @@ void btor_lsutils_update_cone (Btor* btor,
                                double* time_update_cone_model_gen,
                                double* time_update_cone_compute_score);
 
+#ifdef BTOR_HAVE_PTHREADS
+/**
+ * Run 'nworkers' walkers of the current local search engine (SLS or PROP) in
+ * parallel, one on 'btor' and one on each of 'nworkers' - 1 clones with
+ * different seeds. All walkers are stopped as soon as one of them determined
+ * a result. If a clone found a model, its model is copied to 'btor'.
+ */
+BtorSolverResult btor_lsutils_sat_parallel (Btor* btor, uint32_t nworkers);
+
+/**
+ * Restart the walker on 'btor' with 'nroots' unsatisfied roots.
+ * If 'nroots' is less than the number of unsatisfied roots of the best
+ * assignment in 'pool', the current assignment of the inputs becomes the
+ * new best assignment. If the best assignment in 'pool' has fewer unsatisfied
+ * roots than 'nroots', the walker restarts from the best assignment with
+ * probability BTOR_LSUTILS_PROB_RESTART_FROM_BEST. Else, it restarts from the
+ * initial model.
+ */
+void btor_lsutils_restart (Btor* btor,
+                           BtorLSWorkerPool* pool,
+                           uint32_t nroots);
+#endif
+
 #endif
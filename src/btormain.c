@@ -31,7 +31,7 @@
 typedef struct BtorMainApp BtorMainApp;
 static BtorMainApp *g_app;
 
-bool g_dual_threads;
+uint32_t g_quant_threads;
 static double g_start_time_real;
 static uint32_t g_verbosity;
 static uint32_t g_set_alarm;
@@ -870,10 +870,10 @@ print_static_stats (int32_t sat_res)
 #ifdef BTOR_TIME_STATISTICS
   double real = btor_util_current_time () - g_start_time_real;
   double process = btor_util_time_stamp ();
-  if (g_dual_threads)
+  if (g_quant_threads > 1)
     btormain_msg ("%.1f seconds process, %.0f%% utilization",
                   process,
-                  real > 0 ? (100 * process) / real / 2 : 0.0);
+                  real > 0 ? (100 * process) / real / g_quant_threads : 0.0);
   else
     btormain_msg ("%.1f seconds process", process);
   btormain_msg ("%.1f seconds real", real);
@@ -1446,9 +1446,19 @@ boolector_main (int32_t argc, char **argv)
   /* verbosity may have been increased via input (set-option) */
   g_verbosity = boolector_get_opt (btor, BTOR_OPT_VERBOSITY);
 
-  g_dual_threads =
-      boolector_get_opt (g_app->btor, BTOR_OPT_QUANT_DUAL_SOLVER) == 1
-      && g_app->btor->quantifiers->count > 0;
+  g_quant_threads = 1;
+  if (g_app->btor->quantifiers->count > 0)
+  {
+    g_quant_threads = boolector_get_opt (g_app->btor, BTOR_OPT_QUANT_WORKERS);
+    if (boolector_get_opt (g_app->btor, BTOR_OPT_QUANT_DUAL_SOLVER) == 1
+        && g_quant_threads < 2)
+      g_quant_threads = 2;
+  }
+  else if (boolector_get_opt (g_app->btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_SLS)
+    g_quant_threads = boolector_get_opt (g_app->btor, BTOR_OPT_SLS_WORKERS);
+  else if (boolector_get_opt (g_app->btor, BTOR_OPT_ENGINE)
+           == BTOR_ENGINE_PROP)
+    g_quant_threads = boolector_get_opt (g_app->btor, BTOR_OPT_PROP_WORKERS);
 
   if (parse_res == BOOLECTOR_PARSE_ERROR)
   {
@@ -2664,7 +2664,8 @@ btormbt_state_opt (BtorMBT *mbt)
         || btoropt_engine->val == BTOR_ENGINE_SLS
         || (btoropt_engine->val == BTOR_ENGINE_FUN
             && (btor_opt_get (mbt->btor, BTOR_OPT_FUN_PREPROP)
-                || btor_opt_get (mbt->btor, BTOR_OPT_FUN_PRESLS))))
+                || btor_opt_get (mbt->btor, BTOR_OPT_FUN_PRESLS)
+                || btor_opt_get (mbt->btor, BTOR_OPT_FUN_SCHEDULE))))
     {
       /* reset if forced engine does not support QF_(AUF)BV */
       mbt->round.logic = BTORMBT_LOGIC_QF_BV;
@@ -2803,23 +2804,8 @@ btormbt_state_opt (BtorMBT *mbt)
     }
 
     /* avoid invalid option combinations */
-    // FIXME remove as soon as ucopt works with mgen
-    /* do not enable unconstrained optimization if either model
-     * generation or incremental is enabled */
-    if (btoropt->kind == BTOR_OPT_UCOPT
-        && (boolector_get_opt (mbt->btor, BTOR_OPT_MODEL_GEN)
-            || boolector_get_opt (mbt->btor, BTOR_OPT_INCREMENTAL)))
-    {
-      continue;
-    }
-    else if ((btoropt->kind == BTOR_OPT_MODEL_GEN
-              || btoropt->kind == BTOR_OPT_INCREMENTAL)
-             && boolector_get_opt (mbt->btor, BTOR_OPT_UCOPT))
-    {
-      continue;
-    }
     /* do not enable justification if dual propagation is enabled */
-    else if (btoropt->kind == BTOR_OPT_FUN_JUST
+    if (btoropt->kind == BTOR_OPT_FUN_JUST
              && boolector_get_opt (mbt->btor, BTOR_OPT_FUN_DUAL_PROP))
     {
       continue;
@@ -126,7 +126,7 @@ btor_model_remove_from_bv (Btor *btor,
   btor_node_release (btor, exp);
   if (btor_hashint_map_contains (bv_model, -id))
   {
-    btor_hashint_map_remove (bv_model, id, &d);
+    btor_hashint_map_remove (bv_model, -id, &d);
     btor_bv_free (btor->mm, d.as_ptr);
     btor_node_release (btor, exp);
   }
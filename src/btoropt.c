@@ -279,6 +279,11 @@ btor_opt_init_opts (Btor *btor)
                 "aigprop",
                 BTOR_ENGINE_AIGPROP,
                 "use the propagation-based local search engine (QF_BV only)");
+  add_opt_help (mm,
+                opts,
+                "auto",
+                BTOR_ENGINE_AUTO,
+                "select engine and configuration based on formula features");
   add_opt_help (mm,
                 opts,
                 "fun",
@@ -525,6 +530,83 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "normalize add/mul/and operators");
+  init_opt (btor,
+            BTOR_OPT_BV_DOMAINS,
+            false,
+            true,
+            "bv-domains",
+            "bd",
+            0,
+            0,
+            1,
+            "propagation of known bits and intervals of bit-vector terms");
+  init_opt (btor,
+            BTOR_OPT_REDUCE_WIDTHS,
+            false,
+            true,
+            "reduce-widths",
+            "rdw",
+            0,
+            0,
+            1,
+            "bit-width reduction of variables and operators");
+  init_opt (btor,
+            BTOR_OPT_ELIMINATE_XORS,
+            false,
+            true,
+            "eliminate-xors",
+            "ex",
+            0,
+            0,
+            1,
+            "gaussian elimination of XOR constraints");
+  init_opt (btor,
+            BTOR_OPT_FRAIG,
+            false,
+            false,
+            "fraig",
+            0,
+            0,
+            0,
+            INT32_MAX,
+            "conflict limit per equivalence check of SAT sweeping on the "
+            "bit-blasted constraints (0: disable)");
+  init_opt (btor,
+            BTOR_OPT_AIG_REWRITE,
+            false,
+            false,
+            "aig-rewrite",
+            0,
+            0,
+            0,
+            16,
+            "max. number of rounds of AIG balancing, rewriting and "
+            "refactoring of the bit-blasted constraints (0: disable)");
+  init_opt (btor,
+            BTOR_OPT_AIG_CNF,
+            false,
+            false,
+            "aig-cnf",
+            0,
+            BTOR_AIG_CNF_DFLT,
+            BTOR_AIG_CNF_MIN,
+            BTOR_AIG_CNF_MAX,
+            "CNF encoding of the bit-blasted constraints");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmpoptval);
+  add_opt_help (
+      mm, opts, "tseitin", BTOR_AIG_CNF_TSEITIN, "Tseitin encoding");
+  add_opt_help (mm,
+                opts,
+                "pg",
+                BTOR_AIG_CNF_PG,
+                "polarity-aware Plaisted-Greenbaum encoding");
+  add_opt_help (mm,
+                opts,
+                "cut",
+                BTOR_AIG_CNF_CUT,
+                "Plaisted-Greenbaum encoding of cuts selected by area flow");
+  btor->options[BTOR_OPT_AIG_CNF].options = opts;
 
   /* FUN engine ---------------------------------------------------------- */
   init_opt (btor,
@@ -549,6 +631,27 @@ btor_opt_init_opts (Btor *btor)
             1,
             "run sls engine as preprocessing within a sequential portfolio "
             "(QF_BV only)");
+  init_opt (btor,
+            BTOR_OPT_FUN_SCHEDULE,
+            false,
+            true,
+            "fun-schedule",
+            0,
+            0,
+            0,
+            1,
+            "interleave prop engine and SAT solver in growing slices "
+            "(QF_BV only)");
+  init_opt (btor,
+            BTOR_OPT_FUN_SCHEDULE_UNIT,
+            false,
+            false,
+            "fun-schedule-unit",
+            0,
+            1000,
+            1,
+            UINT32_MAX,
+            "slice unit of --fun-schedule (propagation steps, conflicts)");
   init_opt (btor,
             BTOR_OPT_FUN_DUAL_PROP,
             false,
@@ -677,6 +780,64 @@ btor_opt_init_opts (Btor *btor)
             1,
             "represent array store as lambda");
 
+  init_opt (btor,
+            BTOR_OPT_FUN_LEMMA_BATCH,
+            false,
+            false,
+            "fun-lemma-batch",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "max. number of lemmas added per refinement iteration "
+            "(0: no limit)");
+
+  init_opt (btor,
+            BTOR_OPT_FUN_CONFLICT_THREADS,
+            false,
+            false,
+            "fun-conflict-threads",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "number of threads for conflict search over initial applies "
+            "(0: disable)");
+
+  init_opt (btor,
+            BTOR_OPT_FUN_BETA_CACHE,
+            false,
+            true,
+            "fun-beta-cache",
+            0,
+            0,
+            0,
+            1,
+            "cache partial beta reduction results within refinements");
+
+  init_opt (btor,
+            BTOR_OPT_FUN_STATIC_LEMMAS,
+            false,
+            false,
+            "fun-static-lemmas",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "max. number of read-over-write lemmas added eagerly "
+            "(0: disable)");
+  init_opt (btor,
+            BTOR_OPT_FUN_LAZY_BITBLAST,
+            false,
+            false,
+            "fun-lazy-bitblast",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "min. bit-width of multipliers and dividers that are bit-blasted "
+            "lazily (0: disable)");
+
   init_opt (
       btor,
       BTOR_OPT_PRINT_DIMACS,
@@ -902,6 +1063,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "use bandit scheme for constraint selection");
+  init_opt (btor,
+            BTOR_OPT_SLS_WORKERS,
+            false,
+            false,
+            "sls-workers",
+            0,
+            1,
+            1,
+            64,
+            "number of parallel walkers");
 
   /* PROP engine ---------------------------------------------------------- */
   init_opt (btor,
@@ -1107,6 +1278,27 @@ btor_opt_init_opts (Btor *btor)
             1,
             "do not perform a propagation move when encountering a conflict"
             "during inverse computation");
+  init_opt (btor,
+            BTOR_OPT_PROP_WORKERS,
+            false,
+            false,
+            "prop-workers",
+            0,
+            1,
+            1,
+            64,
+            "number of parallel walkers");
+  init_opt (btor,
+            BTOR_OPT_PROP_DOMAINS,
+            false,
+            true,
+            "prop-domains",
+            0,
+            0,
+            0,
+            1,
+            "restrict propagated values to domains derived from the "
+            "constraints");
 
   /* AIGPROP engine ------------------------------------------------------- */
   init_opt (btor,
@@ -1246,6 +1438,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "synthesize quantifier instantiations from counterexamples");
+  init_opt (btor,
+            BTOR_OPT_QUANT_WORKERS,
+            false,
+            false,
+            "quant-workers",
+            0,
+            1,
+            1,
+            64,
+            "number of parallel workers");
 
   /* internal options ---------------------------------------------------- */
   init_opt (btor,
@@ -1349,6 +1551,26 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "use CaDiCaL's freeze/melt API");
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_CADICAL_CONFLICTS,
+            true,
+            false,
+            "sat-engine-cadical-conflicts",
+            0,
+            0,
+            0,
+            INT32_MAX,
+            "conflict limit per CaDiCaL call (0: no limit)");
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_CADICAL_DECISIONS,
+            true,
+            false,
+            "sat-engine-cadical-decisions",
+            0,
+            0,
+            0,
+            INT32_MAX,
+            "decision limit per CaDiCaL call (0: no limit)");
   init_opt (btor,
             BTOR_OPT_SAT_ENGINE_N_THREADS,
             true,
@@ -1612,27 +1834,6 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
   else if (opt == BTOR_OPT_MODEL_GEN)
   {
     if (!val && btor_opt_get (btor, opt)) btor_model_delete (btor);
-    if (val && btor_opt_get (btor, BTOR_OPT_UCOPT))
-    {
-      btor_opt_set (btor, BTOR_OPT_UCOPT, 0);
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_UCOPT));
-  }
-  else if (opt == BTOR_OPT_UCOPT)
-  {
-    if (val && btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
-    {
-      BTOR_MSG (btor->msg,
-                1,
-                "Disabling unconstrained optimization since model generation "
-                "is enabled");
-      val = 0;
-    }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
   }
   else if (opt == BTOR_OPT_SAT_ENGINE)
   {
@@ -78,7 +78,7 @@ typedef struct BtorOptHelp BtorOptHelp;
 extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 
 #define BTOR_ENGINE_MIN BTOR_ENGINE_FUN
-#define BTOR_ENGINE_MAX BTOR_ENGINE_QUANT
+#define BTOR_ENGINE_MAX BTOR_ENGINE_AUTO
 #define BTOR_ENGINE_DFLT BTOR_ENGINE_FUN
 
 #define BTOR_INPUT_FORMAT_MIN BTOR_INPUT_FORMAT_NONE
@@ -125,6 +125,10 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_BETA_REDUCE_MAX BTOR_BETA_REDUCE_ALL
 #define BTOR_BETA_REDUCE_DFLT BTOR_BETA_REDUCE_NONE
 
+#define BTOR_AIG_CNF_MIN BTOR_AIG_CNF_TSEITIN
+#define BTOR_AIG_CNF_MAX BTOR_AIG_CNF_CUT
+#define BTOR_AIG_CNF_DFLT BTOR_AIG_CNF_TSEITIN
+
 /*------------------------------------------------------------------------*/
 
 void btor_opt_init_opts (Btor *btor);
@@ -8,6 +8,7 @@
 
 #include "btorproputils.h"
 
+#include "btorbvdomain.h"
 #include "btorprintmodel.h"
 #include "btorslsutils.h"
 #include "utils/btornodeiter.h"
@@ -1532,6 +1533,25 @@ cons_cond_bv (Btor *btor,
 /* Inverse value computation                                                  */
 /* ========================================================================== */
 
+/* Exclude 'bvexp' from the domain of 'exp'. */
+static bool
+refine_domain (Btor *btor,
+               BtorIntHashTable *domains,
+               BtorNode *exp,
+               BtorBitVector *bvexp)
+{
+  assert (btor);
+  assert (domains);
+  assert (btor_node_is_regular (exp));
+  assert (bvexp);
+
+  BtorHashTableData *d;
+
+  d = btor_hashint_map_get (domains, exp->id);
+  if (!d) return false;
+  return btor_bvdomain_exclude (btor->mm, d->as_ptr, bvexp);
+}
+
 static BtorBitVector *
 res_rec_conf (Btor *btor,
               BtorNode *exp,
@@ -1622,7 +1642,13 @@ res_rec_conf (Btor *btor,
     if (is_recoverable)
       BTOR_PROP_SOLVER (btor)->stats.rec_conf += 1;
     else
+    {
       BTOR_PROP_SOLVER (btor)->stats.non_rec_conf += 1;
+      /* 'e' is constant, hence 'exp' can never be assigned 'bvexp' */
+      if (BTOR_PROP_SOLVER (btor)->domains
+          && refine_domain (btor, BTOR_PROP_SOLVER (btor)->domains, exp, bvexp))
+        BTOR_PROP_SOLVER (btor)->stats.domain_refinements += 1;
+    }
     /* fix counter since we always increase the counter, even in the conflict
      * case */
     BTOR_PROP_SOLVER (btor)->stats.props_inv -= 1;
@@ -1687,6 +1713,301 @@ check_result_binary_dbg (Btor *btor,
 }
 #endif
 
+/* -------------------------------------------------------------------------- */
+/* Invertibility conditions                                                   */
+/* -------------------------------------------------------------------------- */
+
+/* An invertibility condition determines whether an inverse value for operand
+ * e[eidx] exists, i.e., whether there is an x s.t. x <> s = t (eidx = 0) or
+ * s <> x = t (eidx = 1), where s is the assignment of the other operand and
+ * t the target value. All conditions are exact, i.e., if a condition does not
+ * hold, the inverse value computation is skipped and the conflict is handled
+ * via res_rec_conf. */
+
+static bool
+record_inv_check (Btor *btor, bool is_inv)
+{
+  assert (btor);
+
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+  {
+    BTOR_PROP_SOLVER (btor)->stats.ic_checks += 1;
+    if (is_inv) BTOR_PROP_SOLVER (btor)->stats.ic_invertible += 1;
+  }
+  return is_inv;
+}
+
+/* Return shift amount 's' if it is less than the bit-width of 's', and the
+ * bit-width of 's' otherwise. */
+static uint32_t
+get_shift_amount (BtorMemMgr *mm, const BtorBitVector *s)
+{
+  assert (mm);
+  assert (s);
+
+  uint32_t bw;
+  uint64_t res;
+  BtorBitVector *tmp;
+
+  bw = btor_bv_get_width (s);
+  /* max bit width handled by Boolector is INT32_MAX */
+  if (bw - btor_bv_get_num_leading_zeros (s) > 32) return bw;
+  if (bw <= 64)
+  {
+    res = btor_bv_to_uint64 (s);
+  }
+  else
+  {
+    tmp = btor_bv_slice (mm, s, 31, 0);
+    res = btor_bv_to_uint64 (tmp);
+    btor_bv_free (mm, tmp);
+  }
+  return res < bw ? (uint32_t) res : bw;
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_and (BtorMemMgr *mm,
+            const BtorBitVector *t,
+            const BtorBitVector *s,
+            int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (eidx >= 0 && eidx <= 1);
+  (void) eidx;
+
+  bool res;
+  BtorBitVector *tmp;
+
+  /* x & s = s & x = t: t & s = t */
+  tmp = btor_bv_and (mm, t, s);
+  res = btor_bv_compare (tmp, t) == 0;
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_ult (BtorMemMgr *mm,
+            const BtorBitVector *t,
+            const BtorBitVector *s,
+            int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) == 1);
+  assert (eidx >= 0 && eidx <= 1);
+  (void) mm;
+
+  if (btor_bv_is_zero (t)) return true;
+  /* s < x = 1: s != 1...1
+   * x < s = 1: s != 0 */
+  return eidx ? !btor_bv_is_ones (s) : !btor_bv_is_zero (s);
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_sll (BtorMemMgr *mm,
+            const BtorBitVector *t,
+            const BtorBitVector *s,
+            int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) == btor_bv_get_width (s));
+  assert (eidx >= 0 && eidx <= 1);
+
+  bool res;
+  uint32_t ctz_s, ctz_t;
+  BtorBitVector *tmp;
+
+  ctz_t = btor_bv_get_num_trailing_zeros (t);
+
+  /* x << s = t: number of 0-LSBs in t >= s */
+  if (!eidx) return ctz_t >= get_shift_amount (mm, s);
+
+  /* s << x = t: t = 0 or s << (ctz(t) - ctz(s)) = t */
+  if (btor_bv_is_zero (t)) return true;
+  ctz_s = btor_bv_get_num_trailing_zeros (s);
+  if (ctz_s > ctz_t) return false;
+  tmp = btor_bv_sll_uint64 (mm, s, ctz_t - ctz_s);
+  res = btor_bv_compare (tmp, t) == 0;
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_srl (BtorMemMgr *mm,
+            const BtorBitVector *t,
+            const BtorBitVector *s,
+            int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) == btor_bv_get_width (s));
+  assert (eidx >= 0 && eidx <= 1);
+
+  bool res;
+  uint32_t clz_s, clz_t;
+  BtorBitVector *tmp;
+
+  clz_t = btor_bv_get_num_leading_zeros (t);
+
+  /* x >> s = t: number of 0-MSBs in t >= s */
+  if (!eidx) return clz_t >= get_shift_amount (mm, s);
+
+  /* s >> x = t: t = 0 or s >> (clz(t) - clz(s)) = t */
+  if (btor_bv_is_zero (t)) return true;
+  clz_s = btor_bv_get_num_leading_zeros (s);
+  if (clz_s > clz_t) return false;
+  tmp = btor_bv_srl_uint64 (mm, s, clz_t - clz_s);
+  res = btor_bv_compare (tmp, t) == 0;
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_mul (BtorMemMgr *mm,
+            const BtorBitVector *t,
+            const BtorBitVector *s,
+            int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) == btor_bv_get_width (s));
+  assert (eidx >= 0 && eidx <= 1);
+  (void) mm;
+  (void) eidx;
+
+  /* x * s = s * x = t: ((-s | s) & t) = t, i.e.,
+   * number of 0-LSBs in t >= number of 0-LSBs in s */
+  if (btor_bv_is_zero (s)) return btor_bv_is_zero (t);
+  return btor_bv_get_num_trailing_zeros (t)
+         >= btor_bv_get_num_trailing_zeros (s);
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_udiv (BtorMemMgr *mm,
+             const BtorBitVector *t,
+             const BtorBitVector *s,
+             int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) == btor_bv_get_width (s));
+  assert (eidx >= 0 && eidx <= 1);
+
+  bool res;
+  BtorBitVector *tmp, *tmp2;
+
+  /* x / s = t: (s * t) / s = t, i.e., s * t does not overflow */
+  if (!eidx)
+  {
+    if (btor_bv_is_zero (s)) return btor_bv_is_ones (t);
+    return !btor_bv_is_umulo (mm, s, t);
+  }
+
+  /* s / x = t: s / (s / t) = t */
+  tmp  = btor_bv_udiv (mm, s, t);
+  tmp2 = btor_bv_udiv (mm, s, tmp);
+  res  = btor_bv_compare (tmp2, t) == 0;
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, tmp2);
+  return res;
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_urem (BtorMemMgr *mm,
+             const BtorBitVector *t,
+             const BtorBitVector *s,
+             int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) == btor_bv_get_width (s));
+  assert (eidx >= 0 && eidx <= 1);
+
+  bool res;
+  int32_t cmp;
+  BtorBitVector *tmp;
+
+  /* x % s = t: ~(-s) >= t, i.e., s = 0 (x = t) or t < s */
+  if (!eidx) return btor_bv_is_zero (s) || btor_bv_compare (t, s) < 0;
+
+  /* s % x = t: s = t (x = 0) or s - t > t (x = s - t) */
+  cmp = btor_bv_compare (s, t);
+  if (cmp <= 0) return cmp == 0;
+  tmp = btor_bv_sub (mm, s, t);
+  res = btor_bv_compare (tmp, t) > 0;
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+#ifdef NDEBUG
+static bool
+#else
+bool
+#endif
+is_inv_concat (BtorMemMgr *mm,
+               const BtorBitVector *t,
+               const BtorBitVector *s,
+               int32_t eidx)
+{
+  assert (mm);
+  assert (t);
+  assert (s);
+  assert (btor_bv_get_width (t) > btor_bv_get_width (s));
+  assert (eidx >= 0 && eidx <= 1);
+
+  bool res;
+  uint32_t bw_t, bw_s;
+  BtorBitVector *tmp;
+
+  bw_t = btor_bv_get_width (t);
+  bw_s = btor_bv_get_width (s);
+
+  /* s o x = t: s = t[bw_t - 1 : bw_t - bw_s]
+   * x o s = t: s = t[bw_s - 1 : 0] */
+  tmp = eidx ? btor_bv_slice (mm, t, bw_t - 1, bw_t - bw_s)
+             : btor_bv_slice (mm, t, bw_s - 1, 0);
+  res = btor_bv_compare (tmp, s) == 0;
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
 /* -------------------------------------------------------------------------- */
 /* INV: and                                                                   */
 /* -------------------------------------------------------------------------- */
@@ -1771,6 +2092,12 @@ inv_and_bv (Btor *btor,
   e  = and->e[eidx ? 0 : 1];
   assert (e);
 
+  if (!record_inv_check (btor, is_inv_and (mm, bvand, bve, eidx)))
+  {
+    /* CONFLICT: all bits set in bvand, must be set in bve ------------------ */
+    return res_rec_conf (btor, and, e, bvand, bve, eidx, cons_and_bv, "AND");
+  }
+
   b = btor_rng_pick_with_prob (
       &btor->rng, btor_opt_get (btor, BTOR_OPT_PROP_PROB_AND_FLIP));
   BTOR_INIT_STACK (mm, dcbits);
@@ -1782,14 +2109,7 @@ inv_and_bv (Btor *btor,
   {
     bitand = btor_bv_get_bit (bvand, i);
     bite   = btor_bv_get_bit (bve, i);
-
-    if (bitand&&!bite)
-    {
-      /* CONFLICT: all bits set in bvand, must be set in bve ---------------- */
-      btor_bv_free (mm, res);
-      res = res_rec_conf (btor, and, e, bvand, bve, eidx, cons_and_bv, "AND");
-      goto DONE;
-    }
+    assert (!bitand || bite);
 
     /* ----------------------------------------------------------------------
      * res & bve = bve & res = bvand
@@ -1820,7 +2140,6 @@ inv_and_bv (Btor *btor,
       btor, btor_bv_and, and, bve, bvand, res, eidx, "AND");
 #endif
 
-DONE:
   BTOR_RELEASE_STACK (dcbits);
   return res;
 }
@@ -1927,9 +2246,6 @@ inv_ult_bv (Btor *btor,
   BtorNode *e;
   BtorBitVector *res, *zero, *one, *bvmax, *tmp;
   BtorMemMgr *mm;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -1943,6 +2259,12 @@ inv_ult_bv (Btor *btor,
   e  = ult->e[eidx ? 0 : 1];
   assert (e);
 
+  if (!record_inv_check (btor, is_inv_ult (mm, bvult, bve, eidx)))
+  {
+    /* CONFLICT: 1...1 < e[1] or e[0] < 0 ----------------------------------- */
+    return res_rec_conf (btor, ult, e, bvult, bve, eidx, cons_ult_bv, "<");
+  }
+
   bw    = btor_bv_get_width (bve);
   zero  = btor_bv_new (mm, bw);
   one   = btor_bv_one (mm, bw);
@@ -1953,59 +2275,37 @@ inv_ult_bv (Btor *btor,
 
   if (eidx)
   {
-    if (!btor_bv_compare (bve, bvmax) && isult)
+    if (!isult)
     {
-    BVULT_CONF:
-      /* CONFLICT: 1...1 < e[1] --------------------------------------------- */
-      res = res_rec_conf (btor, ult, e, bvult, bve, eidx, cons_ult_bv, "<");
-#ifndef NDEBUG
-      is_inv = false;
-#endif
+      /* bve >= e[1] -------------------------------------------------------- */
+      res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, bve);
     }
     else
     {
-      if (!isult)
-      {
-        /* bve >= e[1] ------------------------------------------------------ */
-        res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, bve);
-      }
-      else
-      {
-        /* bve < e[1] ------------------------------------------------------- */
-        tmp = btor_bv_add (mm, bve, one);
-        res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
-        btor_bv_free (mm, tmp);
-      }
+      /* bve < e[1] --------------------------------------------------------- */
+      tmp = btor_bv_add (mm, bve, one);
+      res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
+      btor_bv_free (mm, tmp);
     }
   }
   else
   {
-    if (btor_bv_is_zero (bve) && isult)
+    if (!isult)
     {
-      /* CONFLICT: e[0] < 0 ------------------------------------------------- */
-      goto BVULT_CONF;
+      /* e[0] >= bve -------------------------------------------------------- */
+      res = btor_bv_new_random_range (mm, &btor->rng, bw, bve, bvmax);
     }
     else
     {
-      if (!isult)
-      {
-        /* e[0] >= bve ------------------------------------------------------ */
-        res = btor_bv_new_random_range (mm, &btor->rng, bw, bve, bvmax);
-      }
-      else
-      {
-        /* e[0] < bve ------------------------------------------------------- */
-        tmp = btor_bv_sub (mm, bve, one);
-        res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, tmp);
-        btor_bv_free (mm, tmp);
-      }
+      /* e[0] < bve --------------------------------------------------------- */
+      tmp = btor_bv_sub (mm, bve, one);
+      res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, tmp);
+      btor_bv_free (mm, tmp);
     }
   }
 
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_ult, ult, bve, bvult, res, eidx, "<");
+  check_result_binary_dbg (btor, btor_bv_ult, ult, bve, bvult, res, eidx, "<");
 #endif
   btor_bv_free (mm, zero);
   btor_bv_free (mm, one);
@@ -2036,13 +2336,10 @@ inv_sll_bv (Btor *btor,
   assert (btor_bv_get_width (bve) == btor_bv_get_width (bvsll));
   assert (!btor_node_is_bv_const (sll->e[eidx]));
 
-  uint32_t i, j, ctz_bve, ctz_bvsll, shift, bw;
+  uint32_t i, ctz_bve, ctz_bvsll, shift, bw;
   BtorNode *e;
   BtorBitVector *res, *tmp, *bvmax;
   BtorMemMgr *mm;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -2055,6 +2352,12 @@ inv_sll_bv (Btor *btor,
   mm = btor->mm;
   e  = sll->e[eidx ? 0 : 1];
   assert (e);
+
+  if (!record_inv_check (btor, is_inv_sll (mm, bvsll, bve, eidx)))
+  {
+    /* CONFLICT: shifted bits must match ------------------------------------ */
+    return res_rec_conf (btor, sll, e, bvsll, bve, eidx, cons_sll_bv, "<<");
+  }
   bw = btor_bv_get_width (bvsll);
 
   res = 0;
@@ -2076,48 +2379,28 @@ inv_sll_bv (Btor *btor,
     }
     else
     {
-      /* -> ctz(bve) > ctz (bvsll) -> conflict
-       * -> shift = ctz(bvsll) - ctz(bve)
+      /* -> shift = ctz(bvsll) - ctz(bve)
        *      -> if bvsll = 0 choose shift <= res < bw
        *      -> else res = shift
-       *           + if all remaining shifted bits match
-       * -> else conflict
        * -------------------------------------------------------------------- */
-      ctz_bve   = btor_bv_get_num_trailing_zeros (bve);
-      if (ctz_bve <= ctz_bvsll)
-      {
-        shift = ctz_bvsll - ctz_bve;
-
-        if (btor_bv_is_zero (bvsll))
-        {
-          /* x...x0 << e[1] = 0...0
-           * -> choose random shift <= res < 2^bw
-           * ---------------------------------------------------------------- */
-          bvmax = btor_bv_ones (mm, bw);
-          tmp   = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
-          res   = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
-          btor_bv_free (mm, bvmax);
-          btor_bv_free (mm, tmp);
-        }
-        else
-        {
-          for (i = 0, j = shift, res = 0; i < bw - j; i++)
-          {
-            /* CONFLICT: shifted bits must match ---------------------------- */
-            if (btor_bv_get_bit (bve, i) != btor_bv_get_bit (bvsll, j + i))
-              goto BVSLL_CONF;
-          }
+      ctz_bve = btor_bv_get_num_trailing_zeros (bve);
+      assert (ctz_bve <= ctz_bvsll);
+      shift = ctz_bvsll - ctz_bve;
 
-          res = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
-        }
+      if (btor_bv_is_zero (bvsll))
+      {
+        /* x...x0 << e[1] = 0...0
+         * -> choose random shift <= res < 2^bw
+         * ------------------------------------------------------------------ */
+        bvmax = btor_bv_ones (mm, bw);
+        tmp   = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
+        res   = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
+        btor_bv_free (mm, bvmax);
+        btor_bv_free (mm, tmp);
       }
       else
       {
-      BVSLL_CONF:
-        res = res_rec_conf (btor, sll, e, bvsll, bve, eidx, cons_sll_bv, "<<");
-#ifndef NDEBUG
-        is_inv = false;
-#endif
+        res = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
       }
     }
   }
@@ -2129,27 +2412,11 @@ inv_sll_bv (Btor *btor,
    * ------------------------------------------------------------------------ */
   else
   {
-    /* actual value is small enough to fit into 32 bit (max bit width handled
-     * by Boolector is INT32_MAX) */
-    if (bw > 64)
-    {
-      tmp   = btor_bv_slice (mm, bve, 32, 0);
-      shift = btor_bv_to_uint64 (tmp);
-      btor_bv_free (mm, tmp);
-    }
-    else
-    {
-      shift = btor_bv_to_uint64 (bve);
-    }
-
-    if ((shift < bw && ctz_bvsll < shift) || (shift >= bw && ctz_bvsll != bw))
-    {
-      /* CONFLICT: the LSBs shifted must be zero ---------------------------- */
-      goto BVSLL_CONF;
-    }
+    shift = get_shift_amount (mm, bve);
+    assert (ctz_bvsll >= shift);
 
     res = btor_bv_srl (mm, bvsll, bve);
-    for (i = 0; i < shift && i < bw; i++)
+    for (i = 0; i < shift; i++)
     {
       btor_bv_set_bit (res,
                        btor_bv_get_width (res) - 1 - i,
@@ -2157,9 +2424,7 @@ inv_sll_bv (Btor *btor,
     }
   }
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_sll, sll, bve, bvsll, res, eidx, "<<");
+  check_result_binary_dbg (btor, btor_bv_sll, sll, bve, bvsll, res, eidx, "<<");
 #endif
   return res;
 }
@@ -2187,13 +2452,10 @@ inv_srl_bv (Btor *btor,
   assert (btor_bv_get_width (bve) == btor_bv_get_width (bvsrl));
   assert (!btor_node_is_bv_const (srl->e[eidx]));
 
-  uint32_t i, j, clz_bve, clz_bvsrl, shift, bw;
+  uint32_t i, clz_bve, clz_bvsrl, shift, bw;
   BtorNode *e;
   BtorBitVector *res, *bvmax, *tmp;
   BtorMemMgr *mm;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -2206,6 +2468,12 @@ inv_srl_bv (Btor *btor,
   mm = btor->mm;
   e  = srl->e[eidx ? 0 : 1];
   assert (e);
+
+  if (!record_inv_check (btor, is_inv_srl (mm, bvsrl, bve, eidx)))
+  {
+    /* CONFLICT: shifted bits must match ------------------------------------ */
+    return res_rec_conf (btor, srl, e, bvsrl, bve, eidx, cons_srl_bv, ">>");
+  }
   bw = btor_bv_get_width (bvsrl);
 
   res = 0;
@@ -2227,52 +2495,28 @@ inv_srl_bv (Btor *btor,
     }
     else
     {
-      /* clz(bve) > clz(bvsrl) -> conflict
-       *
-       * -> shift = clz(bvsrl) - clz(bve)
+      /* -> shift = clz(bvsrl) - clz(bve)
        *      -> if bvsrl = 0 choose shift <= res < bw
        *      -> else res = shift
-       *           + if all remaining shifted bits match
-       * -> else conflict
        * -------------------------------------------------------------------- */
-      clz_bve   = btor_bv_get_num_leading_zeros (bve);
-      if (clz_bve <= clz_bvsrl)
-      {
-        shift = clz_bvsrl - clz_bve;
-
-        if (btor_bv_is_zero (bvsrl))
-        {
-          /* x...x0 >> e[1] = 0...0
-           * -> choose random shift <= res < 2^bw
-           * ---------------------------------------------------------------- */
-          bvmax = btor_bv_ones (mm, bw);
-          tmp   = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
-          res   = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
-          btor_bv_free (mm, bvmax);
-          btor_bv_free (mm, tmp);
-        }
-        else
-        {
-          for (i = 0, j = shift, res = 0; i < bw - j; i++)
-          {
-            if (btor_bv_get_bit (bve, bw - 1 - i)
-                != btor_bv_get_bit (bvsrl, bw - 1 - (j + i)))
-            {
-              /* CONFLICT: shifted bits must match -------------------------- */
-              goto BVSRL_CONF;
-            }
-          }
+      clz_bve = btor_bv_get_num_leading_zeros (bve);
+      assert (clz_bve <= clz_bvsrl);
+      shift = clz_bvsrl - clz_bve;
 
-          res = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
-        }
+      if (btor_bv_is_zero (bvsrl))
+      {
+        /* x...x0 >> e[1] = 0...0
+         * -> choose random shift <= res < 2^bw
+         * ------------------------------------------------------------------ */
+        bvmax = btor_bv_ones (mm, bw);
+        tmp   = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
+        res   = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
+        btor_bv_free (mm, bvmax);
+        btor_bv_free (mm, tmp);
       }
       else
       {
-      BVSRL_CONF:
-        res = res_rec_conf (btor, srl, e, bvsrl, bve, eidx, cons_srl_bv, ">>");
-#ifndef NDEBUG
-        is_inv = false;
-#endif
+        res = btor_bv_uint64_to_bv (mm, (uint64_t) shift, bw);
       }
     }
   }
@@ -2284,36 +2528,18 @@ inv_srl_bv (Btor *btor,
    * ------------------------------------------------------------------------ */
   else
   {
-    /* actual value is small enough to fit into 32 bit (max bit width handled
-     * by Boolector is INT32_MAX) */
-    if (bw > 64)
-    {
-      tmp   = btor_bv_slice (mm, bve, 32, 0);
-      shift = btor_bv_to_uint64 (tmp);
-      btor_bv_free (mm, tmp);
-    }
-    else
-    {
-      shift = btor_bv_to_uint64 (bve);
-    }
-
-    if ((shift < bw && clz_bvsrl < shift) || (shift >= bw && clz_bvsrl != bw))
-    {
-      /* CONFLICT: the MSBs shifted must be zero ---------------------------- */
-      goto BVSRL_CONF;
-    }
+    shift = get_shift_amount (mm, bve);
+    assert (clz_bvsrl >= shift);
 
     res = btor_bv_sll (mm, bvsrl, bve);
-    for (i = 0; i < shift && i < bw; i++)
+    for (i = 0; i < shift; i++)
     {
       btor_bv_set_bit (res, i, btor_rng_pick_rand (&btor->rng, 0, 1));
     }
   }
 
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_srl, srl, bve, bvsrl, res, eidx, ">>");
+  check_result_binary_dbg (btor, btor_bv_srl, srl, bve, bvsrl, res, eidx, ">>");
 #endif
   return res;
 }
@@ -2341,14 +2567,11 @@ inv_mul_bv (Btor *btor,
   assert (eidx >= 0 && eidx <= 1);
   assert (!btor_node_is_bv_const (mul->e[eidx]));
 
-  int32_t lsbve, lsbvmul, ispow2_bve;
+  int32_t ispow2_bve;
   uint32_t i, j, bw;
   BtorBitVector *res, *inv, *tmp, *tmp2;
   BtorMemMgr *mm;
   BtorNode *e;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -2361,6 +2584,12 @@ inv_mul_bv (Btor *btor,
   mm = btor->mm;
   e  = mul->e[eidx ? 0 : 1];
   assert (e);
+
+  if (!record_inv_check (btor, is_inv_mul (mm, bvmul, bve, eidx)))
+  {
+    /* CONFLICT: number of 0-LSBs in bvmul < number of 0-LSBs in bve -------- */
+    return res_rec_conf (btor, mul, e, bvmul, bve, eidx, cons_mul_bv, "*");
+  }
   bw = btor_bv_get_width (bvmul);
 
   res = 0;
@@ -2368,49 +2597,25 @@ inv_mul_bv (Btor *btor,
   /* ------------------------------------------------------------------------
    * bve * res = bvmul
    *
-   * -> if bve = 0: * bvmul = 0 -> choose random value for res
-   *                * bvmul > 0 -> conflict
-   *
-   * -> if bvmul odd and bve even -> conflict
+   * -> if bve = 0 (and thus bvmul = 0) -> choose random value for res
    *
    * -> if bve odd -> determine res via modular inverse (extended euklid)
    *                  (unique solution)
    *
    * -> else if bve is even (non-unique, multiple solutions possible!)
-   *      * bve = 2^n: + if number of 0-LSBs in bvmul < n -> conflict
-   *                   + else res = bvmul >> n
-   *                     (with all bits shifted in randomly set to 0 or 1)
+   *      * bve = 2^n: res = bvmul >> n
+   *                   (with all bits shifted in randomly set to 0 or 1)
    *      * else: bve = 2^n * m, m is odd
-   *              + if number of 0-LSBs in bvmul < n -> conflict
-   *              + else c' = bvmul >> n
-   *                (with all bits shifted in randomly set to 0 or 1)
-   *                -> res = c' * m^-1 (with m^-1 the mod inverse of m, m odd)
+   *              c' = bvmul >> n
+   *              (with all bits shifted in randomly set to 0 or 1)
+   *              -> res = c' * m^-1 (with m^-1 the mod inverse of m, m odd)
    * ------------------------------------------------------------------------ */
 
-  lsbve   = btor_bv_get_bit (bve, 0);
-  lsbvmul = btor_bv_get_bit (bvmul, 0);
-
   if (btor_bv_is_zero (bve))
   {
-    /* bve = 0 -> if bvmul = 0 choose random value, else conflict ----------- */
-    if (btor_bv_is_zero (bvmul))
-    {
-      res = btor_bv_new_random (mm, &btor->rng, bw);
-    }
-    else
-    {
-    BVMUL_CONF:
-      /* CONFLICT: bve = 0 but bvmul != 0 ----------------------------------- */
-      res = res_rec_conf (btor, mul, e, bvmul, bve, eidx, cons_mul_bv, "*");
-#ifndef NDEBUG
-      is_inv = false;
-#endif
-    }
-  }
-  else if (lsbvmul && !lsbve)
-  {
-    /* CONFLICT: bvmul odd and bve is even ---------------------------------- */
-    goto BVMUL_CONF;
+    /* bve = 0 -> bvmul = 0, choose random value ---------------------------- */
+    assert (btor_bv_is_zero (bvmul));
+    res = btor_bv_new_random (mm, &btor->rng, bw);
   }
   else
   {
@@ -2420,7 +2625,7 @@ inv_mul_bv (Btor *btor,
      * -> determine res via modular inverse (extended euklid)
      *    (unique solution)
      * ---------------------------------------------------------------------- */
-    if (lsbve)
+    if (btor_bv_get_bit (bve, 0))
     {
       inv = btor_bv_mod_inverse (mm, bve);
       res = btor_bv_mul (mm, inv, bvmul);
@@ -2430,85 +2635,63 @@ inv_mul_bv (Btor *btor,
      * bve even
      * (non-unique, multiple solutions possible!)
      *
-     * if bve = 2^n: + if number of 0-LSBs in bvmul < n -> conflict
-     *               + else res = bvmul >> n
-     *                      (with all bits shifted in set randomly)
+     * if bve = 2^n: res = bvmul >> n
+     *               (with all bits shifted in set randomly)
      * else: bve = 2^n * m, m is odd
-     *       + if number of 0-LSBs in bvmul < n -> conflict
-     *       + else c' = bvmul >> n (with all bits shifted in set randomly)
-     *         res = c' * m^-1 (with m^-1 the mod inverse of m)
+     *       c' = bvmul >> n (with all bits shifted in set randomly)
+     *       res = c' * m^-1 (with m^-1 the mod inverse of m)
      * ---------------------------------------------------------------------- */
     else
     {
+      j = btor_bv_get_num_trailing_zeros (bve);
+      assert (btor_bv_get_num_trailing_zeros (bvmul) >= j);
+
       if ((ispow2_bve = btor_bv_power_of_two (bve)) >= 0)
       {
-        for (i = 0; i < bw; i++)
-          if (btor_bv_get_bit (bvmul, i)) break;
-        if (i < (uint32_t) ispow2_bve)
-        {
-          /* CONFLICT: number of 0-LSBs in bvmul < n (for bve = 2^n) -------- */
-          goto BVMUL_CONF;
-        }
-        else
-        {
-          /* res = bvmul >> n with all bits shifted in set randomly
-           * (note: bw is not necessarily power of 2 -> do not use srl)
-           * ---------------------------------------------------------------- */
-          tmp = btor_bv_slice (mm, bvmul, bw - 1, ispow2_bve);
-          res = btor_bv_uext (mm, tmp, ispow2_bve);
-          assert (btor_bv_get_width (res) == bw);
-          for (i = 0; i < (uint32_t) ispow2_bve; i++)
-            btor_bv_set_bit (
-                res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
-          btor_bv_free (mm, tmp);
-        }
+        /* res = bvmul >> n with all bits shifted in set randomly
+         * (note: bw is not necessarily power of 2 -> do not use srl)
+         * ------------------------------------------------------------------ */
+        assert ((uint32_t) ispow2_bve == j);
+        tmp = btor_bv_slice (mm, bvmul, bw - 1, j);
+        res = btor_bv_uext (mm, tmp, j);
+        assert (btor_bv_get_width (res) == bw);
+        for (i = 0; i < j; i++)
+          btor_bv_set_bit (
+              res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
+        btor_bv_free (mm, tmp);
       }
       else
       {
-        for (i = 0; i < bw; i++)
-          if (btor_bv_get_bit (bvmul, i)) break;
-        for (j = 0; j < bw; j++)
-          if (btor_bv_get_bit (bve, j)) break;
-        if (i < j)
-        {
-          /* CONFLICT: number of 0-LSB in bvmul < number of 0-LSB in bve ---- */
-          goto BVMUL_CONF;
-        }
-        else
-        {
-          /* c' = bvmul >> n (with all bits shifted in set randomly)
-           * (note: bw is not necessarily power of 2 -> do not use srl)
-           * -> res = c' * m^-1 (with m^-1 the mod inverse of m, m odd)
-           * ---------------------------------------------------------------- */
-          tmp = btor_bv_slice (mm, bvmul, bw - 1, j);
-          res = btor_bv_uext (mm, tmp, j);
-          assert (btor_bv_get_width (res) == bw);
-          btor_bv_free (mm, tmp);
+        /* c' = bvmul >> n (with all bits shifted in set randomly)
+         * (note: bw is not necessarily power of 2 -> do not use srl)
+         * -> res = c' * m^-1 (with m^-1 the mod inverse of m, m odd)
+         * ------------------------------------------------------------------ */
+        tmp = btor_bv_slice (mm, bvmul, bw - 1, j);
+        res = btor_bv_uext (mm, tmp, j);
+        assert (btor_bv_get_width (res) == bw);
+        btor_bv_free (mm, tmp);
 
-          tmp  = btor_bv_slice (mm, bve, bw - 1, j);
-          tmp2 = btor_bv_uext (mm, tmp, j);
-          assert (btor_bv_get_width (tmp2) == bw);
-          assert (btor_bv_get_bit (tmp2, 0));
-          inv = btor_bv_mod_inverse (mm, tmp2);
-          btor_bv_free (mm, tmp);
-          btor_bv_free (mm, tmp2);
-          tmp = res;
-          res = btor_bv_mul (mm, tmp, inv);
-          /* choose one of all possible values */
-          for (i = 0; i < j; i++)
-            btor_bv_set_bit (
-                res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
-          btor_bv_free (mm, tmp);
-          btor_bv_free (mm, inv);
-        }
+        tmp  = btor_bv_slice (mm, bve, bw - 1, j);
+        tmp2 = btor_bv_uext (mm, tmp, j);
+        assert (btor_bv_get_width (tmp2) == bw);
+        assert (btor_bv_get_bit (tmp2, 0));
+        inv = btor_bv_mod_inverse (mm, tmp2);
+        btor_bv_free (mm, tmp);
+        btor_bv_free (mm, tmp2);
+        tmp = res;
+        res = btor_bv_mul (mm, tmp, inv);
+        /* choose one of all possible values */
+        for (i = 0; i < j; i++)
+          btor_bv_set_bit (
+              res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
+        btor_bv_free (mm, tmp);
+        btor_bv_free (mm, inv);
       }
     }
   }
 
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_mul, mul, bve, bvmul, res, eidx, "*");
+  check_result_binary_dbg (btor, btor_bv_mul, mul, bve, bvmul, res, eidx, "*");
 #endif
   return res;
 }
@@ -2541,9 +2724,6 @@ inv_udiv_bv (Btor *btor,
   BtorBitVector *res, *lo, *up, *one, *bvmax, *tmp;
   BtorMemMgr *mm;
   BtorRNG *rng;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -2557,6 +2737,12 @@ inv_udiv_bv (Btor *btor,
   rng = &btor->rng;
   e   = udiv->e[eidx ? 0 : 1];
   assert (e);
+
+  if (!record_inv_check (btor, is_inv_udiv (mm, bvudiv, bve, eidx)))
+  {
+    /* CONFLICT ------------------------------------------------------------- */
+    return res_rec_conf (btor, udiv, e, bvudiv, bve, eidx, cons_udiv_bv, "/");
+  }
   bw = btor_bv_get_width (bve);
 
   one   = btor_bv_one (mm, bw);
@@ -2571,8 +2757,6 @@ inv_udiv_bv (Btor *btor,
    *                          + bve != bvudiv -> e[1] = 0
    * -> if bvudiv = 0 and 0 < bve < 2^bw - 1 choose random e[1] > bve
    *                  and bve = 0            choose random e[1] > 0
-   *                  else conflict
-   * -> if bve < bvudiv -> conflict
    * -> if bvudiv is a divisor of bve choose with 0.5 prob out of
    *      + e[1] = bvudiv / bve
    *      + choose bve s.t. bve / e[1] = bvudiv
@@ -2603,31 +2787,19 @@ inv_udiv_bv (Btor *btor,
         /* bvudiv = 0 and bve = 0 -> choose random e[1] > 0 ----------------- */
         res = btor_bv_new_random_range (mm, rng, bw, one, bvmax);
       }
-      else if (btor_bv_compare (bve, bvmax))
+      else
       {
         /* bvudiv = 0 and 0 < bve < 2^bw - 1 -> choose random e[1] > bve ---- */
+        assert (btor_bv_compare (bve, bvmax));
         tmp = btor_bv_inc (mm, bve);
         res = btor_bv_new_random_range (mm, rng, bw, tmp, bvmax);
         btor_bv_free (mm, tmp);
       }
-      else
-      {
-      BVUDIV_CONF:
-        /* CONFLICT --------------------------------------------------------- */
-        res =
-            res_rec_conf (btor, udiv, e, bvudiv, bve, eidx, cons_udiv_bv, "/");
-#ifndef NDEBUG
-        is_inv = false;
-#endif
-      }
-    }
-    else if (btor_bv_compare (bve, bvudiv) < 0)
-    {
-      /* CONFLICT: bve < bvudiv --------------------------------------------- */
-      goto BVUDIV_CONF;
     }
     else
     {
+      assert (btor_bv_compare (bve, bvudiv) >= 0);
+
       /* if bvudiv is a divisor of bve, choose e[1] = bve / bvudiv
        * with prob = 0.5 and a bve s.t. bve / e[1] = bvudiv otherwise
        * -------------------------------------------------------------------- */
@@ -2645,8 +2817,7 @@ inv_udiv_bv (Btor *btor,
 
         /* determine upper and lower bounds for e[1]:
          * up = bve / bvudiv
-         * lo = bve / (bvudiv + 1) + 1
-         * if lo > up -> conflict */
+         * lo = bve / (bvudiv + 1) + 1 */
         btor_bv_free (mm, tmp);
         up  = btor_bv_udiv (mm, bve, bvudiv); /* upper bound */
         tmp = btor_bv_inc (mm, bvudiv);
@@ -2655,21 +2826,12 @@ inv_udiv_bv (Btor *btor,
         tmp = lo;
         lo  = btor_bv_inc (mm, tmp); /* lower bound (incl.) */
         btor_bv_free (mm, tmp);
+        assert (btor_bv_compare (lo, up) <= 0);
 
-        if (btor_bv_compare (lo, up) > 0)
-        {
-          /* CONFLICT: lo > up ---------------------------------------------- */
-          btor_bv_free (mm, lo);
-          btor_bv_free (mm, up);
-          goto BVUDIV_CONF;
-        }
-        else
-        {
-          /* choose lo <= e[1] <= up ---------------------------------------- */
-          res = btor_bv_new_random_range (mm, rng, bw, lo, up);
-          btor_bv_free (mm, lo);
-          btor_bv_free (mm, up);
-        }
+        /* choose lo <= e[1] <= up ------------------------------------------ */
+        res = btor_bv_new_random_range (mm, rng, bw, lo, up);
+        btor_bv_free (mm, lo);
+        btor_bv_free (mm, up);
       }
     }
   }
@@ -2679,9 +2841,7 @@ inv_udiv_bv (Btor *btor,
    *
    * -> if bvudiv = 2^bw - 1 and bve = 1 e[0] = 2^bw-1
    *                         and bve = 0, choose random e[0] > 0
-   *                         and bve > 0 -> conflict
-   * -> if bve = 0 and bvudiv < 2^bw - 1 -> conflict
-   * -> if bve * bvudiv does not overflow, choose with 0.5 prob out of
+   * -> bve * bvudiv does not overflow, choose with 0.5 prob out of
    *      + e[0] = bve * bvudiv
    *      + choose bve s.t. e[0] / bve = bvudiv
    * -> else choose bve s.t. e[0] / bve = bvudiv
@@ -2695,69 +2855,54 @@ inv_udiv_bv (Btor *btor,
         /* bvudiv = 2^bw-1 and bve = 1 -> e[0] = 2^bw-1 --------------------- */
         res = btor_bv_copy (mm, bvmax);
       }
-      else if (btor_bv_is_zero (bve))
+      else
       {
         /* bvudiv = 2^bw - 1 and bve = 0 -> choose random e[0] -------------- */
+        assert (btor_bv_is_zero (bve));
         res = btor_bv_new_random (mm, rng, bw);
       }
-      else
-      {
-        /* CONFLICT --------------------------------------------------------- */
-        goto BVUDIV_CONF;
-      }
-    }
-    else if (btor_bv_is_zero (bve))
-    {
-      /* CONFLICT: bve = 0 and bvudiv < 2^bw - 1 ---------------------------- */
-      goto BVUDIV_CONF;
     }
     else
     {
-      /* if bve * bvudiv does not overflow, choose e[0] = bve * bvudiv
+      /* bve * bvudiv does not overflow, choose e[0] = bve * bvudiv
        * with prob = 0.5 and a bve s.t. e[0] / bve = bvudiv otherwise */
+      assert (!btor_bv_is_zero (bve));
+      assert (!btor_bv_is_umulo (mm, bve, bvudiv));
 
-      if (btor_bv_is_umulo (mm, bve, bvudiv))
-      {
-        /* CONFLICT: overflow: bve * bvudiv --------------------------------- */
-        goto BVUDIV_CONF;
-      }
+      if (btor_rng_pick_with_prob (rng, 500))
+        res = btor_bv_mul (mm, bve, bvudiv);
       else
       {
-        if (btor_rng_pick_with_prob (rng, 500))
-          res = btor_bv_mul (mm, bve, bvudiv);
+        /* choose e[0] out of all options that yield
+         * e[0] / bve = bvudiv
+         * Note: udiv always truncates the results towards 0.
+         * ------------------------------------------------------------------ */
+
+        /* determine upper and lower bounds for e[0]:
+         * up = bve * (budiv + 1) - 1
+         *      if bve * (bvudiv + 1) does not overflow
+         *      else 2^bw - 1
+         * lo = bve * bvudiv */
+        lo  = btor_bv_mul (mm, bve, bvudiv);
+        tmp = btor_bv_inc (mm, bvudiv);
+        if (btor_bv_is_umulo (mm, bve, tmp))
+        {
+          btor_bv_free (mm, tmp);
+          up = btor_bv_copy (mm, bvmax);
+        }
         else
         {
-          /* choose e[0] out of all options that yield
-           * e[0] / bve = bvudiv
-           * Note: udiv always truncates the results towards 0.
-           * ---------------------------------------------------------------- */
-
-          /* determine upper and lower bounds for e[0]:
-           * up = bve * (budiv + 1) - 1
-           *      if bve * (bvudiv + 1) does not overflow
-           *      else 2^bw - 1
-           * lo = bve * bvudiv */
-          lo  = btor_bv_mul (mm, bve, bvudiv);
-          tmp = btor_bv_inc (mm, bvudiv);
-          if (btor_bv_is_umulo (mm, bve, tmp))
-          {
-            btor_bv_free (mm, tmp);
-            up = btor_bv_copy (mm, bvmax);
-          }
-          else
-          {
-            up = btor_bv_mul (mm, bve, tmp);
-            btor_bv_free (mm, tmp);
-            tmp = btor_bv_dec (mm, up);
-            btor_bv_free (mm, up);
-            up = tmp;
-          }
-
-          res = btor_bv_new_random_range (mm, &btor->rng, bw, lo, up);
-
+          up = btor_bv_mul (mm, bve, tmp);
+          btor_bv_free (mm, tmp);
+          tmp = btor_bv_dec (mm, up);
           btor_bv_free (mm, up);
-          btor_bv_free (mm, lo);
+          up = tmp;
         }
+
+        res = btor_bv_new_random_range (mm, &btor->rng, bw, lo, up);
+
+        btor_bv_free (mm, up);
+        btor_bv_free (mm, lo);
       }
     }
   }
@@ -2765,9 +2910,8 @@ inv_udiv_bv (Btor *btor,
   btor_bv_free (mm, bvmax);
   btor_bv_free (mm, one);
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_udiv, udiv, bve, bvudiv, res, eidx, "/");
+  check_result_binary_dbg (
+      btor, btor_bv_udiv, udiv, bve, bvudiv, res, eidx, "/");
 #endif
   return res;
 }
@@ -2800,9 +2944,6 @@ inv_urem_bv (Btor *btor,
   BtorNode *e;
   BtorBitVector *res, *bvmax, *tmp, *tmp2, *one, *n, *mul, *up, *sub;
   BtorMemMgr *mm;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -2816,6 +2957,12 @@ inv_urem_bv (Btor *btor,
   e  = urem->e[eidx ? 0 : 1];
   assert (e);
 
+  if (!record_inv_check (btor, is_inv_urem (mm, bvurem, bve, eidx)))
+  {
+    /* CONFLICT ------------------------------------------------------------- */
+    return res_rec_conf (btor, urem, e, bvurem, bve, eidx, cons_urem_bv, "%");
+  }
+
   bw = btor_bv_get_width (bvurem);
 
   bvmax = btor_bv_ones (mm, bw); /* 2^bw - 1 */
@@ -2826,35 +2973,22 @@ inv_urem_bv (Btor *btor,
   /* -----------------------------------------------------------------------
    * bve % e[1] = bvurem
    *
-   * -> if bvurem = 1...1 -> bve = 1...1 and e[1] = 0...0, else conflict
+   * -> if bvurem = 1...1 -> bve = 1...1 and e[1] = 0...0
    * -> if bve = bvurem, choose either e[1] = 0 or some e[1] > bvurem randomly
-   * -> if bvurem > 0 and bvurem = bve - 1, conflict
-   * -> if bve > bvurem, e[1] = ((bve - bvurem) / n) > bvurem, else conflict
-   * -> if bve < bvurem, conflict
+   * -> if bve > bvurem, e[1] = ((bve - bvurem) / n) > bvurem
    * ------------------------------------------------------------------------ */
   if (eidx)
   {
     if (!btor_bv_compare (bvurem, bvmax))
     {
-      /* CONFLICT: bvurem = 1...1 but bve != 1...1 -------------------------- */
-      if (btor_bv_compare (bve, bvmax))
-      {
-      BVUREM_CONF:
-        res =
-            res_rec_conf (btor, urem, e, bvurem, bve, eidx, cons_urem_bv, "%");
-#ifndef NDEBUG
-        is_inv = false;
-#endif
-      }
-      else
-      {
-        /* bve % e[1] = 1...1 -> bve = 1...1, e[1] = 0 ---------------------- */
-        res = btor_bv_new (mm, bw);
-      }
+      /* bve % e[1] = 1...1 -> bve = 1...1, e[1] = 0 ------------------------ */
+      assert (!btor_bv_compare (bve, bvmax));
+      res = btor_bv_new (mm, bw);
     }
     else
     {
       cmp = btor_bv_compare (bve, bvurem);
+      assert (cmp >= 0);
 
       if (cmp == 0)
       {
@@ -2871,134 +3005,102 @@ inv_urem_bv (Btor *btor,
           btor_bv_free (mm, tmp);
         }
       }
-      else if (cmp > 0)
+      else
       {
         /* bve > bvurem, e[1] = (bve - bvurem) / n -------------------------- */
-        if (!btor_bv_is_zero (bvurem))
-        {
-          tmp = btor_bv_dec (mm, bve);
-          if (!btor_bv_compare (bvurem, tmp))
-          {
-            /* CONFLICT:
-             * bvurem = bve - 1 -> bve % e[1] = bve - 1
-             * -> not possible if bvurem > 0
-             * -------------------------------------------------------------- */
-            btor_bv_free (mm, tmp);
-            goto BVUREM_CONF;
-          }
-          btor_bv_free (mm, tmp);
-        }
-
         sub = btor_bv_sub (mm, bve, bvurem);
+        assert (btor_bv_compare (sub, bvurem) > 0);
+        /* choose either n = 1 or 1 <= n < (bve - bvurem) / bvurem
+         * with prob = 0.5
+         * ------------------------------------------------------------------ */
 
-        if (btor_bv_compare (sub, bvurem) <= 0)
+        if (btor_rng_pick_with_prob (&btor->rng, 500))
         {
-          /* CONFLICT: bve - bvurem <= bvurem ------------------------------- */
-          btor_bv_free (mm, sub);
-          goto BVUREM_CONF;
+          res = btor_bv_copy (mm, sub);
         }
         else
         {
-          /* choose either n = 1 or 1 <= n < (bve - bvurem) / bvurem
-           * with prob = 0.5
+          /* 1 <= n < (bve - bvurem) / bvurem (non-truncating)
+           * (note: div truncates towards 0!)
            * ---------------------------------------------------------------- */
 
-          if (btor_rng_pick_with_prob (&btor->rng, 500))
+          if (btor_bv_is_zero (bvurem))
           {
-            res = btor_bv_copy (mm, sub);
+            /* bvurem = 0 -> 1 <= n <= bve ---------------------------------- */
+            up = btor_bv_copy (mm, bve);
           }
           else
           {
-            /* 1 <= n < (bve - bvurem) / bvurem (non-truncating)
-             * (note: div truncates towards 0!)
+            /* e[1] > bvurem
+             * -> (bve - bvurem) / n > bvurem
+             * -> (bve - bvurem) / bvurem > n
              * -------------------------------------------------------------- */
-
-            if (btor_bv_is_zero (bvurem))
+            tmp  = btor_bv_urem (mm, sub, bvurem);
+            tmp2 = btor_bv_udiv (mm, sub, bvurem);
+            if (btor_bv_is_zero (tmp))
             {
-              /* bvurem = 0 -> 1 <= n <= bve -------------------------------- */
-              up = btor_bv_copy (mm, bve);
+              /* (bve - bvurem) / bvurem is not truncated
+               * (remainder is 0), therefore the EXclusive
+               * upper bound
+               * -> up = (bve - bvurem) / bvurem - 1
+               * ------------------------------------------------------------ */
+              up = btor_bv_sub (mm, tmp2, one);
+              btor_bv_free (mm, tmp2);
             }
             else
             {
-              /* e[1] > bvurem
-               * -> (bve - bvurem) / n > bvurem
-               * -> (bve - bvurem) / bvurem > n
+              /* (bve - bvurem) / bvurem is truncated
+               * (remainder is not 0), therefore the INclusive
+               * upper bound
+               * -> up = (bve - bvurem) / bvurem
                * ------------------------------------------------------------ */
-              tmp  = btor_bv_urem (mm, sub, bvurem);
-              tmp2 = btor_bv_udiv (mm, sub, bvurem);
-              if (btor_bv_is_zero (tmp))
-              {
-                /* (bve - bvurem) / bvurem is not truncated
-                 * (remainder is 0), therefore the EXclusive
-                 * upper bound
-                 * -> up = (bve - bvurem) / bvurem - 1
-                 * ---------------------------------------------------------- */
-                up = btor_bv_sub (mm, tmp2, one);
-                btor_bv_free (mm, tmp2);
-              }
-              else
-              {
-                /* (bve - bvurem) / bvurem is truncated
-                 * (remainder is not 0), therefore the INclusive
-                 * upper bound
-                 * -> up = (bve - bvurem) / bvurem
-                 * ---------------------------------------------------------- */
-                up = tmp2;
-              }
-              btor_bv_free (mm, tmp);
+              up = tmp2;
             }
+            btor_bv_free (mm, tmp);
+          }
 
-            if (btor_bv_is_zero (up))
-              res = btor_bv_udiv (mm, sub, one);
-            else
+          if (btor_bv_is_zero (up))
+            res = btor_bv_udiv (mm, sub, one);
+          else
+          {
+            /* choose 1 <= n <= up randomly
+             * s.t (bve - bvurem) % n = 0
+             * -------------------------------------------------------------- */
+            n   = btor_bv_new_random_range (mm, &btor->rng, bw, one, up);
+            tmp = btor_bv_urem (mm, sub, n);
+            for (cnt = 0; cnt < bw && !btor_bv_is_zero (tmp); cnt++)
             {
-              /* choose 1 <= n <= up randomly
-               * s.t (bve - bvurem) % n = 0
-               * ------------------------------------------------------------ */
+              btor_bv_free (mm, n);
+              btor_bv_free (mm, tmp);
               n   = btor_bv_new_random_range (mm, &btor->rng, bw, one, up);
               tmp = btor_bv_urem (mm, sub, n);
-              for (cnt = 0; cnt < bw && !btor_bv_is_zero (tmp); cnt++)
-              {
-                btor_bv_free (mm, n);
-                btor_bv_free (mm, tmp);
-                n   = btor_bv_new_random_range (mm, &btor->rng, bw, one, up);
-                tmp = btor_bv_urem (mm, sub, n);
-              }
-
-              if (btor_bv_is_zero (tmp))
-              {
-                /* res = (bve - bvurem) / n */
-                res = btor_bv_udiv (mm, sub, n);
-              }
-              else
-              {
-                /* fallback: n = 1 */
-                res = btor_bv_copy (mm, sub);
-              }
+            }
 
-              btor_bv_free (mm, n);
-              btor_bv_free (mm, tmp);
+            if (btor_bv_is_zero (tmp))
+            {
+              /* res = (bve - bvurem) / n */
+              res = btor_bv_udiv (mm, sub, n);
+            }
+            else
+            {
+              /* fallback: n = 1 */
+              res = btor_bv_copy (mm, sub);
             }
-            btor_bv_free (mm, up);
+
+            btor_bv_free (mm, n);
+            btor_bv_free (mm, tmp);
           }
+          btor_bv_free (mm, up);
         }
         btor_bv_free (mm, sub);
       }
-      else
-      {
-        /* CONFLICT: bve < bvurem ------------------------------------------- */
-        goto BVUREM_CONF;
-      }
     }
   }
   /* ------------------------------------------------------------------------
    * e[0] % bve = bvurem
    *
    * -> if bve = 0, e[0] = bvurem
-   * -> if bvurem = 1...1 and bve != 0, conflict
-   * -> if bve <= bvurem, conflict
-   * -> if bvurem > 0 and bve = 1, conflict
-   * -> else choose either
+   * -> else (bve > bvurem) choose either
    *      - e[0] = bvurem, or
    *      - e[0] = bve * n + b, with n s.t. (bve * n + b) does not overflow
    * ------------------------------------------------------------------------ */
@@ -3006,30 +3108,12 @@ inv_urem_bv (Btor *btor,
   {
     if (btor_bv_is_zero (bve))
     {
-    BVUREM_ZERO_0:
       /* bve = 0 -> e[0] = bvurem ------------------------------------------- */
       res = btor_bv_copy (mm, bvurem);
     }
-    else if (!btor_bv_is_zero (bvurem) && btor_bv_is_one (bve))
-    {
-      /* CONFLICT: bvurem > 0 and bve = 1 ----------------------------------- */
-      goto BVUREM_CONF;
-    }
-    else if (!btor_bv_compare (bvurem, bvmax))
-    {
-      if (!btor_bv_is_zero (bve))
-      {
-        /* CONFLICT: bve != 0 ----------------------------------------------- */
-        goto BVUREM_CONF;
-      }
-      else
-      {
-        /* bvurem = 1...1 -> bve = 0, e[0] = 1...1 -------------------------- */
-        goto BVUREM_ZERO_0;
-      }
-    }
-    else if (btor_bv_compare (bve, bvurem) > 0)
+    else
     {
+      assert (btor_bv_compare (bve, bvurem) > 0);
       if (btor_rng_pick_with_prob (&btor->rng, 500))
       {
       BVUREM_EQ_0:
@@ -3090,20 +3174,14 @@ inv_urem_bv (Btor *btor,
         }
       }
     }
-    else
-    {
-      /* CONFLICT: bve <= bvurem -------------------------------------------- */
-      goto BVUREM_CONF;
-    }
   }
 
   btor_bv_free (mm, one);
   btor_bv_free (mm, bvmax);
 
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_urem, urem, bve, bvurem, res, eidx, "%");
+  check_result_binary_dbg (
+      btor, btor_bv_urem, urem, bve, bvurem, res, eidx, "%");
 #endif
   return res;
 }
@@ -3132,11 +3210,8 @@ inv_concat_bv (Btor *btor,
 
   uint32_t bw_t, bw_s;
   BtorNode *e;
-  BtorBitVector *res, *tmp;
+  BtorBitVector *res;
   BtorMemMgr *mm;
-#ifndef NDEBUG
-  bool is_inv = true;
-#endif
 
   if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
   {
@@ -3149,11 +3224,16 @@ inv_concat_bv (Btor *btor,
   mm = btor->mm;
   e  = concat->e[eidx ? 0 : 1];
   assert (e);
+
+  if (!record_inv_check (btor, is_inv_concat (mm, bvconcat, bve, eidx)))
+  {
+    /* CONFLICT: bve bits do not match bvconcat ----------------------------- */
+    return res_rec_conf (
+        btor, concat, e, bvconcat, bve, eidx, cons_concat_bv, "o");
+  }
   bw_t = btor_bv_get_width (bvconcat);
   bw_s = btor_bv_get_width (bve);
 
-  res = 0;
-
   /* ------------------------------------------------------------------------
    * bve o e[1] = bvconcat
    *
@@ -3161,21 +3241,7 @@ inv_concat_bv (Btor *btor,
    * ------------------------------------------------------------------------ */
   if (eidx)
   {
-    tmp = btor_bv_slice (mm, bvconcat, bw_t - 1, bw_t - bw_s);
-    if (btor_bv_compare (tmp, bve))
-    {
-    BVCONCAT_CONF:
-      /* CONFLICT: bve bits do not match bvconcat --------------------------- */
-      res = res_rec_conf (
-          btor, concat, e, bvconcat, bve, eidx, cons_concat_bv, "o");
-#ifndef NDEBUG
-      is_inv = false;
-#endif
-    }
-    else
-    {
-      res = btor_bv_slice (mm, bvconcat, bw_t - bw_s - 1, 0);
-    }
+    res = btor_bv_slice (mm, bvconcat, bw_t - bw_s - 1, 0);
   }
   /* ------------------------------------------------------------------------
    * e[0] o bve = bvconcat
@@ -3184,22 +3250,11 @@ inv_concat_bv (Btor *btor,
    * ------------------------------------------------------------------------ */
   else
   {
-    tmp = btor_bv_slice (mm, bvconcat, bw_s - 1, 0);
-    if (btor_bv_compare (tmp, bve))
-    {
-      /* CONFLICT: bve bits do not match bvconcat --------------------------- */
-      goto BVCONCAT_CONF;
-    }
-    else
-    {
-      res = btor_bv_slice (mm, bvconcat, bw_t - 1, bw_s);
-    }
+    res = btor_bv_slice (mm, bvconcat, bw_t - 1, bw_s);
   }
-  btor_bv_free (mm, tmp);
 #ifndef NDEBUG
-  if (is_inv)
-    check_result_binary_dbg (
-        btor, btor_bv_concat, concat, bve, bvconcat, res, eidx, "o");
+  check_result_binary_dbg (
+      btor, btor_bv_concat, concat, bve, bvconcat, res, eidx, "o");
 #endif
   return res;
 }
@@ -3453,6 +3508,49 @@ inv_cond_bv (Btor *btor,
 /* Propagation move                                                           */
 /* ========================================================================== */
 
+/* Move value 'bv' for 'exp' into the domain of 'exp' if it is not contained
+ * in it (prop-domains). Takes ownership of 'bv'. */
+static BtorBitVector *
+restrict_to_domain (Btor *btor, BtorNode *exp, BtorBitVector *bv)
+{
+  assert (btor);
+  assert (exp);
+  assert (bv);
+
+  BtorPropSolver *slv;
+  BtorHashTableData *d;
+  BtorBitVector *tmp, *res;
+
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) != BTOR_ENGINE_PROP) return bv;
+  slv = BTOR_PROP_SOLVER (btor);
+  if (!slv->domains) return bv;
+  d = btor_hashint_map_get (slv->domains, btor_node_real_addr (exp)->id);
+  if (!d) return bv;
+
+  /* domains are stored for regular nodes */
+  if (btor_node_is_inverted (exp))
+  {
+    tmp = btor_bv_not (btor->mm, bv);
+    btor_bv_free (btor->mm, bv);
+    bv = tmp;
+  }
+  if (btor_bvdomain_check_value (btor->mm, d->as_ptr, bv))
+    res = bv;
+  else
+  {
+    res = btor_bvdomain_project (btor->mm, d->as_ptr, bv);
+    btor_bv_free (btor->mm, bv);
+    slv->stats.domain_props += 1;
+  }
+  if (btor_node_is_inverted (exp))
+  {
+    tmp = btor_bv_not (btor->mm, res);
+    btor_bv_free (btor->mm, res);
+    res = tmp;
+  }
+  return res;
+}
+
 static BtorNode *
 select_move (Btor *btor,
              BtorNode *exp,
@@ -3621,6 +3719,8 @@ btor_proputils_select_move_prop (Btor *btor,
       cur = select_move (
           btor, real_cur, bvcur, bve, select_path, compute_value, &bvenew);
       if (!bvenew) break; /* non-recoverable conflict */
+      if (!btor_node_is_bv_const (cur))
+        bvenew = restrict_to_domain (btor, cur, bvenew);
 
       btor_bv_free (btor->mm, bvcur);
       bvcur = bvenew;
@@ -105,6 +105,39 @@ BtorBitVector* inv_cond_bv (Btor* btor,
                             BtorBitVector* bve,
                             int32_t eidx);
 
+bool is_inv_and (BtorMemMgr* mm,
+                 const BtorBitVector* t,
+                 const BtorBitVector* s,
+                 int32_t eidx);
+bool is_inv_ult (BtorMemMgr* mm,
+                 const BtorBitVector* t,
+                 const BtorBitVector* s,
+                 int32_t eidx);
+bool is_inv_sll (BtorMemMgr* mm,
+                 const BtorBitVector* t,
+                 const BtorBitVector* s,
+                 int32_t eidx);
+bool is_inv_srl (BtorMemMgr* mm,
+                 const BtorBitVector* t,
+                 const BtorBitVector* s,
+                 int32_t eidx);
+bool is_inv_mul (BtorMemMgr* mm,
+                 const BtorBitVector* t,
+                 const BtorBitVector* s,
+                 int32_t eidx);
+bool is_inv_udiv (BtorMemMgr* mm,
+                  const BtorBitVector* t,
+                  const BtorBitVector* s,
+                  int32_t eidx);
+bool is_inv_urem (BtorMemMgr* mm,
+                  const BtorBitVector* t,
+                  const BtorBitVector* s,
+                  int32_t eidx);
+bool is_inv_concat (BtorMemMgr* mm,
+                    const BtorBitVector* t,
+                    const BtorBitVector* s,
+                    int32_t eidx);
+
 int32_t sat_prop_solver_aux (Btor* btor);
 #endif
 
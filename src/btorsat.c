@@ -112,6 +112,12 @@ melt (BtorSATMgr *smgr, int32_t lit)
   // TODO: else case warning?
 }
 
+static inline void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.phase) smgr->api.phase (smgr, lit);
+}
+
 static inline int32_t
 repr (BtorSATMgr *smgr, int32_t lit)
 {
@@ -409,6 +415,7 @@ btor_sat_check_sat (BtorSATMgr *smgr, int32_t limit)
     case 20: res = BTOR_RESULT_UNSAT; break;
     default: assert (sat_res == 0); res = BTOR_RESULT_UNKNOWN;
   }
+  smgr->has_model = res == BTOR_RESULT_SAT;
   return res;
 }
 
@@ -454,6 +461,15 @@ btor_sat_fixed (BtorSATMgr *smgr, int32_t lit)
   return res;
 }
 
+void
+btor_sat_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (abs (lit) <= smgr->maxvar);
+  phase (smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -697,6 +713,13 @@ dimacs_printer_melt (BtorSATMgr *smgr, int32_t lit)
   melt (wrapped_smgr, lit);
 }
 
+static void
+dimacs_printer_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  phase (printer->smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 /* The DIMACS printer is a SAT manager that wraps the currently configured SAT
@@ -728,6 +751,7 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = dimacs_printer_inc_max_var;
   smgr->api.init             = dimacs_printer_init;
   smgr->api.melt             = dimacs_printer_melt;
+  smgr->api.phase            = dimacs_printer_phase;
   smgr->api.repr             = dimacs_printer_repr;
   smgr->api.reset            = dimacs_printer_reset;
   smgr->api.sat              = dimacs_printer_sat;
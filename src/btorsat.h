@@ -39,6 +39,7 @@ struct BtorSATMgr
 
   bool initialized;
   int32_t satcalls;
+  bool has_model; /* last SAT call was satisfiable */
   int32_t clauses;
   int32_t true_lit;
   int32_t maxvar;
@@ -63,6 +64,7 @@ struct BtorSATMgr
     int32_t (*inc_max_var) (BtorSATMgr *);
     void *(*init) (BtorSATMgr *); /* required */
     void (*melt) (BtorSATMgr *, int32_t);
+    void (*phase) (BtorSATMgr *, int32_t);
     int32_t (*repr) (BtorSATMgr *, int32_t);
     void (*reset) (BtorSATMgr *);           /* required */
     int32_t (*sat) (BtorSATMgr *, int32_t); /* required */
@@ -171,6 +173,12 @@ int32_t btor_sat_repr (BtorSATMgr *smgr, int32_t lit);
  */
 int32_t btor_sat_fixed (BtorSATMgr *smgr, int32_t lit);
 
+/* Sets the preferred phase of the variable of a literal to the phase of the
+ * literal (a hint for the decision heuristic of the next SAT call).
+ * Ignored if the SAT solver does not support this.
+ */
+void btor_sat_phase (BtorSATMgr *smgr, int32_t lit);
+
 /* Resets the status of the SAT solver. */
 void btor_sat_reset (BtorSATMgr *smgr);
 
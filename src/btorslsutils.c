@@ -53,97 +53,159 @@
  *
  * ========================================================================== */
 
-static uint32_t
-hamming_distance (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
+/* -------------------------------------------------------------------------- */
+
+BtorSLSScore *
+btor_slsutils_new_score (Btor *btor)
 {
-  assert (bv1);
-  assert (bv2);
-  assert (btor_bv_get_width (bv1) == btor_bv_get_width (bv2));
-#ifndef BTOR_USE_GMP
-  assert (btor_bv_get_len (bv1) == btor_bv_get_len (bv2));
-#endif
+  assert (btor);
+
+  uint32_t i;
+  BtorSLSScore *res;
+
+  BTOR_CNEW (btor->mm, res);
+  res->mm   = btor->mm;
+  res->size = 2 * BTOR_COUNT_STACK (btor->nodes_id_table);
+  if (res->size)
+  {
+    BTOR_NEWN (btor->mm, res->scores, res->size);
+    for (i = 0; i < res->size; i++) res->scores[i] = -1.0;
+  }
+  return res;
+}
+
+BtorSLSScore *
+btor_slsutils_clone_score (BtorMemMgr *mm, BtorSLSScore *score)
+{
+  assert (mm);
+
+  BtorSLSScore *res;
 
-  uint32_t res, bw;
-  BtorBitVector *bv, *bvdec = 0, *zero, *ones, *tmp;
+  if (!score) return 0;
 
-  bw   = btor_bv_get_width (bv1);
-  zero = btor_bv_new (btor->mm, bw);
-  ones = btor_bv_ones (btor->mm, bw);
-  bv   = btor_bv_xor (btor->mm, bv1, bv2);
-  for (res = 0; !btor_bv_is_zero (bv); res++)
+  BTOR_CNEW (mm, res);
+  res->mm   = mm;
+  res->size = score->size;
+  if (res->size)
   {
-    bvdec = btor_bv_add (btor->mm, bv, ones);
-    tmp   = bv;
-    bv    = btor_bv_and (btor->mm, bv, bvdec);
-    btor_bv_free (btor->mm, tmp);
-    btor_bv_free (btor->mm, bvdec);
+    BTOR_NEWN (mm, res->scores, res->size);
+    memcpy (res->scores, score->scores, res->size * sizeof (double));
   }
-  btor_bv_free (btor->mm, bv);
-  btor_bv_free (btor->mm, ones);
-  btor_bv_free (btor->mm, zero);
   return res;
 }
 
-// TODO find a better heuristic this might be too expensive
-// this is not necessarily the actual minimum, but the minimum if you flip
-// bits in bv1 s.t. bv1 < bv2 (if bv2 is 0, we need to flip 1 bit in bv2, too,
-// which we do not consider to prevent negative scores)
+void
+btor_slsutils_delete_score (BtorSLSScore *score)
+{
+  assert (score);
+
+  BTOR_DELETEN (score->mm, score->scores, score->size);
+  BTOR_DELETE (score->mm, score);
+}
+
+void
+btor_slsutils_reset_score (BtorSLSScore *score)
+{
+  assert (score);
+
+  uint32_t i;
+  for (i = 0; i < score->size; i++) score->scores[i] = -1.0;
+}
+
+void
+btor_slsutils_set_score (BtorSLSScore *score, int32_t id, double value)
+{
+  assert (score);
+  assert (value >= 0.0);
+
+  uint32_t i, idx, size;
+
+  idx = BTOR_SLS_SCORE_IDX (id);
+  if (idx >= score->size)
+  {
+    size = score->size ? 2 * score->size : 16;
+    while (size <= idx) size *= 2;
+    BTOR_REALLOC (score->mm, score->scores, score->size, size);
+    for (i = score->size; i < size; i++) score->scores[i] = -1.0;
+    score->size = size;
+  }
+  score->scores[idx] = value;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* Minimum number of bits to flip in bv1 s.t. bv1 < bv2, flipping 1s to 0s
+ * from MSB to LSB (this is not necessarily the actual minimum; if bv2 is 0,
+ * we would need to flip 1 bit in bv2, too, which we do not consider to
+ * prevent negative scores).
+ *
+ * For bv2 != 0 with MSB at position p, all 1s of bv1 above p need to be
+ * flipped, plus bit p if bv1[p:0] >= bv2[p:0]. */
 static uint32_t
 min_flip (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
 {
   assert (bv1);
   assert (bv2);
   assert (btor_bv_get_width (bv1) == btor_bv_get_width (bv2));
-#ifndef BTOR_USE_GMP
-  assert (btor_bv_get_len (bv1) == btor_bv_get_len (bv2));
-#endif
+  assert (btor_bv_compare (bv1, bv2) >= 0);
 
-  uint32_t i, j, res, bw;
-  BtorBitVector *tmp;
+  uint32_t res, bw, p;
+  BtorBitVector *hi, *lo1, *lo2;
 
-  if (btor_bv_is_zero (bv2))
-    res = hamming_distance (btor, bv1, bv2);
-  else
-  {
-    tmp = btor_bv_copy (btor->mm, bv1);
-    bw  = btor_bv_get_width (tmp);
-    for (res = 0, i = 0, j = bw - 1; i < bw; i++, j--)
-    {
-      if (!btor_bv_get_bit (tmp, j)) continue;
-      res += 1;
-      btor_bv_set_bit (tmp, j, 0);
-      if (btor_bv_compare (tmp, bv2) < 0) break;
-    }
-    if (btor_bv_is_zero (bv2)) res += 1;
-    btor_bv_free (btor->mm, tmp);
-  }
-  assert (res <= btor_bv_get_width (bv1));
+  bw = btor_bv_get_width (bv1);
+  if (btor_bv_is_zero (bv2)) return btor_bv_get_num_ones (bv1);
+
+  p = bw - 1 - btor_bv_get_num_leading_zeros (bv2);
+  if (p == bw - 1) return 1;
+
+  hi  = btor_bv_slice (btor->mm, bv1, bw - 1, p + 1);
+  lo1 = btor_bv_slice (btor->mm, bv1, p, 0);
+  lo2 = btor_bv_slice (btor->mm, bv2, p, 0);
+  res = btor_bv_get_num_ones (hi) + (btor_bv_compare (lo1, lo2) >= 0);
+  btor_bv_free (btor->mm, hi);
+  btor_bv_free (btor->mm, lo1);
+  btor_bv_free (btor->mm, lo2);
+  assert (res <= bw);
   return res;
 }
 
+/* Minimum number of bits to flip in bv1 s.t. bv1 >= bv2, flipping 0s to 1s
+ * from MSB to LSB.
+ *
+ * With l the number of leading 1s of bv2, all 0s of bv1 within the l MSBs
+ * need to be flipped, plus one more if none or if the remaining lower bits
+ * of bv1 are less than the remaining lower bits of bv2. */
 static uint32_t
 min_flip_inv (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
 {
   assert (bv1);
   assert (bv2);
   assert (btor_bv_get_width (bv1) == btor_bv_get_width (bv2));
-#ifndef BTOR_USE_GMP
-  assert (btor_bv_get_len (bv1) == btor_bv_get_len (bv2));
-#endif
+  assert (btor_bv_compare (bv1, bv2) < 0);
 
-  uint32_t i, j, res, bw;
-  BtorBitVector *tmp;
+  uint32_t res, bw, l;
+  BtorBitVector *hi, *lo1, *lo2;
 
-  tmp = btor_bv_copy (btor->mm, bv1);
-  bw  = btor_bv_get_width (tmp);
-  for (res = 0, i = 0, j = bw - 1; i < bw; i++, j--)
+  bw = btor_bv_get_width (bv1);
+  l  = btor_bv_get_num_leading_ones (bv2);
+  if (l == 0) return 1;
+
+  hi  = btor_bv_slice (btor->mm, bv1, bw - 1, bw - l);
+  res = l - btor_bv_get_num_ones (hi);
+  btor_bv_free (btor->mm, hi);
+  if (res > 0 && l < bw)
+  {
+    lo1 = btor_bv_slice (btor->mm, bv1, bw - l - 1, 0);
+    lo2 = btor_bv_slice (btor->mm, bv2, bw - l - 1, 0);
+    if (btor_bv_compare (lo1, lo2) < 0) res += 1;
+    btor_bv_free (btor->mm, lo1);
+    btor_bv_free (btor->mm, lo2);
+  }
+  else if (res == 0)
   {
-    if (btor_bv_get_bit (tmp, j)) continue;
-    res += 1;
-    btor_bv_set_bit (tmp, j, 1);
-    if (btor_bv_compare (tmp, bv2) >= 0) break;
+    res = 1;
   }
-  btor_bv_free (btor->mm, tmp);
+  assert (res <= bw);
   return res;
 }
 
@@ -151,7 +213,7 @@ double
 btor_slsutils_compute_score_node (Btor *btor,
                                   BtorIntHashTable *bv_model,
                                   BtorIntHashTable *fun_model,
-                                  BtorIntHashTable *score,
+                                  BtorSLSScore *score,
                                   BtorNode *exp)
 {
   assert (btor);
@@ -183,14 +245,8 @@ btor_slsutils_compute_score_node (Btor *btor,
     /* ---------------------------------------------------------------------- */
     if (btor_node_is_inverted (exp))
     {
-      assert (btor_hashint_map_contains (score,
-                                         -btor_node_get_id ((real_exp->e[0]))));
-      assert (btor_hashint_map_contains (score,
-                                         -btor_node_get_id ((real_exp->e[1]))));
-      s0 = btor_hashint_map_get (score, -btor_node_get_id ((real_exp->e[0])))
-               ->as_dbl;
-      s1 = btor_hashint_map_get (score, -btor_node_get_id ((real_exp->e[1])))
-               ->as_dbl;
+      s0 = btor_slsutils_get_score (score, -btor_node_get_id (real_exp->e[0]));
+      s1 = btor_slsutils_get_score (score, -btor_node_get_id (real_exp->e[1]));
 #ifndef NBTORLOG
       if (btor_opt_get (btor, BTOR_OPT_LOGLEVEL) >= 2)
       {
@@ -217,14 +273,8 @@ btor_slsutils_compute_score_node (Btor *btor,
     /* ---------------------------------------------------------------------- */
     else
     {
-      assert (btor_hashint_map_contains (score,
-                                         btor_node_get_id ((real_exp->e[0]))));
-      assert (btor_hashint_map_contains (score,
-                                         btor_node_get_id ((real_exp->e[1]))));
-      s0 = btor_hashint_map_get (score, btor_node_get_id ((real_exp->e[0])))
-               ->as_dbl;
-      s1 = btor_hashint_map_get (score, btor_node_get_id ((real_exp->e[1])))
-               ->as_dbl;
+      s0 = btor_slsutils_get_score (score, btor_node_get_id (real_exp->e[0]));
+      s1 = btor_slsutils_get_score (score, btor_node_get_id (real_exp->e[1]));
 #ifndef NBTORLOG
       if (btor_opt_get (btor, BTOR_OPT_LOGLEVEL) >= 2)
       {
@@ -283,7 +333,7 @@ btor_slsutils_compute_score_node (Btor *btor,
                 ? 1.0
                 : BTOR_SLS_SCORE_CFACT
                       * (1.0
-                         - hamming_distance (btor, bv0, bv1)
+                         - btor_bv_hamming_distance (bv0, bv1)
                                / (double) btor_bv_get_width (bv0));
   }
   /* ------------------------------------------------------------------------ */
@@ -358,7 +408,7 @@ static double
 recursively_compute_sls_score_node (Btor *btor,
                                     BtorIntHashTable *bv_model,
                                     BtorIntHashTable *fun_model,
-                                    BtorIntHashTable *score,
+                                    BtorSLSScore *score,
                                     BtorNode *exp)
 {
   assert (btor);
@@ -379,8 +429,8 @@ recursively_compute_sls_score_node (Btor *btor,
   assert (btor_node_is_bv_eq (exp) || btor_node_is_bv_ult (exp)
           || btor_node_bv_get_width (btor, exp) == 1);
 
-  if (btor_hashint_map_contains (score, btor_node_get_id (exp)))
-    return btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl;
+  if (btor_slsutils_has_score (score, btor_node_get_id (exp)))
+    return btor_slsutils_get_score (score, btor_node_get_id (exp));
 
   mm = btor->mm;
   BTOR_INIT_STACK (mm, stack);
@@ -394,7 +444,7 @@ recursively_compute_sls_score_node (Btor *btor,
     d        = btor_hashint_map_get (mark, real_cur->id);
 
     if ((d && d->as_int == 1)
-        || btor_hashint_map_get (score, btor_node_get_id (cur)))
+        || btor_slsutils_has_score (score, btor_node_get_id (cur)))
       continue;
 
     if (!d)
@@ -414,16 +464,15 @@ recursively_compute_sls_score_node (Btor *btor,
       res = btor_slsutils_compute_score_node (
           btor, bv_model, fun_model, score, cur);
 
-      assert (!btor_hashint_map_contains (score, btor_node_get_id (cur)));
-      btor_hashint_map_add (score, btor_node_get_id (cur))->as_dbl = res;
+      assert (!btor_slsutils_has_score (score, btor_node_get_id (cur)));
+      btor_slsutils_set_score (score, btor_node_get_id (cur), res);
     }
   }
 
   BTOR_RELEASE_STACK (stack);
   btor_hashint_map_delete (mark);
 
-  assert (btor_hashint_map_contains (score, btor_node_get_id (exp)));
-  assert (res == btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl);
+  assert (res == btor_slsutils_get_score (score, btor_node_get_id (exp)));
   return res;
 }
 
@@ -433,7 +482,7 @@ void
 btor_slsutils_compute_sls_scores (Btor *btor,
                                   BtorIntHashTable *bv_model,
                                   BtorIntHashTable *fun_model,
-                                  BtorIntHashTable *score)
+                                  BtorSLSScore *score)
 {
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP
@@ -471,7 +520,7 @@ btor_slsutils_compute_sls_scores (Btor *btor,
     d        = btor_hashint_map_get (mark, real_cur->id);
 
     if ((d && d->as_int == 1)
-        || btor_hashint_map_contains (score, btor_node_get_id (cur)))
+        || btor_slsutils_has_score (score, btor_node_get_id (cur)))
       continue;
 
     if (!d)
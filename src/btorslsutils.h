@@ -9,17 +9,56 @@
 #ifndef BTORSLSUTILS_H_INCLUDED
 #define BTORSLSUTILS_H_INCLUDED
 
+#include <assert.h>
+
 #include "btortypes.h"
 #include "utils/btorhashint.h"
+#include "utils/btormem.h"
+
+/* SLS scores of Boolean nodes, stored in a flat array indexed by node id.
+ * The score of 'id' is at index 2 * id, the score of '-id' at 2 * id + 1.
+ * Negative entries denote scores that have not been computed yet. */
+struct BtorSLSScore
+{
+  BtorMemMgr *mm;
+  uint32_t size;
+  double *scores;
+};
+
+typedef struct BtorSLSScore BtorSLSScore;
+
+#define BTOR_SLS_SCORE_IDX(id) (2 * (uint32_t) abs (id) + ((id) < 0))
+
+BtorSLSScore *btor_slsutils_new_score (Btor *btor);
+BtorSLSScore *btor_slsutils_clone_score (BtorMemMgr *mm, BtorSLSScore *score);
+void btor_slsutils_delete_score (BtorSLSScore *score);
+/* Mark all scores as not computed. */
+void btor_slsutils_reset_score (BtorSLSScore *score);
+
+void btor_slsutils_set_score (BtorSLSScore *score, int32_t id, double value);
+
+static inline bool
+btor_slsutils_has_score (const BtorSLSScore *score, int32_t id)
+{
+  uint32_t idx = BTOR_SLS_SCORE_IDX (id);
+  return idx < score->size && score->scores[idx] >= 0.0;
+}
+
+static inline double
+btor_slsutils_get_score (const BtorSLSScore *score, int32_t id)
+{
+  assert (btor_slsutils_has_score (score, id));
+  return score->scores[BTOR_SLS_SCORE_IDX (id)];
+}
 
 double btor_slsutils_compute_score_node (Btor *btor,
                                          BtorIntHashTable *bv_model,
                                          BtorIntHashTable *fun_model,
-                                         BtorIntHashTable *score,
+                                         BtorSLSScore *score,
                                          BtorNode *exp);
 
 void btor_slsutils_compute_sls_scores (Btor *btor,
                                        BtorIntHashTable *bv_model,
                                        BtorIntHashTable *fun_model,
-                                       BtorIntHashTable *score);
+                                       BtorSLSScore *score);
 #endif
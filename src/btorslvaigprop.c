@@ -67,12 +67,12 @@ get_assignment_aig (BtorAIGProp *aprop, BtorAIG *aig)
   assert (aprop);
   assert (aprop->model);
 
-  if (aig == BTOR_AIG_TRUE) return 1;
-  if (aig == BTOR_AIG_FALSE) return -1;
+  int32_t res;
+
   /* initialize don't care bits with false */
-  if (!btor_hashint_map_contains (aprop->model, BTOR_REAL_ADDR_AIG (aig)->id))
+  if (!(res = btor_aigprop_get_assignment_aig (aprop, aig)))
     return BTOR_IS_INVERTED_AIG (aig) ? 1 : -1;
-  return btor_aigprop_get_assignment_aig (aprop, aig);
+  return res;
 }
 
 static BtorBitVector *
@@ -267,21 +267,8 @@ sat_aigprop_solver (BtorAIGPropSolver *slv)
     goto UNSAT;
   generate_model_from_aig_model (btor);
   assert (sat_result == BTOR_RESULT_SAT);
-  slv->stats.moves                  = slv->aprop->stats.moves;
-  slv->stats.restarts               = slv->aprop->stats.restarts;
-  slv->time.aprop_sat               = slv->aprop->time.sat;
-  slv->time.aprop_update_cone       = slv->aprop->time.update_cone;
-  slv->time.aprop_update_cone_reset = slv->aprop->time.update_cone_reset;
-  slv->time.aprop_update_cone_model_gen =
-      slv->aprop->time.update_cone_model_gen;
-  slv->time.aprop_update_cone_compute_score =
-      slv->aprop->time.update_cone_compute_score;
 DONE:
-  if (slv->aprop->model)
-  {
-    btor_hashint_map_delete (slv->aprop->model);
-    slv->aprop->model = 0;
-  }
+  btor_aigprop_delete_model (slv->aprop);
   if (roots) btor_hashint_table_delete (roots);
   return sat_result;
 }
@@ -294,17 +281,8 @@ print_stats_aigprop_solver (BtorAIGPropSolver *slv)
   assert (slv->btor);
   assert (slv->btor->slv == (BtorSolver *) slv);
 
-  Btor *btor;
-
-  btor = slv->btor;
-
-  BTOR_MSG (btor->msg, 1, "");
-  BTOR_MSG (btor->msg, 1, "restarts: %d", slv->stats.restarts);
-  BTOR_MSG (btor->msg, 1, "moves: %d", slv->stats.moves);
-  BTOR_MSG (btor->msg,
-            1,
-            "moves per second: %.2f",
-            (double) slv->stats.moves / slv->time.aprop_sat);
+  if (btor_opt_get (slv->btor, BTOR_OPT_VERBOSITY) < 1) return;
+  btor_aigprop_print_stats (slv->aprop);
 }
 
 static void
@@ -312,32 +290,8 @@ print_time_stats_aigprop_solver (BtorAIGPropSolver *slv)
 {
   assert (slv);
 
-  Btor *btor;
-
-  btor = slv->btor;
-
-  BTOR_MSG (btor->msg, 1, "");
-  BTOR_MSG (
-      btor->msg, 1, "%.2f seconds in AIG propagator", slv->time.aprop_sat);
-  BTOR_MSG (btor->msg, 1, "");
-  BTOR_MSG (btor->msg,
-            1,
-            "%.2f seconds for updating cone (total)",
-            slv->time.aprop_update_cone);
-  BTOR_MSG (btor->msg,
-            1,
-            "%.2f seconds for updating cone (reset)",
-            slv->time.aprop_update_cone_reset);
-  BTOR_MSG (btor->msg,
-            1,
-            "%.2f seconds for updating cone (model gen)",
-            slv->time.aprop_update_cone_model_gen);
-  if (btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT))
-    BTOR_MSG (btor->msg,
-              1,
-              "%.2f seconds for updating cone (compute score)",
-              slv->time.aprop_update_cone_compute_score);
-  BTOR_MSG (btor->msg, 1, "");
+  if (btor_opt_get (slv->btor, BTOR_OPT_VERBOSITY) < 1) return;
+  btor_aigprop_print_time_stats (slv->aprop);
 }
 
 static void
@@ -19,21 +19,6 @@ struct BtorAIGPropSolver
   BTOR_SOLVER_STRUCT;
 
   BtorAIGProp *aprop;
-
-  /* statistics */
-  struct
-  {
-    uint32_t moves;
-    uint32_t restarts;
-  } stats;
-  struct
-  {
-    double aprop_sat;
-    double aprop_update_cone;
-    double aprop_update_cone_reset;
-    double aprop_update_cone_model_gen;
-    double aprop_update_cone_compute_score;
-  } time;
 };
 
 typedef struct BtorAIGPropSolver BtorAIGPropSolver;
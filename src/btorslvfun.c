@@ -10,6 +10,7 @@
 
 #include "btorabort.h"
 #include "btorbeta.h"
+#include "btorbvdomain.h"
 #include "btorclone.h"
 #include "btorcore.h"
 #include "btordbg.h"
@@ -19,6 +20,7 @@
 #include "btormodel.h"
 #include "btoropt.h"
 #include "btorprintmodel.h"
+#include "btorsat.h"
 #include "btorslvprop.h"
 #include "btorslvsls.h"
 #include "utils/btorhashint.h"
@@ -28,6 +30,10 @@
 #include "utils/btorunionfind.h"
 #include "utils/btorutil.h"
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 static BtorFunSolver *
@@ -48,12 +54,23 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   memcpy (res, slv, sizeof (BtorFunSolver));
 
   res->btor   = clone;
-  res->lemmas = btor_hashptr_table_clone (
-      clone->mm, slv->lemmas, btor_clone_key_as_node, 0, exp_map, 0);
+  res->lemmas = btor_hashptr_table_clone (clone->mm,
+                                          slv->lemmas,
+                                          btor_clone_key_as_node,
+                                          btor_clone_data_as_int,
+                                          exp_map,
+                                          0);
 
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
 
+  res->pending_lemmas = btor_hashint_map_clone (
+      clone->mm, slv->pending_lemmas, btor_clone_data_as_int, 0);
+
+  if (slv->betap_cache)
+    res->betap_cache =
+        btor_beta_cache_clone (clone, slv->betap_cache, exp_map);
+
   if (slv->score)
   {
     h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -116,6 +133,8 @@ delete_fun_solver (BtorFunSolver *slv)
   while (btor_iter_hashptr_has_next (&it))
     btor_node_release (btor, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (slv->lemmas);
+  btor_hashint_map_delete (slv->pending_lemmas);
+  if (slv->betap_cache) btor_beta_cache_delete (slv->betap_cache);
 
   if (slv->score)
   {
@@ -221,7 +240,9 @@ configure_sat_mgr (Btor *btor)
   /* reset SAT solver to non-incremental if all functions have been
    * eliminated */
   if (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL) && smgr->inc_required
-      && !incremental_required (btor))
+      && !incremental_required (btor)
+      && !(btor_opt_get (btor, BTOR_OPT_FUN_SCHEDULE)
+           && btor_sat_mgr_has_incremental_support (smgr)))
   {
     smgr->inc_required = false;
     BTOR_MSG (btor->msg,
@@ -360,6 +381,8 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   //  btor_opt_set (clone, BTOR_OPT_LOGLEVEL, 0);
   //  btor_opt_set (clone, BTOR_OPT_VERBOSITY, 0);
   btor_opt_set (clone, BTOR_OPT_FUN_DUAL_PROP, 0);
+  /* abstracted BV operators are not refined in the clone */
+  btor_opt_set (clone, BTOR_OPT_FUN_LAZY_BITBLAST, 0);
 
   assert (!btor_sat_is_initialized (btor_get_sat_mgr (clone)));
   btor_opt_set_str (clone, BTOR_OPT_SAT_ENGINE, "plain=1");
@@ -1386,11 +1409,48 @@ mk_equal_args (Btor *btor, BtorNode *args1, BtorNode *args2)
   return res;
 }
 
-static BtorNode *
-mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
+/* Push the equalities of the arguments 'args1' and 'args2' onto 'lits',
+ * either as separate literals ('flat') or as one conjunction. */
+static void
+push_equal_args (Btor *btor,
+                 BtorNode *args1,
+                 BtorNode *args2,
+                 bool flat,
+                 BtorNodePtrStack *lits)
+{
+  BtorArgsIterator it1, it2;
+
+  if (!flat)
+  {
+    BTOR_PUSH_STACK (*lits, mk_equal_args (btor, args1, args2));
+    return;
+  }
+
+  btor_iter_args_init (&it1, args1);
+  btor_iter_args_init (&it2, args2);
+  while (btor_iter_args_has_next (&it1))
+  {
+    assert (btor_iter_args_has_next (&it2));
+    BTOR_PUSH_STACK (*lits,
+                     btor_exp_eq (btor,
+                                  btor_iter_args_next (&it1),
+                                  btor_iter_args_next (&it2)));
+  }
+  assert (!btor_iter_args_has_next (&it2));
+}
+
+/* Push the premisses 'prem' of a propagation path onto 'lits', either as
+ * separate literals ('flat') or as one conjunction. */
+static void
+push_premise (Btor *btor,
+              BtorNode *args,
+              BtorNode *prem[],
+              uint32_t num_prem,
+              bool flat,
+              BtorNodePtrStack *lits)
 {
   uint32_t i;
-  BtorNode *cur, *res = 0, *tmp, *p;
+  BtorNode *cur, *p, *tmp, *res = 0;
 
   for (i = 0; i < num_prem; i++)
   {
@@ -1401,7 +1461,9 @@ mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
     else
       p = btor_node_copy (btor, cur);
 
-    if (res)
+    if (flat)
+      BTOR_PUSH_STACK (*lits, p);
+    else if (res)
     {
       tmp = btor_exp_bv_and (btor, res, p);
       btor_node_release (btor, res);
@@ -1411,7 +1473,55 @@ mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
     else
       res = p;
   }
-  return res;
+  if (res) BTOR_PUSH_STACK (*lits, res);
+}
+
+/* Normalize the premise of a lemma, i.e., sort its literals by id and remove
+ * duplicate and trivially true literals. Premisses collected along different
+ * propagation paths (function congruence conflicts) often share conditions,
+ * and sorting ensures that lemmas with the same set of premisses are hashed
+ * to the same node. Returns the number of removed literals. */
+static uint32_t
+minimize_premisses (Btor *btor, BtorNodePtrStack *lits)
+{
+  uint32_t i, j, n;
+  BtorNode *cur;
+
+  n = BTOR_COUNT_STACK (*lits);
+  if (n == 0) return 0;
+
+  qsort (lits->start,
+         n,
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  for (i = 0, j = 0; i < n; i++)
+  {
+    cur = BTOR_PEEK_STACK (*lits, i);
+    if (cur == btor->true_exp
+        || (j > 0 && BTOR_PEEK_STACK (*lits, j - 1) == cur))
+    {
+      btor_node_release (btor, cur);
+      continue;
+    }
+    BTOR_POKE_STACK (*lits, j, cur);
+    j++;
+  }
+  lits->top = lits->start + j;
+  return n - j;
+}
+
+/* Update the statistics for a lemma of size 'lemma_size' that is added to
+ * the formula. Extensionality lemmas are not counted by size (size 0). */
+static void
+count_lemma (BtorFunSolver *slv, uint32_t lemma_size)
+{
+  slv->stats.lod_refinements++;
+  if (!lemma_size) return;
+  slv->stats.lemmas_size_sum += lemma_size;
+  if (lemma_size >= BTOR_SIZE_STACK (slv->stats.lemmas_size))
+    BTOR_FIT_STACK (slv->stats.lemmas_size, lemma_size);
+  slv->stats.lemmas_size.start[lemma_size] += 1;
 }
 
 static void
@@ -1429,17 +1539,22 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   assert (btor_node_is_apply (app1));
   assert (!app2 || btor_node_is_regular (app2) || btor_node_is_apply (app2));
 
+  bool norm;
   double start;
-  uint32_t i, lemma_size = 1;
+  uint32_t i, lemma_size;
   BtorIntHashTable *cache_app1, *cache_app2;
   BtorNodePtrStack prem_app1, prem_app2, prem;
-  BtorNode *value, *tmp, *and, *con, *lemma;
+  BtorNode *value, *and, *con, *lemma;
   BtorMemMgr *mm;
   BtorFunSolver *slv;
+  BtorPtrHashBucket *b;
+  BtorHashTableData *d;
 
   start      = btor_util_time_stamp ();
   mm         = btor->mm;
   slv        = BTOR_FUN_SOLVER (btor);
+  norm       = btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_BATCH) > 0;
+  lemma_size = 1;
   cache_app1 = btor_hashint_table_new (mm);
   cache_app2 = btor_hashint_table_new (mm);
   BTOR_INIT_STACK (mm, prem_app1);
@@ -1449,26 +1564,30 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   /* collect premise and conclusion */
 
   collect_premisses (btor, app1, fun, app1->e[1], &prem_app1, cache_app1);
-  tmp = mk_premise (
-      btor, app1->e[1], prem_app1.start, BTOR_COUNT_STACK (prem_app1));
-
-  BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+  push_premise (btor,
+                app1->e[1],
+                prem_app1.start,
+                BTOR_COUNT_STACK (prem_app1),
+                norm,
+                &prem);
   lemma_size += BTOR_COUNT_STACK (prem_app1);
 
   if (app2) /* function congruence axiom conflict */
   {
     collect_premisses (btor, app2, fun, app2->e[1], &prem_app2, cache_app2);
-    tmp = mk_premise (
-        btor, app2->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], app2->e[1]));
+    push_premise (btor,
+                  app2->e[1],
+                  prem_app2.start,
+                  BTOR_COUNT_STACK (prem_app2),
+                  norm,
+                  &prem);
+    push_equal_args (btor, app1->e[1], app2->e[1], norm, &prem);
     lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, app2);
   }
   else if (btor_node_is_update (fun)) /* read over write conflict */
   {
-    BTOR_PUSH_STACK (prem, mk_equal_args (btor, app1->e[1], fun->e[1]));
+    push_equal_args (btor, app1->e[1], fun->e[1], norm, &prem);
     lemma_size += btor_node_args_get_arity (btor, app1->e[1]);
     con = btor_exp_eq (btor, app1, fun->e[2]);
   }
@@ -1476,9 +1595,8 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   {
     assert (btor_node_is_lambda (fun));
 
-    btor_beta_assign_args (btor, fun, app1->e[1]);
-    value = btor_beta_reduce_partial (btor, fun, 0);
-    btor_beta_unassign_params (btor, fun);
+    value = btor_beta_reduce_partial_cached (
+        btor, fun, app1->e[1], 0, BTOR_FUN_SOLVER (btor)->betap_cache);
     assert (!btor_node_is_lambda (value));
 
     /* path from conflicting fun to value */
@@ -1489,15 +1607,27 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
                        &prem_app2,
                        cache_app2);
 
-    tmp = mk_premise (
-        btor, app1->e[1], prem_app2.start, BTOR_COUNT_STACK (prem_app2));
-
-    BTOR_PUSH_STACK_IF (tmp != 0, prem, tmp);
+    push_premise (btor,
+                  app1->e[1],
+                  prem_app2.start,
+                  BTOR_COUNT_STACK (prem_app2),
+                  norm,
+                  &prem);
     lemma_size += BTOR_COUNT_STACK (prem_app2);
     con = btor_exp_eq (btor, app1, value);
     btor_node_release (btor, value);
   }
 
+  /* Normalizing the premisses changes the structure (and hence, the CNF) of
+   * all lemmas, which may slow down the SAT solver on instances that need
+   * no lemma scheduling. Only normalize if lemmas are scheduled, where
+   * lemmas derived again have to be identified. */
+  if (norm)
+  {
+    slv->stats.lemmas_premisses_removed += minimize_premisses (btor, &prem);
+    lemma_size = 1 + BTOR_COUNT_STACK (prem);
+  }
+
   /* create lemma */
   if (BTOR_EMPTY_STACK (prem))
     lemma = con;
@@ -1510,15 +1640,21 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   }
 
   assert (lemma != btor->true_exp);
-  if (!btor_hashptr_table_get (slv->lemmas, lemma))
+  if (!(b = btor_hashptr_table_get (slv->lemmas, lemma)))
+  {
+    b = btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
+    b->data.as_int = lemma_size;
+    BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
+    /* scheduled lemmas are counted when added (see schedule_lemmas) */
+    if (!norm) count_lemma (slv, lemma_size);
+  }
+  /* lemma was deferred in a previous refinement iteration */
+  else if ((d = btor_hashint_map_get (slv->pending_lemmas,
+                                      btor_node_get_id (lemma))))
   {
-    btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
+    d->as_int += 1;
     BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
-    slv->stats.lod_refinements++;
-    slv->stats.lemmas_size_sum += lemma_size;
-    if (lemma_size >= BTOR_SIZE_STACK (slv->stats.lemmas_size))
-      BTOR_FIT_STACK (slv->stats.lemmas_size, lemma_size);
-    slv->stats.lemmas_size.start[lemma_size] += 1;
+    slv->stats.lemmas_rederived++;
   }
   btor_node_release (btor, lemma);
 
@@ -1537,6 +1673,241 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
   BTOR_FUN_SOLVER (btor)->time.lemma_gen += btor_util_time_stamp () - start;
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Syntactic matching of argument lists.  Returns 1 if 'args1' and 'args2' are
+ * equal, -1 if they are distinct (at least one pair of distinct constants),
+ * and 0 if this can not be decided statically. */
+static int32_t
+match_args (BtorNode *args1, BtorNode *args2)
+{
+  BtorNode *arg1, *arg2;
+  BtorArgsIterator it1, it2;
+
+  if (args1 == args2) return 1;
+
+  btor_iter_args_init (&it1, args1);
+  btor_iter_args_init (&it2, args2);
+  while (btor_iter_args_has_next (&it1))
+  {
+    assert (btor_iter_args_has_next (&it2));
+    arg1 = btor_iter_args_next (&it1);
+    arg2 = btor_iter_args_next (&it2);
+    if (arg1 != arg2 && btor_node_is_bv_const (arg1)
+        && btor_node_is_bv_const (arg2))
+      return -1;
+  }
+  return 0;
+}
+
+/* Add read-over-write lemma for apply 'app' on write chain 'app->e[0]' and
+ * update 'upd', where 'skipped' contains the indices of all updates between
+ * 'app' and 'upd'. Returns true if a new lemma was added. */
+static bool
+add_static_row_lemma (Btor *btor,
+                      BtorNode *app,
+                      BtorNode *upd,
+                      BtorNodePtrStack *skipped)
+{
+  bool res;
+  uint32_t i, lemma_size;
+  BtorNode *and, *con, *lemma;
+  BtorNodePtrStack prem;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  res = false;
+  BTOR_INIT_STACK (btor->mm, prem);
+
+  push_premise (btor,
+                app->e[1],
+                skipped->start,
+                BTOR_COUNT_STACK (*skipped),
+                true,
+                &prem);
+  push_equal_args (btor, app->e[1], upd->e[1], true, &prem);
+  con = btor_exp_eq (btor, app, upd->e[2]);
+
+  slv->stats.lemmas_premisses_removed += minimize_premisses (btor, &prem);
+  lemma_size = 1 + BTOR_COUNT_STACK (prem);
+
+  if (BTOR_EMPTY_STACK (prem))
+    lemma = con;
+  else
+  {
+    and   = btor_exp_bv_and_n (btor, prem.start, BTOR_COUNT_STACK (prem));
+    lemma = btor_exp_implies (btor, and, con);
+    btor_node_release (btor, and);
+    btor_node_release (btor, con);
+  }
+
+  if (lemma != btor->true_exp && !btor_hashptr_table_get (slv->lemmas, lemma))
+  {
+    btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma))
+        ->data.as_int = lemma_size;
+    BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
+    slv->stats.static_lemmas++;
+    res = true;
+  }
+  btor_node_release (btor, lemma);
+
+  for (i = 0; i < BTOR_COUNT_STACK (prem); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (prem, i));
+  BTOR_RELEASE_STACK (prem);
+  return res;
+}
+
+/* Eagerly generate read-over-write lemmas for applies on write chains
+ * (updates) that are reachable from the constraints, which would otherwise
+ * be found one refinement iteration at a time.  Updates with statically
+ * distinct indices are skipped, and the chain walk stops at an update with
+ * a syntactically equal index.  At most 'budget' lemmas are generated. */
+static void
+add_static_lemmas (Btor *btor, uint32_t budget)
+{
+  assert (btor);
+  assert (budget);
+
+  uint32_t i, num_lemmas;
+  int32_t match;
+  double start;
+  BtorNode *cur, *fun;
+  BtorNodePtrStack visit, skipped;
+  BtorIntHashTable *cache;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  start      = btor_util_time_stamp ();
+  mm         = btor->mm;
+  num_lemmas = 0;
+  cache      = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, skipped);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+
+  while (!BTOR_EMPTY_STACK (visit) && num_lemmas < budget)
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (!cur->apply_below || cur->parameterized || btor_node_is_fun (cur)
+        || btor_node_is_simplified (cur)
+        || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+
+    if (btor_node_is_apply (cur))
+    {
+      BTOR_RESET_STACK (skipped);
+      for (fun = cur->e[0];
+           num_lemmas < budget && btor_node_is_update (fun)
+           && !btor_node_is_simplified (fun);
+           fun = fun->e[0])
+      {
+        /* index and value may contain further applies */
+        BTOR_PUSH_STACK (visit, fun->e[1]);
+        BTOR_PUSH_STACK (visit, fun->e[2]);
+        match = match_args (cur->e[1], fun->e[1]);
+        if (match == -1) continue;
+        if (add_static_row_lemma (btor, cur, fun, &skipped)) num_lemmas++;
+        if (match == 1) break;
+        BTOR_PUSH_STACK (skipped, fun->e[1]);
+      }
+      BTOR_PUSH_STACK (visit, cur->e[1]);
+      continue;
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+
+  BTOR_RELEASE_STACK (visit);
+  BTOR_RELEASE_STACK (skipped);
+  btor_hashint_table_delete (cache);
+  BTOR_FUN_SOLVER (btor)->time.static_lemmas += btor_util_time_stamp () - start;
+}
+
+/* Check the abstractions of lazily bit-blasted BV operators against the
+ * values of their operands in the current model of the bit-vector skeleton
+ * and bit-blast all operators that are inconsistent.  Operators that were
+ * simplified in the meantime are dropped, their abstraction only occurs in
+ * constraints that were rebuilt.  Returns the number of refinements. */
+static uint32_t
+refine_lazy_bv_ops (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, res;
+  double start;
+  BtorNode *cur;
+  BtorBitVector *bv0, *bv1, *bv, *val;
+  BtorNodePtrStack refine, drop;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+  slv   = BTOR_FUN_SOLVER (btor);
+  BTOR_INIT_STACK (mm, refine);
+  BTOR_INIT_STACK (mm, drop);
+
+  btor_iter_hashptr_init (&it, btor->lazy_bv_ops);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    assert (btor_node_is_regular (cur));
+    if (btor_node_is_simplified (cur) || btor_node_is_proxy (cur) || !cur->av
+        || !btor_node_real_addr (cur->e[0])->av
+        || !btor_node_real_addr (cur->e[1])->av)
+    {
+      BTOR_PUSH_STACK (drop, cur);
+      continue;
+    }
+
+    slv->stats.lazy_bv_checks++;
+    bv0 = btor_bv_get_assignment (mm, cur->e[0]);
+    bv1 = btor_bv_get_assignment (mm, cur->e[1]);
+    bv  = btor_bv_get_assignment (mm, cur);
+    if (btor_node_is_bv_mul (cur))
+      val = btor_bv_mul (mm, bv0, bv1);
+    else if (btor_node_is_bv_udiv (cur))
+      val = btor_bv_udiv (mm, bv0, bv1);
+    else
+    {
+      assert (btor_node_is_bv_urem (cur));
+      val = btor_bv_urem (mm, bv0, bv1);
+    }
+    if (btor_bv_compare (bv, val)) BTOR_PUSH_STACK (refine, cur);
+    btor_bv_free (mm, val);
+    btor_bv_free (mm, bv);
+    btor_bv_free (mm, bv1);
+    btor_bv_free (mm, bv0);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (drop); i++)
+  {
+    cur = BTOR_PEEK_STACK (drop, i);
+    btor_hashptr_table_remove (btor->lazy_bv_ops, cur, 0, 0);
+    btor_node_release (btor, cur);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (refine); i++)
+  {
+    cur = BTOR_PEEK_STACK (refine, i);
+    BTORLOG (1, "bit-blast: %s", btor_util_node2string (cur));
+    btor_synthesize_lazy_bv_op (btor, cur);
+  }
+  res = BTOR_COUNT_STACK (refine);
+  slv->stats.lazy_bv_refinements += res;
+
+  BTOR_RELEASE_STACK (drop);
+  BTOR_RELEASE_STACK (refine);
+  slv->time.lazy_bv += btor_util_time_stamp () - start;
+  return res;
+}
+
 static void
 push_applies_for_propagation (Btor *btor,
                               BtorNode *exp,
@@ -1823,10 +2194,9 @@ propagate (Btor *btor,
     conds = btor_hashptr_table_new (mm,
                                     (BtorHashPtr) btor_node_hash_by_id,
                                     (BtorCmpPtr) btor_node_compare_by_id);
-    btor_beta_assign_args (btor, fun, args);
-    fun_value = btor_beta_reduce_partial (btor, fun, conds);
+    fun_value = btor_beta_reduce_partial_cached (
+        btor, fun, args, conds, slv->betap_cache);
     assert (!btor_node_is_fun (fun_value));
-    btor_beta_unassign_params (btor, fun);
 
     prop_down = false;
     if (!btor_node_is_inverted (fun_value) && btor_node_is_apply (fun_value))
@@ -2113,7 +2483,8 @@ add_extensionality_lemmas (Btor *btor)
         btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, con));
         BTOR_PUSH_STACK (slv->cur_lemmas, con);
         slv->stats.extensionality_lemmas++;
-        slv->stats.lod_refinements++;
+        if (!btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_BATCH))
+          count_lemma (slv, 0);
         num_lemmas++;
         BTORLOG (1,
                  "    %s, %s",
@@ -2227,6 +2598,367 @@ push_unreachable_applies (Btor *btor, BtorNodePtrStack *init_apps)
   btor_hashint_table_delete (cache);
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Read-only conflict search over the initial applies.  The current SAT
+ * assignment is copied into a frozen model, which allows to evaluate
+ * synthesized nodes without querying the SAT solver.  Applies are traced
+ * through updates and function conditionals down to their UF, which does not
+ * modify any node and can therefore be done in parallel.  Lemmas for all
+ * detected conflicts are added afterwards.  Applies that reach a lambda or
+ * any simplified or unsynthesized node are left to 'propagate'. */
+
+#define BTOR_FUN_CONFLICT_SEARCH_MIN_APPS 256
+
+struct BtorFunConflictApp
+{
+  BtorNode *app;
+  BtorNode *fun;        /* UF reached or update with conflicting value */
+  BtorBitVector *args;  /* (concatenated) argument assignment */
+  BtorBitVector *value; /* assignment of 'app' */
+  uint32_t hash;        /* hash of 'args' */
+  bool conflict;        /* read-over-write conflict at update 'fun' */
+};
+
+typedef struct BtorFunConflictApp BtorFunConflictApp;
+
+struct BtorFunConflictSearch
+{
+  BtorMemMgr *mm; /* thread local memory manager */
+  const int8_t *model;
+  BtorFunConflictApp *apps;
+  uint32_t from, to;
+  bool threaded; /* false if the search ran in the current thread */
+};
+
+typedef struct BtorFunConflictSearch BtorFunConflictSearch;
+
+static int8_t *
+freeze_model (Btor *btor, uint32_t *size)
+{
+  assert (btor);
+  assert (size);
+
+  uint32_t i;
+  int32_t val;
+  int8_t *res;
+  BtorAIGMgr *amgr;
+
+  amgr  = btor_get_aig_mgr (btor);
+  *size = BTOR_SIZE_STACK (amgr->cnfid2aig);
+  if (!*size) return 0;
+
+  BTOR_NEWN (btor->mm, res, *size);
+  res[0] = -1;
+  for (i = 1; i < *size; i++)
+  {
+    val = -1;
+    if (amgr->cnfid2aig.start[i])
+      val = btor_aig_get_assignment (
+          amgr, btor_aig_get_by_id (amgr, amgr->cnfid2aig.start[i]));
+    res[i] = val;
+  }
+  return res;
+}
+
+/* Same as btor_bv_get_assignment, but with assignments from the frozen model.
+ * Returns 0 if 'exp' was simplified or is not synthesized. */
+static BtorBitVector *
+get_frozen_bv_assignment (BtorMemMgr *mm, const int8_t *model, BtorNode *exp)
+{
+  uint32_t i, j, width;
+  int32_t bit, cnf_id;
+  bool inv;
+  BtorAIG *aig;
+  BtorNode *real_exp;
+  BtorBitVector *res;
+
+  real_exp = btor_node_real_addr (exp);
+  if (btor_node_is_simplified (real_exp) || !real_exp->av) return 0;
+
+  width = real_exp->av->width;
+  res   = btor_bv_new (mm, width);
+  inv   = btor_node_is_inverted (exp);
+
+  for (i = 0, j = width - 1; i < width; i++, j--)
+  {
+    aig = real_exp->av->aigs[j];
+    if (aig == BTOR_AIG_TRUE)
+      bit = 1;
+    else if (aig == BTOR_AIG_FALSE)
+      bit = -1;
+    else
+    {
+      cnf_id = BTOR_REAL_ADDR_AIG (aig)->cnf_id;
+      bit    = cnf_id > 0 ? model[cnf_id] : -1;
+      if (BTOR_IS_INVERTED_AIG (aig)) bit = -bit;
+    }
+    if (inv) bit = -bit;
+    btor_bv_set_bit (res, i, bit == 1 ? 1 : 0);
+  }
+  return res;
+}
+
+static BtorBitVector *
+get_frozen_args_assignment (BtorMemMgr *mm,
+                            const int8_t *model,
+                            BtorNode *args)
+{
+  assert (btor_node_is_regular (args));
+  assert (btor_node_is_args (args));
+
+  BtorBitVector *res, *bv, *tmp;
+  BtorArgsIterator it;
+
+  if (btor_node_is_simplified (args)) return 0;
+
+  res = 0;
+  btor_iter_args_init (&it, args);
+  while (btor_iter_args_has_next (&it))
+  {
+    bv = get_frozen_bv_assignment (mm, model, btor_iter_args_next (&it));
+    if (!bv)
+    {
+      if (res) btor_bv_free (mm, res);
+      return 0;
+    }
+    if (!res)
+    {
+      res = bv;
+      continue;
+    }
+    tmp = btor_bv_concat (mm, res, bv);
+    btor_bv_free (mm, res);
+    btor_bv_free (mm, bv);
+    res = tmp;
+  }
+  return res;
+}
+
+static void
+search_conflict_app (BtorMemMgr *mm,
+                     const int8_t *model,
+                     BtorFunConflictApp *capp)
+{
+  bool is_true;
+  BtorNode *fun;
+  BtorBitVector *bv;
+
+  fun         = capp->app->e[0];
+  capp->args  = get_frozen_args_assignment (mm, model, capp->app->e[1]);
+  capp->value = get_frozen_bv_assignment (mm, model, capp->app);
+  if (!capp->args || !capp->value) goto UNKNOWN;
+  capp->hash = btor_bv_hash (capp->args);
+
+  for (;;)
+  {
+    assert (btor_node_is_regular (fun));
+    if (btor_node_is_simplified (fun)) goto UNKNOWN;
+
+    if (btor_node_is_uf (fun))
+    {
+      capp->fun = fun;
+      return;
+    }
+    else if (btor_node_is_fun_cond (fun))
+    {
+      bv = get_frozen_bv_assignment (mm, model, fun->e[0]);
+      if (!bv) goto UNKNOWN;
+      is_true = btor_bv_is_true (bv);
+      btor_bv_free (mm, bv);
+      fun = is_true ? fun->e[1] : fun->e[2];
+    }
+    else if (btor_node_is_update (fun))
+    {
+      bv = get_frozen_args_assignment (mm, model, fun->e[1]);
+      if (!bv) goto UNKNOWN;
+      is_true = btor_bv_compare (bv, capp->args) == 0;
+      btor_bv_free (mm, bv);
+      if (!is_true)
+      {
+        fun = fun->e[0];
+        continue;
+      }
+      bv = get_frozen_bv_assignment (mm, model, fun->e[2]);
+      if (!bv) goto UNKNOWN;
+      if (btor_bv_compare (bv, capp->value) != 0)
+      {
+        capp->fun      = fun;
+        capp->conflict = true;
+      }
+      btor_bv_free (mm, bv);
+      return;
+    }
+    /* lambdas require partial beta reduction */
+    else
+      goto UNKNOWN;
+  }
+
+UNKNOWN:
+  if (capp->args) btor_bv_free (mm, capp->args);
+  if (capp->value) btor_bv_free (mm, capp->value);
+  capp->args  = 0;
+  capp->value = 0;
+  capp->fun   = 0;
+}
+
+static void *
+conflict_search_work (void *state)
+{
+  uint32_t i;
+  BtorFunConflictSearch *search;
+
+  search = (BtorFunConflictSearch *) state;
+  for (i = search->from; i < search->to; i++)
+    search_conflict_app (search->mm, search->model, &search->apps[i]);
+  return 0;
+}
+
+static int
+compare_conflict_apps (const void *p, const void *q)
+{
+  const BtorFunConflictApp *a = *(const BtorFunConflictApp **) p;
+  const BtorFunConflictApp *b = *(const BtorFunConflictApp **) q;
+
+  if (a->fun->id != b->fun->id) return a->fun->id - b->fun->id;
+  if (a->hash != b->hash) return a->hash < b->hash ? -1 : 1;
+  return a->app->id - b->app->id;
+}
+
+static void
+search_conflicts (Btor *btor, BtorNodePtrStack *init_apps)
+{
+  assert (btor);
+  assert (init_apps);
+
+  double start;
+  uint32_t i, j, k, l, n, num_threads, model_size, num_ufs, num_lemmas;
+  int8_t *model;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+  BtorFunConflictApp *apps, *a, *b, **ufs;
+  BtorFunConflictSearch *search;
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_t *threads;
+#endif
+
+  n = BTOR_COUNT_STACK (*init_apps);
+  if (!n) return;
+
+  start      = btor_util_time_stamp ();
+  mm         = btor->mm;
+  slv        = BTOR_FUN_SOLVER (btor);
+  num_lemmas = 0;
+  model      = freeze_model (btor, &model_size);
+  if (!model) return;
+
+  num_threads = btor_opt_get (btor, BTOR_OPT_FUN_CONFLICT_THREADS);
+  if (num_threads > n / BTOR_FUN_CONFLICT_SEARCH_MIN_APPS)
+    num_threads = n / BTOR_FUN_CONFLICT_SEARCH_MIN_APPS;
+#ifndef BTOR_HAVE_PTHREADS
+  num_threads = 1;
+#endif
+  if (num_threads == 0) num_threads = 1;
+
+  BTOR_CNEWN (mm, apps, n);
+  for (i = 0; i < n; i++) apps[i].app = BTOR_PEEK_STACK (*init_apps, i);
+
+  BTOR_CNEWN (mm, search, num_threads);
+  for (i = 0; i < num_threads; i++)
+  {
+    search[i].mm    = btor_mem_mgr_new ();
+    search[i].model = model;
+    search[i].apps  = apps;
+    search[i].from  = (uint64_t) n * i / num_threads;
+    search[i].to    = (uint64_t) n * (i + 1) / num_threads;
+  }
+
+#ifdef BTOR_HAVE_PTHREADS
+  if (num_threads > 1)
+  {
+    BTOR_NEWN (mm, threads, num_threads);
+    for (i = 0; i < num_threads; i++)
+    {
+      search[i].threaded =
+          !pthread_create (&threads[i], 0, conflict_search_work, &search[i]);
+      /* fall back to the current thread if no thread could be created */
+      if (!search[i].threaded) conflict_search_work (&search[i]);
+    }
+    for (i = 0; i < num_threads; i++)
+      if (search[i].threaded) pthread_join (threads[i], 0);
+    BTOR_DELETEN (mm, threads, num_threads);
+  }
+  else
+#endif
+    conflict_search_work (&search[0]);
+
+  /* serialized lemma generation: read-over-write conflicts */
+  BTOR_NEWN (mm, ufs, n);
+  num_ufs = 0;
+  for (i = 0; i < n; i++)
+  {
+    a = &apps[i];
+    if (!a->fun) continue;
+    if (a->conflict)
+    {
+      BTORLOG (1, "update conflict at: %s", btor_util_node2string (a->fun));
+      slv->stats.beta_reduction_conflicts++;
+      add_lemma (btor, a->fun, a->app, 0);
+      num_lemmas++;
+    }
+    else
+    {
+      assert (btor_node_is_uf (a->fun));
+      ufs[num_ufs++] = a;
+    }
+  }
+
+  /* function congruence conflicts: applies on the same UF with equal
+   * argument assignments are adjacent after sorting */
+  qsort (ufs, num_ufs, sizeof (BtorFunConflictApp *), compare_conflict_apps);
+  for (i = 0; i < num_ufs; i = j)
+  {
+    j = i + 1;
+    while (j < num_ufs && ufs[j]->fun == ufs[i]->fun
+           && ufs[j]->hash == ufs[i]->hash)
+      j++;
+    for (k = i + 1; k < j; k++)
+    {
+      b = ufs[k];
+      for (a = 0, l = i; l < k; l++)
+      {
+        if (btor_bv_compare (ufs[l]->args, b->args) == 0)
+        {
+          a = ufs[l];
+          break;
+        }
+      }
+      if (!a || btor_bv_compare (a->value, b->value) == 0) continue;
+      BTORLOG (1, "FC conflict at: %s", btor_util_node2string (b->fun));
+      slv->stats.function_congruence_conflicts++;
+      add_lemma (btor, b->fun, a->app, b->app);
+      num_lemmas++;
+    }
+  }
+  BTOR_DELETEN (mm, ufs, n);
+
+  for (i = 0; i < num_threads; i++)
+  {
+    for (j = search[i].from; j < search[i].to; j++)
+    {
+      if (apps[j].args) btor_bv_free (search[i].mm, apps[j].args);
+      if (apps[j].value) btor_bv_free (search[i].mm, apps[j].value);
+    }
+    btor_mem_mgr_delete (search[i].mm);
+  }
+  BTOR_DELETEN (mm, search, num_threads);
+  BTOR_DELETEN (mm, apps, n);
+  BTOR_DELETEN (mm, model, model_size);
+
+  slv->stats.conflict_search_lemmas += num_lemmas;
+  slv->time.conflict_search += btor_util_time_stamp () - start;
+}
+
 static void
 check_and_resolve_conflicts (Btor *btor,
                              Btor *clone,
@@ -2264,6 +2996,11 @@ check_and_resolve_conflicts (Btor *btor,
    * consistency checking. this also deletes the model from the previous run */
   btor_model_init_bv (btor, &btor->bv_model);
 
+  /* cached partial beta reduction results depend on the model and on the
+   * constraints (embedded constraints rewriting), which both may have changed
+   * since the previous run due to the lemmas added */
+  if (slv->betap_cache) btor_beta_cache_reset (slv->betap_cache);
+
   BTOR_INIT_STACK (mm, prop_stack);
   BTOR_INIT_STACK (mm, top_applies);
   apply_search_cache = btor_hashint_table_new (mm);
@@ -2309,20 +3046,31 @@ check_and_resolve_conflicts (Btor *btor,
     push_unreachable_applies (btor, init_apps);
   }
 
-  for (i = BTOR_COUNT_STACK (*init_apps) - 1; i >= 0; i--)
+  /* check initial applies on the frozen model first, fall back to
+   * propagation if no conflict was found */
+  if (btor_opt_get (btor, BTOR_OPT_FUN_CONFLICT_THREADS))
   {
-    app = BTOR_PEEK_STACK (*init_apps, i);
-    assert (btor_node_is_regular (app));
-    assert (btor_node_is_apply (app));
-    assert (!app->parameterized);
-    assert (!app->propagated);
-    BTOR_PUSH_STACK (prop_stack, app);
-    BTOR_PUSH_STACK (prop_stack, app->e[0]);
-    BTORLOG (2, "push apply: %s", btor_util_node2string (app));
+    search_conflicts (btor, init_apps);
+    found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
   }
 
-  propagate (btor, &prop_stack, cleanup_table, apply_search_cache);
-  found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
+  if (!found_conflicts)
+  {
+    for (i = BTOR_COUNT_STACK (*init_apps) - 1; i >= 0; i--)
+    {
+      app = BTOR_PEEK_STACK (*init_apps, i);
+      assert (btor_node_is_regular (app));
+      assert (btor_node_is_apply (app));
+      assert (!app->parameterized);
+      assert (!app->propagated);
+      BTOR_PUSH_STACK (prop_stack, app);
+      BTOR_PUSH_STACK (prop_stack, app->e[0]);
+      BTORLOG (2, "push apply: %s", btor_util_node2string (app));
+    }
+
+    propagate (btor, &prop_stack, cleanup_table, apply_search_cache);
+    found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
+  }
 
   /* check consistency of array/uf equalities */
   if (!found_conflicts && btor->feqs->count > 0)
@@ -2389,6 +3137,125 @@ check_and_resolve_conflicts (Btor *btor,
   slv->time.check_consistency += btor_util_time_stamp () - start;
 }
 
+/*------------------------------------------------------------------------*/
+
+struct BtorFunLemmaRank
+{
+  BtorNode *lemma;
+  int32_t rederived; /* number of re-derivations while deferred */
+  int32_t size;
+};
+
+typedef struct BtorFunLemmaRank BtorFunLemmaRank;
+
+static int
+compare_lemma_rank (const void *p, const void *q)
+{
+  const BtorFunLemmaRank *a = (const BtorFunLemmaRank *) p;
+  const BtorFunLemmaRank *b = (const BtorFunLemmaRank *) q;
+
+  if (a->rederived != b->rederived) return b->rederived - a->rederived;
+  if (a->size != b->size) return a->size - b->size;
+  return btor_node_get_id (a->lemma) - btor_node_get_id (b->lemma);
+}
+
+/* Select the lemmas to be added in the current refinement iteration.
+ * Lemmas are ranked by the number of times they were derived again while
+ * being deferred, and then by size (smaller lemmas first). Lemmas that do not
+ * fit into the current batch are deferred, i.e., they are only added if they
+ * are derived again in a subsequent refinement iteration. If more than half
+ * of the batch consists of re-derived lemmas, the batch size is doubled. */
+static void
+schedule_lemmas (BtorFunSolver *slv)
+{
+  assert (slv);
+  assert (!BTOR_EMPTY_STACK (slv->cur_lemmas));
+
+  uint32_t i, n, nrederived, nadded;
+  Btor *btor;
+  BtorNode *lemma;
+  BtorFunLemmaRank *ranks;
+  BtorPtrHashBucket *b;
+  BtorHashTableData *d;
+
+  btor = slv->btor;
+
+  if (slv->lemma_batch == 0)
+    slv->lemma_batch = btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_BATCH);
+  assert (slv->lemma_batch > 0);
+
+  n = BTOR_COUNT_STACK (slv->cur_lemmas);
+  BTOR_NEWN (btor->mm, ranks, n);
+  for (i = 0, nrederived = 0; i < n; i++)
+  {
+    lemma = BTOR_PEEK_STACK (slv->cur_lemmas, i);
+    b     = btor_hashptr_table_get (slv->lemmas, lemma);
+    d     = btor_hashint_map_get (slv->pending_lemmas,
+                              btor_node_get_id (lemma));
+    ranks[i].lemma     = lemma;
+    ranks[i].size      = b->data.as_int;
+    ranks[i].rederived = d ? d->as_int : 0;
+    if (d) nrederived += 1;
+  }
+  qsort (ranks, n, sizeof (BtorFunLemmaRank), compare_lemma_rank);
+
+  if (2 * nrederived > slv->lemma_batch && slv->lemma_batch < INT32_MAX)
+    slv->lemma_batch *= 2;
+
+  BTOR_RESET_STACK (slv->cur_lemmas);
+  for (i = 0, nadded = 0; i < n; i++)
+  {
+    lemma = ranks[i].lemma;
+    /* lemmas may be derived more than once per refinement iteration */
+    if (i > 0 && ranks[i - 1].lemma == lemma) continue;
+
+    if (nadded < slv->lemma_batch)
+    {
+      if (btor_hashint_map_contains (slv->pending_lemmas,
+                                     btor_node_get_id (lemma)))
+        btor_hashint_map_remove (
+            slv->pending_lemmas, btor_node_get_id (lemma), 0);
+      BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
+      count_lemma (slv, ranks[i].size);
+      nadded++;
+    }
+    else if (!btor_hashint_map_contains (slv->pending_lemmas,
+                                         btor_node_get_id (lemma)))
+    {
+      btor_hashint_map_add (slv->pending_lemmas, btor_node_get_id (lemma));
+      slv->stats.lemmas_deferred++;
+    }
+  }
+  BTOR_DELETEN (btor->mm, ranks, n);
+
+  BTORLOG (1,
+           "scheduled %u lemma(s), %u lemma(s) deferred",
+           nadded,
+           slv->pending_lemmas->count);
+}
+
+/* Remove lemmas that were deferred but never added from the lemma cache. */
+static void
+reset_pending_lemmas (BtorFunSolver *slv)
+{
+  Btor *btor;
+  BtorNode *lemma;
+  BtorIntHashTableIterator it;
+
+  btor = slv->btor;
+  btor_iter_hashint_init (&it, slv->pending_lemmas);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    lemma = btor_node_get_by_id (btor, btor_iter_hashint_next (&it));
+    assert (lemma);
+    assert (btor_hashptr_table_get (slv->lemmas, lemma));
+    btor_hashptr_table_remove (slv->lemmas, lemma, 0, 0);
+    btor_node_release (btor, lemma);
+  }
+  btor_hashint_map_delete (slv->pending_lemmas);
+  slv->pending_lemmas = btor_hashint_map_new (btor->mm);
+}
+
 static void
 reset_lemma_cache (BtorFunSolver *slv)
 {
@@ -2405,6 +3272,205 @@ reset_lemma_cache (BtorFunSolver *slv)
                                         (BtorCmpPtr) btor_node_compare_by_id);
 }
 
+/* Add lemmas of current refinement iteration to formula. */
+static void
+add_cur_lemmas (Btor *btor,
+                Btor *clone,
+                BtorNode **clone_root,
+                BtorNodeMap *exp_map)
+{
+  uint32_t i;
+  BtorNode *lemma;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
+
+  BTORLOG (1, "add %d lemma(s)", BTOR_COUNT_STACK (slv->cur_lemmas));
+  for (i = 0; i < BTOR_COUNT_STACK (slv->cur_lemmas); i++)
+  {
+    lemma = BTOR_PEEK_STACK (slv->cur_lemmas, i);
+    assert (!btor_node_is_simplified (lemma));
+    // TODO (ma): use btor_assert_exp?
+    if (slv->assume_lemmas)
+      btor_assume_exp (btor, lemma);
+    else
+      btor_insert_unsynthesized_constraint (btor, lemma);
+    if (clone)
+      add_lemma_to_dual_prop_clone (btor, clone, clone_root, lemma, exp_map);
+  }
+  BTOR_RESET_STACK (slv->cur_lemmas);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Sequential schedule of prop engine and SAT solver (--fun-schedule).
+ *
+ * Slice i of both engines gets a budget of unit * luby (i) propagation steps
+ * (prop) and conflicts (SAT). The prop engine is restarted from scratch in
+ * every slice, with the values of the inputs fixed by the SAT solver as
+ * input domains. The SAT solver is called incrementally and uses the last
+ * assignment of the prop engine as phases.
+ *
+ * --prop-nprops and the SAT limit bound the total number of propagation
+ * steps and conflicts of all slices. */
+
+/* Budget of given slice, at most 'left' (-1: unbounded). */
+static int32_t
+schedule_budget (Btor *btor, uint32_t slice, int64_t left)
+{
+  uint64_t res;
+
+  res = (uint64_t) btor_opt_get (btor, BTOR_OPT_FUN_SCHEDULE_UNIT)
+        * btor_util_luby (slice);
+  if (res > INT32_MAX) res = INT32_MAX;
+  if (left > -1 && (uint64_t) left < res) res = left;
+  return (int32_t) res;
+}
+
+/* Collect the bits of the inputs fixed by the SAT solver as domains. */
+static void
+schedule_collect_domains (Btor *btor, BtorIntHashTable *domains)
+{
+  assert (btor);
+  assert (domains);
+
+  uint32_t i, w;
+  int32_t val;
+  BtorNode *var;
+  BtorAIG *aig;
+  BtorAIGVec *av;
+  BtorBvDomain *d;
+  BtorSATMgr *smgr;
+  BtorPtrHashTableIterator it;
+
+  smgr = btor_get_sat_mgr (btor);
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_node_real_addr (btor_iter_hashptr_next (&it));
+    if (!(av = var->av)) continue;
+    w = av->width;
+    d = 0;
+    for (i = 0; i < w; i++)
+    {
+      aig = av->aigs[i];
+      if (btor_aig_is_const (aig) || !BTOR_REAL_ADDR_AIG (aig)->cnf_id)
+        continue;
+      if (!(val = btor_sat_fixed (smgr, btor_aig_get_cnf_id (aig)))) continue;
+      if (!d) d = btor_bvdomain_new_init (btor->mm, w);
+      /* aigs[i] is bit w - 1 - i */
+      if (val > 0)
+        btor_bv_set_bit (d->lo, w - 1 - i, 1);
+      else
+        btor_bv_set_bit (d->hi, w - 1 - i, 0);
+    }
+    if (!d) continue;
+    btor_bv_free (btor->mm, d->min);
+    btor_bv_free (btor->mm, d->max);
+    d->min = btor_bv_copy (btor->mm, d->lo);
+    d->max = btor_bv_copy (btor->mm, d->hi);
+    btor_hashint_map_add (domains, var->id)->as_ptr = d;
+  }
+}
+
+/* Use the current model of the inputs as phases of the SAT solver. */
+static void
+schedule_set_phases (Btor *btor)
+{
+  assert (btor);
+  assert (btor->bv_model);
+
+  uint32_t i, w;
+  int32_t lit;
+  BtorNode *var;
+  BtorAIG *aig;
+  BtorAIGVec *av;
+  BtorBitVector *bv;
+  BtorHashTableData *d;
+  BtorSATMgr *smgr;
+  BtorPtrHashTableIterator it;
+
+  smgr = btor_get_sat_mgr (btor);
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_node_real_addr (btor_iter_hashptr_next (&it));
+    if (!(av = var->av)) continue;
+    if (!(d = btor_hashint_map_get (btor->bv_model, var->id))) continue;
+    bv = d->as_ptr;
+    w  = av->width;
+    assert (btor_bv_get_width (bv) == w);
+    for (i = 0; i < w; i++)
+    {
+      aig = av->aigs[i];
+      if (btor_aig_is_const (aig) || !BTOR_REAL_ADDR_AIG (aig)->cnf_id)
+        continue;
+      lit = btor_aig_get_cnf_id (aig);
+      btor_sat_phase (smgr, btor_bv_get_bit (bv, w - 1 - i) ? lit : -lit);
+    }
+  }
+}
+
+/* Run the prop engine for one slice. 'props_left' is the number of
+ * propagation steps left for all remaining slices (-1: unbounded). */
+static BtorSolverResult
+schedule_prop_slice (BtorFunSolver *slv,
+                     uint32_t slice,
+                     BtorIntHashTable *domains,
+                     int64_t *props_left)
+{
+  assert (slv);
+  assert (domains);
+  assert (props_left);
+
+  uint32_t nprops, pdomains;
+  int32_t budget;
+  uint64_t props;
+  BtorSolverResult result;
+  BtorSolver *preslv;
+  Btor *btor;
+
+  if (*props_left == 0) return BTOR_RESULT_UNKNOWN;
+
+  btor     = slv->btor;
+  nprops   = btor_opt_get (btor, BTOR_OPT_PROP_NPROPS);
+  pdomains = btor_opt_get (btor, BTOR_OPT_PROP_DOMAINS);
+  budget   = schedule_budget (btor, slice, *props_left);
+
+  preslv = btor_new_prop_solver (btor);
+  btor_opt_set (btor, BTOR_OPT_PROP_NPROPS, budget);
+  if (domains->count)
+  {
+    btor_opt_set (btor, BTOR_OPT_PROP_DOMAINS, 1);
+    ((BtorPropSolver *) preslv)->domains =
+        btor_bvdomain_clone_map (btor->mm, domains);
+  }
+  btor->slv = preslv;
+  btor_opt_set (btor, BTOR_OPT_ENGINE, BTOR_ENGINE_PROP);
+  result = btor->slv->api.sat (btor->slv);
+  props  = BTOR_PROP_SOLVER (btor)->stats.props;
+  btor->slv->api.delet (btor->slv);
+  /* reset */
+  btor->slv = (BtorSolver *) slv;
+  btor_opt_set (btor, BTOR_OPT_ENGINE, BTOR_ENGINE_FUN);
+  btor_opt_set (btor, BTOR_OPT_PROP_NPROPS, nprops);
+  btor_opt_set (btor, BTOR_OPT_PROP_DOMAINS, pdomains);
+
+  if (*props_left > -1)
+    *props_left = props < (uint64_t) *props_left ? *props_left - props : 0;
+
+  BTOR_MSG (btor->msg,
+            1,
+            "schedule slice %u: PROP with %d steps, %u fixed inputs: %s",
+            slice,
+            budget,
+            domains->count,
+            result == BTOR_RESULT_SAT
+                ? "sat"
+                : (result == BTOR_RESULT_UNSAT ? "unsat" : "unknown"));
+  return result;
+}
+
 static BtorSolverResult
 sat_fun_solver (BtorFunSolver *slv)
 {
@@ -2413,13 +3479,15 @@ sat_fun_solver (BtorFunSolver *slv)
   assert (slv->btor);
   assert (slv->btor->slv == (BtorSolver *) slv);
 
-  uint32_t i;
-  bool done;
+  bool done, schedule, sliced;
+  uint32_t slice;
+  int32_t limit;
+  int64_t props_left, conflicts_left;
   BtorSolverResult result;
   Btor *btor, *clone;
-  BtorNode *clone_root, *lemma;
+  BtorNode *clone_root;
   BtorNodeMap *exp_map;
-  BtorIntHashTable *init_apps_cache;
+  BtorIntHashTable *init_apps_cache, *sched_domains;
   BtorNodePtrStack init_apps;
 
   btor = slv->btor;
@@ -2430,9 +3498,17 @@ sat_fun_solver (BtorFunSolver *slv)
   BTOR_INIT_STACK (btor->mm, init_apps);
   init_apps_cache = btor_hashint_table_new (btor->mm);
 
-  clone      = 0;
-  clone_root = 0;
-  exp_map    = 0;
+  clone         = 0;
+  clone_root    = 0;
+  exp_map       = 0;
+  sched_domains  = 0;
+  slice          = 0;
+  limit          = slv->sat_limit;
+  props_left     = -1;
+  conflicts_left = slv->sat_limit;
+
+  if (btor_opt_get (btor, BTOR_OPT_FUN_BETA_CACHE) && !slv->betap_cache)
+    slv->betap_cache = btor_beta_cache_new (btor);
 
   if ((btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
        || btor_opt_get (btor, BTOR_OPT_FUN_PRESLS))
@@ -2479,6 +3555,19 @@ sat_fun_solver (BtorFunSolver *slv)
     btor_model_delete (btor);
   }
 
+  schedule = btor_opt_get (btor, BTOR_OPT_FUN_SCHEDULE)
+             && btor->ufs->count == 0 && btor->feqs->count == 0
+             && btor->lambdas->count == 0;
+  if (schedule)
+  {
+    if (btor_opt_get (btor, BTOR_OPT_PROP_NPROPS))
+      props_left = btor_opt_get (btor, BTOR_OPT_PROP_NPROPS);
+    sched_domains = btor_hashint_map_new (btor->mm);
+    result = schedule_prop_slice (slv, ++slice, sched_domains, &props_left);
+    if (result != BTOR_RESULT_UNKNOWN) goto DONE;
+    /* model of prop engine is kept for setting phases */
+  }
+
   if (btor_terminate (btor))
   {
   UNKNOWN:
@@ -2498,6 +3587,14 @@ sat_fun_solver (BtorFunSolver *slv)
     clone = new_exp_layer_clone_for_dual_prop (btor, &exp_map, &clone_root);
   }
 
+  if (btor_opt_get (btor, BTOR_OPT_FUN_STATIC_LEMMAS)
+      && (btor->ufs->count > 0 || btor->lambdas->count > 0))
+  {
+    add_static_lemmas (btor, btor_opt_get (btor, BTOR_OPT_FUN_STATIC_LEMMAS));
+    add_cur_lemmas (btor, clone, &clone_root, exp_map);
+    if (btor->inconsistent) goto UNSAT;
+  }
+
   while (true)
   {
     if (btor_terminate (btor)
@@ -2520,19 +3617,54 @@ sat_fun_solver (BtorFunSolver *slv)
 
     /* make SAT call on bv skeleton */
     btor_add_again_assumptions (btor);
-    result = timed_sat_sat (btor, slv->sat_limit);
+    /* slices require an incremental SAT solver, without prop steps left the
+     * SAT solver runs up to the SAT limit */
+    sliced = schedule && btor_get_sat_mgr (btor)->inc_required
+             && props_left != 0;
+    if (schedule && btor->bv_model)
+    {
+      schedule_set_phases (btor);
+      btor_model_delete (btor);
+    }
+    if (sliced)
+      limit = schedule_budget (btor, slice, conflicts_left);
+    else
+      limit = slv->sat_limit;
+    result = timed_sat_sat (btor, limit);
 
     if (result == BTOR_RESULT_UNSAT)
       goto DONE;
     else if (result == BTOR_RESULT_UNKNOWN)
     {
-      assert (slv->sat_limit > -1 || btor->cbs.term.done
+      if (sliced && !btor_terminate (btor))
+      {
+        BTOR_MSG (btor->msg,
+                  1,
+                  "schedule slice %u: SAT with %d conflicts: unknown",
+                  slice,
+                  limit);
+        if (conflicts_left > -1) conflicts_left -= limit;
+        /* SAT limit reached */
+        if (conflicts_left == 0) goto DONE;
+        btor_bvdomain_delete_map (btor->mm, sched_domains);
+        sched_domains = btor_hashint_map_new (btor->mm);
+        schedule_collect_domains (btor, sched_domains);
+        result =
+            schedule_prop_slice (slv, ++slice, sched_domains, &props_left);
+        if (result != BTOR_RESULT_UNKNOWN) goto DONE;
+        continue;
+      }
+      assert (limit > -1 || btor->cbs.term.done
               || btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS));
       goto DONE;
     }
 
     assert (result == BTOR_RESULT_SAT);
 
+    /* BV operator abstractions are refined before function consistency is
+     * checked since lemmas are derived from BV values */
+    if (btor->lazy_bv_ops->count > 0 && refine_lazy_bv_ops (btor)) continue;
+
     if (btor->ufs->count == 0 && btor->lambdas->count == 0) break;
 
     check_and_resolve_conflicts (
@@ -2540,21 +3672,9 @@ sat_fun_solver (BtorFunSolver *slv)
     if (BTOR_EMPTY_STACK (slv->cur_lemmas)) break;
     slv->stats.refinement_iterations++;
 
-    BTORLOG (1, "add %d lemma(s)", BTOR_COUNT_STACK (slv->cur_lemmas));
-    /* add generated lemmas to formula */
-    for (i = 0; i < BTOR_COUNT_STACK (slv->cur_lemmas); i++)
-    {
-      lemma = BTOR_PEEK_STACK (slv->cur_lemmas, i);
-      assert (!btor_node_is_simplified (lemma));
-      // TODO (ma): use btor_assert_exp?
-      if (slv->assume_lemmas)
-        btor_assume_exp (btor, lemma);
-      else
-        btor_insert_unsynthesized_constraint (btor, lemma);
-      if (clone)
-        add_lemma_to_dual_prop_clone (btor, clone, &clone_root, lemma, exp_map);
-    }
-    BTOR_RESET_STACK (slv->cur_lemmas);
+    if (btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_BATCH)) schedule_lemmas (slv);
+
+    add_cur_lemmas (btor, clone, &clone_root, exp_map);
 
     if (btor_opt_get (btor, BTOR_OPT_VERBOSITY))
     {
@@ -2576,6 +3696,11 @@ sat_fun_solver (BtorFunSolver *slv)
 DONE:
   BTOR_RELEASE_STACK (init_apps);
   btor_hashint_table_delete (init_apps_cache);
+  if (sched_domains) btor_bvdomain_delete_map (btor->mm, sched_domains);
+
+  if (slv->pending_lemmas->count) reset_pending_lemmas (slv);
+  /* do not keep references to nodes across sat calls */
+  if (slv->betap_cache) btor_beta_cache_reset (slv->betap_cache);
 
   if (clone)
   {
@@ -2650,11 +3775,37 @@ print_stats_fun_solver (BtorFunSolver *slv)
                 1,
                 "  %4d extensionality lemmas",
                 slv->stats.extensionality_lemmas);
+      if (btor_opt_get (btor, BTOR_OPT_FUN_STATIC_LEMMAS))
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4d static read-over-write lemmas",
+                  slv->stats.static_lemmas);
       BTOR_MSG (btor->msg,
                 1,
                 "  %.1f average lemma size",
                 BTOR_AVERAGE_UTIL (slv->stats.lemmas_size_sum,
                                    slv->stats.lod_refinements));
+      BTOR_MSG (btor->msg,
+                1,
+                "  %4d redundant lemma premisses removed",
+                slv->stats.lemmas_premisses_removed);
+      if (btor_opt_get (btor, BTOR_OPT_FUN_CONFLICT_THREADS))
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4d lemmas from conflict search",
+                  slv->stats.conflict_search_lemmas);
+      if (btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_BATCH))
+      {
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4d lemmas deferred (%d derived again)",
+                  slv->stats.lemmas_deferred,
+                  slv->stats.lemmas_rederived);
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4d final lemma batch size",
+                  slv->lemma_batch);
+      }
       for (i = 1; i < BTOR_SIZE_STACK (slv->stats.lemmas_size); i++)
       {
         if (!slv->stats.lemmas_size.start[i]) continue;
@@ -2674,9 +3825,25 @@ print_stats_fun_solver (BtorFunSolver *slv)
             1,
             "%7lld partial beta reductions",
             btor->stats.betap_reduce_calls);
+  if (slv->betap_cache)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%7lld partial beta reduction cache hits (%.1f%%)",
+              slv->betap_cache->stats.hits,
+              100 * BTOR_AVERAGE_UTIL (slv->betap_cache->stats.hits,
+                                       slv->betap_cache->stats.hits
+                                           + slv->betap_cache->stats.misses));
+  }
   BTOR_MSG (btor->msg, 1, "%7lld propagations", slv->stats.propagations);
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_LAZY_BITBLAST))
+    BTOR_MSG (btor->msg,
+              1,
+              "%7d lazily bit-blasted BV operators (%d checks)",
+              slv->stats.lazy_bv_refinements,
+              slv->stats.lazy_bv_checks);
 
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
@@ -2706,6 +3873,16 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
   btor = slv->btor;
 
   BTOR_MSG (btor->msg, 1, "");
+  if (btor_opt_get (btor, BTOR_OPT_FUN_STATIC_LEMMAS))
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds static lemma generation",
+              slv->time.static_lemmas);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_LAZY_BITBLAST))
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds lazy bit-blasting",
+              slv->time.lazy_bv);
   BTOR_MSG (btor->msg,
             1,
             "%.2f seconds consistency checking",
@@ -2759,6 +3936,11 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
             1,
             "    %.2f seconds partial beta reduction",
             btor->time.betap);
+  if (slv->betap_cache)
+    BTOR_MSG (btor->msg,
+              1,
+              "      %.2f seconds saved by partial beta reduction cache",
+              slv->betap_cache->stats.time_saved);
   BTOR_MSG (
       btor->msg, 1, "    %.2f seconds lemma generation", slv->time.lemma_gen);
   BTOR_MSG (btor->msg,
@@ -2769,6 +3951,11 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
             1,
             "    %.2f seconds conflict apply search",
             slv->time.find_conf_app);
+  if (btor_opt_get (btor, BTOR_OPT_FUN_CONFLICT_THREADS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds conflict search on frozen model",
+              slv->time.conflict_search);
   if (btor->feqs->count > 0)
     BTOR_MSG (btor->msg,
               1,
@@ -2817,6 +4004,7 @@ btor_new_fun_solver (Btor *btor)
                                         (BtorHashPtr) btor_node_hash_by_id,
                                         (BtorCmpPtr) btor_node_compare_by_id);
   BTOR_INIT_STACK (btor->mm, slv->cur_lemmas);
+  slv->pending_lemmas = btor_hashint_map_new (btor->mm);
 
   BTOR_INIT_STACK (btor->mm, slv->stats.lemmas_size);
 
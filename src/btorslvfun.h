@@ -9,8 +9,10 @@
 #ifndef BTORSLVFUN_H_INCLUDED
 #define BTORSLVFUN_H_INCLUDED
 
+#include "btorbeta.h"
 #include "btornode.h"
 #include "btorslv.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
@@ -19,8 +21,13 @@ struct BtorFunSolver
 {
   BTOR_SOLVER_STRUCT;
 
-  BtorPtrHashTable *lemmas;
+  BtorPtrHashTable *lemmas; /* maps lemmas to their size */
   BtorNodePtrStack cur_lemmas;
+  BtorIntHashTable *pending_lemmas; /* deferred lemmas (maps lemma id to
+                                       number of re-derivations) */
+  uint32_t lemma_batch;             /* current lemma batch size */
+
+  BtorBetaCache *betap_cache; /* partial beta reduction results */
 
   BtorPtrHashTable *score; /* dcr score */
 
@@ -37,9 +44,17 @@ struct BtorFunSolver
     uint32_t function_congruence_conflicts;
     uint32_t beta_reduction_conflicts;
     uint32_t extensionality_lemmas;
+    uint32_t static_lemmas; /* eagerly added read-over-write lemmas */
+    uint32_t lazy_bv_checks;      /* checks of abstracted BV operators */
+    uint32_t lazy_bv_refinements; /* abstracted BV operators bit-blasted */
 
     BtorUIntStack lemmas_size;      /* distribution of n-size lemmas */
     uint_least64_t lemmas_size_sum; /* sum of the size of all added lemmas */
+    uint32_t lemmas_premisses_removed; /* duplicate/true premisses removed */
+    uint32_t lemmas_deferred;          /* lemmas deferred by batching */
+    uint32_t lemmas_rederived;         /* deferred lemmas derived again */
+    uint32_t conflict_search_lemmas;   /* lemmas found by (parallel)
+                                          conflict search */
 
     uint32_t dp_failed_vars; /* number of vars in FA (dual prop) of last
                                 sat call (final bv skeleton) */
@@ -73,6 +88,9 @@ struct BtorFunSolver
     double prop;
     double betap;
     double find_conf_app;
+    double conflict_search;
+    double static_lemmas;
+    double lazy_bv;
     double check_extensionality;
     double prop_cleanup;
   } time;
@@ -10,6 +10,7 @@
 
 #include "btorabort.h"
 #include "btorbv.h"
+#include "btorbvdomain.h"
 #include "btorclone.h"
 #include "btorcore.h"
 #include "btordbg.h"
@@ -26,6 +27,7 @@
 #include "utils/btorhashptr.h"
 #include "utils/btorutil.h"
 
+#include <inttypes.h>
 #include <math.h>
 
 /*------------------------------------------------------------------------*/
@@ -83,8 +85,7 @@ select_constraint (Btor *btor, uint32_t nmoves)
       selected = &slv->roots->data[it.cur_pos].as_int;
       cur      = btor_node_get_by_id (btor, btor_iter_hashint_next (&it));
 
-      assert (btor_hashint_map_contains (slv->score, btor_node_get_id (cur)));
-      score = btor_hashint_map_get (slv->score, btor_node_get_id (cur))->as_dbl;
+      score = btor_slsutils_get_score (slv->score, btor_node_get_id (cur));
       assert (score < 1.0);
       value = score + BTOR_PROP_SELECT_CFACT * sqrt (log (*selected) / nmoves);
 
@@ -172,6 +173,7 @@ move (Btor *btor, uint32_t nmoves)
       slv->roots,
       btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT) ? slv->score : 0,
       exps,
+      0,
       true,
       &slv->stats.updates,
       &slv->time.update_cone,
@@ -204,8 +206,9 @@ clone_prop_solver (Btor *clone, BtorPropSolver *slv, BtorNodeMap *exp_map)
 
   res->btor  = clone;
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
-  res->score =
-      btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
+  res->score = btor_slsutils_clone_score (clone->mm, slv->score);
+  if (slv->domains)
+    res->domains = btor_bvdomain_clone_map (clone->mm, slv->domains);
 
   return res;
 }
@@ -218,12 +221,47 @@ delete_prop_solver (BtorPropSolver *slv)
   assert (slv->btor);
   assert (slv->btor->slv == (BtorSolver *) slv);
 
-  if (slv->score) btor_hashint_map_delete (slv->score);
+  if (slv->score) btor_slsutils_delete_score (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->domains) btor_bvdomain_delete_map (slv->btor->mm, slv->domains);
 
   BTOR_DELETE (slv->btor->mm, slv);
 }
 
+/* Compute the domains of all nodes in the cones of the constraints. Domains
+ * given in 'slv->domains' (e.g., values fixed by the SAT solver in a
+ * sequential schedule) are used as initial domains.
+ * Returns false if the constraints are inconsistent. */
+static bool
+compute_domains (Btor *btor)
+{
+  assert (btor);
+
+  bool res;
+  BtorPropSolver *slv;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack roots;
+
+  slv = BTOR_PROP_SOLVER (btor);
+
+  BTOR_INIT_STACK (btor->mm, roots);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (roots, btor_iter_hashptr_next (&it));
+
+  if (!slv->domains) slv->domains = btor_hashint_map_new (btor->mm);
+  res = btor_bvdomain_compute (btor, &roots, slv->domains);
+  BTOR_RELEASE_STACK (roots);
+  BTOR_MSG (btor->msg,
+            1,
+            "computed %u bit-vector domains%s",
+            slv->domains->count,
+            res ? "" : " (inconsistent)");
+  return res;
+}
+
 /* This is an extra function in order to be able to test completeness
  * via test suite. */
 #ifdef NDEBUG
@@ -263,6 +301,9 @@ sat_prop_solver_aux (Btor *btor)
       goto UNSAT;
   }
 
+  if (btor_opt_get (btor, BTOR_OPT_PROP_DOMAINS) && !compute_domains (btor))
+    goto UNSAT;
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -285,7 +326,7 @@ sat_prop_solver_aux (Btor *btor)
     }
 
     if (!slv->score && btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT))
-      slv->score = btor_hashint_map_new (btor->mm);
+      slv->score = btor_slsutils_new_score (btor);
 
     if (btor_terminate (btor))
     {
@@ -328,14 +369,16 @@ sat_prop_solver_aux (Btor *btor)
     }
 
     /* restart */
-    slv->api.generate_model ((BtorSolver *) slv, false, true);
+#ifdef BTOR_HAVE_PTHREADS
+    if (slv->pool)
+      btor_lsutils_restart (btor, slv->pool, slv->roots->count);
+    else
+#endif
+      slv->api.generate_model ((BtorSolver *) slv, false, true);
     btor_hashint_map_delete (slv->roots);
     slv->roots = 0;
     if (btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT))
-    {
-      btor_hashint_map_delete (slv->score);
-      slv->score = btor_hashint_map_new (btor->mm);
-    }
+      btor_slsutils_reset_score (slv->score);
     slv->stats.restarts += 1;
   }
 
@@ -354,9 +397,14 @@ DONE:
   }
   if (slv->score)
   {
-    btor_hashint_map_delete (slv->score);
+    btor_slsutils_delete_score (slv->score);
     slv->score = 0;
   }
+  if (slv->domains)
+  {
+    btor_bvdomain_delete_map (btor->mm, slv->domains);
+    slv->domains = 0;
+  }
   return sat_result;
 }
 
@@ -386,6 +434,15 @@ sat_prop_solver (BtorPropSolver *slv)
                       && btor->lambdas->count != 0),
               "prop engine supports QF_BV only");
 
+#ifdef BTOR_HAVE_PTHREADS
+  if (!slv->pool && btor_opt_get (btor, BTOR_OPT_PROP_WORKERS) > 1)
+  {
+    sat_result = btor_lsutils_sat_parallel (
+        btor, btor_opt_get (btor, BTOR_OPT_PROP_WORKERS));
+    goto DONE;
+  }
+#endif
+
   /* Generate intial model, all bv vars are initialized with zero. We do
    * not have to consider model_for_all_nodes, but let this be handled by
    * the model generation (if enabled) after SAT has been determined. */
@@ -452,6 +509,24 @@ print_stats_prop_solver (BtorPropSolver *slv)
             1,
             "propagation move conflicts (non-recoverable): %u",
             slv->stats.non_rec_conf);
+  BTOR_MSG (btor->msg,
+            1,
+            "invertibility conditions: %" PRIu64 " checks, %.1f%% invertible",
+            slv->stats.ic_checks,
+            slv->stats.ic_checks ? 100.0 * slv->stats.ic_invertible
+                                       / slv->stats.ic_checks
+                                 : 0.0);
+  if (btor_opt_get (btor, BTOR_OPT_PROP_DOMAINS))
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "propagated values moved into domain: %" PRIu64,
+              slv->stats.domain_props);
+    BTOR_MSG (btor->msg,
+              1,
+              "domain bounds excluded on conflicts: %" PRIu64,
+              slv->stats.domain_refinements);
+  }
 #ifndef NDEBUG
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (
@@ -10,6 +10,8 @@
 #define BTORSLVPROP_H_INCLUDED
 
 #include "btorbv.h"
+#include "btorlsutils.h"
+#include "btorslsutils.h"
 #include "btorslv.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
@@ -19,7 +21,11 @@ struct BtorPropSolver
   BTOR_SOLVER_STRUCT;
 
   BtorIntHashTable *roots; /* map: maintains 'selected' */
-  BtorIntHashTable *score;
+  BtorSLSScore *score;
+  BtorLSWorkerPool *pool; /* shared with parallel walkers */
+  /* map: node id -> BtorBvDomain, maintained during sat (prop-domains),
+   * may be initialized with input domains before sat */
+  BtorIntHashTable *domains;
 
   /* current probability for selecting the cond when either the
    * 'then' or 'else' branch is const (path selection) */
@@ -41,6 +47,14 @@ struct BtorPropSolver
     uint64_t props_cons;
     uint64_t props_inv;
     uint64_t updates;
+    /* number of invertibility condition checks, and number of checks that
+     * determined that an inverse value exists */
+    uint64_t ic_checks;
+    uint64_t ic_invertible;
+    /* number of propagated values moved into the domain of their node, and
+     * number of domain bounds excluded due to conflicts */
+    uint64_t domain_props;
+    uint64_t domain_refinements;
 
 #ifndef NDEBUG
     uint32_t inv_add;
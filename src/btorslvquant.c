@@ -26,6 +26,8 @@
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+#include <inttypes.h>
+
 #ifdef BTOR_HAVE_PTHREADS
 #include <pthread.h>
 #include <signal.h>
@@ -38,6 +40,7 @@ struct BtorQuantStats
   {
     uint32_t refinements;
     uint32_t failed_refinements;
+    uint32_t imported_refinements;
 
     /* overall synthesize statistics */
     uint32_t synthesize_const;
@@ -48,6 +51,9 @@ struct BtorQuantStats
     uint32_t synthesize_model_const;
     uint32_t synthesize_model_term;
     uint32_t synthesize_model_none;
+
+    /* term enumeration statistics */
+    BtorSynthStats synth;
   } stats;
 
   struct
@@ -64,6 +70,34 @@ struct BtorQuantStats
 
 typedef struct BtorQuantStats BtorQuantStats;
 
+#ifdef BTOR_HAVE_PTHREADS
+/* counterexample found by a worker, shared with all workers that solve the
+ * same formula */
+struct BtorQuantLemma
+{
+  uint32_t formula;          /* formula id of the producing worker */
+  uint32_t worker;           /* id of the producing worker */
+  BtorBitVectorTuple *ce;    /* values of the universal vars */
+  BtorBitVectorTuple *evars; /* refuted values of the existential vars */
+};
+
+typedef struct BtorQuantLemma BtorQuantLemma;
+
+BTOR_DECLARE_STACK (BtorQuantLemmaPtr, BtorQuantLemma *);
+
+/* state shared between the workers of 'run_parallel' */
+struct BtorQuantWorkerPool
+{
+  BtorMemMgr *mm;
+  BtorQuantLemmaPtrStack lemmas;
+  bool found_result;
+  struct BtorGroundSolvers *winner;
+  pthread_mutex_t mutex;
+};
+
+typedef struct BtorQuantWorkerPool BtorQuantWorkerPool;
+#endif
+
 struct BtorGroundSolvers
 {
   Btor *forall; /* solver for checking the model */
@@ -92,20 +126,27 @@ struct BtorGroundSolvers
 
   BtorQuantStats statistics;
 
+  uint32_t id;      /* worker id */
+  uint32_t formula; /* workers with the same formula id share refinements */
+  bool dual;        /* solves the dual formula */
+
 #ifdef BTOR_HAVE_PTHREADS
-  bool *found_result;
-  pthread_mutex_t *found_result_mutex;
+  BtorQuantWorkerPool *pool;
+  size_t imported; /* number of visited lemmas of the pool */
 #endif
 };
 
 typedef struct BtorGroundSolvers BtorGroundSolvers;
 
+BTOR_DECLARE_STACK (BtorGroundSolversPtr, BtorGroundSolvers *);
+
 struct BtorQuantSolver
 {
   BTOR_SOLVER_STRUCT;
 
   BtorGroundSolvers *gslv;  /* two ground solver instances */
   BtorGroundSolvers *dgslv; /* two ground solver instances for dual */
+  BtorGroundSolversPtrStack workers; /* all workers incl. gslv and dgslv */
 };
 
 typedef struct BtorQuantSolver BtorQuantSolver;
@@ -962,58 +1003,34 @@ instantiate_args (Btor *btor, BtorNode *args, BtorNodeMap *map)
   return res;
 }
 
+/* refine exists solver with counter example 'ce' for the universal vars,
+ * 'evar_tup' holds the values of the existential vars refuted by 'ce'.
+ * takes ownership of 'ce' and 'evar_tup'. */
 static void
-refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
+add_refinement (BtorGroundSolvers *gslv,
+                BtorBitVectorTuple *ce,
+                BtorBitVectorTuple *evar_tup)
 {
-  assert (gslv->forall_uvars->table->count > 0);
-
   uint32_t i;
   Btor *f_solver, *e_solver;
   BtorNodeMap *map;
   BtorNodeMapIterator it;
-  BtorNode *var_es, *var_fs, *c, *res, *uvar, *evar, *a;
-  const BtorBitVector *bv;
-  BtorBitVectorTuple *ce, *evar_tup;
+  BtorNode *var_es, *var_fs, *c, *res, *uvar, *a;
 
   f_solver = gslv->forall;
   e_solver = gslv->exists;
 
   map = btor_nodemap_new (f_solver);
 
-  /* generate counter example for universal vars */
-  assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
-  f_solver->slv->api.generate_model (f_solver->slv, false, false);
-
   /* instantiate universal vars with counter example */
-  i  = 0;
-  ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
+  i = 0;
   btor_iter_nodemap_init (&it, gslv->forall_uvars);
   while (btor_iter_nodemap_has_next (&it))
   {
-    var_fs = it.it.bucket->data.as_ptr;
-    uvar   = btor_iter_nodemap_next (&it);
-    bv     = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-    c      = btor_exp_bv_const (e_solver, (BtorBitVector *) bv);
+    uvar = btor_iter_nodemap_next (&it);
+    c    = btor_exp_bv_const (e_solver, ce->bv[i++]);
     btor_nodemap_map (map, uvar, c);
     btor_node_release (e_solver, c);
-    btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
-  }
-
-  i        = 0;
-  evar_tup = 0;
-  if (gslv->forall_evars->table->count)
-  {
-    evar_tup =
-        btor_bv_new_tuple (f_solver->mm, gslv->forall_evars->table->count);
-    btor_iter_nodemap_init (&it, gslv->forall_evars);
-    while (btor_iter_nodemap_has_next (&it))
-    {
-      evar   = btor_iter_nodemap_next (&it);
-      var_fs = btor_nodemap_mapped (evar_map, evar);
-      assert (var_fs);
-      bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-      btor_bv_add_to_tuple (f_solver->mm, evar_tup, bv, i++);
-    }
   }
 
   /* map existential variables to skolem constants */
@@ -1054,7 +1071,6 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
   BTOR_ABORT (res == e_solver->true_exp,
               "invalid refinement '%s'",
               btor_util_node2string (res));
-  gslv->statistics.stats.refinements++;
 
   assert (!btor_hashptr_table_get (gslv->forall_ces, ce));
   btor_hashptr_table_add (gslv->forall_ces, ce)->data.as_ptr = evar_tup;
@@ -1064,6 +1080,152 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
   btor_node_release (e_solver, res);
 }
 
+#ifdef BTOR_HAVE_PTHREADS
+/* share counter example 'ce' with the other workers */
+static void
+export_refinement (BtorGroundSolvers *gslv,
+                   BtorBitVectorTuple *ce,
+                   BtorBitVectorTuple *evar_tup)
+{
+  BtorQuantWorkerPool *pool;
+  BtorQuantLemma *lemma;
+
+  if (!(pool = gslv->pool)) return;
+
+  pthread_mutex_lock (&pool->mutex);
+  BTOR_NEW (pool->mm, lemma);
+  lemma->formula = gslv->formula;
+  lemma->worker  = gslv->id;
+  lemma->ce      = btor_bv_copy_tuple (pool->mm, ce);
+  lemma->evars   = evar_tup ? btor_bv_copy_tuple (pool->mm, evar_tup) : 0;
+  BTOR_PUSH_STACK (pool->lemmas, lemma);
+  pthread_mutex_unlock (&pool->mutex);
+}
+
+static bool
+is_compatible_ce (BtorGroundSolvers *gslv, BtorBitVectorTuple *ce)
+{
+  uint32_t i;
+  BtorNodeMapIterator it;
+  BtorNode *uvar;
+
+  if (ce->arity != gslv->forall_uvars->table->count) return false;
+
+  i = 0;
+  btor_iter_nodemap_init (&it, gslv->forall_uvars);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    uvar = btor_iter_nodemap_next (&it);
+    if (btor_node_bv_get_width (gslv->forall, uvar)
+        != btor_bv_get_width (ce->bv[i++]))
+      return false;
+  }
+  return true;
+}
+
+/* refine exists solver with the counter examples found by other workers
+ * that solve the same formula */
+static void
+import_refinements (BtorGroundSolvers *gslv)
+{
+  size_t i;
+  BtorQuantWorkerPool *pool;
+  BtorQuantLemma *lemma;
+  BtorBitVectorTuplePtrStack ces, evars;
+  BtorBitVectorTuple *ce, *evar_tup;
+  BtorMemMgr *mm;
+
+  if (!(pool = gslv->pool)) return;
+
+  mm = gslv->forall->mm;
+  BTOR_INIT_STACK (mm, ces);
+  BTOR_INIT_STACK (mm, evars);
+
+  pthread_mutex_lock (&pool->mutex);
+  for (i = gslv->imported; i < BTOR_COUNT_STACK (pool->lemmas); i++)
+  {
+    lemma = BTOR_PEEK_STACK (pool->lemmas, i);
+    if (lemma->worker == gslv->id || lemma->formula != gslv->formula
+        || !is_compatible_ce (gslv, lemma->ce))
+      continue;
+    BTOR_PUSH_STACK (ces, btor_bv_copy_tuple (mm, lemma->ce));
+    BTOR_PUSH_STACK (evars,
+                     lemma->evars ? btor_bv_copy_tuple (mm, lemma->evars) : 0);
+  }
+  gslv->imported = BTOR_COUNT_STACK (pool->lemmas);
+  pthread_mutex_unlock (&pool->mutex);
+
+  for (i = 0; i < BTOR_COUNT_STACK (ces); i++)
+  {
+    ce       = BTOR_PEEK_STACK (ces, i);
+    evar_tup = BTOR_PEEK_STACK (evars, i);
+    if (btor_hashptr_table_get (gslv->forall_ces, ce))
+    {
+      btor_bv_free_tuple (mm, ce);
+      if (evar_tup) btor_bv_free_tuple (mm, evar_tup);
+      continue;
+    }
+    add_refinement (gslv, ce, evar_tup);
+    gslv->statistics.stats.imported_refinements++;
+  }
+  BTOR_RELEASE_STACK (ces);
+  BTOR_RELEASE_STACK (evars);
+}
+#endif
+
+static void
+refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
+{
+  assert (gslv->forall_uvars->table->count > 0);
+
+  uint32_t i;
+  Btor *f_solver;
+  BtorNodeMapIterator it;
+  BtorNode *var_fs, *evar;
+  const BtorBitVector *bv;
+  BtorBitVectorTuple *ce, *evar_tup;
+
+  f_solver = gslv->forall;
+
+  /* generate counter example for universal vars */
+  assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
+  f_solver->slv->api.generate_model (f_solver->slv, false, false);
+
+  i  = 0;
+  ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
+  btor_iter_nodemap_init (&it, gslv->forall_uvars);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    var_fs = it.it.bucket->data.as_ptr;
+    (void) btor_iter_nodemap_next (&it);
+    bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
+    btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
+  }
+
+  i        = 0;
+  evar_tup = 0;
+  if (gslv->forall_evars->table->count)
+  {
+    evar_tup =
+        btor_bv_new_tuple (f_solver->mm, gslv->forall_evars->table->count);
+    btor_iter_nodemap_init (&it, gslv->forall_evars);
+    while (btor_iter_nodemap_has_next (&it))
+    {
+      evar   = btor_iter_nodemap_next (&it);
+      var_fs = btor_nodemap_mapped (evar_map, evar);
+      assert (var_fs);
+      bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
+      btor_bv_add_to_tuple (f_solver->mm, evar_tup, bv, i++);
+    }
+  }
+
+  add_refinement (gslv, ce, evar_tup);
+  gslv->statistics.stats.refinements++;
+#ifdef BTOR_HAVE_PTHREADS
+  export_refinement (gslv, ce, evar_tup);
+#endif
+}
+
 static BtorNode *
 mk_concrete_ite_model (BtorGroundSolvers *gslv,
                        BtorNode *evar,
@@ -1178,8 +1340,9 @@ delete_quant_solver (BtorQuantSolver *slv)
 
   Btor *btor;
   btor = slv->btor;
-  delete_ground_solvers (slv, slv->gslv);
-  if (slv->dgslv) delete_ground_solvers (slv, slv->dgslv);
+  while (!BTOR_EMPTY_STACK (slv->workers))
+    delete_ground_solvers (slv, BTOR_POP_STACK (slv->workers));
+  BTOR_RELEASE_STACK (slv->workers);
   BTOR_DELETE (btor->mm, slv);
   btor->slv = 0;
 }
@@ -1487,7 +1650,8 @@ synthesize (BtorGroundSolvers *gslv,
                                    BTOR_COUNT_STACK (gslv->forall_consts),
                                    limit,
                                    0,
-                                   prev_synth);
+                                   prev_synth,
+                                   &gslv->statistics.stats.synth);
   }
 
   if (!result
@@ -1555,7 +1719,8 @@ synthesize (BtorGroundSolvers *gslv,
                                    BTOR_COUNT_STACK (gslv->forall_consts),
                                    limit,
                                    0,
-                                   0);
+                                   0,
+                                   &gslv->statistics.stats.synth);
   }
 
   if (result && btor_opt_get (gslv->forall, BTOR_OPT_QUANT_FIXSYNTH))
@@ -2172,7 +2337,8 @@ synthesize_quant_inst (BtorGroundSolvers *gslv)
                                      BTOR_COUNT_STACK (consts),
                                      10000,
                                      0,
-                                     prev_synth);
+                                     prev_synth,
+                                     &gslv->statistics.stats.synth);
 
       while (!BTOR_EMPTY_STACK (value_in))
         btor_bv_free_tuple (mm, BTOR_POP_STACK (value_in));
@@ -2342,31 +2508,46 @@ DONE:
 }
 
 #ifdef BTOR_HAVE_PTHREADS
+static bool
+has_result (BtorQuantWorkerPool *pool)
+{
+  bool res;
+
+  pthread_mutex_lock (&pool->mutex);
+  res = pool->found_result;
+  pthread_mutex_unlock (&pool->mutex);
+  return res;
+}
+
 static void *
 thread_work (void *state)
 {
   BtorSolverResult res = BTOR_RESULT_UNKNOWN;
   BtorGroundSolvers *gslv;
+  BtorQuantWorkerPool *pool;
   bool skip_exists = true;
 
   gslv = state;
-  while (res == BTOR_RESULT_UNKNOWN && !*gslv->found_result)
+  pool = gslv->pool;
+  while (res == BTOR_RESULT_UNKNOWN && !has_result (pool))
   {
+    import_refinements (gslv);
     res         = find_model (gslv, skip_exists);
     skip_exists = false;
     gslv->statistics.stats.refinements++;
   }
-  pthread_mutex_lock (gslv->found_result_mutex);
-  if (!*gslv->found_result)
+  pthread_mutex_lock (&pool->mutex);
+  if (!pool->found_result)
   {
     BTOR_MSG (gslv->exists->msg,
               1,
               "found solution in %.2f seconds",
               btor_util_process_time_thread ());
-    *gslv->found_result = true;
+    pool->found_result = true;
+    pool->winner       = gslv;
   }
-  assert (*gslv->found_result || res == BTOR_RESULT_UNKNOWN);
-  pthread_mutex_unlock (gslv->found_result_mutex);
+  assert (pool->found_result || res == BTOR_RESULT_UNKNOWN);
+  pthread_mutex_unlock (&pool->mutex);
   gslv->result = res;
   return NULL;
 }
@@ -2374,80 +2555,113 @@ thread_work (void *state)
 static int32_t
 thread_terminate (void *state)
 {
-  bool found_result = *((bool *) state);
-  return found_result;
+  return has_result ((BtorQuantWorkerPool *) state);
 }
 
 static BtorSolverResult
-run_parallel (BtorGroundSolvers *gslv, BtorGroundSolvers *dgslv)
+run_parallel (BtorQuantSolver *slv)
 {
-  bool thread_found_result;
-  pthread_mutex_t thread_result_mutex = PTHREAD_MUTEX_INITIALIZER;
+  size_t i, nworkers;
+  BtorQuantWorkerPool pool;
+  BtorQuantLemma *lemma;
+  BtorGroundSolvers *gslv;
   BtorSolverResult res;
-  pthread_t thread_orig, thread_dual;
-
-  thread_found_result   = false;
-  g_measure_thread_time = true;
-  btor_set_term (gslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (gslv->exists, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->exists, thread_terminate, &thread_found_result);
+  BtorMemMgr *mm;
+  pthread_t *threads;
+  bool *threaded;
 
-  gslv->found_result        = &thread_found_result;
-  gslv->found_result_mutex  = &thread_result_mutex;
-  dgslv->found_result       = &thread_found_result;
-  dgslv->found_result_mutex = &thread_result_mutex;
+  mm       = slv->btor->mm;
+  nworkers = BTOR_COUNT_STACK (slv->workers);
 
-  pthread_create (&thread_orig, 0, thread_work, gslv);
-  pthread_create (&thread_dual, 0, thread_work, dgslv);
-  pthread_join (thread_orig, 0);
-  pthread_join (thread_dual, 0);
+  pool.mm           = mm;
+  pool.found_result = false;
+  pool.winner       = 0;
+  BTOR_INIT_STACK (mm, pool.lemmas);
+  pthread_mutex_init (&pool.mutex, 0);
 
-  if (gslv->result != BTOR_RESULT_UNKNOWN)
-  {
-    res = gslv->result;
+  g_measure_thread_time = true;
+  for (i = 0; i < nworkers; i++)
+  {
+    gslv = BTOR_PEEK_STACK (slv->workers, i);
+    btor_set_term (gslv->forall, thread_terminate, &pool);
+    btor_set_term (gslv->exists, thread_terminate, &pool);
+    gslv->pool = &pool;
+  }
+
+  BTOR_NEWN (mm, threads, nworkers);
+  BTOR_NEWN (mm, threaded, nworkers);
+  for (i = 0; i < nworkers; i++)
+    threaded[i] = !pthread_create (
+        &threads[i], 0, thread_work, BTOR_PEEK_STACK (slv->workers, i));
+  /* workers whose thread could not be created run in the current thread */
+  for (i = 0; i < nworkers; i++)
+    if (!threaded[i]) thread_work (BTOR_PEEK_STACK (slv->workers, i));
+  for (i = 0; i < nworkers; i++)
+    if (threaded[i]) pthread_join (threads[i], 0);
+  BTOR_DELETEN (mm, threaded, nworkers);
+  BTOR_DELETEN (mm, threads, nworkers);
+
+  gslv = pool.winner;
+  assert (!gslv || gslv->result != BTOR_RESULT_UNKNOWN);
+  if (!gslv)
+    res = BTOR_RESULT_UNKNOWN;
+  else if (!gslv->dual)
+  {
+    slv->gslv = gslv;
+    res       = gslv->result;
   }
   else
   {
-    assert (dgslv->result != BTOR_RESULT_UNKNOWN);
-    if (dgslv->result == BTOR_RESULT_SAT)
+    slv->dgslv = gslv;
+    if (gslv->result == BTOR_RESULT_SAT)
     {
-      BTOR_MSG (dgslv->forall->msg,
+      BTOR_MSG (gslv->forall->msg,
                 1,
                 "dual solver result: sat, original formula: unsat");
       res = BTOR_RESULT_UNSAT;
     }
     else
     {
-      assert (dgslv->result == BTOR_RESULT_UNSAT);
+      assert (gslv->result == BTOR_RESULT_UNSAT);
       res = BTOR_RESULT_SAT;
-      BTOR_MSG (dgslv->forall->msg,
+      BTOR_MSG (gslv->forall->msg,
                 1,
                 "dual solver result: unsat, original formula: sat");
     }
   }
+
+  for (i = 0; i < nworkers; i++) BTOR_PEEK_STACK (slv->workers, i)->pool = 0;
+  while (!BTOR_EMPTY_STACK (pool.lemmas))
+  {
+    lemma = BTOR_POP_STACK (pool.lemmas);
+    btor_bv_free_tuple (mm, lemma->ce);
+    if (lemma->evars) btor_bv_free_tuple (mm, lemma->evars);
+    BTOR_DELETE (mm, lemma);
+  }
+  BTOR_RELEASE_STACK (pool.lemmas);
+  pthread_mutex_destroy (&pool.mutex);
   return res;
 }
 #endif
 
 static BtorNode *
-simplify (Btor *btor, BtorNode *g)
+simplify (Btor *btor, BtorNode *g, bool miniscope, bool der, bool cer)
 {
   BtorNode *tmp;
 
-  if (btor_opt_get (btor, BTOR_OPT_QUANT_MINISCOPE))
+  if (miniscope)
   {
     tmp = btor_miniscope_node (btor, g);
     btor_node_release (btor, g);
     g = tmp;
   }
-  if (btor_opt_get (btor, BTOR_OPT_QUANT_DER))
+  if (der)
   {
     tmp = btor_der_node (btor, g);
     btor_node_release (btor, g);
     g = tmp;
   }
-  if (btor_opt_get (btor, BTOR_OPT_QUANT_CER))
+  if (cer)
   {
     tmp = btor_cer_node (btor, g);
     btor_node_release (btor, g);
@@ -2456,6 +2670,88 @@ simplify (Btor *btor, BtorNode *g)
   return g;
 }
 
+/* Variations of the user configuration used for diversifying the workers
+ * created via BTOR_OPT_QUANT_WORKERS. */
+struct BtorQuantWorkerConfig
+{
+  bool synth_qi;      /* toggle BTOR_OPT_QUANT_SYNTH_QI */
+  bool miniscope;     /* toggle BTOR_OPT_QUANT_MINISCOPE */
+  bool der_cer;       /* toggle BTOR_OPT_QUANT_DER and BTOR_OPT_QUANT_CER */
+  double synth_limit; /* factor for BTOR_OPT_QUANT_SYNTH_LIMIT */
+};
+
+typedef struct BtorQuantWorkerConfig BtorQuantWorkerConfig;
+
+static const BtorQuantWorkerConfig g_worker_configs[] = {
+    {false, false, false, 1},    /* user configuration */
+    {true, false, false, 1},
+    {false, false, false, 4},
+    {false, true, false, 1},
+    {false, false, true, 1},
+    {true, false, false, 0.25},
+    {false, true, true, 4},
+};
+
+#define BTOR_QUANT_NUM_WORKER_CONFIGS \
+  (sizeof (g_worker_configs) / sizeof (*g_worker_configs))
+
+/* Create worker 'id' for formula 'g' with configuration 'variation'. Workers
+ * with a variation beyond the configuration table use larger synthesis
+ * limits. */
+static BtorGroundSolvers *
+new_worker (BtorQuantSolver *slv,
+            BtorNode *g,
+            uint32_t id,
+            uint32_t variation,
+            bool dual)
+{
+  bool miniscope, der, cer;
+  char prefix_forall[32], prefix_exists[32];
+  double limit;
+  Btor *btor;
+  BtorGroundSolvers *res;
+  const BtorQuantWorkerConfig *cfg;
+
+  btor = slv->btor;
+  cfg  = &g_worker_configs[variation % BTOR_QUANT_NUM_WORKER_CONFIGS];
+
+  miniscope = btor_opt_get (btor, BTOR_OPT_QUANT_MINISCOPE) != cfg->miniscope;
+  der       = btor_opt_get (btor, BTOR_OPT_QUANT_DER) != cfg->der_cer;
+  cer       = btor_opt_get (btor, BTOR_OPT_QUANT_CER) != cfg->der_cer;
+  g         = simplify (btor, btor_node_copy (btor, g), miniscope, der, cer);
+
+  if (id < 2)
+  {
+    sprintf (prefix_forall, "%sforall", dual ? "dual_" : "");
+    sprintf (prefix_exists, "%sexists", dual ? "dual_" : "");
+  }
+  else
+  {
+    sprintf (prefix_forall, "%sforall_%u", dual ? "dual_" : "", id);
+    sprintf (prefix_exists, "%sexists_%u", dual ? "dual_" : "", id);
+  }
+  res = setup_solvers (slv, g, dual, prefix_forall, prefix_exists);
+  btor_node_release (btor, g);
+
+  res->id      = id;
+  res->dual    = dual;
+  res->formula = dual | miniscope << 1 | der << 2 | cer << 3;
+
+  if (cfg->synth_qi)
+    btor_opt_set (res->forall,
+                  BTOR_OPT_QUANT_SYNTH_QI,
+                  !btor_opt_get (res->forall, BTOR_OPT_QUANT_SYNTH_QI));
+  limit = btor_opt_get (res->forall, BTOR_OPT_QUANT_SYNTH_LIMIT)
+          * cfg->synth_limit
+          * (1 + variation / BTOR_QUANT_NUM_WORKER_CONFIGS);
+  btor_opt_set (res->forall,
+                BTOR_OPT_QUANT_SYNTH_LIMIT,
+                limit > UINT32_MAX ? UINT32_MAX : (uint32_t) limit);
+
+  BTOR_PUSH_STACK (slv->workers, res);
+  return res;
+}
+
 static BtorSolverResult
 sat_quant_solver (BtorQuantSolver *slv)
 {
@@ -2473,25 +2769,51 @@ sat_quant_solver (BtorQuantSolver *slv)
 
   /* make sure that all quantifiers occur in the correct phase */
   g = btor_normalize_quantifiers (slv->btor);
-  g = simplify (slv->btor, g);
 
-  slv->gslv = setup_solvers (slv, g, false, "forall", "exists");
-  btor_node_release (slv->btor, g);
+  slv->gslv = new_worker (slv, g, 0, 0, false);
 
 #ifdef BTOR_HAVE_PTHREADS
-  bool opt_dual_solver;
+  bool opt_dual_solver, dual;
+  uint32_t i, num_workers;
+  long num_cpus;
+  BtorGroundSolvers *gslv;
+
   opt_dual_solver = btor_opt_get (slv->btor, BTOR_OPT_QUANT_DUAL_SOLVER) == 1;
+  num_workers     = btor_opt_get (slv->btor, BTOR_OPT_QUANT_WORKERS);
+
+  /* workers only compete for time slices if there are more workers than
+   * CPUs, which slows down the worker that would finish first */
+  num_cpus = sysconf (_SC_NPROCESSORS_ONLN);
+  if (num_cpus > 0 && num_workers > (uint32_t) num_cpus)
+  {
+    BTOR_MSG (slv->btor->msg,
+              1,
+              "limiting number of workers to %ld available CPUs",
+              num_cpus);
+    num_workers = num_cpus;
+  }
 
   /* disable dual solver if UFs are present in the formula */
   if (slv->gslv->exists_ufs->table->count > 0) opt_dual_solver = false;
+  if (opt_dual_solver && num_workers < 2) num_workers = 2;
+
+  /* with the dual solver enabled, every other worker solves the dual
+   * formula */
+  for (i = 1; i < num_workers; i++)
+  {
+    dual = opt_dual_solver && i % 2 == 1;
+    gslv = new_worker (slv, g, i, opt_dual_solver ? i / 2 : i, dual);
+    if (dual && !slv->dgslv) slv->dgslv = gslv;
+  }
+  btor_node_release (slv->btor, g);
 
-  if (opt_dual_solver)
+  if (num_workers > 1)
   {
-    slv->dgslv = setup_solvers (
-        slv, slv->gslv->forall_formula, true, "dual_forall", "dual_exists");
-    res = run_parallel (slv->gslv, slv->dgslv);
+    res = run_parallel (slv);
   }
   else
+#else
+  btor_node_release (slv->btor, g);
 #endif
   {
     while (true)
@@ -2534,6 +2856,10 @@ print_stats_quant_solver (BtorQuantSolver *slv)
   assert (slv->btor->slv == (BtorSolver *) slv);
   assert (slv->gslv);
 
+  size_t i;
+  uint32_t imported;
+  BtorSynthStats synth, *wsynth;
+
   BTOR_MSG (slv->btor->msg, 1, "");
   BTOR_MSG (slv->btor->msg,
             1,
@@ -2543,6 +2869,46 @@ print_stats_quant_solver (BtorQuantSolver *slv)
             1,
             "cegqi solver failed refinements: %u",
             slv->gslv->statistics.stats.failed_refinements);
+  if (BTOR_COUNT_STACK (slv->workers) > 1)
+  {
+    imported = 0;
+    for (i = 0; i < BTOR_COUNT_STACK (slv->workers); i++)
+      imported += BTOR_PEEK_STACK (slv->workers, i)
+                      ->statistics.stats.imported_refinements;
+    BTOR_MSG (slv->btor->msg,
+              1,
+              "cegqi workers: %zu",
+              BTOR_COUNT_STACK (slv->workers));
+    BTOR_MSG (slv->btor->msg,
+              1,
+              "cegqi imported refinements: %u",
+              imported);
+  }
+  memset (&synth, 0, sizeof (BtorSynthStats));
+  for (i = 0; i < BTOR_COUNT_STACK (slv->workers); i++)
+  {
+    wsynth = &BTOR_PEEK_STACK (slv->workers, i)->statistics.stats.synth;
+    synth.enumerated += wsynth->enumerated;
+    synth.pruned_ops += wsynth->pruned_ops;
+    synth.pruned_oe += wsynth->pruned_oe;
+  }
+  BTOR_MSG (slv->btor->msg,
+            1,
+            "synthesis enumerated terms: %" PRIu64,
+            synth.enumerated);
+  BTOR_MSG (slv->btor->msg,
+            1,
+            "synthesis pruned by operator rules: %" PRIu64 " (%.1f%%)",
+            synth.pruned_ops,
+            synth.enumerated ? 100.0 * synth.pruned_ops / synth.enumerated
+                             : 0.0);
+  BTOR_MSG (slv->btor->msg,
+            1,
+            "synthesis pruned by observational equivalence: %" PRIu64
+            " (%.1f%%)",
+            synth.pruned_oe,
+            synth.enumerated ? 100.0 * synth.pruned_oe / synth.enumerated
+                             : 0.0);
   if (slv->gslv->result == BTOR_RESULT_SAT
       || slv->gslv->result == BTOR_RESULT_UNKNOWN)
   {
@@ -2562,9 +2928,8 @@ print_stats_quant_solver (BtorQuantSolver *slv)
               slv->gslv->statistics.stats.synthesize_model_none,
               slv->gslv->statistics.stats.synthesize_none);
   }
-  if (btor_opt_get (slv->btor, BTOR_OPT_QUANT_DUAL_SOLVER))
+  if (slv->dgslv)
   {
-    assert (slv->dgslv);
     BTOR_MSG (slv->btor->msg,
               1,
               "cegqi dual solver refinements: %u",
@@ -2627,9 +2992,8 @@ print_time_stats_quant_solver (BtorQuantSolver *slv)
             1,
             "%.2f seconds check instantiation",
             slv->gslv->statistics.time.checkinst);
-  if (btor_opt_get (slv->btor, BTOR_OPT_QUANT_DUAL_SOLVER))
+  if (slv->dgslv)
   {
-    assert (slv->dgslv);
     BTOR_MSG (slv->btor->msg,
               1,
               "%.2f seconds dual exists solver",
@@ -2711,6 +3075,7 @@ btor_new_quantifier_solver (Btor *btor)
 
   slv->kind      = BTOR_QUANT_SOLVER_KIND;
   slv->btor      = btor;
+  BTOR_INIT_STACK (btor->mm, slv->workers);
   slv->api.clone = (BtorSolverClone) clone_quant_solver;
   slv->api.delet = (BtorSolverDelete) delete_quant_solver;
   slv->api.sat   = (BtorSolverSat) sat_quant_solver;
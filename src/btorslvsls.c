@@ -49,7 +49,7 @@
 /*------------------------------------------------------------------------*/
 
 static double
-compute_sls_score_formula (Btor *btor, BtorIntHashTable *score, bool *done)
+compute_sls_score_formula (Btor *btor, BtorSLSScore *score, bool *done)
 {
   assert (btor);
   assert (score);
@@ -74,7 +74,7 @@ compute_sls_score_formula (Btor *btor, BtorIntHashTable *score, bool *done)
         (double) ((BtorSLSConstrData *) slv->weights->data[it.cur_pos].as_ptr)
             ->weight;
     id = btor_iter_hashint_next (&it);
-    sc = btor_hashint_map_get (score, id)->as_dbl;
+    sc = btor_slsutils_get_score (score, id);
     assert (sc >= 0.0 && sc <= 1.0);
     if (done && sc < 1.0) *done = false;
     res += weight * sc;
@@ -116,8 +116,7 @@ select_candidate_constraint (Btor *btor, uint32_t nmoves)
       assert (btor_hashint_map_contains (slv->weights, id));
       d = btor_hashint_map_get (slv->weights, id)->as_ptr;
       assert (d);
-      assert (btor_hashint_map_contains (slv->score, id));
-      score = btor_hashint_map_get (slv->score, id)->as_dbl;
+      score = btor_slsutils_get_score (slv->score, id);
       assert (score < 1.0);
       value = score + BTOR_SLS_SELECT_CFACT * sqrt (log (d->selected) / nmoves);
       if (!res || value > max_value)
@@ -142,8 +141,7 @@ select_candidate_constraint (Btor *btor, uint32_t nmoves)
       cur = btor_node_get_by_id (btor, id);
       assert (!btor_node_is_bv_const (cur)
               || !btor_bv_is_zero (btor_model_get_bv (btor, cur)));
-      assert (btor_hashint_map_contains (slv->score, id));
-      score = btor_hashint_map_get (slv->score, id)->as_dbl;
+      score = btor_slsutils_get_score (slv->score, id);
       assert (score < 1.0);
       BTOR_PUSH_STACK (stack, cur);
     }
@@ -272,8 +270,7 @@ update_assertion_weights (Btor *btor)
     {
       d  = (BtorSLSConstrData *) slv->weights->data[it.cur_pos].as_ptr;
       id = btor_iter_hashint_next (&it);
-      assert (btor_hashint_table_contains (slv->score, id));
-      if (btor_hashint_map_get (slv->score, id)->as_dbl == 0.0) continue;
+      if (btor_slsutils_get_score (slv->score, id) == 0.0) continue;
       if (d->weight > 1) d->weight -= 1;
     }
   }
@@ -285,23 +282,61 @@ update_assertion_weights (Btor *btor)
     {
       d  = (BtorSLSConstrData *) slv->weights->data[it.cur_pos].as_ptr;
       id = btor_iter_hashint_next (&it);
-      assert (btor_hashint_table_contains (slv->score, id));
-      if (btor_hashint_map_get (slv->score, id)->as_dbl == 1.0) continue;
+      if (btor_slsutils_get_score (slv->score, id) == 1.0) continue;
       d->weight += 1;
     }
   }
 }
 
+/* Scratch state shared by all moves tried on the same set of candidates:
+ * a copy of the current model and scores (updated by 'try_move'), and the
+ * cone of influence of the candidates, which is the same for all moves. */
+struct BtorSLSNeighborhood
+{
+  BtorIntHashTable *bv_model;
+  BtorSLSScore *score;
+  BtorNodePtrStack cone;
+};
+
+typedef struct BtorSLSNeighborhood BtorSLSNeighborhood;
+
+static void
+init_neighborhood (Btor *btor,
+                   BtorSLSNeighborhood *nb,
+                   BtorNodePtrStack *candidates)
+{
+  assert (btor);
+  assert (nb);
+  assert (candidates);
+
+  BtorSLSSolver *slv;
+
+  slv          = BTOR_SLS_SOLVER (btor);
+  nb->bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
+  nb->score    = btor_slsutils_clone_score (btor->mm, slv->score);
+  BTOR_INIT_STACK (btor->mm, nb->cone);
+  (void) btor_lsutils_collect_cone (btor, candidates, &nb->cone);
+}
+
+static void
+release_neighborhood (Btor *btor, BtorSLSNeighborhood *nb)
+{
+  assert (btor);
+  assert (nb);
+
+  btor_model_delete_bv (btor, &nb->bv_model);
+  btor_slsutils_delete_score (nb->score);
+  BTOR_RELEASE_STACK (nb->cone);
+}
+
 static inline double
 try_move (Btor *btor,
-          BtorIntHashTable *bv_model,
-          BtorIntHashTable *score,
+          BtorSLSNeighborhood *nb,
           BtorIntHashTable *cans,
           bool *done)
 {
   assert (btor);
-  assert (bv_model);
-  assert (score);
+  assert (nb);
   assert (cans);
   assert (cans->count);
   assert (done);
@@ -345,10 +380,11 @@ try_move (Btor *btor,
 #endif
 
   btor_lsutils_update_cone (btor,
-                            bv_model,
+                            nb->bv_model,
                             slv->roots,
-                            score,
+                            nb->score,
                             cans,
+                            &nb->cone,
                             false,
                             &slv->stats.updates,
                             &slv->time.update_cone,
@@ -356,7 +392,7 @@ try_move (Btor *btor,
                             &slv->time.update_cone_model_gen,
                             &slv->time.update_cone_compute_score);
 
-  return compute_sls_score_formula (btor, score, done);
+  return compute_sls_score_formula (btor, nb->score, done);
 }
 
 static int32_t
@@ -424,78 +460,75 @@ cmp_sls_moves_qsort (const void *move1, const void *move2)
 
 static inline bool
 select_inc_dec_not_move (Btor *btor,
-                         BtorBitVector *(*fun) (BtorMemMgr *,
-                                                const BtorBitVector *),
                          BtorNodePtrStack *candidates,
-                         int32_t gw)
+                         int32_t gw,
+                         BtorSLSNeighborhood *nb)
 {
   size_t i;
-  uint32_t sls_strat;
+  uint32_t k, sls_strat;
   bool done;
   double sc;
   BtorSLSMove *m;
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
+  BtorBitVector *(*funs[3]) (BtorMemMgr *, const BtorBitVector *) = {
+      btor_bv_inc, btor_bv_dec, btor_bv_not};
 
   done      = false;
   slv       = BTOR_SLS_SOLVER (btor);
   sls_strat = btor_opt_get (btor, BTOR_OPT_SLS_STRATEGY);
 
-  if (fun == btor_bv_inc)
-    mk = BTOR_SLS_MOVE_INC;
-  else if (fun == btor_bv_dec)
-    mk = BTOR_SLS_MOVE_DEC;
-  else
+  /* try inc, dec and not (in this order) in one pass */
+  for (k = 0; k < 3; k++)
   {
-    assert (fun == btor_bv_not);
-    mk = BTOR_SLS_MOVE_NOT;
-  }
+    mk = BTOR_SLS_MOVE_INC + k;
+    assert (mk == BTOR_SLS_MOVE_INC || mk == BTOR_SLS_MOVE_DEC
+            || mk == BTOR_SLS_MOVE_NOT);
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
-  cans = btor_hashint_map_new (btor->mm);
+    cans = btor_hashint_map_new (btor->mm);
 
-  for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
-  {
-    can = BTOR_PEEK_STACK (*candidates, i);
-    assert (can);
-    assert (btor_node_is_regular (can));
+    for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
+    {
+      can = BTOR_PEEK_STACK (*candidates, i);
+      assert (can);
+      assert (btor_node_is_regular (can));
 
-    ass = (BtorBitVector *) btor_model_get_bv (btor, can);
-    assert (ass);
+      ass = (BtorBitVector *) btor_model_get_bv (btor, can);
+      assert (ass);
 
-    max_neigh = btor_hashint_map_contains (slv->max_cans, can->id)
-                    ? btor_hashint_map_get (slv->max_cans, can->id)->as_ptr
-                    : 0;
+      max_neigh = btor_hashint_map_contains (slv->max_cans, can->id)
+                      ? btor_hashint_map_get (slv->max_cans, can->id)->as_ptr
+                      : 0;
 
-    btor_hashint_map_add (cans, can->id)->as_ptr =
-        btor_opt_get (btor, BTOR_OPT_SLS_MOVE_INC_MOVE_TEST) && max_neigh
-            ? fun (btor->mm, max_neigh)
-            : fun (btor->mm, ass);
-  }
+      btor_hashint_map_add (cans, can->id)->as_ptr =
+          btor_opt_get (btor, BTOR_OPT_SLS_MOVE_INC_MOVE_TEST) && max_neigh
+              ? funs[k](btor->mm, max_neigh)
+              : funs[k](btor->mm, ass);
+    }
 
-  sc = try_move (btor, bv_model, score, cans, &done);
-  if (slv->terminate)
-  {
-    BTOR_SLS_DELETE_CANS (cans);
-    goto DONE;
+    sc = try_move (btor, nb, cans, &done);
+    if (slv->terminate)
+    {
+      BTOR_SLS_DELETE_CANS (cans);
+      break;
+    }
+    BTOR_SLS_SELECT_MOVE_CHECK_SCORE (sc);
+  DONE:
+    if (done) break;
   }
-  BTOR_SLS_SELECT_MOVE_CHECK_SCORE (sc);
 
-DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
 static inline bool
-select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
+select_flip_move (Btor *btor,
+                 BtorNodePtrStack *candidates,
+                 int32_t gw,
+                 BtorSLSNeighborhood *nb)
 {
   size_t i, n_endpos;
   uint32_t pos, cpos, sls_strat;
@@ -505,7 +538,7 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -514,10 +547,6 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (pos = 0, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates); pos++)
   {
     cans = btor_hashint_map_new (btor->mm);
@@ -544,7 +573,7 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
               : btor_bv_flipped_bit (btor->mm, ass, cpos);
     }
 
-    sc = try_move (btor, bv_model, score, cans, &done);
+    sc = try_move (btor, nb, cans, &done);
     if (slv->terminate)
     {
       BTOR_SLS_DELETE_CANS (cans);
@@ -554,13 +583,14 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
 static inline bool
-select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
+select_flip_range_move (Btor *btor,
+                       BtorNodePtrStack *candidates,
+                       int32_t gw,
+                       BtorSLSNeighborhood *nb)
 {
   size_t i, n_endpos;
   uint32_t up, cup, clo, sls_strat, bw;
@@ -570,7 +600,7 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -579,10 +609,6 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP_RANGE;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (up = 1, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates);
        up = 2 * up + 1)
   {
@@ -624,7 +650,7 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
               : btor_bv_flipped_bit_range (btor->mm, ass, cup, clo);
     }
 
-    sc = try_move (btor, bv_model, score, cans, &done);
+    sc = try_move (btor, nb, cans, &done);
     if (slv->terminate)
     {
       BTOR_SLS_DELETE_CANS (cans);
@@ -634,13 +660,14 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
 static inline bool
-select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
+select_flip_segment_move (Btor *btor,
+                         BtorNodePtrStack *candidates,
+                         int32_t gw,
+                         BtorSLSNeighborhood *nb)
 {
   size_t i, n_endpos;
   int32_t ctmp;
@@ -651,7 +678,7 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -660,10 +687,6 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP_SEGMENT;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (seg = 2; seg <= 8; seg <<= 1)
   {
     for (lo = 0, up = seg - 1, n_endpos = 0;
@@ -711,7 +734,7 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
                 : btor_bv_flipped_bit_range (btor->mm, ass, cup, clo);
       }
 
-      sc = try_move (btor, bv_model, score, cans, &done);
+      sc = try_move (btor, nb, cans, &done);
       if (slv->terminate)
       {
         BTOR_SLS_DELETE_CANS (cans);
@@ -722,13 +745,14 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
 static inline bool
-select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
+select_rand_range_move (Btor *btor,
+                       BtorNodePtrStack *candidates,
+                       int32_t gw,
+                       BtorSLSNeighborhood *nb)
 {
   double sc, rand_max_score = -1.0;
   size_t i, n_endpos;
@@ -738,7 +762,7 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -748,10 +772,6 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_RAND;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (up = 1, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates);
        up = 2 * up + 1)
   {
@@ -785,7 +805,7 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
           btor_bv_new_random_bit_range (btor->mm, &btor->rng, bw, cup, clo);
     }
 
-    sc = try_move (btor, bv_model, score, cans, &done);
+    sc = try_move (btor, nb, cans, &done);
     if (slv->terminate)
     {
       BTOR_SLS_DELETE_CANS (cans);
@@ -801,8 +821,6 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
@@ -815,10 +833,13 @@ select_move_aux (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   BtorSLSMoveKind mk;
   BtorSLSSolver *slv;
+  BtorSLSNeighborhood nb;
   bool done = false;
 
   slv = BTOR_SLS_SOLVER (btor);
 
+  init_neighborhood (btor, &nb, candidates);
+
   for (mk = 0; mk < BTOR_SLS_MOVE_DONE; mk++)
   {
     if (slv->nflips && slv->stats.flips >= slv->nflips)
@@ -830,40 +851,32 @@ select_move_aux (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
     switch (mk)
     {
       case BTOR_SLS_MOVE_INC:
-        if ((done =
-                 select_inc_dec_not_move (btor, btor_bv_inc, candidates, gw)))
-          return done;
+        done = select_inc_dec_not_move (btor, candidates, gw, &nb);
         break;
 
       case BTOR_SLS_MOVE_DEC:
-        if ((done =
-                 select_inc_dec_not_move (btor, btor_bv_dec, candidates, gw)))
-          return done;
-        break;
-
       case BTOR_SLS_MOVE_NOT:
-        if ((done =
-                 select_inc_dec_not_move (btor, btor_bv_not, candidates, gw)))
-          return done;
-        break;
+        /* tried together with BTOR_SLS_MOVE_INC */
+        continue;
 
       case BTOR_SLS_MOVE_FLIP_RANGE:
         if (!btor_opt_get (btor, BTOR_OPT_SLS_MOVE_RANGE)) continue;
-        if ((done = select_flip_range_move (btor, candidates, gw))) return done;
+        done = select_flip_range_move (btor, candidates, gw, &nb);
         break;
 
       case BTOR_SLS_MOVE_FLIP_SEGMENT:
         if (!btor_opt_get (btor, BTOR_OPT_SLS_MOVE_SEGMENT)) continue;
-        if ((done = select_flip_segment_move (btor, candidates, gw)))
-          return done;
+        done = select_flip_segment_move (btor, candidates, gw, &nb);
         break;
 
       default:
         assert (mk == BTOR_SLS_MOVE_FLIP);
-        if ((done = select_flip_move (btor, candidates, gw))) return done;
+        done = select_flip_move (btor, candidates, gw, &nb);
     }
+    if (done) break;
   }
 
+  release_neighborhood (btor, &nb);
   return done;
 }
 
@@ -881,6 +894,7 @@ select_move (Btor *btor, BtorNodePtrStack *candidates)
   BtorBitVector *neigh;
   BtorNodePtrStack cans;
   BtorSLSMove *m;
+  BtorSLSNeighborhood nb;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -996,7 +1010,9 @@ select_move (Btor *btor, BtorNodePtrStack *candidates)
       {
         assert (!BTOR_COUNT_STACK (cans));
         BTOR_PUSH_STACK (cans, can);
-        select_rand_range_move (btor, &cans, 0);
+        init_neighborhood (btor, &nb, &cans);
+        select_rand_range_move (btor, &cans, 0, &nb);
+        release_neighborhood (btor, &nb);
         BTOR_RESET_STACK (cans);
         assert (slv->max_cans->count == 1);
       }
@@ -1259,6 +1275,7 @@ move (Btor *btor, uint32_t nmoves)
                             slv->roots,
                             slv->score,
                             slv->max_cans,
+                            0,
                             true,
                             &slv->stats.updates,
                             &slv->time.update_cone,
@@ -1362,8 +1379,7 @@ clone_sls_solver (Btor *clone, BtorSLSSolver *slv, BtorNodeMap *exp_map)
 
   res->btor  = clone;
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
-  res->score =
-      btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
+  res->score = btor_slsutils_clone_score (clone->mm, slv->score);
 
   BTOR_INIT_STACK (clone->mm, res->moves);
   assert (BTOR_SIZE_STACK (slv->moves) || !BTOR_COUNT_STACK (slv->moves));
@@ -1408,7 +1424,7 @@ delete_sls_solver (BtorSLSSolver *slv)
 
   btor = slv->btor;
 
-  if (slv->score) btor_hashint_map_delete (slv->score);
+  if (slv->score) btor_slsutils_delete_score (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
   if (slv->weights)
   {
@@ -1478,6 +1494,15 @@ sat_sls_solver (BtorSLSSolver *slv)
                       && btor->lambdas->count != 0),
               "sls engine supports QF_BV only");
 
+#ifdef BTOR_HAVE_PTHREADS
+  if (!slv->pool && btor_opt_get (btor, BTOR_OPT_SLS_WORKERS) > 1)
+  {
+    sat_result = btor_lsutils_sat_parallel (
+        btor, btor_opt_get (btor, BTOR_OPT_SLS_WORKERS));
+    goto DONE;
+  }
+#endif
+
   /* Generate intial model, all bv vars are initialized with zero. We do
    * not have to consider model_for_all_nodes, but let this be handled by
    * the model generation (if enabled) after SAT has been determined. */
@@ -1519,7 +1544,7 @@ sat_sls_solver (BtorSLSSolver *slv)
     }
   }
 
-  if (!slv->score) slv->score = btor_hashint_map_new (btor->mm);
+  if (!slv->score) slv->score = btor_slsutils_new_score (btor);
 
   for (;;)
   {
@@ -1580,11 +1605,15 @@ sat_sls_solver (BtorSLSSolver *slv)
     }
 
     /* restart */
-    slv->api.generate_model ((BtorSolver *) slv, false, true);
-    btor_hashint_map_delete (slv->score);
+#ifdef BTOR_HAVE_PTHREADS
+    if (slv->pool)
+      btor_lsutils_restart (btor, slv->pool, slv->roots->count);
+    else
+#endif
+      slv->api.generate_model ((BtorSolver *) slv, false, true);
+    btor_slsutils_reset_score (slv->score);
     btor_hashint_map_delete (slv->roots);
     slv->roots = 0;
-    slv->score = btor_hashint_map_new (btor->mm);
     slv->stats.restarts += 1;
   }
 
@@ -1613,7 +1642,7 @@ DONE:
   }
   if (slv->score)
   {
-    btor_hashint_map_delete (slv->score);
+    btor_slsutils_delete_score (slv->score);
     slv->score = 0;
   }
   return sat_result;
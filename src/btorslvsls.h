@@ -14,6 +14,8 @@
 #include "btorbv.h"
 #endif
 
+#include "btorlsutils.h"
+#include "btorslsutils.h"
 #include "btorslv.h"
 #include "utils/btorhashint.h"
 #include "utils/btorstack.h"
@@ -60,7 +62,8 @@ struct BtorSLSSolver
   BtorIntHashTable *roots;   /* must be map (for common local search funs)
                                 but does not maintain anything */
   BtorIntHashTable *weights; /* also maintains assertion weights */
-  BtorIntHashTable *score;   /* sls score */
+  BtorSLSScore *score;       /* sls score */
+  BtorLSWorkerPool *pool;    /* shared with parallel walkers */
 
   uint32_t nflips; /* limit, disabled if 0 */
   bool terminate;
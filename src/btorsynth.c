@@ -24,6 +24,26 @@ typedef BtorNode *(*BtorUnOp) (Btor *, BtorNode *);
 typedef BtorNode *(*BtorBinOp) (Btor *, BtorNode *, BtorNode *);
 typedef BtorNode *(*BtorTerOp) (Btor *, BtorNode *, BtorNode *, BtorNode *);
 
+typedef BtorBitVector *(*BtorBvUnOp) (BtorMemMgr *, const BtorBitVector *);
+typedef BtorBitVector *(*BtorBvBinOp) (BtorMemMgr *,
+                                       const BtorBitVector *,
+                                       const BtorBitVector *);
+typedef BtorBitVector *(*BtorBvTerOp) (BtorMemMgr *,
+                                       const BtorBitVector *,
+                                       const BtorBitVector *,
+                                       const BtorBitVector *);
+
+/* Constant operands that make an operation redundant. */
+enum OpConst
+{
+  OP_CONST_NONE = 0,
+  OP_CONST_ZERO,
+  OP_CONST_ONE,
+  OP_CONST_ONES,
+};
+
+typedef enum OpConst OpConst;
+
 struct Op
 {
   bool assoc;
@@ -35,6 +55,22 @@ struct Op
     BtorTerOp ter;
     void *fun;
   };
+  /* evaluation on constant bit-vectors, 0 if not available */
+  union
+  {
+    BtorBvUnOp bv_un;
+    BtorBvBinOp bv_bin;
+    BtorBvTerOp bv_ter;
+    void *bv_fun;
+  };
+  /* additional level cost of expressions created with this operator */
+  uint32_t cost;
+  /* right operand 'identity' yields the left operand */
+  OpConst identity;
+  /* right operand 'annihilator' yields a constant */
+  OpConst annihilator;
+  /* op (e, e) yields 'e' or a constant */
+  bool trivial_self;
   const char *name;
   uint32_t num_added;
 };
@@ -50,6 +86,7 @@ struct Candidates
   uint32_t nbinary;
   uint32_t nternary;
   uint32_t nexps;
+  BtorIntHashTable *sigs; /* maps node ids to their signature */
 };
 
 typedef struct Candidates Candidates;
@@ -450,7 +487,7 @@ eval_exps (Btor *btor,
            uint32_t nexps,
            BtorIntHashTable *value_cache,
            BtorIntHashTable *cone_hash,
-           BtorNode *candidate,
+           BtorBitVector *value_candidate,
            BtorBitVectorTuple *value_in,
            BtorBitVector *value_out,
            BtorIntHashTable *value_in_map)
@@ -513,11 +550,8 @@ eval_exps (Btor *btor,
           /* initial signature computation */
           if (pos == -1)
           {
-            if (candidate)
-            {
-              result = eval_candidate (
-                  btor, candidate, value_in, value_out, value_in_map);
-            }
+            if (value_candidate)
+              result = btor_bv_copy (mm, value_candidate);
             else
             {
               assert (value_out);
@@ -613,13 +647,18 @@ eval_exps (Btor *btor,
 }
 
 /* Add expression 'exp' to expression candidates 'candidates' at level
- * 'exp_size'. */
+ * 'exp_size'. Takes ownership of signature 'sig' (may be 0). */
 static void
-add_exp (Btor *btor, uint32_t exp_size, Candidates *candidates, BtorNode *exp)
+add_exp (Btor *btor,
+         uint32_t exp_size,
+         Candidates *candidates,
+         BtorNode *exp,
+         BtorBitVectorTuple *sig)
 {
   assert (exp_size > 0);
   assert (candidates);
 
+  int32_t id;
   BtorIntHashTable *sorted_exps;
   BtorHashTableData *d;
   BtorSortId sort;
@@ -662,6 +701,15 @@ add_exp (Btor *btor, uint32_t exp_size, Candidates *candidates, BtorNode *exp)
   if (exp_size >= BTOR_COUNT_STACK (candidates->nexps_level))
     BTOR_PUSH_STACK (candidates->nexps_level, 0);
   candidates->nexps_level.start[exp_size]++;
+
+  if (sig)
+  {
+    id = btor_node_get_id (exp);
+    if (btor_hashint_map_contains (candidates->sigs, id))
+      btor_bv_free_tuple (mm, sig);
+    else
+      btor_hashint_map_add (candidates->sigs, id)->as_ptr = sig;
+  }
 }
 
 static BtorBitVectorTuple *
@@ -691,64 +739,166 @@ create_signature_exp (Btor *btor,
   return sig;
 }
 
+/* Compute the signature of 'op' applied to 'args' from the signatures of
+ * 'args' without creating the expression. Returns 0 if 'op' can not be
+ * evaluated on bit-vectors. */
+static BtorBitVectorTuple *
+create_signature_op (Btor *btor,
+                     Op *op,
+                     BtorNode *args[],
+                     Candidates *candidates)
+{
+  assert (op);
+  assert (args);
+  assert (candidates);
+
+  uint32_t i, j, nvalues;
+  BtorBitVectorTuple *sig, *sig_args[3];
+  BtorBitVector *res;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  if (!op->bv_fun) return 0;
+
+  mm = btor->mm;
+  for (j = 0; j < op->arity; j++)
+  {
+    d = btor_hashint_map_get (candidates->sigs, btor_node_get_id (args[j]));
+    assert (d);
+    sig_args[j] = d->as_ptr;
+  }
+
+  nvalues = sig_args[0]->arity;
+  sig     = btor_bv_new_tuple (mm, nvalues);
+  for (i = 0; i < nvalues; i++)
+  {
+    switch (op->arity)
+    {
+      case 1: res = op->bv_un (mm, sig_args[0]->bv[i]); break;
+      case 2:
+        res = op->bv_bin (mm, sig_args[0]->bv[i], sig_args[1]->bv[i]);
+        break;
+      default:
+        assert (op->arity == 3);
+        res = op->bv_ter (
+            mm, sig_args[0]->bv[i], sig_args[1]->bv[i], sig_args[2]->bv[i]);
+    }
+    sig->bv[i] = res;
+  }
+  return sig;
+}
+
+static BtorNode *
+create_exp_op (Btor *btor, Op *op, BtorNode *args[])
+{
+  switch (op->arity)
+  {
+    case 1: return op->un (btor, args[0]);
+    case 2: return op->bin (btor, args[0], args[1]);
+    default:
+      assert (op->arity == 3);
+      return op->ter (btor, args[0], args[1], args[2]);
+  }
+}
+
+static bool
+is_op_const (Btor *btor, BtorNode *exp, OpConst c)
+{
+  switch (c)
+  {
+    case OP_CONST_ZERO: return btor_node_is_bv_const_zero (btor, exp);
+    case OP_CONST_ONE: return btor_node_is_bv_const_one (btor, exp);
+    case OP_CONST_ONES: return btor_node_is_bv_const_ones (btor, exp);
+    default: assert (c == OP_CONST_NONE); return false;
+  }
+}
+
+/* Check if 'op' applied to 'args' trivially simplifies to a constant or to
+ * an expression that is already a candidate. If 'symmetric' is true, both
+ * argument orders of a commutative 'op' get enumerated and only the one
+ * with ordered ids is kept. */
+static bool
+is_redundant_op (Btor *btor,
+                 Op *op,
+                 BtorNode *args[],
+                 bool symmetric,
+                 BtorIntHashTable *cache)
+{
+  BtorNode *real_arg;
+
+  if (op->arity == 1)
+  {
+    /* not (not e) = e */
+    real_arg = btor_node_real_addr (args[0]);
+    return op->un == btor_exp_bv_not && btor_node_is_inverted (args[0])
+           && btor_hashint_table_contains (cache, btor_node_get_id (real_arg));
+  }
+
+  /* constant condition or equal branches */
+  if (op->arity == 3)
+    return btor_node_is_bv_const (args[0]) || args[1] == args[2];
+
+  assert (op->arity == 2);
+  if (op->trivial_self && args[0] == args[1]) return true;
+  if (is_op_const (btor, args[1], op->identity)
+      || is_op_const (btor, args[1], op->annihilator))
+    return true;
+  if (op->assoc)
+  {
+    if (is_op_const (btor, args[0], op->identity)
+        || is_op_const (btor, args[0], op->annihilator))
+      return true;
+    if (symmetric
+        && btor_node_get_id (args[0]) > btor_node_get_id (args[1]))
+      return true;
+  }
+  return false;
+}
+
 static bool
 check_signature_exps (Btor *btor,
                       BtorNode *exps[],
                       uint32_t nexps,
                       BtorIntHashTable *value_caches[],
                       BtorIntHashTable *cone_hash,
-                      BtorNode *exp,
+                      BtorBitVectorTuple *sig_exp,
                       BtorBitVectorTuple *value_in[],
                       BtorBitVector *value_out[],
                       uint32_t nvalues,
                       BtorIntHashTable *value_in_map,
-                      BtorBitVectorTuple **sig,
-                      uint32_t *num_matches,
-                      BtorBitVector **matchbv)
+                      BtorBitVectorTuple **sig)
 {
   bool is_equal = true;
-  uint32_t i = 0, nmatches = 0;
-  BtorBitVectorTuple *inputs;
-  BtorBitVector *output, *res, *bv;
-  BtorMemMgr *mm;
-
-  mm = btor->mm;
-
-  if (sig) *sig = btor_bv_new_tuple (mm, nvalues);
+  uint32_t i;
+  BtorBitVector *res;
 
-  if (matchbv) bv = btor_bv_new (mm, nvalues);
+  /* no constraints, compare candidate values with expected outputs */
+  if (nexps == 0)
+  {
+    for (i = 0; i < nvalues; i++)
+      if (btor_bv_compare (sig_exp->bv[i], value_out[i]) != 0) return false;
+    return true;
+  }
 
+  assert (sig);
+  *sig = btor_bv_new_tuple (btor->mm, nvalues);
   for (i = 0; i < nvalues; i++)
   {
-    inputs = value_in[i];
-    output = value_out[i];
-
-    if (nexps)
-      res = eval_exps (btor,
-                       exps,
-                       nexps,
-                       value_caches[i],
-                       cone_hash,
-                       exp,
-                       inputs,
-                       output,
-                       value_in_map);
-    else
-      res = eval_candidate (btor, exp, inputs, output, value_in_map);
-
-    if (btor_bv_compare (res, output) == 0)
-    {
-      nmatches++;
-      if (matchbv) btor_bv_set_bit (bv, i, 1);
-    }
-    else if (is_equal)
+    res = eval_exps (btor,
+                     exps,
+                     nexps,
+                     value_caches[i],
+                     cone_hash,
+                     sig_exp->bv[i],
+                     value_in[i],
+                     value_out[i],
+                     value_in_map);
+
+    if (is_equal && btor_bv_compare (res, value_out[i]) != 0)
       is_equal = false;
 
-    if (sig) btor_bv_add_to_tuple (mm, *sig, res, i);
-    btor_bv_free (mm, res);
+    (*sig)->bv[i] = res;
   }
-  if (num_matches) *num_matches = nmatches;
-  if (matchbv) *matchbv = bv;
   return is_equal;
 }
 
@@ -760,6 +910,7 @@ check_candidate_exps (Btor *btor,
                       BtorIntHashTable *cone_hash,
                       uint32_t cur_level,
                       BtorNode *exp,
+                      BtorBitVectorTuple *sig_exp,
                       BtorSortId target_sort,
                       BtorBitVectorTuple *value_in[],
                       BtorBitVector *value_out[],
@@ -769,12 +920,12 @@ check_candidate_exps (Btor *btor,
                       BtorIntHashTable *cache,
                       BtorPtrHashTable *sigs,
                       BtorPtrHashTable *sigs_exp,
+                      BtorSynthStats *stats,
                       Op *op)
 {
   bool found_candidate = false;
   int32_t id;
-  BtorBitVectorTuple *sig = 0, *sig_exp;
-  BtorBitVector *matchbv  = 0;
+  BtorBitVectorTuple *sig = 0;
   BtorMemMgr *mm;
 
   id = btor_node_get_id (exp);
@@ -782,58 +933,127 @@ check_candidate_exps (Btor *btor,
 
   if (btor_node_is_bv_const (exp) || btor_hashint_table_contains (cache, id))
   {
+    if (sig_exp) btor_bv_free_tuple (mm, sig_exp);
     btor_node_release (btor, exp);
     return false;
   }
 
-  if (nexps == 0 || btor_node_real_addr (exp)->sort_id == target_sort)
+  /* check signature for candidate expression (in/out values) */
+  if (!sig_exp)
   {
-    /* check signature for candidate expression (in/out values) */
     sig_exp = create_signature_exp (
         btor, exp, value_in, value_out, nvalues, value_in_map);
 
     if (btor_hashptr_table_get (sigs_exp, sig_exp))
     {
+      stats->pruned_oe++;
       btor_bv_free_tuple (mm, sig_exp);
       btor_node_release (btor, exp);
       return false;
     }
-    btor_hashptr_table_add (sigs_exp, sig_exp);
+  }
+#ifndef NDEBUG
+  else
+  {
+    BtorBitVectorTuple *sig_eval;
+    sig_eval = create_signature_exp (
+        btor, exp, value_in, value_out, nvalues, value_in_map);
+    assert (btor_bv_compare_tuple (sig_eval, sig_exp) == 0);
+    btor_bv_free_tuple (mm, sig_eval);
+  }
+#endif
+  assert (!btor_hashptr_table_get (sigs_exp, sig_exp));
 
+  if (btor_node_real_addr (exp)->sort_id == target_sort)
+  {
     /* check signature for candidate expression w.r.t. formula */
     found_candidate = check_signature_exps (btor,
                                             exps,
                                             nexps,
                                             value_caches,
                                             cone_hash,
-                                            exp,
+                                            sig_exp,
                                             value_in,
                                             value_out,
                                             nvalues,
                                             value_in_map,
-                                            &sig,
-                                            0,
-                                            &matchbv);
-  }
+                                            nexps ? &sig : 0);
 
-  if (sig && btor_hashptr_table_get (sigs, sig))
-  {
-    assert (!found_candidate);
-    btor_bv_free_tuple (mm, sig);
-    btor_bv_free (mm, matchbv);
-    btor_node_release (btor, exp);
-    return false;
+    if (sig && btor_hashptr_table_get (sigs, sig))
+    {
+      assert (!found_candidate);
+      btor_bv_free_tuple (mm, sig);
+      btor_bv_free_tuple (mm, sig_exp);
+      btor_node_release (btor, exp);
+      return false;
+    }
+    if (sig) btor_hashptr_table_add (sigs, sig);
   }
 
-  if (matchbv) btor_bv_free (mm, matchbv);
-
-  if (sig) btor_hashptr_table_add (sigs, sig);
+  btor_hashptr_table_add (sigs_exp, sig_exp);
   btor_hashint_table_add (cache, id);
   if (op) op->num_added++;
-  add_exp (btor, cur_level, candidates, exp);
+  add_exp (btor, cur_level, candidates, exp, sig_exp);
   return found_candidate;
 }
 
+/* Enumerate expression 'op (args)'. Its signature is computed bottom-up from
+ * the signatures of 'args', which allows to discard observationally
+ * equivalent expressions before they are created. */
+static bool
+check_candidate_op (Btor *btor,
+                    BtorNode *exps[],
+                    uint32_t nexps,
+                    BtorIntHashTable *value_caches[],
+                    BtorIntHashTable *cone_hash,
+                    uint32_t cur_level,
+                    Op *op,
+                    BtorNode *args[],
+                    BtorSortId target_sort,
+                    BtorBitVectorTuple *value_in[],
+                    BtorBitVector *value_out[],
+                    uint32_t nvalues,
+                    BtorIntHashTable *value_in_map,
+                    Candidates *candidates,
+                    BtorIntHashTable *cache,
+                    BtorPtrHashTable *sigs,
+                    BtorPtrHashTable *sigs_exp,
+                    BtorSynthStats *stats,
+                    BtorNode **exp)
+{
+  BtorBitVectorTuple *sig_exp;
+
+  sig_exp = create_signature_op (btor, op, args, candidates);
+  if (sig_exp && btor_hashptr_table_get (sigs_exp, sig_exp))
+  {
+    stats->pruned_oe++;
+    btor_bv_free_tuple (btor->mm, sig_exp);
+    *exp = 0;
+    return false;
+  }
+
+  *exp = create_exp_op (btor, op, args);
+  return check_candidate_exps (btor,
+                               exps,
+                               nexps,
+                               value_caches,
+                               cone_hash,
+                               cur_level,
+                               *exp,
+                               sig_exp,
+                               target_sort,
+                               value_in,
+                               value_out,
+                               nvalues,
+                               value_in_map,
+                               candidates,
+                               cache,
+                               sigs,
+                               sigs_exp,
+                               stats,
+                               op);
+}
+
 static inline void
 report_stats (Btor *btor,
               double start,
@@ -865,34 +1085,42 @@ report_op_stats (Btor *btor, Op ops[], uint32_t nops)
     BTOR_MSG (btor->msg, 1, "%s: %u", ops[i].name, ops[i].num_added);
 }
 
-#define CHECK_CANDIDATE(exp)                                              \
-  {                                                                       \
-    found_candidate = check_candidate_exps (btor,                         \
-                                            trav_cone.start,              \
-                                            BTOR_COUNT_STACK (trav_cone), \
-                                            value_caches.start,           \
-                                            cone_hash,                    \
-                                            cur_level,                    \
-                                            exp,                          \
-                                            target_sort,                  \
-                                            value_in,                     \
-                                            value_out,                    \
-                                            nvalues,                      \
-                                            value_in_map,                 \
-                                            &candidates,                  \
-                                            cache,                        \
-                                            sigs,                         \
-                                            sigs_exp,                     \
-                                            &ops[i]);                     \
-    num_checks++;                                                         \
-    if (num_checks % 10000 == 0)                                          \
-      report_stats (btor, start, cur_level, num_checks, &candidates);     \
-    if (num_checks % 1000 == 0 && btor_terminate (btor))                  \
-    {                                                                     \
-      BTOR_MSG (btor->msg, 1, "terminate");                               \
-      goto DONE;                                                          \
-    }                                                                     \
-    if (found_candidate || num_checks >= max_checks) goto DONE;           \
+#define CHECK_CANDIDATE(ARGS, SYMMETRIC)                                     \
+  {                                                                          \
+    stats->enumerated++;                                                     \
+    if (is_redundant_op (btor, &ops[i], ARGS, SYMMETRIC, cache))             \
+      stats->pruned_ops++;                                                   \
+    else                                                                     \
+    {                                                                        \
+      found_candidate = check_candidate_op (btor,                            \
+                                            trav_cone.start,                 \
+                                            BTOR_COUNT_STACK (trav_cone),    \
+                                            value_caches.start,              \
+                                            cone_hash,                       \
+                                            cur_level,                       \
+                                            &ops[i],                         \
+                                            ARGS,                            \
+                                            target_sort,                     \
+                                            value_in,                        \
+                                            value_out,                       \
+                                            nvalues,                         \
+                                            value_in_map,                    \
+                                            &candidates,                     \
+                                            cache,                           \
+                                            sigs,                            \
+                                            sigs_exp,                        \
+                                            stats,                           \
+                                            &exp);                           \
+      num_checks++;                                                          \
+      if (num_checks % 10000 == 0)                                           \
+        report_stats (btor, start, cur_level, num_checks, &candidates);      \
+      if (num_checks % 1000 == 0 && btor_terminate (btor))                   \
+      {                                                                      \
+        BTOR_MSG (btor->msg, 1, "terminate");                                \
+        goto DONE;                                                           \
+      }                                                                      \
+      if (found_candidate || num_checks >= max_checks) goto DONE;            \
+    }                                                                        \
   }
 
 static BtorNode *
@@ -911,7 +1139,8 @@ synthesize (Btor *btor,
             BtorIntHashTable *value_in_map,
             uint32_t max_checks,
             uint32_t max_level,
-            BtorNode *prev_synth)
+            BtorNode *prev_synth,
+            BtorSynthStats *stats)
 {
   assert (btor);
   assert (inputs);
@@ -922,11 +1151,13 @@ synthesize (Btor *btor,
   assert (ops);
   assert (nops > 0);
   assert (!nconsts || consts);
+  assert (stats);
 
   double start;
   bool found_candidate = false, equal;
-  uint32_t i, j, k, *tuple, cur_level = 1, num_checks = 0, num_added;
-  BtorNode *exp, **exp_tuple, *result = 0;
+  uint32_t i, j, k, n, *tuple, cur_level = 1, num_checks = 0, num_added;
+  uint32_t max_cost, num_empty_levels;
+  BtorNode *exp = 0, **exp_tuple, *args[3], *result = 0;
   BtorNodePtrStack *exps, trav_exps, trav_cone;
   Candidates candidates;
   BtorIntHashTable *cache, *e0_exps, *e1_exps, *e2_exps;
@@ -949,6 +1180,8 @@ synthesize (Btor *btor,
   cone_hash = btor_hashint_table_new (mm);
   sigs      = btor_hashptr_table_new (
       mm, (BtorHashPtr) btor_bv_hash_tuple, (BtorCmpPtr) btor_bv_compare_tuple);
+  /* global observational equivalence table (signatures of all candidates,
+   * owned by 'candidates.sigs') */
   sigs_exp = btor_hashptr_table_new (
       mm, (BtorHashPtr) btor_bv_hash_tuple, (BtorCmpPtr) btor_bv_compare_tuple);
 
@@ -962,9 +1195,13 @@ synthesize (Btor *btor,
   BTOR_PUSH_STACK (candidates.exps, 0);
   BTOR_INIT_STACK (mm, candidates.nexps_level);
   BTOR_PUSH_STACK (candidates.nexps_level, 0);
+  candidates.sigs = btor_hashint_map_new (mm);
 
   target_sort = btor_sort_bv (btor, btor_bv_get_width (value_out[0]));
 
+  max_cost = 0;
+  for (i = 0; i < nops; i++) max_cost = BTOR_MAX_UTIL (max_cost, ops[i].cost);
+
   /* generate target signature */
   tmp_value_out = value_out;
   if (nconstraints > 0)
@@ -1003,7 +1240,8 @@ synthesize (Btor *btor,
 
   if (prev_synth)
   {
-    exp             = btor_node_copy (btor, prev_synth);
+    exp = btor_node_copy (btor, prev_synth);
+    stats->enumerated++;
     found_candidate = check_candidate_exps (btor,
                                             trav_cone.start,
                                             BTOR_COUNT_STACK (trav_cone),
@@ -1011,6 +1249,7 @@ synthesize (Btor *btor,
                                             cone_hash,
                                             cur_level,
                                             exp,
+                                            0,
                                             target_sort,
                                             value_in,
                                             value_out,
@@ -1020,6 +1259,7 @@ synthesize (Btor *btor,
                                             cache,
                                             sigs,
                                             sigs_exp,
+                                            stats,
                                             0);
     num_checks++;
     if (num_checks % 10000 == 0)
@@ -1034,7 +1274,8 @@ synthesize (Btor *btor,
   /* level 1 checks (inputs) */
   for (i = 0; i < ninputs; i++)
   {
-    exp             = btor_node_copy (btor, inputs[i]);
+    exp = btor_node_copy (btor, inputs[i]);
+    stats->enumerated++;
     found_candidate = check_candidate_exps (btor,
                                             trav_cone.start,
                                             BTOR_COUNT_STACK (trav_cone),
@@ -1042,6 +1283,7 @@ synthesize (Btor *btor,
                                             cone_hash,
                                             cur_level,
                                             exp,
+                                            0,
                                             target_sort,
                                             value_in,
                                             value_out,
@@ -1051,6 +1293,7 @@ synthesize (Btor *btor,
                                             cache,
                                             sigs,
                                             sigs_exp,
+                                            stats,
                                             0);
     num_checks++;
     if (num_checks % 10000 == 0)
@@ -1072,24 +1315,32 @@ synthesize (Btor *btor,
   {
     found_candidate = true;
     exp             = btor_exp_bv_const (btor, tmp_value_out[0]);
-    add_exp (btor, 1, &candidates, exp);
+    add_exp (btor, 1, &candidates, exp, 0);
     goto DONE;
   }
 
-  /* add constants to level 1 */
+  /* add constants to level 1, constants are not added to the observational
+   * equivalence table since they are never checked as candidates */
   for (i = 0; i < nconsts; i++)
-    add_exp (btor, 1, &candidates, btor_node_copy (btor, consts[i]));
+    add_exp (btor,
+             1,
+             &candidates,
+             btor_node_copy (btor, consts[i]),
+             create_signature_exp (
+                 btor, consts[i], value_in, value_out, nvalues, value_in_map));
 
 #if 0
   /* add the desired outputs as constants to level 1 */
   for (i = 0; i < nvalues; i++)
     {
       exp = btor_exp_bv_const (btor, tmp_value_out[i]);
-      add_exp (btor, 1, &candidates, exp);
+      add_exp (btor, 1, &candidates, exp, 0);
     }
 #endif
 
-  /* level 2+ checks */
+  /* level 2+ checks, an expression created with operator 'op' is at level
+   * 'op.cost' plus the level of its arguments */
+  num_empty_levels = 0;
   for (cur_level = 2; !max_level || cur_level < max_level; cur_level++)
   {
     /* initialize current level */
@@ -1100,25 +1351,29 @@ synthesize (Btor *btor,
     num_added = candidates.nexps;
     for (i = 0; i < nops; i++)
     {
+      /* arguments are taken from (partitions of) level 'n' */
+      if (cur_level < ops[i].cost + BTOR_MAX_UTIL (ops[i].arity, 2u)) continue;
+      n = cur_level - ops[i].cost;
+
       if (ops[i].arity == 1)
       {
         /* use all expressions from previous level and apply unary
          * operators */
-        e0_exps = BTOR_PEEK_STACK (candidates.exps, cur_level - 1);
+        e0_exps = BTOR_PEEK_STACK (candidates.exps, n - 1);
         for (j = 0; j < e0_exps->size; j++)
         {
           if (!e0_exps->keys[j]) continue;
           exps = e0_exps->data[j].as_ptr;
           for (k = 0; k < BTOR_COUNT_STACK (*exps); k++)
           {
-            exp = ops[i].un (btor, BTOR_PEEK_STACK (*exps, k));
-            CHECK_CANDIDATE (exp);
+            args[0] = BTOR_PEEK_STACK (*exps, k);
+            CHECK_CANDIDATE (args, false);
           }
         }
       }
       else if (ops[i].arity == 2)
       {
-        btor_init_part_gen (&pg, cur_level, 2, !ops[i].assoc);
+        btor_init_part_gen (&pg, n, 2, !ops[i].assoc);
         while (btor_has_next_part_gen (&pg))
         {
           tuple   = btor_next_part_gen (&pg);
@@ -1129,16 +1384,15 @@ synthesize (Btor *btor,
           while (btor_has_next_cart_prod_iterator (&cpit))
           {
             exp_tuple = btor_next_cart_prod_iterator (&cpit);
-            exp       = ops[i].bin (btor, exp_tuple[0], exp_tuple[1]);
-            CHECK_CANDIDATE (exp);
+            CHECK_CANDIDATE (exp_tuple, tuple[0] == tuple[1]);
           }
         }
       }
-      else if (cur_level > 2)
+      else
       {
         assert (ops[i].arity == 3);
 
-        btor_init_part_gen (&pg, cur_level, 3, true);
+        btor_init_part_gen (&pg, n, 3, true);
         while (btor_has_next_part_gen (&pg))
         {
           tuple   = btor_next_part_gen (&pg);
@@ -1158,17 +1412,24 @@ synthesize (Btor *btor,
 
             for (j = 0; j < BTOR_COUNT_STACK (*exps); j++)
             {
-              exp = ops[i].ter (
-                  btor, BTOR_PEEK_STACK (*exps, j), exp_tuple[0], exp_tuple[1]);
-              CHECK_CANDIDATE (exp);
+              args[0] = BTOR_PEEK_STACK (*exps, j);
+              args[1] = exp_tuple[0];
+              args[2] = exp_tuple[1];
+              CHECK_CANDIDATE (args, false);
             }
           }
         }
       }
     }
     report_op_stats (btor, ops, nops);
-    /* no more expressions generated */
-    if (num_added == candidates.nexps) break;
+    /* no more expressions generated, operators with cost may still create
+     * expressions from lower levels */
+    if (num_added == candidates.nexps)
+    {
+      if (++num_empty_levels > max_cost) break;
+    }
+    else
+      num_empty_levels = 0;
   }
 DONE:
   report_stats (btor, start, cur_level, num_checks, &candidates);
@@ -1219,6 +1480,12 @@ DONE:
   }
   BTOR_RELEASE_STACK (candidates.exps);
   BTOR_RELEASE_STACK (candidates.nexps_level);
+  for (j = 0; j < candidates.sigs->size; j++)
+  {
+    if (!candidates.sigs->data[j].as_ptr) continue;
+    btor_bv_free_tuple (mm, candidates.sigs->data[j].as_ptr);
+  }
+  btor_hashint_map_delete (candidates.sigs);
 
   while (!BTOR_EMPTY_STACK (value_caches))
   {
@@ -1237,7 +1504,6 @@ DONE:
   BTOR_RELEASE_STACK (sig_constraints);
 
   btor_iter_hashptr_init (&it, sigs);
-  btor_iter_hashptr_queue (&it, sigs_exp);
   while (btor_iter_hashptr_has_next (&it))
     btor_bv_free_tuple (mm, btor_iter_hashptr_next (&it));
 
@@ -1254,14 +1520,19 @@ DONE:
   return result;
 }
 
-#define INIT_OP(ARITY, ASSOC, FPTR) \
-  {                                 \
-    ops[i].arity     = ARITY;       \
-    ops[i].assoc     = ASSOC;       \
-    ops[i].fun       = FPTR;        \
-    ops[i].num_added = 0;           \
-    ops[i].name      = #FPTR;       \
-    i += 1;                         \
+#define INIT_OP(ARITY, ASSOC, COST, FPTR, BVFPTR, ID, ANNIHILATOR, SELF) \
+  {                                                                      \
+    ops[i].arity        = ARITY;                                         \
+    ops[i].assoc        = ASSOC;                                         \
+    ops[i].cost         = COST;                                          \
+    ops[i].fun          = FPTR;                                          \
+    ops[i].bv_fun       = BVFPTR;                                        \
+    ops[i].identity     = OP_CONST_##ID;                                 \
+    ops[i].annihilator  = OP_CONST_##ANNIHILATOR;                        \
+    ops[i].trivial_self = SELF;                                          \
+    ops[i].num_added    = 0;                                             \
+    ops[i].name         = #FPTR;                                         \
+    i += 1;                                                              \
   }
 
 static uint32_t
@@ -1269,7 +1540,7 @@ init_ops (Btor *btor, Op *ops)
 {
   uint32_t i = 0;
 
-  INIT_OP (1, false, btor_exp_bv_not);
+  INIT_OP (1, false, 0, btor_exp_bv_not, btor_bv_not, NONE, NONE, false);
   //  INIT_OP (1, false, btor_neg_exp);
   //  INIT_OP (1, false, btor_redor_exp);
   //  INIT_OP (1, false, btor_redxor_exp);
@@ -1278,28 +1549,31 @@ init_ops (Btor *btor, Op *ops)
   //  INIT_OP (1, false, btor_dec_exp);
 
   /* boolean ops */
-  INIT_OP (2, false, btor_exp_bv_ult);
-  INIT_OP (2, false, btor_exp_bv_slt);
-  INIT_OP (2, true, btor_exp_eq);
+  INIT_OP (2, false, 0, btor_exp_bv_ult, btor_bv_ult, NONE, ZERO, true);
+  INIT_OP (2, false, 0, btor_exp_bv_slt, btor_bv_slt, NONE, NONE, true);
+  INIT_OP (2, true, 0, btor_exp_eq, btor_bv_eq, NONE, NONE, true);
 
   /* bv ops */
-  if (btor->ops[BTOR_BV_AND_NODE].cur > 0) INIT_OP (2, true, btor_exp_bv_and);
+  if (btor->ops[BTOR_BV_AND_NODE].cur > 0)
+    INIT_OP (2, true, 0, btor_exp_bv_and, btor_bv_and, ONES, ZERO, true);
   if (btor->ops[BTOR_BV_ADD_NODE].cur > 0)
   {
-    INIT_OP (2, true, btor_exp_bv_add);
-    INIT_OP (2, false, btor_exp_bv_sub);
+    INIT_OP (2, true, 0, btor_exp_bv_add, btor_bv_add, ZERO, NONE, false);
+    INIT_OP (2, false, 0, btor_exp_bv_sub, btor_bv_sub, ZERO, NONE, true);
   }
-  if (btor->ops[BTOR_BV_MUL_NODE].cur > 0) INIT_OP (2, true, btor_exp_bv_mul);
+  if (btor->ops[BTOR_BV_MUL_NODE].cur > 0)
+    INIT_OP (2, true, 0, btor_exp_bv_mul, btor_bv_mul, ONE, ZERO, false);
+  /* division and remainder are expensive, prefer smaller terms */
   if (btor->ops[BTOR_BV_UDIV_NODE].cur > 0)
   {
-    INIT_OP (2, false, btor_exp_bv_udiv);
-    INIT_OP (2, false, btor_exp_bv_sdiv);
+    INIT_OP (2, false, 1, btor_exp_bv_udiv, btor_bv_udiv, ONE, ZERO, false);
+    INIT_OP (2, false, 1, btor_exp_bv_sdiv, btor_bv_sdiv, ONE, NONE, false);
   }
   if (btor->ops[BTOR_BV_UREM_NODE].cur > 0)
   {
-    INIT_OP (2, false, btor_exp_bv_urem);
-    INIT_OP (2, false, btor_exp_bv_srem);
-    INIT_OP (2, false, btor_exp_bv_smod);
+    INIT_OP (2, false, 1, btor_exp_bv_urem, btor_bv_urem, ZERO, ONE, true);
+    INIT_OP (2, false, 1, btor_exp_bv_srem, btor_bv_srem, ZERO, ONE, true);
+    INIT_OP (2, false, 1, btor_exp_bv_smod, 0, ZERO, ONE, true);
   }
 #if 0
   INIT_OP (2, true,  btor_ne_exp);
@@ -1329,7 +1603,7 @@ init_ops (Btor *btor, Op *ops)
   INIT_OP (2, false, btor_exp_bv_smod);
   INIT_OP (2, false, btor_concat_exp);
 #endif
-  INIT_OP (3, false, btor_exp_cond);
+  INIT_OP (3, false, 0, btor_exp_cond, btor_bv_ite, NONE, NONE, false);
   return i;
 }
 
@@ -1347,11 +1621,19 @@ btor_synthesize_term (Btor *btor,
                       uint32_t nconsts,
                       uint32_t max_checks,
                       uint32_t max_level,
-                      BtorNode *prev_synth)
+                      BtorNode *prev_synth,
+                      BtorSynthStats *stats)
 {
   uint32_t nops;
   Op ops[64];
   BtorNode *result;
+  BtorSynthStats local_stats;
+
+  if (!stats)
+  {
+    memset (&local_stats, 0, sizeof (BtorSynthStats));
+    stats = &local_stats;
+  }
 
   nops = init_ops (btor, ops);
   assert (nops);
@@ -1371,7 +1653,8 @@ btor_synthesize_term (Btor *btor,
                        value_in_map,
                        max_checks,
                        max_level,
-                       prev_synth);
+                       prev_synth,
+                       stats);
 
   return result;
 }
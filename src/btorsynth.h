@@ -15,6 +15,17 @@
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 
+/* Enumeration statistics, accumulated over calls to btor_synthesize_term. */
+struct BtorSynthStats
+{
+  uint64_t enumerated; /* number of enumerated candidate expressions */
+  uint64_t pruned_ops; /* discarded by operator rules (commutativity,
+                          identity and absorbing elements) */
+  uint64_t pruned_oe;  /* discarded by observational equivalence */
+};
+
+typedef struct BtorSynthStats BtorSynthStats;
+
 BtorNode* btor_synthesize_term (Btor* btor,
                                 BtorNode* params[],
                                 uint32_t nparams,
@@ -28,5 +39,6 @@ BtorNode* btor_synthesize_term (Btor* btor,
                                 uint32_t nconsts,
                                 uint32_t max_checks,
                                 uint32_t max_level,
-                                BtorNode* prev_synth);
+                                BtorNode* prev_synth,
+                                BtorSynthStats* stats);
 #endif
@@ -141,6 +141,9 @@ enum BtorOption
         bit-blasted formula (the AIG layer)
       * BTOR_ENGINE_QUANT:
         the quantifier engine (BV only)
+      * BTOR_ENGINE_AUTO:
+        select engine, SAT engine and prop pre-pass budget based on features
+        of the simplified formula (see contrib/btortrainengine.py)
   */
   BTOR_OPT_ENGINE,
 
@@ -281,6 +284,11 @@ enum BtorOption
 
       Enable (``value``: 1) or disable (``value``: 0) unconstrained
       optimization.
+
+      In incremental mode and with model generation enabled, only
+      unconstrained bit-vector terms are eliminated. Eliminated terms are
+      restored if their inputs are used in subsequent assertions or
+      assumptions, and models are reconstructed for eliminated inputs.
   */
   BTOR_OPT_UCOPT,
 
@@ -316,6 +324,80 @@ enum BtorOption
   */
   BTOR_OPT_NORMALIZE_ADD,
 
+  /*!
+    * **BTOR_OPT_BV_DOMAINS**
+
+      | Enable (``value``: 1) or disable (``value``: 0) propagation of known
+        bits and unsigned intervals over the bit-vector terms of the
+        constraints during simplification.
+      | Variables and Boolean terms with a fixed value are added as new
+        constraints, and constraints with an empty domain make the formula
+        inconsistent.
+  */
+  BTOR_OPT_BV_DOMAINS,
+
+  /*!
+    * **BTOR_OPT_REDUCE_WIDTHS**
+
+      | Enable (``value``: 1) or disable (``value``: 0) bit-width reduction
+        during simplification.
+      | Variables with implied constant upper bits are substituted by
+        narrower variables, and operators over zero- or sign-extended
+        operands or with unused upper bits are replaced by narrower
+        operators. Models are preserved.
+  */
+  BTOR_OPT_REDUCE_WIDTHS,
+
+  /*!
+    * **BTOR_OPT_ELIMINATE_XORS**
+
+      | Enable (``value``: 1) or disable (``value``: 0) Gaussian elimination
+        of XOR constraints during simplification.
+      | Top-level equations over XORs of terms of the same width are solved
+        over GF(2), and the solved variables are substituted.
+  */
+  BTOR_OPT_ELIMINATE_XORS,
+
+  /*!
+    * **BTOR_OPT_FRAIG**
+
+      | Enable SAT sweeping (fraiging) of the bit-blasted constraints
+        (``value``: conflict limit per equivalence check).
+      | AIG nodes with equal simulation signatures are checked for
+        equivalence by a separate SAT solver and proven equivalent nodes
+        are merged before the translation into CNF.
+      | Disabled if ``value`` is 0.
+  */
+  BTOR_OPT_FRAIG,
+
+  /*!
+    * **BTOR_OPT_AIG_REWRITE**
+
+      | Set the maximum number of rounds (``value``: 0-16) of AIG
+        optimization (AND balancing, DAG-aware cut rewriting and
+        refactoring) of the bit-blasted constraints before the translation
+        into CNF.
+      | Disabled if ``value`` is 0.
+  */
+  BTOR_OPT_AIG_REWRITE,
+
+  /*!
+    * **BTOR_OPT_AIG_CNF**
+
+      | Select the encoding of the bit-blasted constraints into CNF.
+
+      * BTOR_AIG_CNF_TSEITIN [default]:
+        Tseitin encoding of every AIG node in both polarities
+      * BTOR_AIG_CNF_PG:
+        Plaisted-Greenbaum encoding, i.e., AIG nodes are only encoded in
+        the polarities they occur in
+      * BTOR_AIG_CNF_CUT:
+        Plaisted-Greenbaum encoding of 4-feasible cuts selected by area
+        flow, where the function of each cut is encoded with a minimal
+        number of clauses
+  */
+  BTOR_OPT_AIG_CNF,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Fun Engine Options:**
@@ -338,6 +420,27 @@ enum BtorOption
    */
   BTOR_OPT_FUN_PRESLS,
 
+  /*!
+    * **BTOR_OPT_FUN_SCHEDULE**
+
+      Enable (``value``: 1) or disable (``value``: 0) sequential scheduling
+      of the prop engine and the SAT solver in growing slices (QF_BV only).
+      Slices follow the Luby sequence (in units of
+      BTOR_OPT_FUN_SCHEDULE_UNIT). Values fixed by the SAT solver are used
+      as domains by the prop engine, and the assignments found by the prop
+      engine are used as phases by the SAT solver.
+   */
+  BTOR_OPT_FUN_SCHEDULE,
+
+  /*!
+    * **BTOR_OPT_FUN_SCHEDULE_UNIT**
+
+      | Set the size of a slice unit of the sequential schedule
+        (BTOR_OPT_FUN_SCHEDULE), i.e., the number of propagation steps of
+        the prop engine and the number of conflicts of the SAT solver.
+   */
+  BTOR_OPT_FUN_SCHEDULE_UNIT,
+
   /*!
     * **BTOR_OPT_FUN_DUAL_PROP**
 
@@ -409,6 +512,63 @@ enum BtorOption
 
   BTOR_OPT_FUN_STORE_LAMBDAS,
 
+  /*!
+    * **BTOR_OPT_FUN_LEMMA_BATCH**
+
+      | Set the maximum number of lemmas added per refinement iteration
+        (``value``: 0 for no limit).
+      | Lemmas are ranked by the number of times they were derived and by
+        size. Lemmas that do not fit into the current batch are deferred and
+        only added if they are derived again. The batch size is increased
+        if most lemmas of a refinement iteration had been deferred before.
+  */
+  BTOR_OPT_FUN_LEMMA_BATCH,
+
+  /*!
+    * **BTOR_OPT_FUN_CONFLICT_THREADS**
+
+      | Set the number of threads used for checking the initial applies for
+        conflicts (``value``: 0 to disable).
+      | The current model is frozen and the applies are checked in parallel
+        without modifying the formula. Lemmas for all detected conflicts are
+        added afterwards. If no conflict is found, the regular consistency
+        check is performed.
+  */
+  BTOR_OPT_FUN_CONFLICT_THREADS,
+
+  /*!
+    * **BTOR_OPT_FUN_BETA_CACHE**
+
+      | Enable (``value``: 1) or disable (``value``: 0) caching of partial
+        beta reduction results within a refinement iteration.
+      | Results are cached per lambda and arguments and reused for all
+        applies that propagate the same arguments to a lambda, and for lemma
+        generation.
+  */
+  BTOR_OPT_FUN_BETA_CACHE,
+
+  /*!
+    * **BTOR_OPT_FUN_STATIC_LEMMAS**
+
+      | Set the maximum number of read-over-write lemmas generated eagerly
+        before the first refinement iteration (``value``: 0 to disable).
+      | Lemmas are generated for reads on write chains, where writes with
+        statically distinct indices are skipped.
+  */
+  BTOR_OPT_FUN_STATIC_LEMMAS,
+
+  /*!
+    * **BTOR_OPT_FUN_LAZY_BITBLAST**
+
+      | Set the minimum bit-width of multiplication, unsigned division and
+        unsigned remainder nodes that are bit-blasted lazily (``value``: 0 to
+        disable).
+      | These operators are first abstracted as fresh bit-vectors and only
+        bit-blasted if the value of the abstraction does not match the
+        values of its operands in the model of the bit-vector skeleton.
+  */
+  BTOR_OPT_FUN_LAZY_BITBLAST,
+
   /*!
     * **BTOR_OPT_PRINT_DIMACS**
 
@@ -590,6 +750,17 @@ enum BtorOption
   */
   BTOR_OPT_SLS_USE_BANDIT,
 
+  /*!
+    * **BTOR_OPT_SLS_WORKERS**
+
+      | Set the number of parallel SLS walkers.
+      | Each additional walker runs on a clone with a different seed. On
+        restarts, walkers share the assignment with the least number of
+        unsatisfied constraints (see ``BTOR_OPT_SLS_USE_RESTARTS``). All
+        walkers are stopped as soon as one of them found a model.
+  */
+  BTOR_OPT_SLS_WORKERS,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Prop Engine Options**:
@@ -742,6 +913,28 @@ enum BtorOption
     */
   BTOR_OPT_PROP_NO_MOVE_ON_CONFLICT,
 
+  /*!
+    * **BTOR_OPT_PROP_WORKERS**
+
+      | Set the number of parallel propagation-based local search walkers.
+      | Each additional walker runs on a clone with a different seed. On
+        restarts, walkers share the assignment with the least number of
+        unsatisfied constraints (see ``BTOR_OPT_PROP_USE_RESTARTS``). All
+        walkers are stopped as soon as one of them found a model.
+  */
+  BTOR_OPT_PROP_WORKERS,
+
+  /*!
+    * **BTOR_OPT_PROP_DOMAINS**
+
+      | Enable (``value``: 1) or disable (``value``: 0) restricting
+        propagated values to the known bits and unsigned intervals implied
+        by the constraints (see ``BTOR_OPT_BV_DOMAINS``).
+      | The domains are computed when the prop engine starts, and their
+        interval bounds are narrowed on non-recoverable conflicts.
+  */
+  BTOR_OPT_PROP_DOMAINS,
+
   /* --------------------------------------------------------------------- */
   /*!
     **AIGProp Engine Options**:
@@ -835,6 +1028,19 @@ enum BtorOption
    */
   BTOR_OPT_QUANT_MINISCOPE,
 
+  /*!
+    * **BTOR_OPT_QUANT_WORKERS**
+
+      Set the number of parallel workers of the quantifier solver.
+      Each worker runs a diversified configuration (synthesis limit,
+      quantifier instantiation synthesis, miniscoping, equality resolution)
+      and counterexamples are shared between workers that solve the same
+      formula. If the dual solver is enabled, every other worker solves the
+      dual formula.
+      The number of workers is limited to the number of available CPUs.
+   */
+  BTOR_OPT_QUANT_WORKERS,
+
   /* internal options --------------------------------------------------- */
 
   BTOR_OPT_SORT_EXP,
@@ -848,6 +1054,8 @@ enum BtorOption
   BTOR_OPT_PARSE_INTERACTIVE,
   BTOR_OPT_SAT_ENGINE_LGL_FORK,
   BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE,
+  BTOR_OPT_SAT_ENGINE_CADICAL_CONFLICTS,
+  BTOR_OPT_SAT_ENGINE_CADICAL_DECISIONS,
   BTOR_OPT_SAT_ENGINE_N_THREADS,
   BTOR_OPT_SIMP_NORMAMLIZE_ADDERS,
   BTOR_OPT_DECLSORT_BV_WIDTH,
@@ -887,6 +1095,7 @@ enum BtorOptEngine
   BTOR_ENGINE_PROP,
   BTOR_ENGINE_AIGPROP,
   BTOR_ENGINE_QUANT,
+  BTOR_ENGINE_AUTO,
 };
 typedef enum BtorOptEngine BtorOptEngine;
 
@@ -986,6 +1195,14 @@ enum BtorOptBetaReduceMode
 };
 typedef enum BtorOptBetaReduceMode BtorOptBetaReduceMode;
 
+enum BtorOptAIGCNF
+{
+  BTOR_AIG_CNF_TSEITIN,
+  BTOR_AIG_CNF_PG,
+  BTOR_AIG_CNF_CUT,
+};
+typedef enum BtorOptAIGCNF BtorOptAIGCNF;
+
 /* --------------------------------------------------------------------- */
 
 /* Callback function to be executed on abort, primarily intended to be used for
@@ -0,0 +1,112 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btordomains.h"
+
+#include "btorbvdomain.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorutil.h"
+
+static bool
+is_constraint (Btor *btor, BtorNode *exp)
+{
+  return btor_hashptr_table_get (btor->unsynthesized_constraints, exp)
+         || btor_hashptr_table_get (btor->synthesized_constraints, exp);
+}
+
+/* Note: Implied constants are not substituted in place, since the
+ *       constraints that imply them would be simplified away in the
+ *       process. Asserting them lets variable substitution and embedded
+ *       constraint processing do the actual simplification. */
+void
+btor_propagate_domains (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, num_constraints = 0;
+  double start, delta;
+  BtorMemMgr *mm;
+  BtorNode *cur, *c, *eq;
+  BtorNodePtrStack roots, new_assertions;
+  BtorIntHashTable *domains;
+  BtorIntHashTableIterator iit;
+  BtorPtrHashTableIterator it;
+  BtorBvDomain *d;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+
+  BTOR_INIT_STACK (mm, roots);
+  BTOR_INIT_STACK (mm, new_assertions);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (roots, btor_iter_hashptr_next (&it));
+
+  domains = btor_hashint_map_new (mm);
+  if (!btor_bvdomain_compute (btor, &roots, domains))
+  {
+    BTOR_MSG (btor->msg, 1, "domain propagation found inconsistency");
+    btor->inconsistent = true;
+    goto DONE;
+  }
+
+  btor_iter_hashint_init (&iit, domains);
+  while (btor_iter_hashint_has_next (&iit))
+  {
+    cur = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
+    assert (cur);
+    if (cur->parameterized || btor_node_is_bv_const (cur)) continue;
+    d = btor_bvdomain_get (mm, domains, cur);
+    if (btor_bvdomain_is_fixed (mm, d))
+    {
+      if (btor_node_is_bv_var (cur))
+      {
+        c  = btor_exp_bv_const (btor, d->lo);
+        eq = btor_exp_eq (btor, cur, c);
+        BTOR_PUSH_STACK (new_assertions, eq);
+        btor_node_release (btor, c);
+      }
+      else if (btor_node_bv_get_width (btor, cur) == 1)
+      {
+        c = btor_bv_is_true (d->lo) ? cur : btor_node_invert (cur);
+        if (!is_constraint (btor, c))
+          BTOR_PUSH_STACK (new_assertions, btor_node_copy (btor, c));
+      }
+    }
+    btor_bvdomain_free (mm, d);
+  }
+
+  num_constraints = BTOR_COUNT_STACK (new_assertions);
+  for (i = 0; i < num_constraints; i++)
+  {
+    cur = BTOR_PEEK_STACK (new_assertions, i);
+    BTORLOG (1, "found constraint (domains): %s", btor_util_node2string (cur));
+    btor_assert_exp (btor, cur);
+    btor_node_release (btor, cur);
+  }
+  btor->stats.domain_constraints += num_constraints;
+
+DONE:
+  btor_bvdomain_delete_map (mm, domains);
+  BTOR_RELEASE_STACK (new_assertions);
+  BTOR_RELEASE_STACK (roots);
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.domains += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "domain propagation produced %u new constraints in %.1f seconds",
+            btor->inconsistent ? 0 : num_constraints,
+            delta);
+}
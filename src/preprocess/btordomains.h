@@ -0,0 +1,20 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORDOMAINS_H_INCLUDED
+#define BTORDOMAINS_H_INCLUDED
+
+#include "btortypes.h"
+
+/**
+ * Propagate known bits and unsigned intervals over the constraints and add
+ * the implied constants of variables and Boolean terms as new constraints.
+ */
+void btor_propagate_domains (Btor *btor);
+
+#endif
@@ -112,6 +112,7 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   double start, delta;
   BtorMemMgr *mm;
   uint32_t vals[4];
+  bool incremental;
 
   assert (btor != NULL);
 
@@ -120,15 +121,28 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
 
   BTORLOG (1, "start slice elimination");
 
-  mm = btor->mm;
+  mm          = btor->mm;
+  incremental = btor_opt_get (btor, BTOR_OPT_INCREMENTAL);
   BTOR_INIT_STACK (mm, vars);
   for (b_var = btor->bv_vars->first; b_var != NULL; b_var = b_var->next)
   {
     if (b_var->data.flag) continue;
     var = (BtorNode *) b_var->key;
+    /* In incremental mode, variables that have already been bit-blasted or
+     * substituted are not split anymore. The equality 'var = concat (...)'
+     * asserted below is a definition and thus valid in all subsequent calls,
+     * independent of assumptions and push/pop. Variables without slices are
+     * only marked as processed after they have been bit-blasted, since
+     * constraints added in later calls may introduce slices on them. */
+    if (incremental
+        && (btor_node_is_synth (var) || btor_node_is_simplified (var)))
+    {
+      b_var->data.flag = true;
+      continue;
+    }
     BTOR_PUSH_STACK (vars, var);
     /* mark as processed, required for non-destructive substiution */
-    b_var->data.flag = true;
+    if (!incremental) b_var->data.flag = true;
   }
 
   while (!BTOR_EMPTY_STACK (vars))
@@ -174,6 +188,13 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
       continue;
     }
 
+    if (incremental)
+    {
+      b_var = btor_hashptr_table_get (btor->bv_vars, var);
+      assert (b_var);
+      b_var->data.flag = true;
+    }
+
     /* add full slice */
     s1 = new_slice (btor, btor_node_bv_get_width (btor, var) - 1, 0);
     assert (!btor_hashptr_table_get (slices, s1));
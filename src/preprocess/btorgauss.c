@@ -0,0 +1,651 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorgauss.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorutil.h"
+
+/* maximum number of nodes visited while decomposing a constraint */
+#define BTOR_GAUSS_MAX_VISIT 10000
+/* maximum number of 64-bit words of a coefficient matrix */
+#define BTOR_GAUSS_MAX_WORDS (1u << 22)
+
+/* The constraints 'roots' (at most two) imply 'a_1 ^ ... ^ a_n = rhs',
+ * where the summands 'a_i' are distinct regular non-XOR terms of the same
+ * width. */
+struct BtorXorEquation
+{
+  BtorNode *roots[2];
+  BtorNodePtrStack atoms;
+  BtorBitVector *rhs;
+};
+
+typedef struct BtorXorEquation BtorXorEquation;
+
+BTOR_DECLARE_STACK (BtorXorEquationPtr, BtorXorEquation *);
+
+/*------------------------------------------------------------------------*/
+
+/* 'exp' = ~(a & b) & ~(~a & ~b), which is how XOR and XNOR are created. */
+static bool
+is_xor (BtorNode *exp, BtorNode **a, BtorNode **b)
+{
+  assert (btor_node_is_regular (exp));
+
+  BtorNode *l, *r;
+
+  if (!btor_node_is_bv_and (exp) || !btor_node_is_inverted (exp->e[0])
+      || !btor_node_is_inverted (exp->e[1]))
+    return false;
+  l = btor_node_real_addr (exp->e[0]);
+  r = btor_node_real_addr (exp->e[1]);
+  if (!btor_node_is_bv_and (l) || !btor_node_is_bv_and (r)) return false;
+  if ((l->e[0] == btor_node_invert (r->e[0])
+       && l->e[1] == btor_node_invert (r->e[1]))
+      || (l->e[0] == btor_node_invert (r->e[1])
+          && l->e[1] == btor_node_invert (r->e[0])))
+  {
+    *a = l->e[0];
+    *b = l->e[1];
+    return true;
+  }
+  return false;
+}
+
+/* Returns 'a & b' if constraint 'root' is 'a & b = 0'. */
+static BtorNode *
+get_zero_and (Btor *btor, BtorNode *root)
+{
+  BtorNode *real_root = btor_node_real_addr (root);
+
+  if (btor_node_is_inverted (root) && btor_node_is_bv_and (real_root))
+    return real_root;
+  if (btor_node_is_inverted (root) || !btor_node_is_bv_eq (root)) return 0;
+  if (btor_node_is_regular (root->e[0]) && btor_node_is_bv_and (root->e[0])
+      && btor_node_is_bv_const_zero (btor, root->e[1]))
+    return root->e[0];
+  if (btor_node_is_regular (root->e[1]) && btor_node_is_bv_and (root->e[1])
+      && btor_node_is_bv_const_zero (btor, root->e[0]))
+    return root->e[1];
+  return 0;
+}
+
+static void
+delete_equation (Btor *btor, BtorXorEquation *eq)
+{
+  btor_bv_free (btor->mm, eq->rhs);
+  BTOR_RELEASE_STACK (eq->atoms);
+  BTOR_DELETE (btor->mm, eq);
+}
+
+/* Decompose 'e0 ^ e1 = rhs' into a sum of atoms, where inverted terms and
+ * 1-bit equalities contribute constant summands. Takes ownership of 'rhs'.
+ * Returns 0 if no XOR terms were found and 'num_xors' is 0. */
+static BtorXorEquation *
+decompose (Btor *btor,
+           BtorNode *roots[2],
+           BtorNode *e0,
+           BtorNode *e1,
+           BtorBitVector *rhs,
+           uint32_t num_xors)
+{
+  uint32_t i, num_visited;
+  BtorNode *cur, *a, *b;
+  BtorNodePtrStack visit, atoms;
+  BtorIntHashTable *parity;
+  BtorBitVector *tmp, *ones;
+  BtorXorEquation *res;
+  BtorMemMgr *mm;
+
+  mm  = btor->mm;
+  res = 0;
+
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, atoms);
+  BTOR_PUSH_STACK (visit, e0);
+  if (e1) BTOR_PUSH_STACK (visit, e1);
+  ones   = btor_bv_ones (mm, btor_bv_get_width (rhs));
+  parity = btor_hashint_table_new (mm);
+
+  num_visited = 0;
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    if (++num_visited > BTOR_GAUSS_MAX_VISIT)
+    {
+      num_xors = 0;
+      break;
+    }
+    cur = BTOR_POP_STACK (visit);
+    if (btor_node_is_inverted (cur))
+    {
+      tmp = btor_bv_xor (mm, rhs, ones);
+      btor_bv_free (mm, rhs);
+      rhs = tmp;
+      cur = btor_node_real_addr (cur);
+    }
+
+    if (btor_node_is_bv_const (cur))
+    {
+      tmp = btor_bv_xor (mm, rhs, btor_node_bv_const_get_bits (cur));
+      btor_bv_free (mm, rhs);
+      rhs = tmp;
+    }
+    else if (is_xor (cur, &a, &b))
+    {
+      BTOR_PUSH_STACK (visit, a);
+      BTOR_PUSH_STACK (visit, b);
+      num_xors++;
+    }
+    else if (btor_node_is_bv_eq (cur)
+             && btor_node_bv_get_width (btor, cur->e[0]) == 1)
+    {
+      /* a = b is a ^ b ^ 1 */
+      assert (btor_bv_get_width (rhs) == 1);
+      tmp = btor_bv_xor (mm, rhs, ones);
+      btor_bv_free (mm, rhs);
+      rhs = tmp;
+      BTOR_PUSH_STACK (visit, cur->e[0]);
+      BTOR_PUSH_STACK (visit, cur->e[1]);
+      num_xors++;
+    }
+    else if (btor_hashint_table_contains (parity, cur->id))
+      btor_hashint_table_remove (parity, cur->id);
+    else
+    {
+      btor_hashint_table_add (parity, cur->id);
+      BTOR_PUSH_STACK (atoms, cur);
+    }
+  }
+
+  if (num_xors > 0)
+  {
+    BTOR_NEW (mm, res);
+    res->roots[0] = roots[0];
+    res->roots[1] = roots[1];
+    res->rhs      = rhs;
+    rhs           = 0;
+    BTOR_INIT_STACK (mm, res->atoms);
+    /* atoms that occur an even number of times cancel out */
+    for (i = 0; i < BTOR_COUNT_STACK (atoms); i++)
+    {
+      cur = BTOR_PEEK_STACK (atoms, i);
+      if (!btor_hashint_table_contains (parity, cur->id)) continue;
+      btor_hashint_table_remove (parity, cur->id);
+      BTOR_PUSH_STACK (res->atoms, cur);
+    }
+    qsort (res->atoms.start,
+           BTOR_COUNT_STACK (res->atoms),
+           sizeof (BtorNode *),
+           btor_node_compare_by_id_qsort_asc);
+  }
+
+  if (rhs) btor_bv_free (mm, rhs);
+  btor_bv_free (mm, ones);
+  btor_hashint_table_delete (parity);
+  BTOR_RELEASE_STACK (atoms);
+  BTOR_RELEASE_STACK (visit);
+  return res;
+}
+
+/* 'e0 = e1' is 'e0 ^ e1 = 0', any other 1-bit constraint 'c' is 'c = 1'. */
+static BtorXorEquation *
+extract_equation (Btor *btor, BtorNode *root)
+{
+  BtorNode *roots[2] = {root, 0};
+
+  if (!btor_sort_is_bv (btor, btor_node_get_sort_id (root))) return 0;
+  if (btor_node_is_regular (root) && btor_node_is_bv_eq (root)
+      && btor_node_bv_get_width (btor, root->e[0]) > 1)
+    return decompose (
+        btor,
+        roots,
+        root->e[0],
+        root->e[1],
+        btor_bv_new (btor->mm, btor_node_bv_get_width (btor, root->e[0])),
+        0);
+  return decompose (btor, roots, root, 0, btor_bv_one (btor->mm, 1), 0);
+}
+
+/* The rewriter splits 'a ^ b = ~0' into 'a & b = 0' and '~a & ~b = 0'.
+ * Returns the equation 'a ^ b = ~0' if the constraint 'root' is one half of
+ * such a pair, and the other half is found in 'zero_ands'. */
+static BtorXorEquation *
+extract_split_equation (Btor *btor,
+                        BtorNode *root,
+                        BtorIntHashTable *zero_ands,
+                        BtorIntHashTable *used)
+{
+  BtorNode *and, *other, *a, *b, *roots[2];
+  BtorNodeIterator it;
+  BtorHashTableData *d;
+
+  if (!(and = get_zero_and (btor, root))) return 0;
+  a = and->e[0];
+  b = and->e[1];
+  btor_iter_parent_init (&it, btor_node_real_addr (a));
+  while (btor_iter_parent_has_next (&it))
+  {
+    other = btor_iter_parent_next (&it);
+    if (other == and || !btor_node_is_bv_and (other)) continue;
+    if (!(other->e[0] == btor_node_invert (a)
+          && other->e[1] == btor_node_invert (b))
+        && !(other->e[0] == btor_node_invert (b)
+             && other->e[1] == btor_node_invert (a)))
+      continue;
+    d = btor_hashint_map_get (zero_ands, other->id);
+    if (!d
+        || btor_hashint_table_contains (
+            used, btor_node_real_addr (d->as_ptr)->id))
+      continue;
+    roots[0] = root;
+    roots[1] = d->as_ptr;
+    return decompose (btor,
+                      roots,
+                      a,
+                      b,
+                      btor_bv_ones (btor->mm, btor_node_bv_get_width (btor, a)),
+                      1);
+  }
+  return 0;
+}
+
+static int32_t
+compare_equations_by_width (const void *p, const void *q)
+{
+  BtorXorEquation *a = *(BtorXorEquation **) p;
+  BtorXorEquation *b = *(BtorXorEquation **) q;
+  uint32_t wa        = btor_bv_get_width (a->rhs);
+  uint32_t wb        = btor_bv_get_width (b->rhs);
+  if (wa != wb) return wa < wb ? -1 : 1;
+  return btor_node_real_addr (a->roots[0])->id
+         - btor_node_real_addr (b->roots[0])->id;
+}
+
+/* Variables in the cone of non-variable atoms can not be solved without
+ * introducing cyclic substitutions. */
+static void
+collect_blocked_vars (Btor *btor,
+                      BtorXorEquationPtrStack *eqs,
+                      BtorIntHashTable *blocked)
+{
+  uint32_t i, j;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+  BtorXorEquation *eq;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  cache = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*eqs); i++)
+  {
+    eq = BTOR_PEEK_STACK (*eqs, i);
+    for (j = 0; j < BTOR_COUNT_STACK (eq->atoms); j++)
+    {
+      cur = BTOR_PEEK_STACK (eq->atoms, j);
+      if (!btor_node_is_bv_var (cur)) BTOR_PUSH_STACK (visit, cur);
+    }
+  }
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (btor_node_is_bv_var (cur)) btor_hashint_table_add (blocked, cur->id);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
+}
+
+static bool
+is_solvable (BtorNode *exp, BtorIntHashTable *blocked)
+{
+  return btor_node_is_bv_var (exp) && !btor_node_is_synth (exp)
+         && !btor_hashint_table_contains (blocked, exp->id);
+}
+
+/* Create 'atoms[0] ^ ... ^ atoms[n-1] ^ rhs'. */
+static BtorNode *
+mk_sum (Btor *btor, BtorNodePtrStack *atoms, BtorBitVector *rhs)
+{
+  uint32_t i;
+  BtorNode *res, *tmp, *c;
+
+  res = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (*atoms); i++)
+  {
+    if (!res)
+      res = btor_node_copy (btor, BTOR_PEEK_STACK (*atoms, i));
+    else
+    {
+      tmp = btor_exp_bv_xor (btor, res, BTOR_PEEK_STACK (*atoms, i));
+      btor_node_release (btor, res);
+      res = tmp;
+    }
+  }
+  if (!res) return btor_exp_bv_const (btor, rhs);
+  if (btor_bv_is_ones (rhs)) return btor_node_invert (res);
+  if (!btor_bv_is_zero (rhs))
+  {
+    c   = btor_exp_bv_const (btor, rhs);
+    tmp = btor_exp_bv_xor (btor, res, c);
+    btor_node_release (btor, c);
+    btor_node_release (btor, res);
+    res = tmp;
+  }
+  return res;
+}
+
+/* Collect the atoms with a non-zero coefficient in 'row' except for
+ * column 'skip'. */
+static void
+collect_row_atoms (BtorNodePtrStack *cols,
+                   uint64_t *row,
+                   uint32_t skip,
+                   BtorNodePtrStack *atoms)
+{
+  uint32_t i;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*cols); i++)
+    if (i != skip && (row[i / 64] & ((uint64_t) 1 << (i % 64))))
+      BTOR_PUSH_STACK (*atoms, BTOR_PEEK_STACK (*cols, i));
+}
+
+/* Solve the system of 'm' equations of the same width by Gauss-Jordan
+ * elimination over bit-packed rows. Columns of solvable variables precede
+ * all other columns, such that each pivot variable is expressed in terms of
+ * free variables and atoms. Returns the number of substituted variables.
+ * Equations without pivot are added to 'residual'. */
+static uint32_t
+eliminate (Btor *btor,
+           BtorXorEquation **eqs,
+           uint32_t m,
+           BtorIntHashTable *blocked,
+           BtorXorEquationPtrStack *residual)
+{
+  uint32_t i, j, k, n, w, nwords, ncand, rank, *pivots;
+  uint64_t *matrix, *row, *prow, bit, tmpw;
+  BtorNode *cur, *subst, *c;
+  BtorNodePtrStack cols, atoms;
+  BtorIntHashTable *idx;
+  BtorHashTableData *d;
+  BtorBitVector **rhs, *tmp;
+  BtorXorEquation *eq;
+  BtorMemMgr *mm;
+
+  mm   = btor->mm;
+  rank = 0;
+  BTOR_INIT_STACK (mm, cols);
+  BTOR_INIT_STACK (mm, atoms);
+  idx = btor_hashint_map_new (mm);
+
+  /* solvable variables first */
+  for (i = 0; i < m; i++)
+    for (j = 0; j < BTOR_COUNT_STACK (eqs[i]->atoms); j++)
+    {
+      cur = BTOR_PEEK_STACK (eqs[i]->atoms, j);
+      if (!is_solvable (cur, blocked)
+          || btor_hashint_map_contains (idx, cur->id))
+        continue;
+      btor_hashint_map_add (idx, cur->id)->as_int = BTOR_COUNT_STACK (cols);
+      BTOR_PUSH_STACK (cols, cur);
+    }
+  ncand = BTOR_COUNT_STACK (cols);
+  if (ncand == 0) goto DONE;
+  for (i = 0; i < m; i++)
+    for (j = 0; j < BTOR_COUNT_STACK (eqs[i]->atoms); j++)
+    {
+      cur = BTOR_PEEK_STACK (eqs[i]->atoms, j);
+      if (btor_hashint_map_contains (idx, cur->id)) continue;
+      btor_hashint_map_add (idx, cur->id)->as_int = BTOR_COUNT_STACK (cols);
+      BTOR_PUSH_STACK (cols, cur);
+    }
+
+  n      = BTOR_COUNT_STACK (cols);
+  nwords = (n + 63) / 64;
+  if ((uint64_t) m * nwords > BTOR_GAUSS_MAX_WORDS) goto DONE;
+
+  BTOR_CNEWN (mm, matrix, m * nwords);
+  BTOR_NEWN (mm, rhs, m);
+  BTOR_NEWN (mm, pivots, m);
+  for (i = 0; i < m; i++)
+  {
+    row    = matrix + i * nwords;
+    rhs[i] = btor_bv_copy (mm, eqs[i]->rhs);
+    for (j = 0; j < BTOR_COUNT_STACK (eqs[i]->atoms); j++)
+    {
+      d = btor_hashint_map_get (idx, BTOR_PEEK_STACK (eqs[i]->atoms, j)->id);
+      row[d->as_int / 64] |= (uint64_t) 1 << (d->as_int % 64);
+    }
+  }
+
+  for (j = 0; j < ncand && rank < m; j++)
+  {
+    w   = j / 64;
+    bit = (uint64_t) 1 << (j % 64);
+    for (i = rank; i < m && !(matrix[i * nwords + w] & bit); i++)
+      ;
+    if (i == m) continue;
+
+    /* all rows from 'rank' on are zero in the columns before 'j' */
+    prow = matrix + rank * nwords;
+    if (i != rank)
+    {
+      row = matrix + i * nwords;
+      for (k = w; k < nwords; k++)
+      {
+        tmpw    = row[k];
+        row[k]  = prow[k];
+        prow[k] = tmpw;
+      }
+      tmp       = rhs[i];
+      rhs[i]    = rhs[rank];
+      rhs[rank] = tmp;
+    }
+    for (i = 0; i < m; i++)
+    {
+      row = matrix + i * nwords;
+      if (i == rank || !(row[w] & bit)) continue;
+      for (k = w; k < nwords; k++) row[k] ^= prow[k];
+      tmp = btor_bv_xor (mm, rhs[i], rhs[rank]);
+      btor_bv_free (mm, rhs[i]);
+      rhs[i] = tmp;
+    }
+    pivots[rank++] = j;
+  }
+
+  if (rank > 0)
+  {
+    for (i = 0; i < rank; i++)
+    {
+      cur = BTOR_PEEK_STACK (cols, pivots[i]);
+      BTOR_RESET_STACK (atoms);
+      collect_row_atoms (&cols, matrix + i * nwords, pivots[i], &atoms);
+      subst = mk_sum (btor, &atoms, rhs[i]);
+      BTORLOG (1,
+               "gauss: %s -> %s",
+               btor_util_node2string (cur),
+               btor_util_node2string (subst));
+      btor_insert_substitution (btor, cur, subst, false);
+      btor_node_release (btor, subst);
+    }
+
+    /* Residual equations are created after the substitution, as the
+     * constraints of the system would simplify them to true before. */
+    for (i = rank; i < m && !btor->inconsistent; i++)
+    {
+      row = matrix + i * nwords;
+      for (k = 0; k < nwords && !row[k]; k++)
+        ;
+      if (k < nwords)
+      {
+        BTOR_NEW (mm, eq);
+        eq->roots[0] = eq->roots[1] = 0;
+        eq->rhs  = btor_bv_copy (mm, rhs[i]);
+        BTOR_INIT_STACK (mm, eq->atoms);
+        collect_row_atoms (&cols, row, n, &eq->atoms);
+        for (j = 0; j < BTOR_COUNT_STACK (eq->atoms); j++)
+          btor_node_copy (btor, BTOR_PEEK_STACK (eq->atoms, j));
+        BTOR_PUSH_STACK (*residual, eq);
+      }
+      else if (!btor_bv_is_zero (rhs[i]))
+        btor->inconsistent = true;
+    }
+
+    /* the constraints of the system are implied by the substitutions and the
+     * residual equations */
+    for (i = 0; i < m; i++)
+      for (j = 0; j < 2 && eqs[i]->roots[j]; j++)
+      {
+        cur = btor_node_real_addr (eqs[i]->roots[j]);
+        if (btor_hashptr_table_get (btor->substitutions, cur)) continue;
+        c = btor_node_is_inverted (eqs[i]->roots[j]) ? btor_exp_false (btor)
+                                                     : btor_exp_true (btor);
+        btor_insert_substitution (btor, cur, c, false);
+        btor_node_release (btor, c);
+      }
+  }
+
+  for (i = 0; i < m; i++) btor_bv_free (mm, rhs[i]);
+  BTOR_DELETEN (mm, pivots, m);
+  BTOR_DELETEN (mm, rhs, m);
+  BTOR_DELETEN (mm, matrix, m * nwords);
+DONE:
+  btor_hashint_map_delete (idx);
+  BTOR_RELEASE_STACK (atoms);
+  BTOR_RELEASE_STACK (cols);
+  return rank;
+}
+
+void
+btor_eliminate_xors (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j, k, num_eqs, num_vars;
+  double start, delta;
+  BtorMemMgr *mm;
+  BtorNode *cur, *and, *sum, *c;
+  BtorXorEquation *eq;
+  BtorXorEquationPtrStack eqs, residual;
+  BtorIntHashTable *blocked, *zero_ands, *used;
+  BtorPtrHashTableIterator it;
+
+  start     = btor_util_time_stamp ();
+  mm        = btor->mm;
+  num_eqs   = num_vars = 0;
+  blocked   = btor_hashint_table_new (mm);
+  zero_ands = btor_hashint_map_new (mm);
+  used      = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, eqs);
+  BTOR_INIT_STACK (mm, residual);
+
+  /* synthesized constraints are not rebuilt */
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if ((and = get_zero_and (btor, cur)))
+      btor_hashint_map_add (zero_ands, and->id)->as_ptr = cur;
+  }
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor_hashint_table_contains (used, btor_node_real_addr (cur)->id))
+      continue;
+    if ((eq = extract_equation (btor, cur))
+        || (eq = extract_split_equation (btor, cur, zero_ands, used)))
+    {
+      for (i = 0; i < 2 && eq->roots[i]; i++)
+        btor_hashint_table_add (used, btor_node_real_addr (eq->roots[i])->id);
+      BTOR_PUSH_STACK (eqs, eq);
+    }
+  }
+  if (BTOR_EMPTY_STACK (eqs)) goto DONE;
+
+  qsort (eqs.start,
+         BTOR_COUNT_STACK (eqs),
+         sizeof (BtorXorEquation *),
+         compare_equations_by_width);
+  collect_blocked_vars (btor, &eqs, blocked);
+  btor_init_substitutions (btor);
+
+  for (i = 0; i < BTOR_COUNT_STACK (eqs) && !btor->inconsistent; i = j)
+  {
+    eq = BTOR_PEEK_STACK (eqs, i);
+    for (j = i + 1; j < BTOR_COUNT_STACK (eqs)
+                    && btor_bv_get_width (BTOR_PEEK_STACK (eqs, j)->rhs)
+                           == btor_bv_get_width (eq->rhs);
+         j++)
+      ;
+    if ((k = eliminate (btor, eqs.start + i, j - i, blocked, &residual)))
+    {
+      num_vars += k;
+      num_eqs += j - i;
+    }
+  }
+
+  if (btor->inconsistent)
+  {
+    BTOR_MSG (btor->msg, 1, "gaussian elimination found inconsistency");
+    btor_delete_substitutions (btor);
+    goto DONE;
+  }
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  for (i = 0; i < BTOR_COUNT_STACK (residual); i++)
+  {
+    eq  = BTOR_PEEK_STACK (residual, i);
+    sum = mk_sum (btor, &eq->atoms, eq->rhs);
+    c   = btor_exp_bv_zero (btor, btor_node_get_sort_id (sum));
+    cur = btor_exp_eq (btor, sum, c);
+    BTORLOG (1, "gauss: residual %s", btor_util_node2string (cur));
+    btor_assert_exp (btor, cur);
+    btor_node_release (btor, cur);
+    btor_node_release (btor, c);
+    btor_node_release (btor, sum);
+  }
+
+  btor->stats.xor_equations += num_eqs;
+  btor->stats.xor_substitutions += num_vars;
+
+DONE:
+  while (!BTOR_EMPTY_STACK (residual))
+  {
+    eq = BTOR_POP_STACK (residual);
+    for (i = 0; i < BTOR_COUNT_STACK (eq->atoms); i++)
+      btor_node_release (btor, BTOR_PEEK_STACK (eq->atoms, i));
+    delete_equation (btor, eq);
+  }
+  while (!BTOR_EMPTY_STACK (eqs)) delete_equation (btor, BTOR_POP_STACK (eqs));
+  BTOR_RELEASE_STACK (residual);
+  BTOR_RELEASE_STACK (eqs);
+  btor_hashint_table_delete (used);
+  btor_hashint_map_delete (zero_ands);
+  btor_hashint_table_delete (blocked);
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.gauss += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "solved %u variables in %u XOR equations in %.1f seconds",
+            num_vars,
+            num_eqs,
+            delta);
+}
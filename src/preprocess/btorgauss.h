@@ -0,0 +1,21 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORGAUSS_H_INCLUDED
+#define BTORGAUSS_H_INCLUDED
+
+#include "btortypes.h"
+
+/**
+ * Extract systems of linear equations over GF(2) (XOR constraints) from the
+ * top-level constraints, solve them by Gaussian elimination and substitute
+ * the solved variables.
+ */
+void btor_eliminate_xors (Btor *btor);
+
+#endif
@@ -15,14 +15,17 @@
 #include "btorsubst.h"
 #include "preprocess/btorack.h"
 #include "preprocess/btorder.h"
+#include "preprocess/btordomains.h"
 #include "preprocess/btorelimapplies.h"
 #include "preprocess/btorelimslices.h"
 #include "preprocess/btorembed.h"
 #include "preprocess/btorextract.h"
+#include "preprocess/btorgauss.h"
 #include "preprocess/btormerge.h"
 #include "preprocess/btornormadd.h"
 #include "preprocess/btorunconstrained.h"
 #include "preprocess/btorvarsubst.h"
+#include "preprocess/btorwidth.h"
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
 #include "preprocess/btorskel.h"
 #endif
@@ -49,6 +52,8 @@ btor_simplify (Btor *btor)
 
   if (btor->inconsistent) goto DONE;
 
+  if (BTOR_COUNT_STACK (btor->uc_terms)) btor_reconnect_unconstrained (btor);
+
   /* empty varsubst_constraints table if variable substitution was disabled
    * after adding variable substitution constraints (they are still in
    * unsynthesized_constraints).
@@ -103,8 +108,7 @@ btor_simplify (Btor *btor)
     }
 
     if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2)
     {
       btor_eliminate_slices_on_bv_vars (btor);
       if (btor->inconsistent)
@@ -123,7 +127,16 @@ btor_simplify (Btor *btor)
         && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
     {
       skelrounds++;
-      if (skelrounds <= 1)  // TODO only one?
+      /* Skeleton constraints are derived from (permanent) constraints only,
+       * hence constraints found in previous calls remain valid. This
+       * includes assertions of context levels > 0, which are permanent
+       * implications 'lit -> c' guarded by the activation literal 'lit' of
+       * their level (popping a level only adds '!lit'). Assumptions are not
+       * part of the skeleton. In incremental mode, new skeleton constraints
+       * can only be derived if constraints have been added since the last
+       * call. */
+      if (skelrounds <= 1  // TODO only one?
+          && btor->unsynthesized_constraints->count > 0)
       {
         btor_process_skeleton (btor);
         if (btor->inconsistent)
@@ -139,13 +152,44 @@ btor_simplify (Btor *btor)
     }
 #endif
 
+    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && btor_opt_get (btor, BTOR_OPT_BV_DOMAINS))
+    {
+      btor_propagate_domains (btor);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after domain propagation");
+        break;
+      }
+    }
+
+    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && btor_opt_get (btor, BTOR_OPT_REDUCE_WIDTHS))
+    {
+      btor_reduce_bv_widths (btor);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after bit-width reduction");
+        break;
+      }
+    }
+
+    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && btor_opt_get (btor, BTOR_OPT_ELIMINATE_XORS))
+    {
+      btor_eliminate_xors (btor);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after XOR elimination");
+        break;
+      }
+    }
+
     if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
       continue;
 
     if (btor_opt_get (btor, BTOR_OPT_UCOPT)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
-        && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2)
     {
       btor_optimize_unconstrained (btor);
       if (btor->inconsistent)
@@ -37,8 +37,8 @@ fixed_exp (Btor *btor, BtorNode *exp)
     res = -1;
   else
   {
+    if (!btor_aig_is_encoded (aig)) return 0;
     id = btor_aig_get_cnf_id (aig);
-    if (!id) return 0;
     smgr = btor_get_sat_mgr (btor);
     res  = btor_sat_fixed (smgr, id);
   }
@@ -12,6 +12,7 @@
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
+#include "btormodel.h"
 #include "btormsg.h"
 #include "btorsubst.h"
 #include "utils/btorhashint.h"
@@ -36,7 +37,35 @@ is_uc_write (BtorNode *cond)
 }
 
 static void
-mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
+record_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp, BtorNode *var)
+{
+  assert (btor_node_is_regular (exp));
+  assert (!exp->parameterized);
+
+  uint32_t i;
+  BtorUCTerm *ucterm;
+
+  BTOR_CNEW (btor->mm, ucterm);
+  ucterm->exp   = btor_node_copy (btor, exp);
+  ucterm->var   = btor_node_copy (btor, var);
+  ucterm->kind  = exp->kind;
+  ucterm->arity = exp->arity;
+  if (btor_node_is_bv_slice (exp))
+  {
+    ucterm->upper = btor_node_bv_slice_get_upper (exp);
+    ucterm->lower = btor_node_bv_slice_get_lower (exp);
+  }
+  for (i = 0; i < exp->arity; i++)
+  {
+    ucterm->e[i] = btor_node_copy (btor, exp->e[i]);
+    ucterm->uc[i] =
+        btor_hashint_table_contains (uc, btor_node_real_addr (exp->e[i])->id);
+  }
+  BTOR_PUSH_STACK (btor->uc_terms, ucterm);
+}
+
+static void
+mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp, bool record)
 {
   assert (btor_node_is_regular (exp));
   /* no inputs allowed here */
@@ -74,20 +103,26 @@ mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
     subst = btor_exp_var (btor, btor_node_get_sort_id (exp), 0);
 
   btor_insert_substitution (btor, exp, subst, false);
+  if (record) record_uc (btor, uc, exp, subst);
   btor_node_release (btor, subst);
 }
 
+static bool
+is_assumed (Btor *btor, BtorNode *exp)
+{
+  return btor_hashptr_table_get (btor->assumptions, exp)
+         || btor_hashptr_table_get (btor->assumptions, btor_node_invert (exp));
+}
+
 void
 btor_optimize_unconstrained (Btor *btor)
 {
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
-  assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
 
   double start, delta;
   uint32_t i, num_ucs;
-  bool uc[3], ucp[3];
+  bool uc[3], ucp[3], record;
   BtorNode *cur, *cur_parent;
   BtorNodePtrStack stack, roots;
   BtorPtrHashTableIterator it;
@@ -108,6 +143,14 @@ btor_optimize_unconstrained (Btor *btor)
   BTOR_INIT_STACK (mm, roots);
   uc[0] = uc[1] = uc[2] = ucp[0] = ucp[1] = ucp[2] = false;
 
+  /* In incremental mode and with model generation enabled, we only consider
+   * bit-vector terms over inputs that have not been bit-blasted yet. All
+   * eliminated terms are recorded for model reconstruction and for
+   * reconnecting them if their inputs get constrained by subsequent
+   * assertions or assumptions (see btor_reconnect_unconstrained). */
+  record = btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+           || btor_opt_get (btor, BTOR_OPT_MODEL_GEN);
+
   mark = btor_hashint_map_new (mm);
   ucs  = btor_hashint_table_new (mm);
   ucsp = btor_hashint_table_new (mm);
@@ -124,6 +167,11 @@ btor_optimize_unconstrained (Btor *btor)
 
     if (btor_node_is_simplified (cur)) continue;
 
+    if (record
+        && (btor_node_is_uf (cur) || btor_node_is_synth (cur)
+            || cur->constraint || is_assumed (btor, cur)))
+      continue;
+
     if (cur->parents == 1)
     {
       cur_parent = btor_node_real_addr (cur->first_parent);
@@ -188,7 +236,10 @@ btor_optimize_unconstrained (Btor *btor)
       btor_hashint_map_remove (mark, cur->id, 0);
 
       /* propagate unconstrained candidates */
-      if (cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+      if ((cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+          && (!record
+              || (!cur->parameterized && !btor_node_is_fun (cur)
+                  && !btor_node_is_apply (cur) && !btor_node_is_fun_eq (cur))))
       {
         for (i = 0; i < cur->arity; i++)
         {
@@ -209,17 +260,17 @@ btor_optimize_unconstrained (Btor *btor)
             {
               if (cur->parameterized)
               {
-                if (btor_node_is_apply (cur)) mark_uc (btor, ucsp, cur);
+                if (btor_node_is_apply (cur)) mark_uc (btor, ucsp, cur, false);
               }
               else
-                mark_uc (btor, ucs, cur);
+                mark_uc (btor, ucs, cur, record);
             }
             break;
           case BTOR_BV_ADD_NODE:
           case BTOR_BV_EQ_NODE:
           case BTOR_FUN_EQ_NODE:
             if (!cur->parameterized && (uc[0] || uc[1]))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, record);
             break;
           case BTOR_BV_ULT_NODE:
           case BTOR_BV_CONCAT_NODE:
@@ -229,19 +280,20 @@ btor_optimize_unconstrained (Btor *btor)
           case BTOR_BV_SRL_NODE:
           case BTOR_BV_UDIV_NODE:
           case BTOR_BV_UREM_NODE:
-            if (!cur->parameterized && uc[0] && uc[1]) mark_uc (btor, ucs, cur);
+            if (!cur->parameterized && uc[0] && uc[1])
+              mark_uc (btor, ucs, cur, record);
             break;
           case BTOR_COND_NODE:
             if ((uc[1] && uc[2]) || (uc[0] && (uc[1] || uc[2])))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, record);
             else if (uc[1] && ucp[2])
             {
               /* case: x = t ? uc : ucp */
-              if (is_uc_write (cur)) mark_uc (btor, ucsp, cur);
+              if (is_uc_write (cur)) mark_uc (btor, ucsp, cur, false);
             }
             break;
           case BTOR_UPDATE_NODE:
-            if (uc[0] && uc[2]) mark_uc (btor, ucs, cur);
+            if (uc[0] && uc[2]) mark_uc (btor, ucs, cur, record);
             break;
           // TODO (ma): functions with parents > 1 can still be
           //            handled as unconstrained, but the applications
@@ -253,7 +305,7 @@ btor_optimize_unconstrained (Btor *btor)
                 /* only consider head lambda of curried lambdas */
                 && (!cur->first_parent
                     || !btor_node_is_lambda (cur->first_parent)))
-              mark_uc (btor, ucs, cur);
+              mark_uc (btor, ucs, cur, record);
             break;
           default: break;
         }
@@ -284,3 +336,364 @@ btor_optimize_unconstrained (Btor *btor)
   assert (btor_dbg_check_all_hash_tables_simp_free (btor));
   assert (btor_dbg_check_unique_table_children_proxy_free (btor));
 }
+
+/*------------------------------------------------------------------------*/
+
+/* Map the ids of eliminated terms to their unconstrained term records. */
+static BtorIntHashTable *
+map_uc_terms (Btor *btor)
+{
+  uint32_t i;
+  BtorUCTerm *ucterm;
+  BtorIntHashTable *terms;
+
+  terms = btor_hashint_map_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->uc_terms); i++)
+  {
+    ucterm = BTOR_PEEK_STACK (btor->uc_terms, i);
+    btor_hashint_map_add (terms, ucterm->exp->id)->as_ptr = ucterm;
+  }
+  return terms;
+}
+
+/* Collect the ids of eliminated terms that occur as unconstrained child of
+ * another eliminated term. These are handled together with their parent. */
+static BtorIntHashTable *
+collect_inner_uc_terms (Btor *btor, BtorIntHashTable *terms)
+{
+  uint32_t i, j;
+  int32_t id;
+  BtorUCTerm *ucterm;
+  BtorIntHashTable *inner;
+
+  inner = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->uc_terms); i++)
+  {
+    ucterm = BTOR_PEEK_STACK (btor->uc_terms, i);
+    for (j = 0; j < ucterm->arity; j++)
+    {
+      id = btor_node_real_addr (ucterm->e[j])->id;
+      if (ucterm->uc[j] && btor_hashint_map_contains (terms, id))
+        btor_hashint_table_add (inner, id);
+    }
+  }
+  return inner;
+}
+
+static void
+delete_uc_term (Btor *btor, BtorUCTerm *ucterm)
+{
+  uint32_t i;
+
+  for (i = 0; i < ucterm->arity; i++) btor_node_release (btor, ucterm->e[i]);
+  btor_node_release (btor, ucterm->exp);
+  btor_node_release (btor, ucterm->var);
+  BTOR_DELETE (btor->mm, ucterm);
+}
+
+/* An input of an eliminated term (or the variable substituted for an inner
+ * eliminated term) is constrained if it got new parents, was asserted or
+ * assumed directly, or was substituted. */
+static bool
+is_constrained (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  return exp->parents > 0 || exp->constraint || is_assumed (btor, exp)
+         || btor_node_is_simplified (exp);
+}
+
+static bool
+is_uc_term_constrained (Btor *btor,
+                        BtorIntHashTable *terms,
+                        BtorUCTerm *ucterm)
+{
+  uint32_t i;
+  BtorNode *real_e;
+  BtorHashTableData *d;
+
+  for (i = 0; i < ucterm->arity; i++)
+  {
+    if (!ucterm->uc[i]) continue;
+    real_e = btor_node_real_addr (ucterm->e[i]);
+    if ((d = btor_hashint_map_get (terms, real_e->id)))
+    {
+      if (is_constrained (btor, ((BtorUCTerm *) d->as_ptr)->var)
+          || is_uc_term_constrained (btor, terms, d->as_ptr))
+        return true;
+    }
+    else if (is_constrained (btor, real_e))
+      return true;
+  }
+  return false;
+}
+
+/* Assert 'var = exp' for 'ucterm' and all its inner eliminated terms. */
+static void
+reconnect_uc_term (Btor *btor,
+                   BtorIntHashTable *terms,
+                   BtorIntHashTable *reconnected,
+                   BtorUCTerm *ucterm)
+{
+  uint32_t i;
+  BtorNode *exp, *eq;
+  BtorHashTableData *d;
+
+  for (i = 0; i < ucterm->arity; i++)
+  {
+    if (!ucterm->uc[i]) continue;
+    d = btor_hashint_map_get (terms, btor_node_real_addr (ucterm->e[i])->id);
+    if (d) reconnect_uc_term (btor, terms, reconnected, d->as_ptr);
+  }
+
+  BTORLOG (2,
+           "reconnect uc term %s with %s",
+           btor_util_node2string (ucterm->exp),
+           btor_util_node2string (ucterm->var));
+
+  if (ucterm->kind == BTOR_BV_SLICE_NODE)
+    exp = btor_exp_bv_slice (btor, ucterm->e[0], ucterm->upper, ucterm->lower);
+  else
+    exp = btor_exp_create (btor, ucterm->kind, ucterm->e, ucterm->arity);
+  eq = btor_exp_eq (btor, ucterm->var, exp);
+  btor_assert_exp (btor, eq);
+  btor_node_release (btor, eq);
+  btor_node_release (btor, exp);
+  btor_hashint_table_add (reconnected, ucterm->exp->id);
+  btor->stats.uc_reconnects++;
+}
+
+void
+btor_reconnect_unconstrained (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j;
+  BtorUCTerm *ucterm;
+  BtorIntHashTable *terms, *inner, *reconnected;
+
+  terms       = map_uc_terms (btor);
+  inner       = collect_inner_uc_terms (btor, terms);
+  reconnected = btor_hashint_table_new (btor->mm);
+
+  /* Reconnecting a term constrains the variable substituted for it, which
+   * may be an input of a term eliminated in a later call. Hence, we check
+   * the terms in the order they were eliminated. */
+  for (i = 0; i < BTOR_COUNT_STACK (btor->uc_terms); i++)
+  {
+    ucterm = BTOR_PEEK_STACK (btor->uc_terms, i);
+    if (btor_hashint_table_contains (inner, ucterm->exp->id)) continue;
+    if (is_uc_term_constrained (btor, terms, ucterm))
+      reconnect_uc_term (btor, terms, reconnected, ucterm);
+  }
+
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (btor->uc_terms); i++)
+  {
+    ucterm = BTOR_PEEK_STACK (btor->uc_terms, i);
+    if (btor_hashint_table_contains (reconnected, ucterm->exp->id))
+      delete_uc_term (btor, ucterm);
+    else
+    {
+      BTOR_POKE_STACK (btor->uc_terms, j, ucterm);
+      j++;
+    }
+  }
+  btor->uc_terms.top = btor->uc_terms.start + j;
+
+  btor_hashint_map_delete (terms);
+  btor_hashint_table_delete (inner);
+  btor_hashint_table_delete (reconnected);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+set_model_value (Btor *btor, BtorNode *exp, const BtorBitVector *bv)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (btor_hashint_map_contains (btor->bv_model, exp->id))
+    btor_model_remove_from_bv (btor, btor->bv_model, exp);
+  btor_model_add_to_bv (btor, btor->bv_model, exp, bv);
+}
+
+static void reconstruct_uc_term (Btor *btor,
+                                 BtorIntHashTable *terms,
+                                 BtorUCTerm *ucterm,
+                                 const BtorBitVector *value);
+
+/* Assign 'value' to unconstrained child 'exp' of an eliminated term. */
+static void
+assign_uc (Btor *btor,
+           BtorIntHashTable *terms,
+           BtorNode *exp,
+           const BtorBitVector *value)
+{
+  BtorNode *real_exp;
+  BtorBitVector *bv;
+  BtorHashTableData *d;
+
+  real_exp = btor_node_real_addr (exp);
+  bv       = btor_node_is_inverted (exp) ? btor_bv_not (btor->mm, value)
+                                   : btor_bv_copy (btor->mm, value);
+  if ((d = btor_hashint_map_get (terms, real_exp->id)))
+  {
+    set_model_value (btor, ((BtorUCTerm *) d->as_ptr)->var, bv);
+    reconstruct_uc_term (btor, terms, d->as_ptr, bv);
+  }
+  else
+    set_model_value (btor, real_exp, bv);
+  btor_bv_free (btor->mm, bv);
+}
+
+/* Determine values for the unconstrained children of 'ucterm' such that it
+ * evaluates to 'value' under the current model. */
+static void
+reconstruct_uc_term (Btor *btor,
+                     BtorIntHashTable *terms,
+                     BtorUCTerm *ucterm,
+                     const BtorBitVector *value)
+{
+  uint32_t i, w;
+  BtorMemMgr *mm;
+  BtorBitVector *bv[3], *tmp;
+
+  mm = btor->mm;
+  for (i = 0; i < ucterm->arity; i++)
+    bv[i] = btor_bv_copy (mm,
+                          btor_model_get_bv_aux (btor,
+                                                 btor->bv_model,
+                                                 btor->fun_model,
+                                                 ucterm->e[i]));
+
+#define SET_BV(i, val)           \
+  do                             \
+  {                              \
+    BtorBitVector *_bv = (val);  \
+    btor_bv_free (mm, bv[i]);    \
+    bv[i] = _bv;                 \
+  } while (0)
+
+  switch (ucterm->kind)
+  {
+    case BTOR_BV_SLICE_NODE:
+      w   = btor_bv_get_width (bv[0]);
+      tmp = btor_bv_uext (mm, value, w - btor_bv_get_width (value));
+      SET_BV (0, btor_bv_sll_uint64 (mm, tmp, ucterm->lower));
+      btor_bv_free (mm, tmp);
+      break;
+    case BTOR_BV_ADD_NODE:
+      if (ucterm->uc[0])
+        SET_BV (0, btor_bv_sub (mm, value, bv[1]));
+      else
+        SET_BV (1, btor_bv_sub (mm, value, bv[0]));
+      break;
+    case BTOR_BV_EQ_NODE:
+      i = ucterm->uc[0] ? 0 : 1;
+      SET_BV (i,
+              btor_bv_is_true (value) ? btor_bv_copy (mm, bv[1 - i])
+                                      : btor_bv_not (mm, bv[1 - i]));
+      break;
+    case BTOR_BV_ULT_NODE:
+      w = btor_bv_get_width (bv[0]);
+      SET_BV (0, btor_bv_new (mm, w));
+      SET_BV (1,
+              btor_bv_is_true (value) ? btor_bv_one (mm, w)
+                                      : btor_bv_new (mm, w));
+      break;
+    case BTOR_BV_CONCAT_NODE:
+      w = btor_bv_get_width (bv[1]);
+      SET_BV (
+          0,
+          btor_bv_slice (mm, value, btor_bv_get_width (value) - 1, w));
+      SET_BV (1, btor_bv_slice (mm, value, w - 1, 0));
+      break;
+    case BTOR_BV_AND_NODE:
+      SET_BV (0, btor_bv_copy (mm, value));
+      SET_BV (1, btor_bv_ones (mm, btor_bv_get_width (bv[1])));
+      break;
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+      SET_BV (0, btor_bv_copy (mm, value));
+      SET_BV (1, btor_bv_one (mm, btor_bv_get_width (bv[1])));
+      break;
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UREM_NODE:
+      SET_BV (0, btor_bv_copy (mm, value));
+      SET_BV (1, btor_bv_new (mm, btor_bv_get_width (bv[1])));
+      break;
+    default:
+      assert (ucterm->kind == BTOR_COND_NODE);
+      if (ucterm->uc[1] && ucterm->uc[2])
+      {
+        SET_BV (1, btor_bv_copy (mm, value));
+        SET_BV (2, btor_bv_copy (mm, value));
+      }
+      else if (ucterm->uc[1])
+      {
+        SET_BV (0, btor_bv_one (mm, 1));
+        SET_BV (1, btor_bv_copy (mm, value));
+      }
+      else
+      {
+        assert (ucterm->uc[2]);
+        SET_BV (0, btor_bv_new (mm, 1));
+        SET_BV (2, btor_bv_copy (mm, value));
+      }
+  }
+#undef SET_BV
+
+  for (i = 0; i < ucterm->arity; i++)
+  {
+    if (ucterm->uc[i]) assign_uc (btor, terms, ucterm->e[i], bv[i]);
+    btor_bv_free (mm, bv[i]);
+  }
+}
+
+void
+btor_reconstruct_unconstrained_model (Btor *btor)
+{
+  assert (btor);
+  assert (btor->bv_model);
+  assert (btor->fun_model);
+
+  uint32_t i;
+  double start;
+  BtorUCTerm *ucterm;
+  BtorBitVector *value;
+  BtorIntHashTable *terms, *inner;
+
+  if (BTOR_EMPTY_STACK (btor->uc_terms)) return;
+
+  start = btor_util_time_stamp ();
+  terms = map_uc_terms (btor);
+  inner = collect_inner_uc_terms (btor, terms);
+
+  /* The variable substituted for a term may be an input of a term that was
+   * eliminated in a later call, hence we reconstruct in reverse order. */
+  for (i = BTOR_COUNT_STACK (btor->uc_terms); i > 0; i--)
+  {
+    ucterm = BTOR_PEEK_STACK (btor->uc_terms, i - 1);
+    if (btor_hashint_table_contains (inner, ucterm->exp->id)) continue;
+    value = btor_bv_copy (
+        btor->mm,
+        btor_model_get_bv_aux (
+            btor, btor->bv_model, btor->fun_model, ucterm->var));
+    reconstruct_uc_term (btor, terms, ucterm, value);
+    btor_bv_free (btor->mm, value);
+  }
+
+  btor_hashint_map_delete (terms);
+  btor_hashint_table_delete (inner);
+  btor->time.model_gen += btor_util_time_stamp () - start;
+}
+
+void
+btor_delete_unconstrained_terms (Btor *btor)
+{
+  assert (btor);
+
+  while (!BTOR_EMPTY_STACK (btor->uc_terms))
+    delete_uc_term (btor, BTOR_POP_STACK (btor->uc_terms));
+  BTOR_RELEASE_STACK (btor->uc_terms);
+}
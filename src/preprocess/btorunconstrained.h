@@ -9,8 +9,31 @@
 #ifndef BTORUNCONSTRAINED_H_INCLUDED
 #define BTORUNCONSTRAINED_H_INCLUDED
 
+#include "btornode.h"
 #include "btortypes.h"
 
+/* Unconstrained term that has been substituted by a fresh variable in
+ * incremental mode or with model generation enabled. */
+struct BtorUCTerm
+{
+  BtorNode* exp;         /* eliminated term (proxy after substitution) */
+  BtorNode* var;         /* fresh variable substituted for 'exp' */
+  BtorNode* e[3];        /* children of 'exp' */
+  bool uc[3];            /* unconstrained children */
+  BtorNodeKind kind;     /* kind of 'exp' */
+  uint32_t arity;        /* arity of 'exp' */
+  uint32_t upper, lower; /* bounds of 'exp' if it is a slice */
+};
+
 void btor_optimize_unconstrained (Btor* btor);
 
+/* Restore the definition of eliminated unconstrained terms whose inputs have
+ * been used in new constraints or assumptions since they were eliminated. */
+void btor_reconnect_unconstrained (Btor* btor);
+
+/* Assign the inputs of eliminated unconstrained terms in the current model. */
+void btor_reconstruct_unconstrained_model (Btor* btor);
+
+void btor_delete_unconstrained_terms (Btor* btor);
+
 #endif
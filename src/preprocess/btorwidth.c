@@ -0,0 +1,602 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorwidth.h"
+
+#include "btorbv.h"
+#include "btorbvdomain.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btormsg.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorutil.h"
+
+/* A bit-vector term of width w is a zero-extended 'ku'-bit value if its
+ * upper w - ku bits are 0, and a sign-extended 'ks'-bit value if its upper
+ * w - ks + 1 bits are equal. Every zero-extended 'ku'-bit value is a
+ * sign-extended (ku + 1)-bit value. */
+struct BtorWidthInfo
+{
+  uint32_t ku;
+  uint32_t ks;
+};
+
+typedef struct BtorWidthInfo BtorWidthInfo;
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_bv_term (Btor *btor, BtorNode *exp)
+{
+  exp = btor_node_real_addr (exp);
+  return !exp->parameterized && btor_sort_is_bv (btor, exp->sort_id);
+}
+
+/* Collect bit-vector terms reachable from given roots in ascending id order,
+ * i.e., children before their parents. */
+static void
+collect_terms (Btor *btor, BtorNodePtrStack *roots, BtorNodePtrStack *terms)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  cache = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (*roots, i));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (!is_bv_term (btor, cur) || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+    BTOR_PUSH_STACK (*terms, cur);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  qsort (terms->start,
+         BTOR_COUNT_STACK (*terms),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
+}
+
+static BtorNode *
+low_bits (Btor *btor, BtorNode *exp, uint32_t k)
+{
+  if (btor_node_bv_get_width (btor, exp) == k)
+    return btor_node_copy (btor, exp);
+  return btor_exp_bv_slice (btor, exp, k - 1, 0);
+}
+
+/*------------------------------------------------------------------------*/
+/* Zero-/sign-extended operands                                           */
+/*------------------------------------------------------------------------*/
+
+static void
+get_info (Btor *btor,
+          BtorIntHashTable *infos,
+          BtorNode *exp,
+          uint32_t *ku,
+          uint32_t *ks)
+{
+  uint32_t w;
+  BtorHashTableData *d;
+  BtorWidthInfo *info;
+
+  w = btor_node_bv_get_width (btor, exp);
+  d = btor_hashint_map_get (infos, btor_node_real_addr (exp)->id);
+  if (!d)
+  {
+    *ku = *ks = w;
+    return;
+  }
+  info = d->as_ptr;
+  /* ~x is a sign-extended value if x is, but never a zero-extended value
+   * (except for x = ~0, which is folded by rewriting). */
+  *ku = btor_node_is_inverted (exp) ? w : info->ku;
+  *ks = info->ks;
+}
+
+/* Check if 'sign' is bit-vector 'exp[msb:msb]' (returns 1), its negation
+ * (returns -1), or neither of both (returns 0). */
+static int32_t
+is_sign_bit (Btor *btor, BtorNode *sign, BtorNode *exp)
+{
+  uint32_t msb;
+  bool inv;
+  BtorNode *real_sign;
+
+  real_sign = btor_node_real_addr (sign);
+  msb       = btor_node_bv_get_width (btor, exp) - 1;
+  if (!btor_node_is_bv_slice (real_sign)
+      || btor_node_bv_slice_get_upper (real_sign) != msb
+      || btor_node_bv_slice_get_lower (real_sign) != msb
+      || btor_node_real_addr (real_sign->e[0]) != btor_node_real_addr (exp))
+    return 0;
+  inv = btor_node_is_inverted (sign) ^ btor_node_is_inverted (real_sign->e[0])
+        ^ btor_node_is_inverted (exp);
+  return inv ? -1 : 1;
+}
+
+/* Check if 'hi' replicates the sign bit of 'lo', i.e., if concat(hi, lo)
+ * was created via btor_exp_bv_sext. */
+static bool
+is_sign_extension (Btor *btor, BtorNode *hi, BtorNode *lo)
+{
+  int32_t sign;
+  BtorNode *real_hi, *t, *e;
+
+  if (btor_node_bv_get_width (btor, hi) == 1)
+    return is_sign_bit (btor, hi, lo) == 1;
+
+  real_hi = btor_node_real_addr (hi);
+  if (!btor_node_is_bv_cond (real_hi)) return false;
+  if (!(sign = is_sign_bit (btor, real_hi->e[0], lo))) return false;
+  t = btor_node_cond_invert (hi, real_hi->e[1]);
+  e = btor_node_cond_invert (hi, real_hi->e[2]);
+  if (sign < 0)
+  {
+    BTOR_SWAP (BtorNode *, t, e);
+  }
+  return btor_node_is_bv_const_ones (btor, t)
+         && btor_node_is_bv_const_zero (btor, e);
+}
+
+static void
+compute_const_info (Btor *btor, BtorNode *exp, uint32_t *ku, uint32_t *ks)
+{
+  uint32_t w, n;
+  BtorBitVector *bits;
+
+  w    = btor_node_bv_get_width (btor, exp);
+  bits = btor_node_bv_const_get_bits (exp);
+  n    = btor_bv_get_num_leading_zeros (bits);
+  *ku  = n < w ? w - n : 1;
+  if (btor_bv_get_bit (bits, w - 1)) n = btor_bv_get_num_leading_ones (bits);
+  *ks = n < w ? w - n + 1 : 1;
+}
+
+static BtorNode *
+mk_binary (Btor *btor, BtorNodeKind kind, BtorNode *e0, BtorNode *e1)
+{
+  switch (kind)
+  {
+    case BTOR_BV_ADD_NODE: return btor_exp_bv_add (btor, e0, e1);
+    case BTOR_BV_MUL_NODE: return btor_exp_bv_mul (btor, e0, e1);
+    case BTOR_BV_AND_NODE: return btor_exp_bv_and (btor, e0, e1);
+    case BTOR_BV_EQ_NODE: return btor_exp_eq (btor, e0, e1);
+    case BTOR_BV_ULT_NODE: return btor_exp_bv_ult (btor, e0, e1);
+    case BTOR_BV_UDIV_NODE: return btor_exp_bv_udiv (btor, e0, e1);
+    default:
+      assert (kind == BTOR_BV_UREM_NODE);
+      return btor_exp_bv_urem (btor, e0, e1);
+  }
+}
+
+/* Determine the width 'k' of the operation on the lower bits of the
+ * operands, and if the result is zero- or sign-extended from 'k' bits.
+ * Returns false if the operation can not be narrowed. */
+static bool
+get_reduced_width (Btor *btor,
+                   BtorIntHashTable *infos,
+                   BtorNode *exp,
+                   uint32_t *k,
+                   bool *is_signed)
+{
+  uint32_t w, ku0, ks0, ku1, ks1, ku, ks;
+
+  w = btor_node_bv_get_width (btor, exp->e[0]);
+  get_info (btor, infos, exp->e[0], &ku0, &ks0);
+  get_info (btor, infos, exp->e[1], &ku1, &ks1);
+  ku = BTOR_MAX_UTIL (ku0, ku1);
+  ks = BTOR_MAX_UTIL (ks0, ks1);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE:
+      ku += 1;
+      ks += 1;
+      break;
+    case BTOR_BV_MUL_NODE:
+      ku = ku0 + ku1;
+      ks = ks0 + ks1;
+      break;
+    case BTOR_BV_AND_NODE: ku = BTOR_MIN_UTIL (ku0, ku1); break;
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE: break;
+    default:
+      /* unsigned division and remainder only */
+      assert (btor_node_is_bv_udiv (exp) || btor_node_is_bv_urem (exp));
+      ks = w;
+  }
+
+  *is_signed = ks < ku;
+  *k         = *is_signed ? ks : ku;
+  return *k < w;
+}
+
+/* Replace operators over zero- or sign-extended operands by the extension
+ * of the operation on the lower bits of the operands.
+ *
+ * Note: Only structural extensions are considered here. Upper bits that are
+ *       implied by the constraints must not be used for substituting terms
+ *       of the constraints themselves, since this may drop the very
+ *       constraint that implied them (e.g., x < 256 would become true). */
+static uint32_t
+reduce_extended_ops (Btor *btor, BtorNodePtrStack *terms)
+{
+  bool is_signed;
+  uint32_t i, k, w, ku, ks, res;
+  BtorNode *cur, *e0, *e1, *op, *subst, *tmp, *zero, *ones, *hi;
+  BtorIntHashTable *infos;
+  BtorIntHashTableIterator it;
+  BtorWidthInfo *info;
+  BtorSortId sort;
+
+  res   = 0;
+  infos = btor_hashint_map_new (btor->mm);
+  btor_init_substitutions (btor);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*terms); i++)
+  {
+    cur = BTOR_PEEK_STACK (*terms, i);
+    w   = btor_node_bv_get_width (btor, cur);
+    ku = ks = w;
+
+    if (btor_node_is_bv_const (cur))
+      compute_const_info (btor, cur, &ku, &ks);
+    else if (btor_node_is_bv_concat (cur))
+    {
+      get_info (btor, infos, cur->e[1], &ku, &ks);
+      if (btor_node_is_bv_const_zero (btor, cur->e[0]))
+        ks = w;
+      else if (is_sign_extension (btor, cur->e[0], cur->e[1]))
+      {
+        if (ku == btor_node_bv_get_width (btor, cur->e[1])) ku = w;
+      }
+      else
+        ku = ks = w;
+    }
+    else if ((btor_node_is_bv_add (cur) || btor_node_is_bv_mul (cur)
+              || btor_node_is_bv_and (cur) || btor_node_is_bv_eq (cur)
+              || btor_node_is_bv_ult (cur) || btor_node_is_bv_udiv (cur)
+              || btor_node_is_bv_urem (cur))
+             && get_reduced_width (btor, infos, cur, &k, &is_signed))
+    {
+      e0 = low_bits (btor, cur->e[0], k);
+      e1 = low_bits (btor, cur->e[1], k);
+      op = mk_binary (btor, cur->kind, e0, e1);
+      if (w == 1)
+        subst = btor_node_copy (btor, op);
+      else if (btor_node_is_bv_udiv (cur))
+      {
+        /* x / 0 = ~0 */
+        sort = btor_sort_bv (btor, w - k);
+        zero = btor_exp_bv_zero (btor, sort);
+        ones = btor_exp_bv_ones (btor, sort);
+        btor_sort_release (btor, sort);
+        sort = btor_node_get_sort_id (e1);
+        tmp  = btor_exp_bv_zero (btor, sort);
+        hi   = btor_exp_eq (btor, e1, tmp);
+        btor_node_release (btor, tmp);
+        tmp   = btor_exp_cond (btor, hi, ones, zero);
+        subst = btor_exp_bv_concat (btor, tmp, op);
+        btor_node_release (btor, tmp);
+        btor_node_release (btor, hi);
+        btor_node_release (btor, ones);
+        btor_node_release (btor, zero);
+      }
+      else if (is_signed)
+      {
+        subst = btor_exp_bv_sext (btor, op, w - k);
+        ks    = k;
+      }
+      else
+      {
+        subst = btor_exp_bv_uext (btor, op, w - k);
+        ku    = k;
+      }
+      btor_node_release (btor, op);
+      btor_node_release (btor, e1);
+      btor_node_release (btor, e0);
+
+      if (subst != cur)
+      {
+        BTORLOG (1,
+                 "reduce width: %s -> %s",
+                 btor_util_node2string (cur),
+                 btor_util_node2string (subst));
+        btor_insert_substitution (btor, cur, subst, false);
+        res++;
+      }
+      btor_node_release (btor, subst);
+    }
+
+    if (ku + 1 < ks) ks = ku + 1;
+    if (ks == w) continue;
+    BTOR_NEW (btor->mm, info);
+    info->ku = ku;
+    info->ks = ks;
+    btor_hashint_map_add (infos, cur->id)->as_ptr = info;
+  }
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  btor_iter_hashint_init (&it, infos);
+  while (btor_iter_hashint_has_next (&it))
+    BTOR_DELETE (btor->mm,
+                 (BtorWidthInfo *) btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (infos);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* Operators with irrelevant upper bits                                   */
+/*------------------------------------------------------------------------*/
+
+static bool
+is_low_bits_op (BtorNode *exp)
+{
+  return btor_node_is_bv_add (exp) || btor_node_is_bv_mul (exp)
+         || btor_node_is_bv_and (exp);
+}
+
+/* The lower 'k' bits of adders, multipliers and bit-wise ands only depend
+ * on the lower 'k' bits of their operands. Determine the number of bits of
+ * each such operator that are actually used by its parents. */
+static void
+compute_demanded_bits (Btor *btor,
+                       BtorNodePtrStack *terms,
+                       BtorIntHashTable *demanded)
+{
+  uint32_t i, w, d, dp;
+  BtorNode *cur, *parent;
+  BtorNodeIterator it;
+  BtorHashTableData *data;
+
+  for (i = BTOR_COUNT_STACK (*terms); i > 0; i--)
+  {
+    cur = BTOR_PEEK_STACK (*terms, i - 1);
+    if (!is_low_bits_op (cur)) continue;
+    w = btor_node_bv_get_width (btor, cur);
+    d = 0;
+    btor_iter_parent_init (&it, cur);
+    while (d < w && btor_iter_parent_has_next (&it))
+    {
+      parent = btor_iter_parent_next (&it);
+      if (btor_node_is_simplified (parent))
+        dp = w;
+      else if (btor_node_is_bv_slice (parent)
+               && (btor_node_is_bv_and (cur)
+                   || btor_node_bv_slice_get_lower (parent) == 0))
+        dp = btor_node_bv_slice_get_upper (parent) + 1;
+      else if (is_low_bits_op (parent)
+               && (data = btor_hashint_map_get (demanded, parent->id)))
+        dp = data->as_int;
+      else
+        dp = w;
+      if (dp > d) d = dp;
+    }
+    btor_hashint_map_add (demanded, cur->id)->as_int = d;
+  }
+}
+
+/* Push slices on the lower bits of adders, multipliers and bit-wise ands
+ * down to their operands if no parent requires the upper bits. */
+static uint32_t
+reduce_sliced_ops (Btor *btor, BtorNodePtrStack *terms)
+{
+  uint32_t i, j, d, w, res;
+  BtorNode *cur, *real_e, *e[2], *subst;
+  BtorIntHashTable *demanded, *reduced;
+  BtorIntHashTableIterator it;
+  BtorHashTableData *data;
+
+  res      = 0;
+  demanded = btor_hashint_map_new (btor->mm);
+  reduced  = btor_hashint_map_new (btor->mm);
+  compute_demanded_bits (btor, terms, demanded);
+  btor_init_substitutions (btor);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*terms); i++)
+  {
+    cur = BTOR_PEEK_STACK (*terms, i);
+
+    if (btor_node_is_bv_slice (cur))
+    {
+      real_e = btor_node_real_addr (cur->e[0]);
+      if (!(data = btor_hashint_map_get (reduced, real_e->id))) continue;
+      e[0]  = btor_node_cond_invert (cur->e[0], data->as_ptr);
+      subst = btor_exp_bv_slice (btor,
+                                 e[0],
+                                 btor_node_bv_slice_get_upper (cur),
+                                 btor_node_bv_slice_get_lower (cur));
+      BTORLOG (1,
+               "reduce width: %s -> %s",
+               btor_util_node2string (cur),
+               btor_util_node2string (subst));
+      btor_insert_substitution (btor, cur, subst, false);
+      btor_node_release (btor, subst);
+      res++;
+      continue;
+    }
+
+    if (!(data = btor_hashint_map_get (demanded, cur->id))) continue;
+    d = data->as_int;
+    w = btor_node_bv_get_width (btor, cur);
+    if (d == 0 || d == w) continue;
+
+    for (j = 0; j < 2; j++)
+    {
+      real_e = btor_node_real_addr (cur->e[j]);
+      if ((data = btor_hashint_map_get (demanded, real_e->id))
+          && (uint32_t) data->as_int == d
+          && (data = btor_hashint_map_get (reduced, real_e->id)))
+        e[j] = btor_node_copy (
+            btor, btor_node_cond_invert (cur->e[j], data->as_ptr));
+      else
+        e[j] = low_bits (btor, cur->e[j], d);
+    }
+    btor_hashint_map_add (reduced, cur->id)->as_ptr =
+        mk_binary (btor, cur->kind, e[0], e[1]);
+    btor_node_release (btor, e[0]);
+    btor_node_release (btor, e[1]);
+  }
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  btor_iter_hashint_init (&it, reduced);
+  while (btor_iter_hashint_has_next (&it))
+    btor_node_release (btor, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (reduced);
+  btor_hashint_map_delete (demanded);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* Variables with constant upper bits                                     */
+/*------------------------------------------------------------------------*/
+
+/* Variables with constant upper bits are substituted by the concatenation
+ * of the constant upper bits and a fresh variable on the remaining bits
+ * (as in slice elimination). Models of the original variables are thus
+ * derived via variable substitution. */
+static void
+reduce_vars (Btor *btor,
+             BtorNodePtrStack *terms,
+             BtorIntHashTable *domains,
+             BtorNodePtrStack *eqs)
+{
+  uint32_t i, w, n;
+  BtorNode *cur, *hi, *lo, *concat;
+  BtorBitVector *bits;
+  BtorBvDomain *d;
+  BtorSortId sort;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*terms); i++)
+  {
+    cur = BTOR_PEEK_STACK (*terms, i);
+    if (!btor_node_is_bv_var (cur)) continue;
+    if (!(d = btor_bvdomain_get (btor->mm, domains, cur))) continue;
+    w = btor_node_bv_get_width (btor, cur);
+    for (n = 0; n < w; n++)
+      if (btor_bv_get_bit (d->lo, w - 1 - n)
+          != btor_bv_get_bit (d->hi, w - 1 - n))
+        break;
+    if (n > 0 && n < w)
+    {
+      bits = btor_bv_slice (btor->mm, d->lo, w - 1, w - n);
+      hi   = btor_exp_bv_const (btor, bits);
+      sort = btor_sort_bv (btor, w - n);
+      lo   = btor_exp_var (btor, sort, 0);
+      btor_sort_release (btor, sort);
+      concat = btor_exp_bv_concat (btor, hi, lo);
+      BTOR_PUSH_STACK (*eqs, btor_exp_eq (btor, cur, concat));
+      btor_node_release (btor, concat);
+      btor_node_release (btor, lo);
+      btor_node_release (btor, hi);
+      btor_bv_free (btor->mm, bits);
+    }
+    btor_bvdomain_free (btor->mm, d);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Note: Operators are only replaced by equivalent narrower terms, and
+ *       variables are narrowed via variable substitution w.r.t. the top level
+ *       constraints, which are never retracted in incremental mode. All
+ *       substitutions hence preserve models and stay valid when further
+ *       constraints are added. */
+void
+btor_reduce_bv_widths (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, num_vars, num_ops;
+  double start, delta;
+  BtorMemMgr *mm;
+  BtorNodePtrStack roots, terms, eqs;
+  BtorIntHashTable *domains;
+  BtorPtrHashTableIterator it;
+
+  start    = btor_util_time_stamp ();
+  mm       = btor->mm;
+  num_vars = num_ops = 0;
+
+  BTOR_INIT_STACK (mm, roots);
+  BTOR_INIT_STACK (mm, terms);
+  BTOR_INIT_STACK (mm, eqs);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (roots, btor_iter_hashptr_next (&it));
+  domains = btor_hashint_map_new (mm);
+  if (!btor_bvdomain_compute (btor, &roots, domains))
+  {
+    BTOR_MSG (btor->msg, 1, "width reduction found inconsistency");
+    btor->inconsistent = true;
+    goto DONE;
+  }
+
+  /* synthesized constraints are not rebuilt */
+  BTOR_RESET_STACK (roots);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (roots, btor_iter_hashptr_next (&it));
+  if (BTOR_EMPTY_STACK (roots)) goto DONE;
+
+  collect_terms (btor, &roots, &terms);
+  reduce_vars (btor, &terms, domains, &eqs);
+  num_ops += reduce_extended_ops (btor, &terms);
+
+  BTOR_RESET_STACK (roots);
+  BTOR_RESET_STACK (terms);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (roots, btor_iter_hashptr_next (&it));
+  collect_terms (btor, &roots, &terms);
+  num_ops += reduce_sliced_ops (btor, &terms);
+
+  num_vars = BTOR_COUNT_STACK (eqs);
+  for (i = 0; i < num_vars; i++)
+  {
+    BTORLOG (1,
+             "reduce width: %s",
+             btor_util_node2string (BTOR_PEEK_STACK (eqs, i)));
+    btor_assert_exp (btor, BTOR_PEEK_STACK (eqs, i));
+  }
+  btor->stats.width_reduced_vars += num_vars;
+  btor->stats.width_reduced_ops += num_ops;
+
+DONE:
+  while (!BTOR_EMPTY_STACK (eqs))
+    btor_node_release (btor, BTOR_POP_STACK (eqs));
+  btor_bvdomain_delete_map (mm, domains);
+  BTOR_RELEASE_STACK (eqs);
+  BTOR_RELEASE_STACK (terms);
+  BTOR_RELEASE_STACK (roots);
+
+  delta = btor_util_time_stamp () - start;
+  btor->time.width += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "reduced width of %u variables and %u operators in %.1f seconds",
+            num_vars,
+            num_ops,
+            delta);
+}
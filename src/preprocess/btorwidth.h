@@ -0,0 +1,20 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORWIDTH_H_INCLUDED
+#define BTORWIDTH_H_INCLUDED
+
+#include "btortypes.h"
+
+/**
+ * Reduce the bit-width of variables with implied constant upper bits and of
+ * operators over zero-/sign-extended operands or with irrelevant upper bits.
+ */
+void btor_reduce_bv_widths (Btor *btor);
+
+#endif
@@ -0,0 +1,256 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_USE_CADICAL
+/*------------------------------------------------------------------------*/
+
+#include "cadical.hpp"
+
+#include <cassert>
+#include <cstdio>
+
+extern "C" {
+#include "btorabort.h"
+#include "btoropt.h"
+#include "btorsat.h"
+#include "sat/btorcadical.h"
+}
+
+/*------------------------------------------------------------------------*/
+
+class BtorCaDiCaL : public CaDiCaL::Terminator
+{
+ public:
+  CaDiCaL::Solver* solver;
+
+  BtorCaDiCaL () : solver (new CaDiCaL::Solver ()), term_fun (0), term_state (0)
+  {
+  }
+
+  ~BtorCaDiCaL ()
+  {
+    solver->disconnect_terminator ();
+    delete solver;
+  }
+
+  void set_terminate (int32_t (*fun) (void*), void* state)
+  {
+    term_fun   = fun;
+    term_state = state;
+    if (fun)
+      solver->connect_terminator (this);
+    else
+      solver->disconnect_terminator ();
+  }
+
+  bool terminate () { return term_fun && term_fun (term_state); }
+
+ private:
+  int32_t (*term_fun) (void*);
+  void* term_state;
+};
+
+/*------------------------------------------------------------------------*/
+
+static void*
+init (BtorSATMgr* smgr)
+{
+  BtorCaDiCaL* res = new BtorCaDiCaL ();
+  if (smgr->inc_required
+      && btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE))
+  {
+    res->solver->set ("checkfrozen", 1);
+  }
+  return res;
+}
+
+static void
+add (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  slv->solver->add (lit);
+}
+
+static void
+assume (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  slv->solver->assume (lit);
+}
+
+static int32_t
+deref (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  int32_t val;
+  val = slv->solver->val (lit);
+  if (val > 0) return 1;
+  if (val < 0) return -1;
+  return 0;
+}
+
+static void
+enable_verbosity (BtorSATMgr* smgr, int32_t level)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  if (level <= 1)
+    slv->solver->set ("quiet", 1);
+  else if (level >= 2)
+    slv->solver->set ("verbose", level - 2);
+}
+
+static int32_t
+failed (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  return slv->solver->failed (lit);
+}
+
+static int32_t
+fixed (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  return slv->solver->fixed (lit);
+}
+
+static void
+reset (BtorSATMgr* smgr)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  delete slv;
+  smgr->solver = 0;
+}
+
+static int32_t
+sat (BtorSATMgr* smgr, int32_t limit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  uint32_t conflicts, decisions;
+
+  /* limits are reset by CaDiCaL after each call to 'solve' */
+  conflicts = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_CONFLICTS);
+  decisions = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_DECISIONS);
+  if (limit > -1)
+    slv->solver->limit ("conflicts", limit);
+  else if (conflicts)
+    slv->solver->limit ("conflicts", conflicts);
+  if (decisions) slv->solver->limit ("decisions", decisions);
+  return slv->solver->solve ();
+}
+
+static void
+setterm (BtorSATMgr* smgr)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  slv->set_terminate (smgr->term.fun, smgr->term.state);
+}
+
+static void
+stats (BtorSATMgr* smgr)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  slv->solver->statistics ();
+  fflush (stdout);
+}
+
+static void*
+clone (Btor* btor, BtorSATMgr* smgr)
+{
+  (void) btor;
+  BtorCaDiCaL *slv, *res;
+
+  slv = (BtorCaDiCaL*) smgr->solver;
+  res = new BtorCaDiCaL ();
+  /* copies irredundant clauses, units, options and the frozen state of
+   * variables, but not the terminator (reset by btor_sat_mgr_clone) */
+  slv->solver->copy (*res->solver);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* incremental API                                                        */
+/*------------------------------------------------------------------------*/
+
+static int32_t
+inc_max_var (BtorSATMgr* smgr)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  int32_t var      = smgr->maxvar + 1;
+  if (smgr->inc_required)
+  {
+    slv->solver->freeze (var);
+  }
+  return var;
+}
+
+static void
+melt (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  if (smgr->inc_required) slv->solver->melt (lit);
+}
+
+static void
+phase (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorCaDiCaL* slv = (BtorCaDiCaL*) smgr->solver;
+  slv->solver->phase (lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+extern "C" {
+
+bool
+btor_sat_enable_cadical (BtorSATMgr* smgr)
+{
+  assert (smgr != NULL);
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_cadical'");
+
+  smgr->name = "CaDiCaL";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add              = add;
+  smgr->api.assume           = assume;
+  smgr->api.clone            = clone;
+  smgr->api.deref            = deref;
+  smgr->api.enable_verbosity = enable_verbosity;
+  smgr->api.failed           = failed;
+  smgr->api.fixed            = fixed;
+  smgr->api.inc_max_var      = 0;
+  smgr->api.init             = init;
+  smgr->api.melt             = 0;
+  smgr->api.phase            = phase;
+  smgr->api.repr             = 0;
+  smgr->api.reset            = reset;
+  smgr->api.sat              = sat;
+  smgr->api.set_output       = 0;
+  smgr->api.set_prefix       = 0;
+  smgr->api.stats            = stats;
+  smgr->api.setterm          = setterm;
+
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE))
+  {
+    smgr->api.inc_max_var = inc_max_var;
+    smgr->api.melt        = melt;
+  }
+  else
+  {
+    smgr->have_restore = true;
+  }
+
+  return true;
+}
+}
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
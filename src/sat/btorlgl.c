@@ -260,6 +260,13 @@ fixed (BtorSATMgr *smgr, int32_t lit)
   return lglfixed (blgl->lgl, lit);
 }
 
+static void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglsetphase (blgl->lgl, lit);
+}
+
 static void *
 clone (Btor *btor, BtorSATMgr *smgr)
 {
@@ -318,6 +325,7 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
   smgr->api.melt             = melt;
+  smgr->api.phase            = phase;
   smgr->api.repr             = repr;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
@@ -82,6 +82,23 @@ btor_util_num_digits (uint32_t x)
   return result;
 }
 
+uint32_t
+btor_util_luby (uint32_t i)
+{
+  assert (i > 0);
+
+  uint32_t k;
+
+  for (;;)
+  {
+    /* find k with 2^(k-1) <= i <= 2^k - 1 */
+    for (k = 1; k < 32 && (1u << k) - 1 < i; k++)
+      ;
+    if (k == 32 || (1u << k) - 1 == i) return 1u << (k - 1);
+    i -= (1u << (k - 1)) - 1;
+  }
+}
+
 /*------------------------------------------------------------------------*/
 
 static const char *digit2const_table[10] = {
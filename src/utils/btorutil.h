@@ -46,6 +46,9 @@ int32_t btor_util_next_power_of_2 (int32_t x);
 
 uint32_t btor_util_num_digits (uint32_t x);
 
+/* Get the i-th element (i > 0) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ... */
+uint32_t btor_util_luby (uint32_t i);
+
 /*------------------------------------------------------------------------*/
 
 char *btor_util_dec_to_bin_str (BtorMemMgr *mm, const char *str);
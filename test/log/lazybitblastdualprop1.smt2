@@ -0,0 +1,10 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 8) (_ BitVec 8)))
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (not (= y #x00)))
+(assert (= (bvmul x y) #x0f))
+(assert (= (select a (bvmul x y)) (bvudiv x y)))
+(assert (bvult #x01 (select a #x0f)))
+(check-sat)
+(exit)
@@ -0,0 +1,10 @@
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 16))
+(declare-fun b () (_ BitVec 16))
+(assert (= (bvand a #xff00) #x1200))
+(assert (= ((_ extract 3 0) b) #x5))
+(assert (bvult #x0100 b))
+(assert (bvult b #x0200))
+(assert (= (bvadd a b) #x1395))
+(check-sat)
+(exit)
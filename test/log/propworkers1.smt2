@@ -0,0 +1,11 @@
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 12))
+(declare-fun b () (_ BitVec 12))
+(declare-fun c () (_ BitVec 12))
+(assert (= (bvadd (bvmul a a) (bvmul b b)) (bvmul c c)))
+(assert (bvult #x020 a))
+(assert (bvult a b))
+(assert (bvult b c))
+(assert (bvult c #x400))
+(check-sat)
+(exit)
@@ -0,0 +1,7 @@
+(set-logic BV)
+(declare-fun a () (_ BitVec 16))
+(declare-fun b () (_ BitVec 16))
+(declare-fun c () (_ BitVec 16))
+(declare-fun d () (_ BitVec 16))
+(assert (forall ((y (_ BitVec 16))) (= (bvadd (bvmul a y y y) (bvmul b y y) (bvmul c y) d) (bvadd (bvmul #x0003 y y y) (bvmul #x0105 y y) (bvmul #x7001 y) #x0abc (bvand y #x0100)))))
+(check-sat)
@@ -0,0 +1,11 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 16))
+(assert (= (bvmul x y) #x1e61))
+(assert (bvult #x0010 x))
+(assert (bvult x y))
+(assert (= (bvadd y z) #x0400))
+(assert (= (bvand z #x000f) #x0003))
+(check-sat)
+(exit)
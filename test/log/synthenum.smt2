@@ -0,0 +1,8 @@
+(set-logic BV)
+(assert
+ (forall ((x (_ BitVec 8)) (z (_ BitVec 8)) (w (_ BitVec 8)))
+  (exists ((y (_ BitVec 8)))
+   (and (bvuge y x) (bvuge y z) (bvuge y w)
+        (or (= y x) (= y z) (= y w))))))
+(check-sat)
+(exit)
@@ -143,3 +143,64 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, fraig)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *and1    = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2    = btor_aig_and (amgr, var2, var3);
+  BtorAIG *and3    = btor_aig_and (amgr, and1, var3);
+  BtorAIG *and4    = btor_aig_and (amgr, var1, and2);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  btor_aig_fraig_defer (amgr);
+  btor_aig_to_sat_tseitin (amgr, and3);
+  btor_aig_to_sat_tseitin (amgr, and4);
+  ASSERT_EQ (btor_aig_get_cnf_id (and3), 0);
+  btor_aig_fraig (amgr, 1000);
+  ASSERT_GT (amgr->num_fraig_merged, 0u);
+  ASSERT_NE (btor_aig_get_cnf_id (and3), 0);
+  ASSERT_NE (btor_aig_get_cnf_id (and4), 0);
+  btor_sat_assume (smgr, btor_aig_get_cnf_id (and3));
+  btor_sat_assume (smgr, -btor_aig_get_cnf_id (and4));
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_UNSAT);
+  btor_sat_reset (smgr);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  btor_aig_release (amgr, and3);
+  btor_aig_release (amgr, and4);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, rewrite)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *xor1    = btor_aig_eq (amgr, var1, var2);
+  BtorAIG *xor2    = btor_aig_eq (amgr, xor1, var2);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  btor_aig_fraig_defer (amgr);
+  btor_aig_to_sat_tseitin (amgr, xor2);
+  btor_aig_rewrite (amgr, 1);
+  btor_aig_fraig (amgr, 0);
+  ASSERT_GT (amgr->num_rw_rewritten, 0u);
+  btor_sat_assume (smgr, btor_aig_get_cnf_id (xor2));
+  btor_sat_assume (smgr, -btor_aig_get_cnf_id (var1));
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_UNSAT);
+  btor_sat_reset (smgr);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, xor1);
+  btor_aig_release (amgr, xor2);
+  btor_aig_mgr_delete (amgr);
+}
@@ -0,0 +1,243 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorbv.h"
+#include "btorbvdomain.h"
+#include "btorclone.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btornode.h"
+#include "btorslvprop.h"
+}
+
+class TestBvDomain : public TestBtor
+{
+ protected:
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+    d_mm = d_btor->mm;
+    btor_opt_set (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+    d_sort = btor_sort_bv (d_btor, 8);
+    d_x    = btor_exp_var (d_btor, d_sort, "x");
+    d_y    = btor_exp_var (d_btor, d_sort, "y");
+    BTOR_INIT_STACK (d_mm, d_roots);
+    BTOR_INIT_STACK (d_mm, d_consts);
+  }
+
+  void TearDown () override
+  {
+    while (!BTOR_EMPTY_STACK (d_roots))
+      btor_node_release (d_btor, BTOR_POP_STACK (d_roots));
+    BTOR_RELEASE_STACK (d_roots);
+    while (!BTOR_EMPTY_STACK (d_consts))
+      btor_node_release (d_btor, BTOR_POP_STACK (d_consts));
+    BTOR_RELEASE_STACK (d_consts);
+    btor_node_release (d_btor, d_x);
+    btor_node_release (d_btor, d_y);
+    btor_sort_release (d_btor, d_sort);
+    TestBtor::TearDown ();
+  }
+
+  BtorNode *constant (uint64_t value)
+  {
+    BtorNode *res = btor_exp_bv_unsigned (d_btor, value, d_sort);
+    BTOR_PUSH_STACK (d_consts, res);
+    return res;
+  }
+
+  /* assert 'exp', takes ownership of 'exp' */
+  void add_root (BtorNode *exp) { BTOR_PUSH_STACK (d_roots, exp); }
+
+  void check_fixed (BtorIntHashTable *domains, BtorNode *exp, uint64_t value)
+  {
+    BtorBvDomain *d = btor_bvdomain_get (d_mm, domains, exp);
+    ASSERT_NE (d, nullptr);
+    ASSERT_TRUE (btor_bvdomain_is_fixed (d_mm, d));
+    ASSERT_EQ (btor_bv_to_uint64 (d->lo), value);
+    btor_bvdomain_free (d_mm, d);
+  }
+
+  BtorMemMgr *d_mm = nullptr;
+  BtorSortId d_sort;
+  BtorNode *d_x = nullptr;
+  BtorNode *d_y = nullptr;
+  BtorNodePtrStack d_roots;
+  BtorNodePtrStack d_consts;
+};
+
+TEST_F (TestBvDomain, intersect)
+{
+  BtorBvDomain *d0, *d1;
+
+  /* x in [7, 9] with x[1:0] = 11 */
+  d0 = btor_bvdomain_new_init (d_mm, 8);
+  d1 = btor_bvdomain_new_init (d_mm, 8);
+  btor_bv_free (d_mm, d0->min);
+  btor_bv_free (d_mm, d0->max);
+  d0->min = btor_bv_uint64_to_bv (d_mm, 7, 8);
+  d0->max = btor_bv_uint64_to_bv (d_mm, 9, 8);
+  btor_bv_free (d_mm, d1->lo);
+  d1->lo = btor_bv_uint64_to_bv (d_mm, 3, 8);
+
+  ASSERT_TRUE (btor_bvdomain_intersect (d_mm, d0, d1));
+  ASSERT_TRUE (btor_bvdomain_is_valid (d_mm, d0));
+  ASSERT_TRUE (btor_bvdomain_is_fixed (d_mm, d0));
+  ASSERT_EQ (btor_bv_to_uint64 (d0->lo), 7u);
+  ASSERT_FALSE (btor_bvdomain_intersect (d_mm, d0, d1));
+
+  /* x in [8, 10] with x[1:0] = 11 */
+  btor_bvdomain_free (d_mm, d0);
+  d0 = btor_bvdomain_new_init (d_mm, 8);
+  btor_bv_free (d_mm, d0->min);
+  btor_bv_free (d_mm, d0->max);
+  d0->min = btor_bv_uint64_to_bv (d_mm, 8, 8);
+  d0->max = btor_bv_uint64_to_bv (d_mm, 10, 8);
+  btor_bvdomain_intersect (d_mm, d0, d1);
+  ASSERT_FALSE (btor_bvdomain_is_valid (d_mm, d0));
+
+  btor_bvdomain_free (d_mm, d0);
+  btor_bvdomain_free (d_mm, d1);
+}
+
+TEST_F (TestBvDomain, range_check)
+{
+  BtorNode *and3, *sum;
+  BtorIntHashTable *domains;
+
+  /* 6 < x < 10, x & 3 = 3, x + y < 10, y <= 10 */
+  and3 = btor_exp_bv_and (d_btor, d_x, constant (3));
+  sum  = btor_exp_bv_add (d_btor, d_x, d_y);
+  add_root (btor_exp_bv_ult (d_btor, constant (6), d_x));
+  add_root (btor_exp_bv_ult (d_btor, d_x, constant (10)));
+  add_root (btor_exp_eq (d_btor, and3, constant (3)));
+  add_root (btor_exp_bv_ult (d_btor, sum, constant (10)));
+  add_root (btor_exp_bv_ulte (d_btor, d_y, constant (10)));
+
+  domains = btor_hashint_map_new (d_mm);
+  ASSERT_TRUE (btor_bvdomain_compute (d_btor, &d_roots, domains));
+  check_fixed (domains, d_x, 7);
+  check_fixed (domains, and3, 3);
+
+  /* y in [0, 2] */
+  BtorBvDomain *d = btor_bvdomain_get (d_mm, domains, d_y);
+  ASSERT_EQ (btor_bv_to_uint64 (d->min), 0u);
+  ASSERT_EQ (btor_bv_to_uint64 (d->max), 2u);
+  btor_bvdomain_free (d_mm, d);
+
+  btor_bvdomain_delete_map (d_mm, domains);
+  btor_node_release (d_btor, and3);
+  btor_node_release (d_btor, sum);
+}
+
+TEST_F (TestBvDomain, conflict)
+{
+  BtorNode *mul;
+  BtorIntHashTable *domains;
+
+  /* x < 4, y < 4, x * y > 9 */
+  mul = btor_exp_bv_mul (d_btor, d_x, d_y);
+  add_root (btor_exp_bv_ult (d_btor, d_x, constant (4)));
+  add_root (btor_exp_bv_ult (d_btor, d_y, constant (4)));
+  add_root (btor_exp_bv_ult (d_btor, constant (9), mul));
+
+  domains = btor_hashint_map_new (d_mm);
+  ASSERT_FALSE (btor_bvdomain_compute (d_btor, &d_roots, domains));
+  btor_bvdomain_delete_map (d_mm, domains);
+  btor_node_release (d_btor, mul);
+}
+
+TEST_F (TestBvDomain, project_exclude)
+{
+  BtorBvDomain *d;
+  BtorBitVector *bv, *res;
+
+  /* x in [5, 13] with x[0] = 1 */
+  d = btor_bvdomain_new_init (d_mm, 8);
+  btor_bv_free (d_mm, d->lo);
+  btor_bv_free (d_mm, d->min);
+  btor_bv_free (d_mm, d->max);
+  d->lo  = btor_bv_uint64_to_bv (d_mm, 1, 8);
+  d->min = btor_bv_uint64_to_bv (d_mm, 5, 8);
+  d->max = btor_bv_uint64_to_bv (d_mm, 13, 8);
+
+  /* known bits are set, values outside of [min, max] are clamped */
+  bv  = btor_bv_uint64_to_bv (d_mm, 8, 8);
+  res = btor_bvdomain_project (d_mm, d, bv);
+  ASSERT_EQ (btor_bv_to_uint64 (res), 9u);
+  btor_bv_free (d_mm, res);
+  btor_bv_free (d_mm, bv);
+  bv  = btor_bv_uint64_to_bv (d_mm, 2, 8);
+  res = btor_bvdomain_project (d_mm, d, bv);
+  ASSERT_EQ (btor_bv_to_uint64 (res), 5u);
+  btor_bv_free (d_mm, res);
+  btor_bv_free (d_mm, bv);
+  bv  = btor_bv_uint64_to_bv (d_mm, 200, 8);
+  res = btor_bvdomain_project (d_mm, d, bv);
+  ASSERT_EQ (btor_bv_to_uint64 (res), 13u);
+  btor_bv_free (d_mm, res);
+  btor_bv_free (d_mm, bv);
+
+  /* only bounds are excluded, the new bounds respect the known bits */
+  bv = btor_bv_uint64_to_bv (d_mm, 9, 8);
+  ASSERT_FALSE (btor_bvdomain_exclude (d_mm, d, bv));
+  btor_bv_free (d_mm, bv);
+  bv = btor_bv_uint64_to_bv (d_mm, 5, 8);
+  ASSERT_TRUE (btor_bvdomain_exclude (d_mm, d, bv));
+  ASSERT_EQ (btor_bv_to_uint64 (d->min), 7u);
+  ASSERT_FALSE (btor_bvdomain_check_value (d_mm, d, bv));
+  btor_bv_free (d_mm, bv);
+  bv = btor_bv_uint64_to_bv (d_mm, 13, 8);
+  ASSERT_TRUE (btor_bvdomain_exclude (d_mm, d, bv));
+  ASSERT_EQ (btor_bv_to_uint64 (d->max), 11u);
+  btor_bv_free (d_mm, bv);
+
+  /* x in {7, 9, 11}, a fixed domain is never emptied */
+  bv = btor_bv_uint64_to_bv (d_mm, 7, 8);
+  ASSERT_TRUE (btor_bvdomain_exclude (d_mm, d, bv));
+  btor_bv_free (d_mm, bv);
+  bv = btor_bv_uint64_to_bv (d_mm, 9, 8);
+  ASSERT_TRUE (btor_bvdomain_exclude (d_mm, d, bv));
+  btor_bv_free (d_mm, bv);
+  ASSERT_TRUE (btor_bvdomain_is_fixed (d_mm, d));
+  bv = btor_bv_uint64_to_bv (d_mm, 11, 8);
+  ASSERT_FALSE (btor_bvdomain_exclude (d_mm, d, bv));
+  ASSERT_TRUE (btor_bvdomain_check_value (d_mm, d, bv));
+  btor_bv_free (d_mm, bv);
+
+  btor_bvdomain_free (d_mm, d);
+}
+
+TEST_F (TestBvDomain, clone_prop_solver)
+{
+  Btor *clone;
+  BtorPropSolver *slv;
+
+  /* x < 4, x & 3 = 3 */
+  BtorNode *and3 = btor_exp_bv_and (d_btor, d_x, constant (3));
+  add_root (btor_exp_bv_ult (d_btor, d_x, constant (4)));
+  add_root (btor_exp_eq (d_btor, and3, constant (3)));
+
+  d_btor->slv  = btor_new_prop_solver (d_btor);
+  slv          = BTOR_PROP_SOLVER (d_btor);
+  slv->domains = btor_hashint_map_new (d_mm);
+  ASSERT_TRUE (btor_bvdomain_compute (d_btor, &d_roots, slv->domains));
+
+  /* memory of the cloned domains is checked in debug mode */
+  clone = btor_clone_btor (d_btor);
+  ASSERT_NE (BTOR_PROP_SOLVER (clone)->domains, nullptr);
+  ASSERT_EQ (BTOR_PROP_SOLVER (clone)->domains->count, slv->domains->count);
+  check_fixed (BTOR_PROP_SOLVER (clone)->domains, d_x, 3);
+  /* the clone inherits the external reference to 'd_sort' */
+  btor_sort_release (clone, d_sort);
+  btor_delete (clone);
+  btor_node_release (d_btor, and3);
+}
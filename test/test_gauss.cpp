@@ -0,0 +1,137 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestGauss : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ELIMINATE_XORS, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+    d_sort1  = boolector_bitvec_sort (d_btor, 1);
+    d_sort32 = boolector_bitvec_sort (d_btor, 32);
+  }
+
+  void TearDown () override
+  {
+    boolector_release_sort (d_btor, d_sort1);
+    boolector_release_sort (d_btor, d_sort32);
+    TestBoolector::TearDown ();
+  }
+
+  /* assert 'e0 ^ e1 = value' */
+  void assert_xor (BoolectorNode *e0, BoolectorNode *e1, uint32_t value)
+  {
+    BoolectorNode *x, *c, *eq;
+
+    x  = boolector_xor (d_btor, e0, e1);
+    c  = boolector_unsigned_int (d_btor, value, boolector_get_sort (d_btor, x));
+    eq = boolector_eq (d_btor, x, c);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, x);
+  }
+
+  uint64_t value (BoolectorNode *exp)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, exp);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  BoolectorSort d_sort1;
+  BoolectorSort d_sort32;
+};
+
+TEST_F (TestGauss, word_system)
+{
+  BoolectorNode *x, *y, *z, *mul;
+
+  x   = boolector_var (d_btor, d_sort32, "x");
+  y   = boolector_var (d_btor, d_sort32, "y");
+  z   = boolector_var (d_btor, d_sort32, "z");
+  mul = boolector_mul (d_btor, y, z);
+  assert_xor (x, y, 0x0f0f);
+  assert_xor (y, z, 0x1234);
+  assert_xor (x, mul, 0xbeef);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.xor_substitutions, 0u);
+  ASSERT_EQ (value (x) ^ value (y), 0x0f0fu);
+  ASSERT_EQ (value (y) ^ value (z), 0x1234u);
+  ASSERT_EQ (value (x) ^ (uint32_t) (value (y) * value (z)), 0xbeefu);
+
+  /* constraints stay valid in incremental mode */
+  assert_xor (x, z, 0);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+}
+
+TEST_F (TestGauss, inconsistent)
+{
+  BoolectorNode *x, *y, *z;
+
+  x = boolector_var (d_btor, d_sort32, "x");
+  y = boolector_var (d_btor, d_sort32, "y");
+  z = boolector_var (d_btor, d_sort32, "z");
+  assert_xor (x, y, 1);
+  assert_xor (y, z, 2);
+  assert_xor (x, z, 4);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+}
+
+TEST_F (TestGauss, bool_system)
+{
+  BoolectorNode *a, *b, *c, *x, *k, *ult, *t;
+
+  a   = boolector_var (d_btor, d_sort1, "a");
+  b   = boolector_var (d_btor, d_sort1, "b");
+  c   = boolector_var (d_btor, d_sort1, "c");
+  x   = boolector_var (d_btor, d_sort32, "x");
+  k   = boolector_unsigned_int (d_btor, 10, d_sort32);
+  ult = boolector_ult (d_btor, x, k);
+  /* a ^ b ^ (x < 10) = 1, (a = c) ^ b = 0 */
+  t = boolector_xor (d_btor, a, b);
+  assert_xor (t, ult, 1);
+  boolector_release (d_btor, t);
+  t = boolector_eq (d_btor, a, c);
+  assert_xor (t, b, 0);
+  boolector_release (d_btor, t);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.xor_substitutions, 0u);
+  ASSERT_EQ (value (a) ^ value (b) ^ (value (x) < 10), 1u);
+  ASSERT_EQ ((uint64_t) (value (a) == value (c)), value (b));
+
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, k);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, c);
+}
@@ -9,6 +9,7 @@
 #include "test.h"
 
 extern "C" {
+#include "btorcore.h"
 #include "btoropt.h"
 }
 
@@ -255,3 +256,322 @@ TEST_F (TestInc, lemmas_on_demand1)
   boolector_release_sort (d_btor, s);
   boolector_release_sort (d_btor, as);
 }
+
+TEST_F (TestInc, lazy_bitblast)
+{
+  int32_t sat_result;
+  const char *assignment;
+  BoolectorNode *x, *y, *mul, *c15, *c3, *zero, *eq_mul, *eq_x, *eq_y;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_LAZY_BITBLAST, 1);
+  s      = boolector_bitvec_sort (d_btor, 8);
+  x      = boolector_var (d_btor, s, "x");
+  y      = boolector_var (d_btor, s, "y");
+  mul    = boolector_mul (d_btor, x, y);
+  c15    = boolector_unsigned_int (d_btor, 15, s);
+  c3     = boolector_unsigned_int (d_btor, 3, s);
+  zero   = boolector_zero (d_btor, s);
+  eq_mul = boolector_eq (d_btor, mul, c15);
+  eq_x   = boolector_eq (d_btor, x, c3);
+  eq_y   = boolector_eq (d_btor, y, zero);
+  boolector_assert (d_btor, eq_mul);
+  boolector_assume (d_btor, eq_x);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  assignment = boolector_bv_assignment (d_btor, y);
+  ASSERT_STREQ (assignment, "00000101");
+  boolector_free_bv_assignment (d_btor, assignment);
+  boolector_assume (d_btor, eq_y);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, eq_y));
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, c15);
+  boolector_release (d_btor, c3);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, eq_mul);
+  boolector_release (d_btor, eq_x);
+  boolector_release (d_btor, eq_y);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, unconstrained)
+{
+  int32_t sat_result;
+  const char *ax, *ay;
+  BoolectorNode *x, *y, *mul, *c42, *c6, *c3, *c10;
+  BoolectorNode *eq_mul, *eq_y, *eq_x, *ult_x;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_UCOPT, 1);
+  s      = boolector_bitvec_sort (d_btor, 8);
+  x      = boolector_var (d_btor, s, "x");
+  y      = boolector_var (d_btor, s, "y");
+  mul    = boolector_mul (d_btor, x, y);
+  c42    = boolector_unsigned_int (d_btor, 42, s);
+  c6     = boolector_unsigned_int (d_btor, 6, s);
+  c3     = boolector_unsigned_int (d_btor, 3, s);
+  c10    = boolector_unsigned_int (d_btor, 10, s);
+  eq_mul = boolector_eq (d_btor, mul, c42);
+  boolector_assert (d_btor, eq_mul);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.bv_uc_props, 0u);
+  ax = boolector_bv_assignment (d_btor, x);
+  ay = boolector_bv_assignment (d_btor, y);
+  ASSERT_EQ ((strtoul (ax, 0, 2) * strtoul (ay, 0, 2)) % 256, 42u);
+  boolector_free_bv_assignment (d_btor, ax);
+  boolector_free_bv_assignment (d_btor, ay);
+
+  /* x and y are not unconstrained anymore */
+  eq_y  = boolector_eq (d_btor, y, c6);
+  ult_x = boolector_ult (d_btor, x, c10);
+  boolector_assert (d_btor, eq_y);
+  boolector_assert (d_btor, ult_x);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.uc_reconnects, 0u);
+  ax = boolector_bv_assignment (d_btor, x);
+  ASSERT_STREQ (ax, "00000111");
+  boolector_free_bv_assignment (d_btor, ax);
+
+  eq_x = boolector_eq (d_btor, x, c3);
+  boolector_assume (d_btor, eq_x);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, eq_x));
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, c42);
+  boolector_release (d_btor, c6);
+  boolector_release (d_btor, c3);
+  boolector_release (d_btor, c10);
+  boolector_release (d_btor, eq_mul);
+  boolector_release (d_btor, eq_y);
+  boolector_release (d_btor, eq_x);
+  boolector_release (d_btor, ult_x);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, eliminate_slices)
+{
+  int32_t sat_result;
+  const char *assignment;
+  BoolectorNode *x, *lo, *hi, *c2, *c5, *c7, *eq_lo, *eq_hi, *eq_hi7;
+  BoolectorSort s8, s4;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s8     = boolector_bitvec_sort (d_btor, 8);
+  s4     = boolector_bitvec_sort (d_btor, 4);
+  x      = boolector_var (d_btor, s8, "x");
+  lo     = boolector_slice (d_btor, x, 3, 0);
+  hi     = boolector_slice (d_btor, x, 7, 4);
+  c2     = boolector_unsigned_int (d_btor, 2, s4);
+  c5     = boolector_unsigned_int (d_btor, 5, s4);
+  c7     = boolector_unsigned_int (d_btor, 7, s4);
+  eq_lo  = boolector_eq (d_btor, lo, c5);
+  eq_hi  = boolector_eq (d_btor, hi, c2);
+  eq_hi7 = boolector_eq (d_btor, hi, c7);
+  boolector_assert (d_btor, eq_lo);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.eliminated_slices, 1u);
+
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, eq_hi);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  assignment = boolector_bv_assignment (d_btor, x);
+  ASSERT_STREQ (assignment, "00100101");
+  boolector_free_bv_assignment (d_btor, assignment);
+  boolector_pop (d_btor, 1);
+
+  boolector_assume (d_btor, eq_hi7);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  assignment = boolector_bv_assignment (d_btor, x);
+  ASSERT_STREQ (assignment, "01110101");
+  boolector_free_bv_assignment (d_btor, assignment);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, lo);
+  boolector_release (d_btor, hi);
+  boolector_release (d_btor, c2);
+  boolector_release (d_btor, c5);
+  boolector_release (d_btor, c7);
+  boolector_release (d_btor, eq_lo);
+  boolector_release (d_btor, eq_hi);
+  boolector_release (d_btor, eq_hi7);
+  boolector_release_sort (d_btor, s8);
+  boolector_release_sort (d_btor, s4);
+}
+
+TEST_F (TestInc, eliminate_slices_scoped)
+{
+  int32_t sat_result;
+  const char *assignment;
+  BoolectorNode *y, *lo, *hi, *c1, *c5, *c6, *eq_lo5, *eq_lo6, *eq_hi1;
+  BoolectorSort s8, s4;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s8     = boolector_bitvec_sort (d_btor, 8);
+  s4     = boolector_bitvec_sort (d_btor, 4);
+  y      = boolector_var (d_btor, s8, "y");
+  lo     = boolector_slice (d_btor, y, 3, 0);
+  hi     = boolector_slice (d_btor, y, 7, 4);
+  c1     = boolector_unsigned_int (d_btor, 1, s4);
+  c5     = boolector_unsigned_int (d_btor, 5, s4);
+  c6     = boolector_unsigned_int (d_btor, 6, s4);
+  eq_lo5 = boolector_eq (d_btor, lo, c5);
+  eq_lo6 = boolector_eq (d_btor, lo, c6);
+  eq_hi1 = boolector_eq (d_btor, hi, c1);
+
+  /* 'y' is only sliced in the guarded assertion of the pushed level, the
+   * split of 'y' must remain valid after the level has been popped */
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, eq_lo5);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.eliminated_slices, 1u);
+  boolector_pop (d_btor, 1);
+
+  boolector_assert (d_btor, eq_lo6);
+  boolector_assert (d_btor, eq_hi1);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  assignment = boolector_bv_assignment (d_btor, y);
+  ASSERT_STREQ (assignment, "00010110");
+  boolector_free_bv_assignment (d_btor, assignment);
+
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, eq_lo5);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 1);
+
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, lo);
+  boolector_release (d_btor, hi);
+  boolector_release (d_btor, c1);
+  boolector_release (d_btor, c5);
+  boolector_release (d_btor, c6);
+  boolector_release (d_btor, eq_lo5);
+  boolector_release (d_btor, eq_lo6);
+  boolector_release (d_btor, eq_hi1);
+  boolector_release_sort (d_btor, s8);
+  boolector_release_sort (d_btor, s4);
+}
+
+TEST_F (TestInc, push_pop)
+{
+  int32_t sat_result;
+  const char *assignment;
+  BoolectorNode *x, *c3, *c10, *c20, *ult_x, *eq_x20, *eq_x3, *ne_x3;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s      = boolector_bitvec_sort (d_btor, 8);
+  x      = boolector_var (d_btor, s, "x");
+  c3     = boolector_unsigned_int (d_btor, 3, s);
+  c10    = boolector_unsigned_int (d_btor, 10, s);
+  c20    = boolector_unsigned_int (d_btor, 20, s);
+  ult_x  = boolector_ult (d_btor, x, c10);
+  eq_x20 = boolector_eq (d_btor, x, c20);
+  eq_x3  = boolector_eq (d_btor, x, c3);
+  ne_x3  = boolector_ne (d_btor, x, c3);
+
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, ult_x);
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, eq_x20);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+
+  boolector_pop (d_btor, 1);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  assignment = boolector_bv_assignment (d_btor, x);
+  ASSERT_LT (strtoul (assignment, 0, 2), 10u);
+  boolector_free_bv_assignment (d_btor, assignment);
+
+  /* fixating assumptions does not fixate the current context level */
+  boolector_assume (d_btor, eq_x3);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  boolector_fixate_assumptions (d_btor);
+  boolector_pop (d_btor, 1);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  assignment = boolector_bv_assignment (d_btor, x);
+  ASSERT_STREQ (assignment, "00000011");
+  boolector_free_bv_assignment (d_btor, assignment);
+  boolector_assert (d_btor, ne_x3);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, c3);
+  boolector_release (d_btor, c10);
+  boolector_release (d_btor, c20);
+  boolector_release (d_btor, ult_x);
+  boolector_release (d_btor, eq_x20);
+  boolector_release (d_btor, eq_x3);
+  boolector_release (d_btor, ne_x3);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, schedule_sat_limit)
+{
+  BoolectorNode *x, *y, *c, *one, *mul, *eq, *umulo, *nomulo, *ugtx, *ugty;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_SCHEDULE, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_SCHEDULE_UNIT, 10);
+
+  /* x * y = 4294967291 (prime), x > 1, y > 1, no overflow */
+  s      = boolector_bitvec_sort (d_btor, 32);
+  x      = boolector_var (d_btor, s, "x");
+  y      = boolector_var (d_btor, s, "y");
+  c      = boolector_constd (d_btor, s, "4294967291");
+  one    = boolector_one (d_btor, s);
+  mul    = boolector_mul (d_btor, x, y);
+  eq     = boolector_eq (d_btor, mul, c);
+  umulo  = boolector_umulo (d_btor, x, y);
+  nomulo = boolector_not (d_btor, umulo);
+  ugtx   = boolector_ugt (d_btor, x, one);
+  ugty   = boolector_ugt (d_btor, y, one);
+  boolector_assert (d_btor, eq);
+  boolector_assert (d_btor, nomulo);
+  boolector_assert (d_btor, ugtx);
+  boolector_assert (d_btor, ugty);
+
+  /* the SAT limit bounds all SAT slices of the schedule */
+  ASSERT_EQ (boolector_limited_sat (d_btor, -1, 100), BOOLECTOR_UNKNOWN);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, umulo);
+  boolector_release (d_btor, nomulo);
+  boolector_release (d_btor, ugtx);
+  boolector_release (d_btor, ugty);
+  boolector_release_sort (d_btor, s);
+}
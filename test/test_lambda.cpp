@@ -1613,3 +1613,90 @@ TEST_F (TestLambda, define_fun)
   btor_mem_free (d_btor->mm, ands, size - sizeof (BtorNode *));
   btor_node_release (d_btor, result);
 }
+
+/* (lambda x . (x < a ? b : c)) (i) with partial beta reduction results
+ * cached (miss, hit) and not cached, where condition i < a is true in the
+ * first and false in the second refinement run */
+TEST_F (TestLambda, partial_reduce_cached)
+{
+  uint32_t k, round;
+  BtorNode *a, *b, *c, *d, *i, *x, *ult, *ite, *fun, *args, *app, *ne, *lt;
+  BtorNode *res[3];
+  BtorPtrHashTable *conds[3];
+  BtorPtrHashTableIterator it;
+  BtorBetaCache *cache;
+
+  btor_opt_set (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  btor_opt_set (d_btor, BTOR_OPT_CHK_MODEL, 0);
+
+  a    = btor_exp_var (d_btor, d_elem_sort, "a");
+  b    = btor_exp_var (d_btor, d_elem_sort, "b");
+  c    = btor_exp_var (d_btor, d_elem_sort, "c");
+  d    = btor_exp_var (d_btor, d_elem_sort, "d");
+  i    = btor_exp_var (d_btor, d_elem_sort, "i");
+  x    = btor_exp_param (d_btor, d_elem_sort, "x");
+  ult  = btor_exp_bv_ult (d_btor, x, a);
+  ite  = btor_exp_cond (d_btor, ult, b, c);
+  fun  = btor_exp_lambda (d_btor, x, ite);
+  args = btor_exp_args (d_btor, &i, 1);
+  app  = btor_exp_apply (d_btor, fun, args);
+  ne   = btor_exp_ne (d_btor, app, d);
+  btor_assert_exp (d_btor, ne);
+  lt = btor_exp_bv_ult (d_btor, i, a);
+
+  cache = btor_beta_cache_new (d_btor);
+  for (round = 0; round < 2; round++)
+  {
+    btor_assume_exp (d_btor, round ? btor_node_invert (lt) : lt);
+    ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+    /* the model changed, cached results are stale */
+    btor_beta_cache_reset (cache);
+
+    for (k = 0; k < 3; k++)
+    {
+      conds[k] = btor_hashptr_table_new (d_btor->mm,
+                                         (BtorHashPtr) btor_node_hash_by_id,
+                                         (BtorCmpPtr) btor_node_compare_by_id);
+      res[k]   = btor_beta_reduce_partial_cached (
+          d_btor, fun, args, conds[k], k < 2 ? cache : 0);
+    }
+    ASSERT_EQ (cache->stats.misses, round + 1);
+    ASSERT_EQ (cache->stats.hits, round + 1);
+    ASSERT_EQ (res[0], round ? c : b);
+
+    for (k = 1; k < 3; k++)
+    {
+      ASSERT_EQ (res[k], res[0]);
+      ASSERT_EQ (conds[k]->count, conds[0]->count);
+      btor_iter_hashptr_init (&it, conds[k]);
+      while (btor_iter_hashptr_has_next (&it))
+        ASSERT_TRUE (btor_hashptr_table_get (conds[0],
+                                             btor_iter_hashptr_next (&it)));
+    }
+
+    for (k = 0; k < 3; k++)
+    {
+      btor_iter_hashptr_init (&it, conds[k]);
+      while (btor_iter_hashptr_has_next (&it))
+        btor_node_release (d_btor,
+                           (BtorNode *) btor_iter_hashptr_next (&it));
+      btor_hashptr_table_delete (conds[k]);
+      btor_node_release (d_btor, res[k]);
+    }
+  }
+  btor_beta_cache_delete (cache);
+
+  btor_node_release (d_btor, lt);
+  btor_node_release (d_btor, ne);
+  btor_node_release (d_btor, app);
+  btor_node_release (d_btor, args);
+  btor_node_release (d_btor, fun);
+  btor_node_release (d_btor, ite);
+  btor_node_release (d_btor, ult);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, i);
+  btor_node_release (d_btor, d);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, b);
+  btor_node_release (d_btor, a);
+}
@@ -1256,6 +1256,61 @@ class TestPropInv : public TestBtor
 #endif
   }
 
+#ifndef NDEBUG
+  /* Check that invertibility condition 'is_inv' holds for all values s and t
+   * of bit-width 'bw_s' if and only if there exists an x of bit-width 'bw_x'
+   * with x <> s = t (eidx = 0) or s <> x = t (eidx = 1). */
+  void check_is_inv (BtorBitVector *(*bv_fun) (BtorMemMgr *,
+                                               const BtorBitVector *,
+                                               const BtorBitVector *),
+                     bool (*is_inv) (BtorMemMgr *,
+                                     const BtorBitVector *,
+                                     const BtorBitVector *,
+                                     int32_t),
+                     uint32_t bw_x,
+                     uint32_t bw_s)
+  {
+    bool *exists;
+    int32_t eidx;
+    uint32_t bw_t, nt;
+    uint64_t i, j;
+    BtorBitVector *s, *t, *x, *r;
+
+    for (eidx = 0; eidx <= 1; eidx++)
+    {
+      for (i = 0; i < (1u << bw_s); i++)
+      {
+        s      = btor_bv_uint64_to_bv (d_mm, i, bw_s);
+        exists = 0;
+        bw_t   = 0;
+        nt     = 0;
+        for (j = 0; j < (1u << bw_x); j++)
+        {
+          x = btor_bv_uint64_to_bv (d_mm, j, bw_x);
+          r = eidx ? bv_fun (d_mm, s, x) : bv_fun (d_mm, x, s);
+          if (!exists)
+          {
+            bw_t   = btor_bv_get_width (r);
+            nt     = 1u << bw_t;
+            exists = (bool *) calloc (nt, sizeof (bool));
+          }
+          exists[btor_bv_to_uint64 (r)] = true;
+          btor_bv_free (d_mm, r);
+          btor_bv_free (d_mm, x);
+        }
+        for (j = 0; j < nt; j++)
+        {
+          t = btor_bv_uint64_to_bv (d_mm, j, bw_t);
+          ASSERT_EQ (is_inv (d_mm, t, s, eidx), exists[j]);
+          btor_bv_free (d_mm, t);
+        }
+        free (exists);
+        btor_bv_free (d_mm, s);
+      }
+    }
+  }
+#endif
+
   BtorMemMgr *d_mm = nullptr;
   BtorRNG *d_rng   = nullptr;
 
@@ -1614,3 +1669,82 @@ TEST_F (TestPropInv, conf_concat)
   check_conf_concat (4);
   check_conf_concat (8);
 }
+
+TEST_F (TestPropInv, is_inv_and)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_and,
+                is_inv_and,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_ult)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_ult,
+                is_inv_ult,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_sll)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_sll,
+                is_inv_sll,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_srl)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_srl,
+                is_inv_srl,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_mul)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_mul,
+                is_inv_mul,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_udiv)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_udiv,
+                is_inv_udiv,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_urem)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_urem,
+                is_inv_urem,
+                TEST_PROP_INV_COMPLETE_BW,
+                TEST_PROP_INV_COMPLETE_BW);
+#endif
+}
+
+TEST_F (TestPropInv, is_inv_concat)
+{
+#ifndef NDEBUG
+  check_is_inv (btor_bv_concat, is_inv_concat, 1, 3);
+  check_is_inv (btor_bv_concat, is_inv_concat, 2, 2);
+  check_is_inv (btor_bv_concat, is_inv_concat, 3, 1);
+#endif
+}
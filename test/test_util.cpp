@@ -29,6 +29,17 @@ TEST (TestUtil, is_power_of_2)
   ASSERT_TRUE (btor_util_is_power_of_2 (256));
 }
 
+TEST (TestUtil, luby)
+{
+  uint32_t i;
+  uint32_t seq[] = {1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, 1};
+
+  for (i = 0; i < sizeof (seq) / sizeof (*seq); i++)
+    ASSERT_EQ (btor_util_luby (i + 1), seq[i]);
+  ASSERT_EQ (btor_util_luby (31), 16u);
+  ASSERT_EQ (btor_util_luby (32), 1u);
+}
+
 TEST (TestUtil, log_2)
 {
   ASSERT_EQ (btor_util_log_2 (1), 0u);
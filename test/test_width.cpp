@@ -0,0 +1,155 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestWidth : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_REDUCE_WIDTHS, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+    d_sort8  = boolector_bitvec_sort (d_btor, 8);
+    d_sort64 = boolector_bitvec_sort (d_btor, 64);
+  }
+
+  void TearDown () override
+  {
+    boolector_release_sort (d_btor, d_sort8);
+    boolector_release_sort (d_btor, d_sort64);
+    TestBoolector::TearDown ();
+  }
+
+  /* assert 'exp', takes ownership of 'exp' */
+  void assert_exp (BoolectorNode *exp)
+  {
+    boolector_assert (d_btor, exp);
+    boolector_release (d_btor, exp);
+  }
+
+  /* assert 'exp' < 'bound' */
+  void assert_ult (BoolectorNode *exp, uint32_t bound)
+  {
+    BoolectorNode *c = boolector_unsigned_int (d_btor, bound, d_sort64);
+    assert_exp (boolector_ult (d_btor, exp, c));
+    boolector_release (d_btor, c);
+  }
+
+  /* assert 'exp' = 'value' */
+  void assert_eq (BoolectorNode *exp, int32_t value)
+  {
+    BoolectorNode *c =
+        boolector_int (d_btor, value, boolector_get_sort (d_btor, exp));
+    assert_exp (boolector_eq (d_btor, exp, c));
+    boolector_release (d_btor, c);
+  }
+
+  uint64_t value (BoolectorNode *exp)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, exp);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  BoolectorSort d_sort8;
+  BoolectorSort d_sort64;
+};
+
+TEST_F (TestWidth, bounded_vars)
+{
+  BoolectorNode *x, *y, *mul;
+
+  x   = boolector_var (d_btor, d_sort64, "x");
+  y   = boolector_var (d_btor, d_sort64, "y");
+  mul = boolector_mul (d_btor, x, y);
+  assert_ult (x, 256);
+  assert_ult (y, 256);
+  assert_eq (mul, 16129);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.width_reduced_vars, 2u);
+  ASSERT_EQ (value (x), 127u);
+  ASSERT_EQ (value (y), 127u);
+
+  /* constraints stay valid in incremental mode */
+  assert_eq (x, 300);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+}
+
+TEST_F (TestWidth, extended_ops)
+{
+  BoolectorNode *a, *b, *sa, *sb, *ua, *ub, *smul, *uadd;
+
+  /* splitting 'a' and 'b' at their sign bits hides the sign extensions */
+  boolector_set_opt (d_btor, BTOR_OPT_ELIMINATE_SLICES, 0);
+  a    = boolector_var (d_btor, d_sort8, "a");
+  b    = boolector_var (d_btor, d_sort8, "b");
+  sa   = boolector_sext (d_btor, a, 56);
+  sb   = boolector_sext (d_btor, b, 56);
+  ua   = boolector_uext (d_btor, a, 56);
+  ub   = boolector_uext (d_btor, b, 56);
+  smul = boolector_mul (d_btor, sa, sb);
+  uadd = boolector_add (d_btor, ua, ub);
+  assert_eq (smul, -6);
+  assert_eq (uadd, 257);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.width_reduced_ops, 0u);
+  ASSERT_EQ ((int8_t) value (a) * (int8_t) value (b), -6);
+  ASSERT_EQ (value (a) + value (b), 257u);
+  ASSERT_EQ (value (smul), (uint64_t) -6);
+
+  boolector_release (d_btor, smul);
+  boolector_release (d_btor, uadd);
+  boolector_release (d_btor, sa);
+  boolector_release (d_btor, sb);
+  boolector_release (d_btor, ua);
+  boolector_release (d_btor, ub);
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, b);
+}
+
+TEST_F (TestWidth, sliced_ops)
+{
+  BoolectorNode *x, *y, *add, *mul, *slice;
+
+  x     = boolector_var (d_btor, d_sort64, "x");
+  y     = boolector_var (d_btor, d_sort64, "y");
+  add   = boolector_add (d_btor, x, y);
+  mul   = boolector_mul (d_btor, add, x);
+  slice = boolector_slice (d_btor, mul, 7, 0);
+  assert_eq (slice, 0x35);
+  boolector_release (d_btor, slice);
+  slice = boolector_slice (d_btor, add, 3, 0);
+  assert_eq (slice, 0x7);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.width_reduced_ops, 0u);
+  ASSERT_EQ ((value (x) + value (y)) * value (x) & 0xff, 0x35u);
+  ASSERT_EQ (value (add) & 0xf, 0x7u);
+  ASSERT_EQ (value (mul), (value (x) + value (y)) * value (x));
+
+  boolector_release (d_btor, slice);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, add);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+}